@@ -0,0 +1,474 @@
+////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2024 The Octave Project Developers
+//
+// See the file COPYRIGHT.md in the top-level directory of this
+// distribution or <https://octave.org/copyright/>.
+//
+// This file is part of Octave.
+//
+// Octave is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Octave is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Octave; see the file COPYING.  If not, see
+// <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////
+
+#if defined (HAVE_CONFIG_H)
+#  include "config.h"
+#endif
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "dNDArray.h"
+#include "fNDArray.h"
+#include "lo-mappers.h"
+#include "sparse-util.h"
+
+#include "defun.h"
+#include "error.h"
+#include "ovl.h"
+#include "utils.h"
+
+OCTAVE_BEGIN_NAMESPACE(octave)
+
+// Count the edges of a sorted array of M edges that are less than or
+// equal to a value (upper) or less than it (lower).  If the edges are
+// close to uniformly spaced, the position of the value is computed with
+// a multiplication and corrected by at most a few comparisons.
+// Otherwise, it is found by a binary search whose steps do not branch
+// on the data.  NaN is never counted.
+
+template <typename T>
+class bin_locator
+{
+public:
+
+  bin_locator (const T *e, octave_idx_type m)
+    : m_e (e), m_n (m), m_uniform (false), m_scale (0)
+  {
+    if (m < 2 || ! math::isfinite (e[0]) || ! math::isfinite (e[m-1])
+        || ! (e[0] < e[m-1]))
+      return;
+
+    T d = (e[m-1] - e[0]) / (m - 1);
+
+    if (! (d > 0))
+      return;
+
+    // The guess is off by at most one if no edge is further than a
+    // quarter of the spacing from its uniform position.
+    for (octave_idx_type i = 0; i < m; i++)
+      {
+        if (! (std::abs (e[i] - (e[0] + i * d)) <= d / 4))
+          return;
+      }
+
+    m_uniform = true;
+    m_scale = (m - 1) / (e[m-1] - e[0]);
+  }
+
+  bool is_uniform () const { return m_uniform; }
+
+  octave_idx_type upper (T y) const
+  {
+    const T *e = m_e;
+    octave_idx_type m = m_n;
+
+    if (m == 0)
+      return 0;
+
+    if (m_uniform)
+      {
+        if (! (y >= e[0]))
+          return 0;
+        if (y >= e[m-1])
+          return m;
+
+        octave_idx_type g = guess (y);
+        while (g > 0 && e[g] > y)
+          g--;
+        while (g + 1 < m && e[g+1] <= y)
+          g++;
+
+        return g + 1;
+      }
+
+    const T *base = e;
+    while (m > 1)
+      {
+        octave_idx_type half = m / 2;
+        base = (base[half] <= y ? base + half : base);
+        m -= half;
+      }
+
+    return (base - e) + (*base <= y);
+  }
+
+  octave_idx_type lower (T y) const
+  {
+    const T *e = m_e;
+    octave_idx_type m = m_n;
+
+    if (m == 0)
+      return 0;
+
+    if (m_uniform)
+      {
+        if (! (y > e[0]))
+          return 0;
+        if (y > e[m-1])
+          return m;
+
+        octave_idx_type g = guess (y);
+        while (g > 0 && e[g] >= y)
+          g--;
+        while (g + 1 < m && e[g+1] < y)
+          g++;
+
+        return g + 1;
+      }
+
+    const T *base = e;
+    while (m > 1)
+      {
+        octave_idx_type half = m / 2;
+        base = (base[half] < y ? base + half : base);
+        m -= half;
+      }
+
+    return (base - e) + (*base < y);
+  }
+
+private:
+
+  // Index of the edge next to Y, for E[0] <= Y <= E[M-1].
+
+  octave_idx_type guess (T y) const
+  {
+    octave_idx_type g = static_cast<octave_idx_type> ((y - m_e[0]) * m_scale);
+
+    return (g < m_n - 1 ? g : m_n - 1);
+  }
+
+  const T *m_e;
+
+  octave_idx_type m_n;
+
+  bool m_uniform;
+
+  T m_scale;
+};
+
+// Bin the elements of X, an NL by NN by NU array, along its second
+// dimension into the NL by NB by NU array COUNT, adding the weights W
+// or 1.  With the edges E[0] <= ... <= E[M-1], the bins are those of
+// histc if HIST is false: bin K (one-based) holds E[K-1] <= X < E[K],
+// and the last bin holds X == E[M-1].  If HIST is true, the edges are
+// the cutoffs between the bins of hist: bin K holds E[K-2] < X <=
+// E[K-1], with open ends, so there are M+1 bins.  NaN is not counted.
+// If IDX is not null, it receives the bin of each element, or 0.
+
+template <typename T, typename W>
+static void
+histc_kernel (const T *x, octave_idx_type nl, octave_idx_type nn,
+              octave_idx_type nu, const T *e, octave_idx_type m, bool hist,
+              const W *w, W *count, double *idx)
+{
+  const bin_locator<T> loc (e, m);
+  const octave_idx_type nb = (hist ? m + 1 : m);
+
+  auto bin = [&loc, e, m, hist] (T y) -> octave_idx_type
+  {
+    if (hist)
+      return (math::isnan (y) ? 0 : loc.lower (y) + 1);
+
+    octave_idx_type k = loc.upper (y);
+    if (k == m && k > 0 && ! (y == e[m-1]))
+      k = 0;
+
+    return k;
+  };
+
+  double cost = (loc.is_uniform () ? 8 : 4 + std::log2 (m + 1.0));
+  octave_idx_type nslices = nl * nu;
+  octave_idx_type n = nslices * nn;
+
+  if (n == 0)
+    return;
+
+  int nt = sparse_kernel_threads (cost * n);
+
+  if (nt <= nslices)
+    {
+      // Each histogram is filled by a single thread.  Within a range of
+      // histograms, X is read in memory order.  The histograms are split
+      // like the columns of a sparse matrix with one element in each, as
+      // sparse_range_blocks would only split more elements than there
+      // are histograms.
+
+      std::vector<octave_idx_type> sidx (nslices + 1);
+      for (octave_idx_type s = 0; s <= nslices; s++)
+        sidx[s] = s;
+
+      sparse_column_blocks (sidx.data (), nslices, nt,
+                            [=] (octave_idx_type sb, octave_idx_type se)
+      {
+        for (octave_idx_type u = sb / nl; u * nl < se; u++)
+          {
+            octave_idx_type lb = std::max (sb - u * nl,
+                                           static_cast<octave_idx_type> (0));
+            octave_idx_type le = std::min (se - u * nl, nl);
+            W *cu = count + u * nl * nb;
+
+            for (octave_idx_type j = 0; j < nn; j++)
+              {
+                octave_idx_type off = nl * (j + nn * u);
+
+                for (octave_idx_type l = lb; l < le; l++)
+                  {
+                    octave_idx_type k = bin (x[off+l]);
+
+                    if (k > 0)
+                      cu[l + nl * (k-1)] += (w ? w[off+l] : 1);
+                    if (idx)
+                      idx[off+l] = k;
+                  }
+              }
+          }
+      });
+    }
+  else
+    {
+      // Few histograms of many elements.  Each thread fills its own
+      // copy of all histograms, which are added at the end.
+
+      octave_idx_type nc = nslices * nb;
+      std::vector<std::vector<W>> part (nt);
+
+      sparse_thread_blocks (n, nt, [=, &part] (int t, octave_idx_type ib,
+                                               octave_idx_type ie)
+      {
+        std::vector<W>& c = part[t];
+        if (c.empty ())
+          c.assign (nc, 0);
+
+        octave_idx_type l = ib % nl;
+        octave_idx_type j = (ib / nl) % nn;
+        octave_idx_type u = ib / (nl * nn);
+
+        for (octave_idx_type i = ib; i < ie; i++)
+          {
+            octave_idx_type k = bin (x[i]);
+
+            if (k > 0)
+              c[l + nl * (k-1 + nb * u)] += (w ? w[i] : 1);
+            if (idx)
+              idx[i] = k;
+
+            if (++l == nl)
+              {
+                l = 0;
+                if (++j == nn)
+                  {
+                    j = 0;
+                    u++;
+                  }
+              }
+          }
+      });
+
+      for (const auto& c : part)
+        {
+          if (! c.empty ())
+            {
+              for (octave_idx_type i = 0; i < nc; i++)
+                count[i] += c[i];
+            }
+        }
+    }
+}
+
+template <typename NDA, typename WNDA>
+static octave_value_list
+do_histc (const NDA& x, const NDA& edges, int dim, const WNDA& w,
+          bool hist, int nargout)
+{
+  typedef typename WNDA::element_type W;
+
+  dim_vector dv = x.dims ();
+  octave_idx_type nl = 1, nn = 1, nu = 1;
+
+  for (int i = 0; i < dv.ndims (); i++)
+    {
+      if (i < dim)
+        nl *= dv(i);
+      else if (i == dim)
+        nn = dv(i);
+      else
+        nu *= dv(i);
+    }
+
+  octave_idx_type m = edges.numel ();
+  octave_idx_type nb = (hist ? m + 1 : m);
+
+  dim_vector rdv = dv;
+  rdv.resize (std::max (dim + 1, static_cast<int> (dv.ndims ())), 1);
+  rdv(dim) = nb;
+
+  WNDA count (rdv, W (0));
+  NDArray idx;
+
+  if (nargout > 1)
+    idx = NDArray (dv);
+
+  histc_kernel (x.data (), nl, nn, nu, edges.data (), m, hist,
+                (w.isempty () ? nullptr : w.data ()), count.rwdata (),
+                (nargout > 1 ? idx.rwdata () : nullptr));
+
+  octave_value_list retval (nargout > 1 ? 2 : 1);
+
+  retval(0) = count;
+  if (nargout > 1)
+    retval(1) = idx;
+
+  return retval;
+}
+
+template <typename NDA>
+static octave_value_list
+do_histc (const octave_value_list& args, int dim, bool hist, int nargout)
+{
+  const NDA x = octave_value_extract<NDA> (args(0));
+  const NDA edges = octave_value_extract<NDA> (args(1));
+
+  octave_value w = (args.length () > 3 ? args(3) : octave_value ());
+
+  if (w.is_defined () && ! w.isempty ())
+    {
+      if (w.dims () != x.dims ())
+        error ("__histc__: W must have the same size as X");
+
+      if (! w.isreal ())
+        error ("__histc__: W must be real");
+
+      if (w.is_single_type ())
+        return do_histc (x, edges, dim, w.float_array_value (), hist, nargout);
+      else
+        return do_histc (x, edges, dim, w.array_value (), hist, nargout);
+    }
+
+  return do_histc (x, edges, dim, NDArray (), hist, nargout);
+}
+
+DEFUN (__histc__, args, nargout,
+       doc: /* -*- texinfo -*-
+@deftypefn  {} {[@var{n}, @var{idx}] =} __histc__ (@var{x}, @var{edges}, @var{dim})
+@deftypefnx {} {[@var{n}, @var{idx}] =} __histc__ (@var{x}, @var{edges}, @var{dim}, @var{w})
+@deftypefnx {} {[@var{n}, @var{idx}] =} __histc__ (@var{x}, @var{edges}, @var{dim}, @var{w}, @var{type})
+Undocumented internal function.
+@end deftypefn */)
+{
+  // Count the elements of X along dimension DIM in the bins given by
+  // the sorted vector EDGES, as histc does.  If W is given and not
+  // empty, add the elements of W instead of 1.  If TYPE is "hist",
+  // EDGES are the cutoffs between the bins of hist instead, and there is
+  // one bin more than there are edges.  IDX is the bin of each element
+  // of X, or 0 if it is in no bin.
+
+  int nargin = args.length ();
+
+  if (nargin < 3 || nargin > 5)
+    print_usage ();
+
+  if (! args(0).isreal () || ! args(1).isreal ())
+    error ("__histc__: X and EDGES must be real");
+
+  int dim = args(2).xint_value ("__histc__: DIM must be an integer") - 1;
+
+  if (dim < 0)
+    error ("__histc__: DIM must be a valid dimension");
+
+  bool hist = false;
+
+  if (nargin > 4)
+    {
+      std::string type = args(4).xstring_value ("__histc__: TYPE must be a string");
+
+      if (type == "hist")
+        hist = true;
+      else if (type != "histc")
+        error (R"(__histc__: TYPE must be "histc" or "hist")");
+    }
+
+  if (args(0).is_single_type () && args(1).is_single_type ())
+    return do_histc<FloatNDArray> (args, dim, hist, nargout);
+  else
+    return do_histc<NDArray> (args, dim, hist, nargout);
+}
+
+/*
+%!test
+%! x = [0.5, 1, 1.5, 2, 2.5, 3, 3.5, NaN, -Inf, Inf];
+%! [n, idx] = __histc__ (x, [1, 2, 3], 2);
+%! assert (n, [2, 2, 1]);
+%! assert (idx, [0, 1, 1, 2, 2, 3, 0, 0, 0, 0]);
+%! [n, idx] = __histc__ (x, [1, 2, 3], 2, [], "hist");
+%! assert (n, [3, 2, 2, 2]);
+%! assert (idx, [1, 1, 2, 2, 3, 3, 4, 0, 1, 4]);
+
+## Uniform and non-uniform edges, along each dimension
+%!test
+%! x = 10 * rand (40, 30, 3) - 1;
+%! x(1:7:end) = NaN;
+%! for edges = {0:8, [0, 1, 1.5, 4, 8, 8.5]}
+%!   e = edges{1};
+%!   for dim = 1:3
+%!     [n, idx] = __histc__ (x, e, dim);
+%!     sz = size (x);
+%!     sz(dim) = numel (e);
+%!     n0 = zeros (sz);
+%!     idx0 = zeros (size (x));
+%!     c = {":", ":", ":"};
+%!     for k = 1:numel (e)
+%!       if (k < numel (e))
+%!         b = (e(k) <= x & x < e(k+1));
+%!       else
+%!         b = (x == e(end));
+%!       endif
+%!       idx0(b) = k;
+%!       c{dim} = k;
+%!       n0(c{:}) = sum (b, dim);
+%!     endfor
+%!     assert (n, n0);
+%!     assert (idx, idx0);
+%!   endfor
+%! endfor
+
+%!test
+%! x = [1, 2, 2, 3, 5];
+%! w = [1, 10, 100, 1000, 10000];
+%! assert (__histc__ (x, [1, 2, 3], 2, w), [1, 110, 1000]);
+%! assert (__histc__ (x, [1, 2, 3], 2, single (w)), single ([1, 110, 1000]));
+%! assert (__histc__ (x, [], 2, w, "hist"), 11111);
+%! assert (__histc__ (x', [1, 2, 3], 1, w'), [1; 110; 1000]);
+
+%!assert (class (__histc__ (single (1:3), single ([1, 2]), 2)), "double")
+%!assert (size (__histc__ (ones (2, 3), 1:4, 3)), [2, 3, 4])
+
+%!error <W must have the same size as X> __histc__ (1:3, 1:2, 2, 1:2)
+%!error <TYPE must be> __histc__ (1:3, 1:2, 2, [], "foo")
+*/
+
+OCTAVE_END_NAMESPACE(octave)
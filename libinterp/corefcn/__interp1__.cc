@@ -0,0 +1,538 @@
+////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2024 The Octave Project Developers
+//
+// See the file COPYRIGHT.md in the top-level directory of this
+// distribution or <https://octave.org/copyright/>.
+//
+// This file is part of Octave.
+//
+// Octave is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Octave is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Octave; see the file COPYING.  If not, see
+// <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////
+
+#if defined (HAVE_CONFIG_H)
+#  include "config.h"
+#endif
+
+#include <string>
+#include <vector>
+
+#include "dNDArray.h"
+#include "f77-fcn.h"
+#include "fNDArray.h"
+#include "lo-mappers.h"
+#include "lo-slatec-proto.h"
+#include "sparse-util.h"
+
+#include "defun.h"
+#include "error.h"
+#include "interp-grid.h"
+#include "ovl.h"
+#include "utils.h"
+
+OCTAVE_BEGIN_NAMESPACE(octave)
+
+enum interp1_method
+{
+  INTERP1_LINEAR,
+  INTERP1_NEAREST,
+  INTERP1_PREVIOUS,
+  INTERP1_NEXT,
+  INTERP1_CUBIC
+};
+
+// Derivatives of the piecewise cubic Hermite interpolant, as computed by
+// __pchip_deriv__.
+
+static void
+pchip_slopes (F77_INT n, const double *x, const double *y, double *d)
+{
+  F77_INT ierr;
+
+  F77_XFCN (dpchim, DPCHIM, (n, x, y, d, 1, ierr));
+
+  if (ierr < 0)
+    error ("__interp1__: DPCHIM failed with ierr = %"
+           OCTAVE_F77_INT_TYPE_FORMAT, ierr);
+}
+
+static void
+pchip_slopes (F77_INT n, const float *x, const float *y, float *d)
+{
+  F77_INT ierr;
+
+  F77_XFCN (pchim, PCHIM, (n, x, y, d, 1, ierr));
+
+  if (ierr < 0)
+    error ("__interp1__: PCHIM failed with ierr = %"
+           OCTAVE_F77_INT_TYPE_FORMAT, ierr);
+}
+
+// The cubic pieces of the interpolants are stored as in the pp form.
+// COEF[4*(K*NP+J)+P] is the coefficient of (X - X[J])^(3-P) in piece J
+// of column K, and NP is the number of pieces.
+
+// Piecewise cubic Hermite interpolation, with the same operations as
+// pchip.m.
+
+template <typename T>
+static void
+pchip_coefs (const T *x, octave_idx_type n, const T *y, octave_idx_type nc,
+             T *coef)
+{
+  octave_idx_type np = n - 1;
+  std::vector<T> d (n);
+
+  for (octave_idx_type k = 0; k < nc; k++)
+    {
+      const T *yk = y + k * n;
+      T *ck = coef + 4 * k * np;
+
+      pchip_slopes (to_f77_int (n), x, yk, d.data ());
+
+      for (octave_idx_type j = 0; j < np; j++)
+        {
+          T h = x[j+1] - x[j];
+          T delta = (yk[j+1] - yk[j]) / h;
+          T del1 = (d[j] - delta) / h;
+          T del2 = (d[j+1] - delta) / h;
+          T c3 = del1 + del2;
+          T c2 = -c3 - del1;
+          c3 /= h;
+
+          ck[4*j] = c3;
+          ck[4*j+1] = c2;
+          ck[4*j+2] = d[j];
+          ck[4*j+3] = yk[j];
+        }
+    }
+}
+
+// Cubic spline interpolation with not-a-knot end conditions, with the
+// same operations as spline.m.  The tridiagonal system for the second
+// derivatives has the same matrix for all columns, so it is factored
+// once.  For three points, the spline is a single parabola on [X[0],
+// X[2]], and the first knot of the pieces is returned in NK.
+
+template <typename T>
+static void
+spline_coefs (const T *x, octave_idx_type n, const T *y, octave_idx_type nc,
+              T *coef, octave_idx_type& nk)
+{
+  nk = n;
+
+  if (n == 2)
+    {
+      for (octave_idx_type k = 0; k < nc; k++)
+        {
+          const T *a = y + k * n;
+          T *ck = coef + 4 * k;
+
+          ck[0] = 0;
+          ck[1] = 0;
+          ck[2] = (a[1] - a[0]) / (x[1] - x[0]);
+          ck[3] = a[0];
+        }
+
+      return;
+    }
+
+  if (n == 3)
+    {
+      nk = 2;
+
+      for (octave_idx_type k = 0; k < nc; k++)
+        {
+          const T *a = y + k * n;
+          T *ck = coef + 4 * k;
+
+          ck[0] = 0;
+          ck[1] = (a[0] - a[2]) / ((x[2] - x[0]) * (x[1] - x[2]))
+                  + (a[1] - a[0]) / ((x[1] - x[0]) * (x[1] - x[2]));
+          ck[2] = (a[1] - a[0]) * (x[2] - x[0])
+                  / ((x[1] - x[0]) * (x[2] - x[1]))
+                  + (a[0] - a[2]) * (x[1] - x[0])
+                  / ((x[2] - x[0]) * (x[2] - x[1]));
+          ck[3] = a[0];
+        }
+
+      return;
+    }
+
+  octave_idx_type np = n - 1;
+  octave_idx_type m = n - 2;
+
+  std::vector<T> h (np);
+  for (octave_idx_type j = 0; j < np; j++)
+    h[j] = x[j+1] - x[j];
+
+  // Diagonal, lower and upper diagonal of the system.
+
+  std::vector<T> dg (m), ldg (m-1), udg (m-1);
+
+  if (n == 4)
+    {
+      dg[0] = h[0] + 2 * h[1];
+      dg[1] = 2 * h[1] + h[2];
+      ldg[0] = h[1] - h[2];
+      udg[0] = h[1] - h[0];
+    }
+  else
+    {
+      for (octave_idx_type r = 0; r < m; r++)
+        dg[r] = 2 * (h[r] + h[r+1]);
+      dg[0] -= h[0];
+      dg[m-1] -= h[np-1];
+
+      for (octave_idx_type r = 0; r < m - 1; r++)
+        ldg[r] = udg[r] = h[r+1];
+      udg[0] -= h[0];
+      ldg[m-2] -= h[np-1];
+    }
+
+  // Forward elimination without pivoting.
+
+  std::vector<T> w (m);
+  for (octave_idx_type r = 1; r < m; r++)
+    {
+      w[r] = ldg[r-1] / dg[r-1];
+      dg[r] -= w[r] * udg[r-1];
+    }
+
+  std::vector<T> g (m), c (n);
+
+  for (octave_idx_type k = 0; k < nc; k++)
+    {
+      const T *a = y + k * n;
+      T *ck = coef + 4 * k * np;
+
+      g[0] = 3 / (h[0] + h[1])
+             * (a[2] - a[1] - h[1] / h[0] * (a[1] - a[0]));
+      g[m-1] = 3 / (h[np-1] + h[np-2])
+               * (h[np-2] / h[np-1] * (a[n-1] - a[n-2])
+                  - (a[n-2] - a[n-3]));
+      for (octave_idx_type r = 1; r < m - 1; r++)
+        g[r] = 3 * (a[r+2] - a[r+1]) / h[r+1] - 3 * (a[r+1] - a[r]) / h[r];
+
+      for (octave_idx_type r = 1; r < m; r++)
+        g[r] -= w[r] * g[r-1];
+
+      c[m] = g[m-1] / dg[m-1];
+      for (octave_idx_type r = m - 2; r >= 0; r--)
+        c[r+1] = (g[r] - udg[r] * c[r+2]) / dg[r];
+
+      c[0] = c[1] + h[0] / h[1] * (c[1] - c[2]);
+      c[n-1] = c[n-2] + h[np-1] / h[np-2] * (c[n-2] - c[n-3]);
+
+      for (octave_idx_type j = 0; j < np; j++)
+        {
+          ck[4*j] = (c[j+1] - c[j]) / (3 * h[j]);
+          ck[4*j+1] = c[j];
+          ck[4*j+2] = (a[j+1] - a[j]) / h[j]
+                      - h[j] / 3 * (c[j+1] + 2 * c[j]);
+          ck[4*j+3] = a[j];
+        }
+    }
+}
+
+// Evaluate the interpolant of the columns of Y (N by NC) at the points
+// XI.  X is strictly increasing.  For the cubic methods, the pieces
+// start at X[0] to X[NK-2] and are given by COEF.  Points outside of
+// [X[0], X[N-1]] are set to EXTRAPVAL unless EXTRAP is true, in which
+// case the first and last piece are extended.
+
+template <typename T>
+static void
+interp1_eval (interp1_method method, const T *x, octave_idx_type n,
+              const T *y, octave_idx_type nc, const T *coef,
+              octave_idx_type nk, const T *xi, octave_idx_type ni,
+              bool extrap, T extrapval, T *yi)
+{
+  T xmin = x[0];
+  T xmax = x[n-1];
+
+  // The slopes of the linear pieces, as in the pp form used by
+  // interp1.m.
+
+  std::vector<T> slope;
+
+  if (method == INTERP1_LINEAR)
+    {
+      slope.resize ((n-1) * nc);
+
+      for (octave_idx_type k = 0; k < nc; k++)
+        for (octave_idx_type j = 0; j < n - 1; j++)
+          slope[k*(n-1)+j] = (y[k*n+j+1] - y[k*n+j]) / (x[j+1] - x[j]);
+    }
+
+  const T *xk = (method == INTERP1_CUBIC ? x : nullptr);
+  octave_idx_type np = nk - 1;
+
+  int nt = sparse_kernel_threads (static_cast<double> (ni) * (4 * nc + 8));
+
+  sparse_range_blocks (ni, nt, [=, &slope] (octave_idx_type ib,
+                                            octave_idx_type ie)
+  {
+    grid_locator<T> locate (x, n);
+    grid_locator<T> locate_piece (xk, nk);
+
+    for (octave_idx_type i = ib; i < ie; i++)
+      {
+        T t = xi[i];
+
+        if (math::isnan (t) || (! extrap && (t < xmin || t > xmax)))
+          {
+            T val = (extrap ? t : extrapval);
+            for (octave_idx_type k = 0; k < nc; k++)
+              yi[i+k*ni] = val;
+
+            continue;
+          }
+
+        switch (method)
+          {
+          case INTERP1_LINEAR:
+            {
+              octave_idx_type j = locate (t);
+              T dx = t - x[j];
+              for (octave_idx_type k = 0; k < nc; k++)
+                yi[i+k*ni] = slope[k*(n-1)+j] * dx + y[k*n+j];
+            }
+            break;
+
+          case INTERP1_NEAREST:
+            {
+              octave_idx_type j = locate (t);
+              if (t >= (x[j] + x[j+1]) / 2)
+                j++;
+              for (octave_idx_type k = 0; k < nc; k++)
+                yi[i+k*ni] = y[k*n+j];
+            }
+            break;
+
+          case INTERP1_PREVIOUS:
+            {
+              octave_idx_type j = locate (t);
+              if (t >= x[j+1])
+                j++;
+              for (octave_idx_type k = 0; k < nc; k++)
+                yi[i+k*ni] = y[k*n+j];
+            }
+            break;
+
+          case INTERP1_NEXT:
+            {
+              octave_idx_type j = locate (t);
+              if (t > x[j])
+                j++;
+              for (octave_idx_type k = 0; k < nc; k++)
+                yi[i+k*ni] = y[k*n+j];
+            }
+            break;
+
+          case INTERP1_CUBIC:
+            {
+              octave_idx_type j = locate_piece (t);
+              T dx = t - xk[j];
+              for (octave_idx_type k = 0; k < nc; k++)
+                {
+                  const T *c = coef + 4 * (k * np + j);
+                  T val = c[0];
+                  val *= dx;
+                  val += c[1];
+                  val *= dx;
+                  val += c[2];
+                  val *= dx;
+                  val += c[3];
+                  yi[i+k*ni] = val;
+                }
+            }
+            break;
+          }
+      }
+  });
+}
+
+template <typename NDA>
+static octave_value
+do_interp1 (const octave_value_list& args, const std::string& method)
+{
+  typedef typename NDA::element_type T;
+
+  const NDA x = octave_value_extract<NDA> (args(0));
+  const NDA y = octave_value_extract<NDA> (args(1));
+  const NDA xi = octave_value_extract<NDA> (args(2));
+
+  octave_idx_type n = x.numel ();
+
+  if (n < 2)
+    error ("__interp1__: X must have at least 2 points");
+
+  if (y.rows () != n)
+    error ("__interp1__: X and Y dimension mismatch");
+
+  const T *xd = x.data ();
+
+  for (octave_idx_type j = 0; j < n - 1; j++)
+    {
+      if (! (xd[j] < xd[j+1]))
+        error ("__interp1__: X must be strictly increasing");
+    }
+
+  octave_idx_type nc = y.numel () / n;
+  octave_idx_type ni = xi.numel ();
+
+  bool extrap = args(4).is_string ();
+  T extrapval = 0;
+
+  if (extrap)
+    {
+      if (args(4).string_value () != "extrap")
+        error (R"(__interp1__: EXTRAP must be a scalar or "extrap")");
+    }
+  else
+    extrapval = octave_value_extract<T> (args(4));
+
+  interp1_method im;
+  std::vector<T> coef;
+  octave_idx_type nk = n;
+
+  if (method == "linear")
+    im = INTERP1_LINEAR;
+  else if (method == "nearest")
+    im = INTERP1_NEAREST;
+  else if (method == "previous")
+    im = INTERP1_PREVIOUS;
+  else if (method == "next")
+    im = INTERP1_NEXT;
+  else if (method == "pchip" || method == "cubic")
+    {
+      im = INTERP1_CUBIC;
+      coef.resize (4 * (n-1) * nc);
+      pchip_coefs (xd, n, y.data (), nc, coef.data ());
+    }
+  else if (method == "spline")
+    {
+      im = INTERP1_CUBIC;
+      coef.resize (4 * (n-1) * nc);
+      spline_coefs (xd, n, y.data (), nc, coef.data (), nk);
+    }
+  else
+    error ("__interp1__: invalid METHOD '%s'", method.c_str ());
+
+  // The knots of the pieces of a spline through three points are the
+  // end points.
+
+  std::vector<T> xk;
+
+  if (nk != n)
+    xk = { xd[0], xd[n-1] };
+
+  NDA yi (dim_vector (ni, nc));
+
+  if (nk == n)
+    interp1_eval (im, xd, n, y.data (), nc, coef.data (), nk, xi.data (),
+                  ni, extrap, extrapval, yi.rwdata ());
+  else
+    {
+      // Only the range of X matters for the cubic pieces.
+      interp1_eval (im, xk.data (), nk, y.data (), nc, coef.data (), nk,
+                    xi.data (), ni, extrap, extrapval, yi.rwdata ());
+    }
+
+  return yi;
+}
+
+DEFUN (__interp1__, args, ,
+       doc: /* -*- texinfo -*-
+@deftypefn {} {@var{yi} =} __interp1__ (@var{x}, @var{y}, @var{xi}, @var{method}, @var{extrap})
+Undocumented internal function.
+@end deftypefn */)
+{
+  // Interpolate the columns of the real matrix Y, given at the strictly
+  // increasing points X, at the points XI.  The result has one row per
+  // element of XI.  METHOD is "linear", "nearest", "previous", "next",
+  // "pchip", "cubic", or "spline".  EXTRAP is the value for points
+  // outside of the range of X, or "extrap" to extend the end pieces.
+  // The arguments are converted to single precision if any of X, Y, or
+  // XI is single.
+
+  if (args.length () != 5)
+    print_usage ();
+
+  std::string method
+    = args(3).xstring_value ("__interp1__: METHOD must be a string");
+
+  for (int i = 0; i < 3; i++)
+    {
+      if (! args(i).isreal () || ! args(i).isfloat ())
+        error ("__interp1__: X, Y, and XI must be real floating point arrays");
+    }
+
+  if (args(0).is_single_type () || args(1).is_single_type ()
+      || args(2).is_single_type ())
+    return ovl (do_interp1<FloatNDArray> (args, method));
+  else
+    return ovl (do_interp1<NDArray> (args, method));
+}
+
+/*
+%!shared x, y, xi
+%! x = [0, 1, 3, 4, 7];
+%! y = [1, -2, 5, 0, 2]';
+%! xi = [-1, 0, 0.5, 1, 2, 3.5, 4, 6.9, 7, 8, NaN];
+
+%!assert (__interp1__ (x, y, xi, "linear", NA)',
+%!        [NA, 1, -0.5, -2, 1.5, 2.5, 0, 1.9333333333333333, 2, NA, NA],
+%!        8*eps)
+%!assert (__interp1__ (x, y, xi, "nearest", 0)',
+%!        [0, 1, -2, -2, 5, 0, 0, 2, 2, 0, 0])
+%!assert (__interp1__ (x, y, xi, "previous", 0)',
+%!        [0, 1, 1, -2, -2, 5, 0, 0, 2, 0, 0])
+%!assert (__interp1__ (x, y, xi, "next", 0)',
+%!        [0, 1, -2, -2, 5, 0, 0, 2, 2, 0, 0])
+%!assert (__interp1__ (x, y, xi, "previous", "extrap")',
+%!        [1, 1, 1, -2, -2, 5, 0, 0, 2, 2, NaN])
+%!assert (__interp1__ (x, y, xi, "linear", "extrap")(1), 4)
+
+## Sorted and unsorted queries give the same results.
+%!function r = sort_by (v, k)
+%!  [~, i] = sort (k);
+%!  r = v(i);
+%!endfunction
+%!test
+%! xq = rand (1, 1000) * 8 - 0.5;
+%! for method = {"linear", "nearest", "previous", "next", "pchip", "spline"}
+%!   assert (__interp1__ (x, y, sort (xq), method{1}, "extrap"),
+%!           sort_by (__interp1__ (x, y, xq, method{1}, "extrap"), xq));
+%! endfor
+
+%!assert (__interp1__ (x, [y, 2*y], xi, "spline", "extrap"),
+%!        [spline(x, y, xi)', 2*spline(x, y, xi)'], 100*eps)
+%!assert (__interp1__ (x, y, xi(1:end-1), "pchip", "extrap"),
+%!        pchip (x, y, xi(1:end-1))', 100*eps)
+%!assert (__interp1__ (x(1:3), y(1:3), xi, "spline", "extrap"),
+%!        spline (x(1:3), y(1:3), xi)', 100*eps)
+%!assert (__interp1__ (x(1:4), y(1:4), xi, "spline", "extrap"),
+%!        spline (x(1:4), y(1:4), xi)', 100*eps)
+%!assert (class (__interp1__ (single (x), y, xi, "linear", NA)), "single")
+
+%!error <X must be strictly increasing> __interp1__ ([1, 1], [1; 2], 1, "linear", NA)
+%!error <invalid METHOD> __interp1__ (x, y, xi, "foo", NA)
+%!error <X and Y dimension mismatch> __interp1__ (x, y(1:3), xi, "linear", NA)
+*/
+
+OCTAVE_END_NAMESPACE(octave)
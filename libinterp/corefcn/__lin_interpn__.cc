@@ -27,16 +27,20 @@
 #  include "config.h"
 #endif
 
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
 #include "lo-ieee.h"
 #include "dNDArray.h"
 #include "oct-locbuf.h"
+#include "sparse-util.h"
 
 #include "defun.h"
 #include "error.h"
+#include "interp-grid.h"
 #include "ovl.h"
 
-#include <type_traits>
-
 OCTAVE_BEGIN_NAMESPACE(octave)
 
 // equivalent to isvector.m
@@ -49,85 +53,10 @@ isvector (const T& array)
   return dv.ndims () == 2 && (dv(0) == 1 || dv(1) == 1);
 }
 
-// lookup a value in a sorted table (lookup.m)
-template <typename T>
-octave_idx_type
-lookup (const T *x, octave_idx_type n, T y)
-{
-  octave_idx_type j;
-
-  if (x[0] < x[n-1])
-    {
-      // increasing x
-
-      if (y > x[n-1] || y < x[0])
-        return -1;
-
-#if defined (EXHAUSTIF)
-      for (j = 0; j < n - 1; j++)
-        {
-          if (x[j] <= y && y <= x[j+1])
-            return j;
-        }
-#else
-      octave_idx_type j0 = 0;
-      octave_idx_type j1 = n - 1;
-
-      while (true)
-        {
-          j = (j0+j1)/2;
-
-          if (y <= x[j+1])
-            {
-              if (x[j] <= y)
-                return j;
-
-              j1 = j;
-            }
-
-          if (x[j] <= y)
-            j0 = j;
-        }
-#endif
-    }
-  else
-    {
-      // decreasing x
-      // previous code with x -> -x and y -> -y
-
-      if (y > x[0] || y < x[n-1])
-        return -1;
-
-#if defined (EXHAUSTIF)
-      for (j = 0; j < n - 1; j++)
-        {
-          if (x[j+1] <= y && y <= x[j])
-            return j;
-        }
-#else
-      octave_idx_type j0 = 0;
-      octave_idx_type j1 = n - 1;
-
-      while (true)
-        {
-          j = (j0+j1)/2;
-
-          if (y >= x[j+1])
-            {
-              if (x[j] >= y)
-                return j;
-
-              j1 = j;
-            }
-
-          if (x[j] >= y)
-            j0 = j;
-        }
-#endif
-    }
-}
-
-// n-dimensional linear interpolation
+// n-dimensional linear interpolation.  The points are located with one
+// grid_locator per dimension, so that sorted or clustered query points
+// walk the grid instead of searching it from scratch.  Points that are
+// NaN or outside of the grid are set to EXTRAPVAL.
 
 template <typename T, typename DT>
 void
@@ -135,56 +64,116 @@ lin_interpn (int n, const octave_idx_type *size, const octave_idx_type *scale,
              octave_idx_type Ni, DT extrapval, const T **x,
              const DT *v, const T **y, DT *vi)
 {
-  bool out = false;
-  int bit;
+  // Decreasing grids are searched in reversed copies.
+  std::vector<std::vector<T>> xrev (n);
+  std::vector<const T *> xinc (n);
 
-  OCTAVE_LOCAL_BUFFER (T, coef, 2*n);
-  OCTAVE_LOCAL_BUFFER (octave_idx_type, index, n);
+  // The corners of the hypercube along singleton dimensions do not
+  // exist.
+  int singleton = 0;
 
-  // loop over all points
-  for (octave_idx_type m = 0; m < Ni; m++)
+  for (int i = 0; i < n; i++)
     {
-      // loop over all dimensions
-      for (int i = 0; i < n; i++)
-        {
-          index[i] = lookup (x[i], size[i], y[i][m]);
-          out = index[i] == -1;
-
-          if (out)
-            break;
-          else
-            {
-              octave_idx_type j = index[i];
-              coef[2*i+1] = (y[i][m] - x[i][j])/(x[i][j+1] - x[i][j]);
-              coef[2*i] = 1 - coef[2*i+1];
-            }
-        }
+      octave_idx_type ni = size[i];
 
-      if (out)
-        vi[m] = extrapval;
-      else
+      if (ni > 1 && x[i][0] > x[i][ni-1])
         {
-          vi[m] = 0;
-
-          // loop over all corners of hypercube (1<<n = 2^n)
-          for (int i = 0; i < (1 << n); i++)
-            {
-              T c = 1;
-              octave_idx_type l = 0;
-
-              // loop over all dimensions
-              for (int j = 0; j < n; j++)
-                {
-                  // test if the jth bit in i is set
-                  bit = i >> j & 1;
-                  l += scale[j] * (index[j] + bit);
-                  c *= coef[2*j+bit];
-                }
-
-              vi[m] += c * v[l];
-            }
+          xrev[i].assign (x[i], x[i] + ni);
+          std::reverse (xrev[i].begin (), xrev[i].end ());
+          xinc[i] = xrev[i].data ();
         }
+      else
+        xinc[i] = x[i];
+
+      if (ni < 2)
+        singleton |= 1 << i;
     }
+
+  int nt = sparse_kernel_threads (static_cast<double> (Ni)
+                                  * ((1 << n) + 4 * n));
+
+  sparse_range_blocks (Ni, nt, [=, &xrev, &xinc] (octave_idx_type mb,
+                                                 octave_idx_type me)
+  {
+    std::vector<grid_locator<T>> locate;
+    locate.reserve (n);
+    for (int i = 0; i < n; i++)
+      locate.emplace_back (xinc[i], size[i]);
+
+    OCTAVE_LOCAL_BUFFER (T, coef, 2*n);
+    OCTAVE_LOCAL_BUFFER (octave_idx_type, index, n);
+
+    // loop over all points
+    for (octave_idx_type m = mb; m < me; m++)
+      {
+        bool out = false;
+
+        // loop over all dimensions
+        for (int i = 0; i < n; i++)
+          {
+            T yy = y[i][m];
+            const T *xi = x[i];
+            octave_idx_type ni = size[i];
+
+            if (ni < 2)
+              {
+                out = ! (yy == xi[0]);
+                index[i] = 0;
+                coef[2*i] = 1;
+                coef[2*i+1] = 0;
+              }
+            else
+              {
+                out = ! (yy >= xinc[i][0] && yy <= xinc[i][ni-1]);
+
+                if (! out)
+                  {
+                    octave_idx_type j = locate[i] (yy);
+
+                    if (! xrev[i].empty ())
+                      j = ni - 2 - j;
+
+                    index[i] = j;
+                    coef[2*i+1] = (yy - xi[j])/(xi[j+1] - xi[j]);
+                    coef[2*i] = 1 - coef[2*i+1];
+                  }
+              }
+
+            if (out)
+              break;
+          }
+
+        if (out)
+          vi[m] = extrapval;
+        else
+          {
+            DT val = 0;
+
+            // loop over all corners of hypercube (1<<n = 2^n)
+            for (int i = 0; i < (1 << n); i++)
+              {
+                if (i & singleton)
+                  continue;
+
+                T c = 1;
+                octave_idx_type l = 0;
+
+                // loop over all dimensions
+                for (int j = 0; j < n; j++)
+                  {
+                    // test if the jth bit in i is set
+                    int bit = i >> j & 1;
+                    l += scale[j] * (index[j] + bit);
+                    c *= coef[2*j+bit];
+                  }
+
+                val += c * v[l];
+              }
+
+            vi[m] = val;
+          }
+      }
+  });
 }
 
 template <typename MT, typename DMT, typename DT>
@@ -283,7 +272,11 @@ Undocumented internal function.
   // dimension of the problem
   int n = (nargin-1)/2;
 
-  if (args(n).is_single_type ())
+  bool is_single = false;
+  for (int i = 0; i < nargin; i++)
+    is_single = is_single || args(i).is_single_type ();
+
+  if (is_single)
     {
       OCTAVE_LOCAL_BUFFER (FloatNDArray, X, n);
       OCTAVE_LOCAL_BUFFER (FloatNDArray, Y, n);
@@ -354,6 +347,28 @@ Undocumented internal function.
 %! vi_imag = __lin_interpn__ (x1, x2, imag (v), XI1, XI2);
 %! assert (real (vi_complex), vi_real);
 %! assert (imag (vi_complex), vi_imag);
+
+%!test
+%! x1 = [0, 1, 3];
+%! x2 = [4, 2, 1, 0];
+%! v = x1' + 10 * x2;
+%! y1 = [-1, 0, 0.5, 2, 3, NaN, 1];
+%! y2 = [1, 0, 1.5, 3, 4, 1, NaN];
+%! assert (__lin_interpn__ (x1, x2, v, y1, y2),
+%!         [NA, 0, 15.5, 32, 43, NA, NA], 100*eps);
+
+## Sorted and unsorted points give the same result
+%!test
+%! x1 = cumsum (rand (1, 20));
+%! x2 = cumsum (rand (1, 30));
+%! v = rand (20, 30);
+%! y1 = x1(1) + (x1(end) - x1(1)) * rand (1000, 1);
+%! y2 = x2(1) + (x2(end) - x2(1)) * rand (1000, 1);
+%! [~, i] = sort (y1);
+%! vi = __lin_interpn__ (x1, x2, v, y1, y2);
+%! assert (__lin_interpn__ (x1, x2, v, y1(i), y2(i)), vi(i));
+
+%!assert (class (__lin_interpn__ (1:2, single ([1, 2]), 1.5)), "single")
 */
 
 OCTAVE_END_NAMESPACE(octave)
@@ -0,0 +1,767 @@
+////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2024 The Octave Project Developers
+//
+// See the file COPYRIGHT.md in the top-level directory of this
+// distribution or <https://octave.org/copyright/>.
+//
+// This file is part of Octave.
+//
+// Octave is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Octave is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Octave; see the file COPYING.  If not, see
+// <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////
+
+#if defined (HAVE_CONFIG_H)
+#  include "config.h"
+#endif
+
+#include <cinttypes>
+#include <cstring>
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "boolNDArray.h"
+#include "dNDArray.h"
+#include "lo-mappers.h"
+#include "oct-inttypes.h"
+#include "quit.h"
+
+#include "defun.h"
+#include "error.h"
+#include "ov-packed-cellstr.h"
+#include "ovl.h"
+
+OCTAVE_BEGIN_NAMESPACE(octave)
+
+// Unsigned keys that are ordered like the values and are equal if the
+// values compare equal.  In particular, -0 and 0 have the same key.
+// NaN values never compare equal and are handled separately.
+
+static inline uint64_t
+set_key (double x)
+{
+  uint64_t u;
+
+  if (x == 0)
+    x = 0;
+
+  std::memcpy (&u, &x, sizeof (u));
+
+  return (u >> 63) ? ~u : (u | (static_cast<uint64_t> (1) << 63));
+}
+
+static inline uint32_t
+set_key (float x)
+{
+  uint32_t u;
+
+  if (x == 0)
+    x = 0;
+
+  std::memcpy (&u, &x, sizeof (u));
+
+  return (u >> 31) ? ~u : (u | (static_cast<uint32_t> (1) << 31));
+}
+
+template <typename T>
+static inline typename std::make_unsigned<T>::type
+set_key (const octave_int<T>& x)
+{
+  typedef typename std::make_unsigned<T>::type U;
+
+  U u = static_cast<U> (x.value ());
+
+  if (std::is_signed<T>::value)
+    u ^= static_cast<U> (1) << (sizeof (T) * 8 - 1);
+
+  return u;
+}
+
+static inline uint8_t
+set_key (bool x)
+{
+  return x;
+}
+
+static inline uint8_t
+set_key (char x)
+{
+  return static_cast<unsigned char> (x);
+}
+
+template <typename T>
+static inline bool
+set_isnan (const T&)
+{
+  return false;
+}
+
+static inline bool
+set_isnan (double x)
+{
+  return math::isnan (x);
+}
+
+static inline bool
+set_isnan (float x)
+{
+  return math::isnan (x);
+}
+
+static inline std::size_t
+set_hash (uint64_t k)
+{
+  // Fibonacci hashing.  The high bits of the product are well mixed.
+  return static_cast<std::size_t> ((k * 0x9E3779B97F4A7C15ULL) >> 32)
+         ^ static_cast<std::size_t> (k * 0x9E3779B97F4A7C15ULL);
+}
+
+static inline std::size_t
+set_hash (std::string_view s)
+{
+  return set_hash (static_cast<uint64_t> (std::hash<std::string_view> () (s)));
+}
+
+// A hash table with open addressing that maps keys to indices.  It is
+// sized once for the number of keys that will be inserted.
+
+template <typename K>
+class set_table
+{
+public:
+
+  set_table (octave_idx_type n)
+    : m_mask (15), m_slots ()
+  {
+    while (m_mask < static_cast<std::size_t> (n + n / 2))
+      m_mask = 2 * m_mask + 1;
+
+    m_slots.resize (m_mask + 1, slot (K (), -1));
+  }
+
+  OCTAVE_DISABLE_COPY_MOVE (set_table)
+
+  ~set_table () = default;
+
+  // The value of KEY.  If KEY is not in the table, insert it with the
+  // value VAL.
+  octave_idx_type insert (const K& key, octave_idx_type val)
+  {
+    slot& s = find_slot (key);
+
+    if (s.second < 0)
+      {
+        s.first = key;
+        s.second = val;
+      }
+
+    return s.second;
+  }
+
+  // Set the value of KEY to VAL.
+  void assign (const K& key, octave_idx_type val)
+  {
+    slot& s = find_slot (key);
+
+    s.first = key;
+    s.second = val;
+  }
+
+  // The value of KEY, or -1 if it is not in the table.
+  octave_idx_type find (const K& key) const
+  {
+    return const_cast<set_table *> (this)->find_slot (key).second;
+  }
+
+private:
+
+  typedef std::pair<K, octave_idx_type> slot;
+
+  slot& find_slot (const K& key)
+  {
+    std::size_t i = set_hash (key) & m_mask;
+
+    for (;;)
+      {
+        slot& s = m_slots[i];
+
+        if (s.second < 0 || s.first == key)
+          return s;
+
+        i = (i + 1) & m_mask;
+      }
+  }
+
+  std::size_t m_mask;
+
+  std::vector<slot> m_slots;
+};
+
+// Sort the keys KEY and their indices IDX by key.  The sort is an LSD
+// radix sort over the bytes of the keys and is stable.
+
+template <typename K>
+static void
+radix_sort (K *key, octave_idx_type *idx, octave_idx_type n)
+{
+  const int nbytes = sizeof (K);
+
+  if (n < 2)
+    return;
+
+  std::vector<octave_idx_type> count (nbytes * 256, 0);
+
+  for (octave_idx_type i = 0; i < n; i++)
+    {
+      K k = key[i];
+
+      for (int b = 0; b < nbytes; b++)
+        count[b * 256 + static_cast<int> ((k >> (8 * b)) & 0xff)]++;
+    }
+
+  std::vector<K> key2 (n);
+  std::vector<octave_idx_type> idx2 (n);
+
+  K *ks = key;
+  K *kd = key2.data ();
+  octave_idx_type *is = idx;
+  octave_idx_type *id = idx2.data ();
+
+  for (int b = 0; b < nbytes; b++)
+    {
+      octave_idx_type *cnt = count.data () + b * 256;
+
+      // A byte that is the same in all keys does not change the order.
+      if (cnt[static_cast<int> ((ks[0] >> (8 * b)) & 0xff)] == n)
+        continue;
+
+      octave_idx_type s = 0;
+      for (int d = 0; d < 256; d++)
+        {
+          octave_idx_type c = cnt[d];
+          cnt[d] = s;
+          s += c;
+        }
+
+      for (octave_idx_type i = 0; i < n; i++)
+        {
+          int d = static_cast<int> ((ks[i] >> (8 * b)) & 0xff);
+          octave_idx_type p = cnt[d]++;
+          kd[p] = ks[i];
+          id[p] = is[i];
+        }
+
+      std::swap (ks, kd);
+      std::swap (is, id);
+
+      octave_quit ();
+    }
+
+  if (ks != key)
+    {
+      std::copy_n (ks, n, key);
+      std::copy_n (is, n, idx);
+    }
+}
+
+// The groups of equal elements of an array.  Element REP[G] stands for
+// group G in the first output of unique and POS[G] is the index in the
+// second output (both zero-based).  GROUP(K) is the group of element K
+// in the third output.
+
+class set_groups
+{
+public:
+
+  set_groups (octave_idx_type n, bool want_group)
+    : m_rep (), m_pos (),
+      m_group (want_group ? dim_vector (n, 1) : dim_vector (0, 1))
+  { }
+
+  OCTAVE_DISABLE_COPY_MOVE (set_groups)
+
+  ~set_groups () = default;
+
+  // Record the groups of the sorted elements PERM.  Element PERM[P] is
+  // equal to PERM[P-1] if EQ (P-1, P) is true.  The last N - NN
+  // elements are NaN values and every one of them is a group of its
+  // own.
+  template <typename EQ>
+  void sorted (const octave_idx_type *perm, octave_idx_type n,
+               octave_idx_type nn, EQ eq, bool last)
+  {
+    double *pg = m_group.numel () ? m_group.rwdata () : nullptr;
+
+    octave_idx_type p = 0;
+
+    while (p < n)
+      {
+        octave_idx_type e = p + 1;
+
+        if (p < nn)
+          while (e < nn && eq (e-1, e))
+            e++;
+
+        // The representative of a sorted group is its last element.
+        // This only matters for -0 and 0.
+        m_rep.push_back (perm[e-1]);
+        m_pos.push_back (last ? perm[e-1] : perm[p]);
+
+        if (pg)
+          {
+            double g = m_rep.size ();
+
+            for (octave_idx_type q = p; q < e; q++)
+              pg[perm[q]] = g;
+          }
+
+        p = e;
+      }
+  }
+
+  // Record that element K is in the group G found by a hash table.
+  // G is new if it is equal to the number of groups so far.
+  void add (octave_idx_type k, octave_idx_type g)
+  {
+    if (g == static_cast<octave_idx_type> (m_rep.size ()))
+      {
+        m_rep.push_back (k);
+        m_pos.push_back (k);
+      }
+
+    if (m_group.numel ())
+      m_group.xelem (k) = g + 1;
+  }
+
+  octave_idx_type count () const { return m_rep.size (); }
+
+  octave_value_list result (const octave_value& x, int nargout) const
+  {
+    octave_idx_type ng = count ();
+
+    Array<octave_idx_type> rep (dim_vector (ng, 1));
+    std::copy_n (m_rep.data (), ng, rep.rwdata ());
+
+    octave_value_list retval (nargout > 1 ? nargout : 1);
+
+    octave_value tmp = x;
+    octave_value_list idx = ovl (octave_value (idx_vector (rep)));
+
+    retval(0) = tmp.index_op (idx);
+
+    if (nargout > 1)
+      {
+        NDArray pos (dim_vector (ng, 1));
+        double *pp = pos.rwdata ();
+
+        for (octave_idx_type g = 0; g < ng; g++)
+          pp[g] = m_pos[g] + 1;
+
+        retval(1) = pos;
+      }
+
+    if (nargout > 2)
+      retval(2) = m_group;
+
+    return retval;
+  }
+
+private:
+
+  std::vector<octave_idx_type> m_rep;
+
+  std::vector<octave_idx_type> m_pos;
+
+  NDArray m_group;
+};
+
+template <typename NDA>
+static void
+unique_groups (const NDA& a, bool stable, bool last, set_groups& groups)
+{
+  typedef typename NDA::element_type T;
+  typedef decltype (set_key (T ())) K;
+
+  octave_idx_type n = a.numel ();
+  const T *v = a.data ();
+
+  if (stable)
+    {
+      set_table<K> table (n);
+
+      for (octave_idx_type k = 0; k < n; k++)
+        {
+          if (set_isnan (v[k]))
+            groups.add (k, groups.count ());
+          else
+            groups.add (k, table.insert (set_key (v[k]), groups.count ()));
+        }
+    }
+  else
+    {
+      // Sort the keys of the values that are not NaN.  The NaN values
+      // follow in their original order, as in the result of sort.
+
+      std::vector<K> key (n);
+      std::vector<octave_idx_type> perm (n);
+
+      octave_idx_type nn = 0;
+      octave_idx_type nan = n;
+
+      for (octave_idx_type k = 0; k < n; k++)
+        {
+          if (set_isnan (v[k]))
+            perm[--nan] = k;
+          else
+            {
+              key[nn] = set_key (v[k]);
+              perm[nn++] = k;
+            }
+        }
+
+      std::reverse (perm.begin () + nn, perm.end ());
+
+      radix_sort (key.data (), perm.data (), nn);
+
+      const K *sk = key.data ();
+
+      groups.sorted (perm.data (), n, nn,
+                     [sk] (octave_idx_type i, octave_idx_type j)
+                     { return sk[i] == sk[j]; },
+                     last);
+    }
+}
+
+// The elements of the cell array of strings X as views.  STORE keeps
+// the strings alive unless X is a packed cell array.
+
+static std::vector<std::string_view>
+string_views (const octave_value& x, Array<std::string>& store)
+{
+  const packed_strings *ps = octave_packed_cellstr::strings_of (x);
+
+  octave_idx_type n = x.numel ();
+
+  std::vector<std::string_view> views (n);
+
+  if (ps)
+    {
+      for (octave_idx_type k = 0; k < n; k++)
+        views[k] = ps->view (k);
+    }
+  else
+    {
+      store = x.cellstr_value ();
+
+      for (octave_idx_type k = 0; k < n; k++)
+        views[k] = store(k);
+    }
+
+  return views;
+}
+
+static void
+unique_groups (const std::vector<std::string_view>& views, bool stable,
+               bool last, set_groups& groups)
+{
+  octave_idx_type n = views.size ();
+
+  if (stable)
+    {
+      set_table<std::string_view> table (n);
+
+      for (octave_idx_type k = 0; k < n; k++)
+        groups.add (k, table.insert (views[k], groups.count ()));
+    }
+  else
+    {
+      // Strings do not have fixed-size keys.  Sort them by comparison,
+      // stably like the sort of a cell array.
+
+      std::vector<octave_idx_type> perm (n);
+
+      std::iota (perm.begin (), perm.end (), static_cast<octave_idx_type> (0));
+
+      std::stable_sort (perm.begin (), perm.end (),
+                        [&views] (octave_idx_type i, octave_idx_type j)
+                        { return views[i] < views[j]; });
+
+      const octave_idx_type *pp = perm.data ();
+
+      groups.sorted (pp, n, n,
+                     [&views, pp] (octave_idx_type i, octave_idx_type j)
+                     { return views[pp[i]] == views[pp[j]]; },
+                     last);
+    }
+}
+
+DEFUN (__unique__, args, nargout,
+       doc: /* -*- texinfo -*-
+@deftypefn {} {[@var{y}, @var{i}, @var{j}] =} __unique__ (@var{x}, @var{stable}, @var{last})
+Private function.  Return the unique elements of the real array or cell array
+of strings @var{x} and the index vectors @var{i} and @var{j}.
+
+The elements of @var{y} are sorted unless @var{stable} is true.  The index
+vector @var{i} selects the last occurrence of each element of @var{y} in
+@var{x} if @var{last} is true and the first occurrence otherwise.  Sorted
+results use a radix sort and stable results a hash table.  Like the
+comparison operators, the kernel does not merge NaN values and regards
+@code{-0} and @code{0} as equal.  You should call unique(@var{x}) instead of
+directly calling this function.
+@seealso{unique}
+@end deftypefn */)
+{
+  if (args.length () != 3)
+    print_usage ();
+
+  octave_value x = args(0);
+
+  bool stable = args(1).bool_value ();
+  bool last = args(2).bool_value ();
+
+  octave_idx_type n = x.numel ();
+
+  set_groups groups (n, nargout > 2);
+
+  if (x.iscellstr ())
+    {
+      Array<std::string> store;
+
+      unique_groups (string_views (x, store), stable, last, groups);
+    }
+  else if (x.issparse () || x.iscomplex ())
+    error ("__unique__: X must be a full real array or a cell array of strings");
+  else
+    {
+      switch (x.builtin_type ())
+        {
+#define MAKE_UNIQUE_CASE(BTYP, METHOD)                          \
+        case BTYP:                                              \
+          unique_groups (x.METHOD (), stable, last, groups);    \
+          break
+
+          MAKE_UNIQUE_CASE (btyp_double, array_value);
+          MAKE_UNIQUE_CASE (btyp_float, float_array_value);
+          MAKE_UNIQUE_CASE (btyp_int8, int8_array_value);
+          MAKE_UNIQUE_CASE (btyp_int16, int16_array_value);
+          MAKE_UNIQUE_CASE (btyp_int32, int32_array_value);
+          MAKE_UNIQUE_CASE (btyp_int64, int64_array_value);
+          MAKE_UNIQUE_CASE (btyp_uint8, uint8_array_value);
+          MAKE_UNIQUE_CASE (btyp_uint16, uint16_array_value);
+          MAKE_UNIQUE_CASE (btyp_uint32, uint32_array_value);
+          MAKE_UNIQUE_CASE (btyp_uint64, uint64_array_value);
+          MAKE_UNIQUE_CASE (btyp_bool, bool_array_value);
+          MAKE_UNIQUE_CASE (btyp_char, char_array_value);
+
+#undef MAKE_UNIQUE_CASE
+
+        default:
+          error ("__unique__: X must be a full real array or a cell array of strings");
+        }
+    }
+
+  return groups.result (x, nargout);
+}
+
+template <typename NDA>
+static void
+ismember_kernel (const NDA& a, const NDA& s, boolNDArray& tf, NDArray *idx)
+{
+  typedef typename NDA::element_type T;
+  typedef decltype (set_key (T ())) K;
+
+  octave_idx_type na = a.numel ();
+  octave_idx_type ns = s.numel ();
+  const T *va = a.data ();
+  const T *vs = s.data ();
+
+  // Like lookup on the sorted set, find the last occurrence of each
+  // value in S.
+  set_table<K> table (ns);
+
+  for (octave_idx_type k = 0; k < ns; k++)
+    if (! set_isnan (vs[k]))
+      table.assign (set_key (vs[k]), k);
+
+  octave_quit ();
+
+  bool *ptf = tf.rwdata ();
+  double *pidx = idx ? idx->rwdata () : nullptr;
+
+  for (octave_idx_type k = 0; k < na; k++)
+    {
+      octave_idx_type p = (set_isnan (va[k]) ? -1
+                           : table.find (set_key (va[k])));
+
+      ptf[k] = (p >= 0);
+      if (pidx)
+        pidx[k] = p + 1;
+    }
+}
+
+static void
+ismember_kernel (const std::vector<std::string_view>& a,
+                 const std::vector<std::string_view>& s,
+                 boolNDArray& tf, NDArray *idx)
+{
+  octave_idx_type na = a.size ();
+  octave_idx_type ns = s.size ();
+
+  set_table<std::string_view> table (ns);
+
+  for (octave_idx_type k = 0; k < ns; k++)
+    table.assign (s[k], k);
+
+  octave_quit ();
+
+  bool *ptf = tf.rwdata ();
+  double *pidx = idx ? idx->rwdata () : nullptr;
+
+  for (octave_idx_type k = 0; k < na; k++)
+    {
+      octave_idx_type p = table.find (a[k]);
+
+      ptf[k] = (p >= 0);
+      if (pidx)
+        pidx[k] = p + 1;
+    }
+}
+
+DEFUN (__ismember__, args, nargout,
+       doc: /* -*- texinfo -*-
+@deftypefn {} {[@var{tf}, @var{s_idx}] =} __ismember__ (@var{a}, @var{s})
+Private function.  Return a logical array that is true for the elements of
+@var{a} that are found in @var{s} and the index of the last occurrence of each
+of them in @var{s}.
+
+The arrays @var{a} and @var{s} must both be cell arrays of strings, or real
+arrays of the same class.  The elements of @var{s} are stored in a hash table.
+You should call ismember(@var{a}, @var{s}) instead of directly calling this
+function.
+@seealso{ismember}
+@end deftypefn */)
+{
+  if (args.length () != 2)
+    print_usage ();
+
+  octave_value a = args(0);
+  octave_value s = args(1);
+
+  boolNDArray tf (a.dims ());
+  NDArray idx (nargout > 1 ? a.dims () : dim_vector (0, 0));
+  NDArray *pidx = (nargout > 1 ? &idx : nullptr);
+
+  if (a.iscellstr () && s.iscellstr ())
+    {
+      Array<std::string> astore;
+      Array<std::string> sstore;
+
+      ismember_kernel (string_views (a, astore), string_views (s, sstore),
+                       tf, pidx);
+    }
+  else if (a.issparse () || a.iscomplex () || s.issparse () || s.iscomplex ()
+           || a.builtin_type () != s.builtin_type ())
+    error ("__ismember__: A and S must be full real arrays of the same class or cell arrays of strings");
+  else
+    {
+      switch (a.builtin_type ())
+        {
+#define MAKE_ISMEMBER_CASE(BTYP, METHOD)                        \
+        case BTYP:                                              \
+          ismember_kernel (a.METHOD (), s.METHOD (), tf, pidx); \
+          break
+
+          MAKE_ISMEMBER_CASE (btyp_double, array_value);
+          MAKE_ISMEMBER_CASE (btyp_float, float_array_value);
+          MAKE_ISMEMBER_CASE (btyp_int8, int8_array_value);
+          MAKE_ISMEMBER_CASE (btyp_int16, int16_array_value);
+          MAKE_ISMEMBER_CASE (btyp_int32, int32_array_value);
+          MAKE_ISMEMBER_CASE (btyp_int64, int64_array_value);
+          MAKE_ISMEMBER_CASE (btyp_uint8, uint8_array_value);
+          MAKE_ISMEMBER_CASE (btyp_uint16, uint16_array_value);
+          MAKE_ISMEMBER_CASE (btyp_uint32, uint32_array_value);
+          MAKE_ISMEMBER_CASE (btyp_uint64, uint64_array_value);
+          MAKE_ISMEMBER_CASE (btyp_bool, bool_array_value);
+          MAKE_ISMEMBER_CASE (btyp_char, char_array_value);
+
+#undef MAKE_ISMEMBER_CASE
+
+        default:
+          error ("__ismember__: A and S must be full real arrays of the same class or cell arrays of strings");
+        }
+    }
+
+  if (nargout > 1)
+    return ovl (tf, idx);
+  else
+    return ovl (tf);
+}
+
+/*
+%!test
+%! [y, i, j] = __unique__ ([3, 1, NaN, 1, -0, 0, NaN, 3], false, false);
+%! assert (y, [0, 1, 3, NaN, NaN]);
+%! assert (i, [5; 2; 1; 3; 7]);
+%! assert (j, [3; 2; 4; 2; 1; 1; 5; 3]);
+%! assert (1 ./ y(1), Inf);
+
+%!test
+%! [y, i, j] = __unique__ ([3, 1, NaN, 1, -0, 0, NaN, 3], true, false);
+%! assert (y, [3, 1, NaN, 0, NaN]);
+%! assert (1 ./ y(4), -Inf);
+%! assert (i, [1; 2; 3; 5; 7]);
+%! assert (j, [1; 2; 3; 2; 4; 4; 5; 1]);
+
+%!test
+%! [y, i] = __unique__ (int8 ([5, -3; 5, 127]), false, true);
+%! assert (y, int8 ([-3; 5; 127]));
+%! assert (i, [3; 2; 4]);
+
+%!test
+%! [y, i, j] = __unique__ ({"b", "a", "b", ""}, false, false);
+%! assert (y, {"", "a", "b"});
+%! assert (i, [4; 2; 1]);
+%! assert (j, [3; 2; 3; 1]);
+%! [y, i, j] = __unique__ (cellstr (["b"; "a"; "b"]), true, false);
+%! assert (y, {"b"; "a"});
+%! assert (i, [1; 2]);
+%! assert (j, [1; 2; 1]);
+
+%!assert (__unique__ ("hello", false, false), "ehlo")
+%!assert (__unique__ (single ([2, -Inf, 2]), false, false), single ([-Inf, 2]))
+%!assert (__unique__ ([true; false; true], true, false), [true; false])
+%!assert (__unique__ (uint64 ([2^64-1, 0, 2^64-1]), false, false),
+%!        uint64 ([0, 2^64-1]))
+
+%!test
+%! [tf, s_idx] = __ismember__ ([1, NaN, -0, 7], [0, 1, NaN, 1]);
+%! assert (tf, [true, false, true, false]);
+%! assert (s_idx, [4, 0, 1, 0]);
+%! [tf, s_idx] = __ismember__ ({"a"; "x"}, {"a", "b", "a"});
+%! assert (tf, [true; false]);
+%! assert (s_idx, [3; 0]);
+
+%!error <full real array> __unique__ ([1+i, 2], false, false)
+%!error <same class> __ismember__ (1, single (1))
+*/
+
+OCTAVE_END_NAMESPACE(octave)
@@ -56,6 +56,7 @@
 #include "ov-int32.h"
 #include "ov-int64.h"
 #include "ov-int8.h"
+#include "ov-packed-cellstr.h"
 #include "ov-scalar.h"
 #include "ov-uint16.h"
 #include "ov-uint32.h"
@@ -130,6 +131,34 @@ try_cellfun_internal_ops (const octave_value_list& args, int nargin)
 
   std::string name = args(0).string_value ();
 
+  // The elements of a packed cell array of strings are 0x0 or 1xN
+  // character arrays, so their lengths are known without converting
+  // the array to a Cell.
+
+  if (const packed_strings *ps = octave_packed_cellstr::strings_of (args(1)))
+    {
+      octave_idx_type k = ps->numel ();
+
+      if (name == "isempty")
+        {
+          BNDA result (ps->dims ());
+          for (octave_idx_type count = 0; count < k; count++)
+            result(count) = (ps->length (count) == 0);
+          retval(0) = result;
+
+          return retval;
+        }
+      else if (name == "length" || name == "numel" || name == "prodofsize")
+        {
+          NDA result (ps->dims ());
+          for (octave_idx_type count = 0; count < k; count++)
+            result(count) = static_cast<double> (ps->length (count));
+          retval(0) = result;
+
+          return retval;
+        }
+    }
+
   const Cell f_args = args(1).cell_value ();
 
   octave_idx_type k = f_args.numel ();
@@ -1006,6 +1035,12 @@ nevermind:
 %!assert (cellfun ("isnumeric", {false,pi,struct()}), [false,true,false])
 %!assert (cellfun ("isreal", {1i,1}), [false,true])
 %!assert (cellfun ("length", {zeros(2,2),1}), [2,1])
+%!test
+%! c = cellstr (["abc"; "   "; "de "]);
+%! assert (cellfun ("isempty", c), [false; true; false]);
+%! assert (cellfun (@isempty, c), [false; true; false]);
+%! assert (cellfun ("length", c), [3; 0; 2]);
+%! assert (cellfun (@numel, c), [3; 0; 2]);
 %!assert (cellfun ("prodofsize", {zeros(2,2),1}), [4,1])
 %!assert (cellfun ("ndims", {zeros([2,2,2]),1}), [3,2])
 %!assert (cellfun ("isclass", {zeros([2,2,2]),"test"}, "double"), [true,false])
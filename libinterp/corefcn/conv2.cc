@@ -65,6 +65,13 @@ The size of the result is @code{max (size (A) - size (B) + 1, 0)}.
 When the third argument is a matrix, return the convolution of the matrix
 @var{m} by the vector @var{v1} in the column direction and by the vector
 @var{v2} in the row direction.
+
+Programming Note: For large kernels the convolution is computed with FFTs,
+either at once or block by block (overlap-add), whichever is estimated to be
+fastest.  The result then differs from direct summation by round-off errors
+relative to the largest values of the result.  If all elements of @var{A}
+and @var{B} are integers, direct summation is always used so that the
+result is exact.
 @seealso{conv, convn}
 @end deftypefn */)
 {
@@ -300,6 +307,34 @@ When the third argument is a matrix, return the convolution of the matrix
 %! B = conv2 (x, y, "valid");
 %! assert (B, A);   # Yes, this test is for *exact* equivalence.
 
+## Large kernels use FFTs.  Integer valued inputs use direct summation.
+%!test
+%! old_state = rand ("state");
+%! restore_state = onCleanup (@() rand ("state", old_state));
+%! rand ("state", 42);
+%! a = floor (10 * rand (3000, 1));
+%! b = floor (10 * rand (500, 1));
+%! for shape = {"full", "same", "valid"}
+%!   c = conv2 (a, b, shape{1});
+%!   tol = 1e-10 * max (abs (c(:)));
+%!   assert (conv2 (a / 8, b, shape{1}), c / 8, tol);
+%!   assert (conv2 (single (a / 8), single (b), shape{1}), single (c / 8),
+%!           single (1e3 * tol));
+%!   assert (conv2 ((1+2i) * a / 8, b, shape{1}), (1+2i) * c / 8, 3 * tol);
+%! endfor
+
+%!test
+%! old_state = rand ("state");
+%! restore_state = onCleanup (@() rand ("state", old_state));
+%! rand ("state", 42);
+%! a = floor (10 * rand (300, 200));
+%! b = floor (10 * rand (40, 30));
+%! for shape = {"full", "same", "valid"}
+%!   c = conv2 (a, b, shape{1});
+%!   assert (conv2 (a / 8, b / 4, shape{1}), c / 32,
+%!           1e-10 * max (abs (c(:))));
+%! endfor
+
 ## Test input validation
 %!error conv2 ()
 %!error conv2 (1)
@@ -409,6 +444,29 @@ The size of the result is @code{max (size (A) - size (B) + 1, 0)}.
 }
 
 /*
+%!test
+%! old_state = rand ("state");
+%! restore_state = onCleanup (@() rand ("state", old_state));
+%! rand ("state", 42);
+%! a = floor (10 * rand (40, 30, 20));
+%! b = floor (10 * rand (9, 8, 7));
+%! for shape = {"full", "same", "valid"}
+%!   c = convn (a, b, shape{1});
+%!   assert (convn (a / 8, b, shape{1}), c / 8, 1e-10 * max (abs (c(:))));
+%! endfor
+
+## NaN and Inf only affect the elements that they contribute to
+%!test
+%! a = 0.5 * ones (3000, 1);
+%! a(100) = NaN;
+%! a(2000) = Inf;
+%! b = ones (500, 1) / 8;
+%! c = conv2 (a, b);
+%! assert (find (isnan (c)), (100:599)');
+%! assert (find (isinf (c)), (2000:2499)');
+%! assert (c(1), 1/16);
+%! assert (c(1000), 500/16);
+
 %!test <39314>
 %! v = reshape ([1 2], [1 1 2]);
 %! assert (convn (v, v), reshape ([1 4 4], [1 1 3]));
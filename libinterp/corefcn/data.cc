@@ -36,6 +36,7 @@
 #include <limits>
 #include <string>
 
+#include "group-partition.h"
 #include "lo-ieee.h"
 #include "mx-base.h"
 #include "oct-base64.h"
@@ -8032,6 +8033,547 @@ Undocumented internal function.
   return retval;
 }
 
+// The reductions of the group-by engine used by accumarray and accumdim.
+
+enum accum_op
+{
+  ACCUM_SUM, ACCUM_PROD, ACCUM_MEAN, ACCUM_VAR, ACCUM_STD, ACCUM_COUNT,
+  ACCUM_MIN, ACCUM_MAX, ACCUM_FIRST, ACCUM_LAST, ACCUM_ANY, ACCUM_ALL,
+  ACCUM_CELL
+};
+
+static accum_op
+accum_op_value (const std::string& name, const char *who)
+{
+  static const std::pair<const char *, accum_op> ops[] =
+  {
+    { "sum", ACCUM_SUM }, { "prod", ACCUM_PROD }, { "mean", ACCUM_MEAN },
+    { "var", ACCUM_VAR }, { "std", ACCUM_STD }, { "count", ACCUM_COUNT },
+    { "min", ACCUM_MIN }, { "max", ACCUM_MAX }, { "first", ACCUM_FIRST },
+    { "last", ACCUM_LAST }, { "any", ACCUM_ANY }, { "all", ACCUM_ALL },
+    { "cell", ACCUM_CELL }
+  };
+
+  for (const auto& op : ops)
+    if (name == op.first)
+      return op.second;
+
+  error ("%s: unknown reduction '%s'", who, name.c_str ());
+}
+
+template <typename T>
+static inline double
+accum_double (const T& x)
+{
+  return static_cast<double> (x);
+}
+
+template <typename T>
+static inline double
+accum_double (const octave_int<T>& x)
+{
+  return x.double_value ();
+}
+
+// Logical values are converted to double before they are summed or
+// multiplied.  These overloads only keep the templates valid for them.
+
+template <typename T>
+static inline void
+accum_plus (T& acc, const T& x)
+{
+  acc += x;
+}
+
+static inline void
+accum_plus (bool& acc, bool x)
+{
+  acc = acc || x;
+}
+
+template <typename T>
+static inline void
+accum_times (T& acc, const T& x)
+{
+  acc *= x;
+}
+
+static inline void
+accum_times (bool& acc, bool x)
+{
+  acc = acc && x;
+}
+
+// Reduce the values of each group of GP.  VALS is an L x M x R array
+// whose second dimension is grouped, and element (A, G, B) of the
+// result of size RDV is FCN (V, L, ORD, LEN, K), where V[ORD[J]*L] for
+// J = 0 to LEN-1 are the values of group G in their order and K is the
+// linear index of the element.  Elements of empty groups are zero.
+
+template <typename RT, typename T, typename F>
+static Array<RT>
+accum_reduce (const octave::group_partition& gp, const Array<T>& vals,
+              const dim_vector& rdv, octave_idx_type l, octave_idx_type r,
+              F fcn)
+{
+  octave_idx_type ng = gp.groups ();
+  octave_idx_type m = gp.numel ();
+
+  Array<RT> retval (rdv, RT ());
+
+  RT *pr = retval.rwdata ();
+  const T *pv = vals.data ();
+
+  gp.parallel_groups (static_cast<double> (l) * r,
+                      [=, &gp] (octave_idx_type gb, octave_idx_type ge)
+  {
+    for (octave_idx_type g = gb; g < ge; g++)
+      {
+        octave_idx_type len = gp.group_size (g);
+
+        if (len == 0)
+          continue;
+
+        const octave_idx_type *ord = gp.order () + gp.start (g);
+
+        for (octave_idx_type b = 0; b < r; b++)
+          for (octave_idx_type a = 0; a < l; a++)
+            {
+              octave_idx_type k = a + l * (g + ng * b);
+              pr[k] = fcn (pv + a + l * m * b, l, ord, len, k);
+            }
+      }
+  });
+
+  return retval;
+}
+
+template <typename NDT>
+static octave_value_list
+do_accum_reduce (const octave::group_partition& gp, const NDT& vals,
+                 accum_op op, const dim_vector& rdv, octave_idx_type l,
+                 octave_idx_type r, int nargout)
+{
+  typedef typename NDT::element_type T;
+
+  // Means and variances of single precision values are single.
+  typedef typename std::conditional<std::is_same<T, float>::value,
+                                    float, double>::type FT;
+
+  octave_value_list retval;
+
+  switch (op)
+    {
+    case ACCUM_SUM:
+      retval(0) = NDT (accum_reduce<T> (gp, vals, rdv, l, r,
+                       [] (const T *v, octave_idx_type s,
+                           const octave_idx_type *ord, octave_idx_type len,
+                           octave_idx_type)
+      {
+        T acc = v[ord[0] * s];
+        for (octave_idx_type j = 1; j < len; j++)
+          accum_plus (acc, v[ord[j] * s]);
+        return acc;
+      }));
+      break;
+
+    case ACCUM_PROD:
+      retval(0) = NDT (accum_reduce<T> (gp, vals, rdv, l, r,
+                       [] (const T *v, octave_idx_type s,
+                           const octave_idx_type *ord, octave_idx_type len,
+                           octave_idx_type)
+      {
+        T acc = v[ord[0] * s];
+        for (octave_idx_type j = 1; j < len; j++)
+          accum_times (acc, v[ord[j] * s]);
+        return acc;
+      }));
+      break;
+
+    case ACCUM_MEAN:
+      retval(0) = accum_reduce<FT> (gp, vals, rdv, l, r,
+                  [] (const T *v, octave_idx_type s,
+                      const octave_idx_type *ord, octave_idx_type len,
+                      octave_idx_type)
+      {
+        // Like mean, sum in double precision.
+        double acc = 0;
+        for (octave_idx_type j = 0; j < len; j++)
+          acc += accum_double (v[ord[j] * s]);
+        return static_cast<FT> (acc / len);
+      });
+      break;
+
+    case ACCUM_VAR:
+    case ACCUM_STD:
+      {
+        bool want_std = (op == ACCUM_STD);
+
+        retval(0) = accum_reduce<FT> (gp, vals, rdv, l, r,
+                    [want_std] (const T *v, octave_idx_type s,
+                                const octave_idx_type *ord,
+                                octave_idx_type len, octave_idx_type)
+        {
+          if (len == 1)
+            {
+              double x = accum_double (v[ord[0] * s]);
+
+              return (math::isfinite (x) ? FT (0)
+                      : numeric_limits<FT>::NaN ());
+            }
+
+          // Two passes, normalized by LEN-1 like var.
+          double mu = 0;
+          for (octave_idx_type j = 0; j < len; j++)
+            mu += accum_double (v[ord[j] * s]);
+          mu /= len;
+
+          double acc = 0;
+          for (octave_idx_type j = 0; j < len; j++)
+            {
+              double d = accum_double (v[ord[j] * s]) - mu;
+              acc += d * d;
+            }
+          acc /= (len - 1);
+
+          return static_cast<FT> (want_std ? std::sqrt (acc) : acc);
+        });
+      }
+      break;
+
+    case ACCUM_COUNT:
+      retval(0) = NDArray (accum_reduce<double> (gp, vals, rdv, l, r,
+                           [] (const T *, octave_idx_type,
+                               const octave_idx_type *, octave_idx_type len,
+                               octave_idx_type)
+      {
+        return static_cast<double> (len);
+      }));
+      break;
+
+    case ACCUM_MIN:
+    case ACCUM_MAX:
+      {
+        bool ismin = (op == ACCUM_MIN);
+
+        NDArray idx (nargout > 1 ? rdv : dim_vector (0, 0), 0);
+        double *pidx = (nargout > 1 ? idx.rwdata () : nullptr);
+
+        retval(0) = NDT (accum_reduce<T> (gp, vals, rdv, l, r,
+                         [ismin, pidx] (const T *v, octave_idx_type s,
+                                        const octave_idx_type *ord,
+                                        octave_idx_type len,
+                                        octave_idx_type k)
+        {
+          // NaN values are ignored unless all values are NaN.  The
+          // index is that of the first extreme value.
+          octave_idx_type j = 0;
+          while (j < len && math::isnan (v[ord[j] * s]))
+            j++;
+
+          octave_idx_type pos = ord[j < len ? j : 0];
+          T best = v[pos * s];
+
+          for (j++; j < len; j++)
+            {
+              T x = v[ord[j] * s];
+              if (ismin ? x < best : x > best)
+                {
+                  best = x;
+                  pos = ord[j];
+                }
+            }
+
+          if (pidx)
+            pidx[k] = pos + 1;
+
+          return best;
+        }));
+
+        if (nargout > 1)
+          retval(1) = idx;
+      }
+      break;
+
+    case ACCUM_FIRST:
+    case ACCUM_LAST:
+      {
+        bool first = (op == ACCUM_FIRST);
+
+        retval(0) = NDT (accum_reduce<T> (gp, vals, rdv, l, r,
+                         [first] (const T *v, octave_idx_type s,
+                                  const octave_idx_type *ord,
+                                  octave_idx_type len, octave_idx_type)
+        {
+          return v[ord[first ? 0 : len-1] * s];
+        }));
+      }
+      break;
+
+    case ACCUM_ANY:
+    case ACCUM_ALL:
+      {
+        bool isany = (op == ACCUM_ANY);
+
+        retval(0) = boolNDArray (accum_reduce<bool> (gp, vals, rdv, l, r,
+                                 [isany] (const T *v, octave_idx_type s,
+                                          const octave_idx_type *ord,
+                                          octave_idx_type len,
+                                          octave_idx_type)
+        {
+          // Like any and all, NaN counts as neither true nor false.
+          for (octave_idx_type j = 0; j < len; j++)
+            if (isany ? xis_true (v[ord[j] * s]) : xis_false (v[ord[j] * s]))
+              return isany;
+          return ! isany;
+        }));
+      }
+      break;
+
+    case ACCUM_CELL:
+      {
+        if (l != 1 || r != 1)
+          error ("accumdim: values cannot be collected in cells");
+
+        // Octave values are not created by several threads.
+
+        octave_idx_type ng = gp.groups ();
+        const T *pv = vals.data ();
+
+        Cell c (rdv);
+
+        for (octave_idx_type g = 0; g < ng; g++)
+          {
+            octave_idx_type len = gp.group_size (g);
+
+            if (len == 0)
+              continue;
+
+            const octave_idx_type *ord = gp.order () + gp.start (g);
+
+            NDT col (dim_vector (len, 1));
+            T *pc = col.rwdata ();
+
+            for (octave_idx_type j = 0; j < len; j++)
+              pc[j] = pv[ord[j]];
+
+            c.xelem (g) = col;
+          }
+
+        retval(0) = c;
+      }
+      break;
+    }
+
+  return retval;
+}
+
+static octave_value_list
+do_accum_reduce_fcn (const octave_value_list& args, int nargout,
+                     bool accumdim)
+{
+  int nargin = args.length ();
+
+  const char *who = (accumdim ? "accumdim" : "accumarray");
+
+  if (! args(0).isnumeric ())
+    error ("%s: first argument must be numeric", who);
+
+  std::string opname = args(2).xstring_value ("%s: OP must be a string",
+                                              who);
+  accum_op op = accum_op_value (opname, who);
+
+  octave_value vals = args(1);
+
+  if (vals.iscomplex () || ! (vals.isnumeric () || vals.islogical ()))
+    err_wrong_type_arg (who, vals);
+
+  octave_value_list retval;
+
+  try
+    {
+      idx_vector idx = args(0).index_vector ();
+
+      int dim = -1;
+      octave_idx_type n = -1;
+
+      if (accumdim)
+        {
+          if (nargin >= 4)
+            dim = args(3).int_value () - 1;
+          if (nargin == 5)
+            n = args(4).idx_type_value (true);
+        }
+      else if (nargin == 4)
+        n = args(3).idx_type_value (true);
+
+      if (n < 0)
+        n = idx.extent (0);
+      else if (idx.extent (n) > n)
+        error ("%s: index out of range", who);
+
+      octave_idx_type m = idx.length (n);
+
+      dim_vector vals_dim = vals.dims ();
+      dim_vector rdv;
+      octave_idx_type l = 1;
+      octave_idx_type r = 1;
+
+      if (accumdim)
+        {
+          if (dim < 0)
+            dim = vals_dim.first_non_singleton ();
+
+          rdv = vals_dim;
+          if (dim >= rdv.ndims ())
+            rdv.resize (dim+1, 1);
+
+          if (m != rdv(dim))
+            error ("accumdim: dimension mismatch");
+
+          for (int i = 0; i < dim; i++)
+            l *= rdv(i);
+          for (int i = dim + 1; i < rdv.ndims (); i++)
+            r *= rdv(i);
+
+          rdv(dim) = n;
+        }
+      else
+        {
+          rdv = dim_vector (n, 1);
+
+          if (vals.numel () == 1)
+            {
+              // Use the scalar value for all indices.
+              Array<octave_idx_type> zeros (dim_vector (m, 1), 0);
+              vals = vals.index_op (ovl (octave_value (idx_vector (zeros))));
+            }
+          else if (vals.numel () != m)
+            error ("accumarray: dimensions mismatch");
+        }
+
+      octave::group_partition gp (idx, n);
+
+      // Sums, products and moments of logical values are double.
+      if (vals.islogical ()
+          && (op == ACCUM_SUM || op == ACCUM_PROD || op == ACCUM_MEAN
+              || op == ACCUM_VAR || op == ACCUM_STD))
+        vals = vals.array_value ();
+
+      switch (vals.builtin_type ())
+        {
+#define MAKE_ACCUM_BRANCH(BTYP, METHOD)                                 \
+        case BTYP:                                                      \
+          retval = do_accum_reduce (gp, vals.METHOD (), op, rdv, l, r,  \
+                                    nargout);                           \
+          break
+
+          MAKE_ACCUM_BRANCH (btyp_double, array_value);
+          MAKE_ACCUM_BRANCH (btyp_float, float_array_value);
+          MAKE_ACCUM_BRANCH (btyp_int8, int8_array_value);
+          MAKE_ACCUM_BRANCH (btyp_int16, int16_array_value);
+          MAKE_ACCUM_BRANCH (btyp_int32, int32_array_value);
+          MAKE_ACCUM_BRANCH (btyp_int64, int64_array_value);
+          MAKE_ACCUM_BRANCH (btyp_uint8, uint8_array_value);
+          MAKE_ACCUM_BRANCH (btyp_uint16, uint16_array_value);
+          MAKE_ACCUM_BRANCH (btyp_uint32, uint32_array_value);
+          MAKE_ACCUM_BRANCH (btyp_uint64, uint64_array_value);
+          MAKE_ACCUM_BRANCH (btyp_bool, bool_array_value);
+
+#undef MAKE_ACCUM_BRANCH
+
+        default:
+          err_wrong_type_arg (who, vals);
+        }
+    }
+  catch (const index_exception& ie)
+    {
+      error ("%s: invalid index %s", who, ie.what ());
+    }
+
+  return retval;
+}
+
+DEFUN (__accumarray_reduce__, args, nargout,
+       doc: /* -*- texinfo -*-
+@deftypefn {} {[@var{A}, @var{I}] =} __accumarray_reduce__ (@var{idx}, @var{vals}, @var{op}, @var{n})
+Undocumented internal function.
+@end deftypefn */)
+{
+  int nargin = args.length ();
+
+  if (nargin < 3 || nargin > 4)
+    print_usage ();
+
+  return do_accum_reduce_fcn (args, nargout, false);
+}
+
+DEFUN (__accumdim_reduce__, args, nargout,
+       doc: /* -*- texinfo -*-
+@deftypefn {} {[@var{A}, @var{I}] =} __accumdim_reduce__ (@var{idx}, @var{vals}, @var{op}, @var{dim}, @var{n})
+Undocumented internal function.
+@end deftypefn */)
+{
+  int nargin = args.length ();
+
+  if (nargin < 3 || nargin > 5)
+    print_usage ();
+
+  return do_accum_reduce_fcn (args, nargout, true);
+}
+
+/*
+%!shared idx, x
+%! idx = [2; 1; 2; 4; 2];
+%! x = [3; -1; NaN; 5; 1];
+
+%!assert (__accumarray_reduce__ (idx, x, "sum"), [-1; NaN; 0; 5])
+%!assert (__accumarray_reduce__ (idx, x, "prod", 5), [-1; NaN; 0; 5; 0])
+%!assert (__accumarray_reduce__ (idx, x, "count"), [1; 3; 0; 1])
+%!assert (__accumarray_reduce__ (idx, x, "first"), [-1; 3; 0; 5])
+%!assert (__accumarray_reduce__ (idx, x, "last"), [-1; 1; 0; 5])
+%!assert (__accumarray_reduce__ (idx, x, "any"), [true; true; false; true])
+%!assert (__accumarray_reduce__ (idx, [1; 0; 1; 1; 1] == 1, "all"),
+%!        [false; true; false; true])
+## NaN is neither true nor false, as for any and all
+%!assert (__accumarray_reduce__ ([1; 1; 2; 2], [NaN; 0; NaN; NaN], "any"),
+%!        [false; false])
+%!assert (__accumarray_reduce__ ([1; 1; 2; 2], [NaN; 0; NaN; NaN], "all"),
+%!        [false; true])
+%!assert (__accumarray_reduce__ (idx, single (x), "mean"),
+%!        single ([-1; NaN; 0; 5]))
+%!assert (__accumarray_reduce__ ([1; 1; 1; 2], [1; 2; 3; 4], "var"),
+%!        [1; 0])
+%!assert (__accumarray_reduce__ ([1; 1; 1; 2], [1; 2; 3; 4], "std"),
+%!        [1; 0])
+%!assert (__accumarray_reduce__ ([1; 1; 2], int8 ([100; 2; 7]), "prod"),
+%!        int8 ([127; 7]))
+%!assert (__accumarray_reduce__ ([1; 1; 2], true, "sum"), [2; 1])
+%!assert (__accumarray_reduce__ (idx, x, "cell"), {-1; [3; NaN; 1]; []; 5})
+
+%!test
+%! [m, i] = __accumarray_reduce__ (idx, x, "max");
+%! assert (m, [-1; 3; 0; 5]);
+%! assert (i, [2; 1; 0; 4]);
+%! [m, i] = __accumarray_reduce__ (idx, x, "min");
+%! assert (m, [-1; 1; 0; 5]);
+%! assert (i, [2; 5; 0; 4]);
+
+%!test
+%! a = reshape (1:24, 2, 4, 3);
+%! s = __accumdim_reduce__ ([2; 1; 2; 2], a, "prod", 2, 3);
+%! assert (size (s), [2, 3, 3]);
+%! assert (s(:,:,2), [9*13*15, 11, 0; 10*14*16, 12, 0]);
+%! [m, i] = __accumdim_reduce__ ([2; 1; 2; 2], a, "max", 2);
+%! assert (m, a(:,[2, 4],:));
+%! assert (i, repmat ([2, 4], [2, 1, 3]));
+
+%!error <index out of range> __accumarray_reduce__ ([1; 3], [1; 2], "sum", 2)
+%!error <dimensions mismatch> __accumarray_reduce__ ([1; 3], [1; 2; 3], "sum")
+%!error <unknown reduction> __accumarray_reduce__ ([1; 3], [1; 2], "median")
+%!error <dimension mismatch> __accumdim_reduce__ ([1; 3], ones (3, 2), "prod")
+*/
+
 template <typename NDT>
 static NDT
 do_merge (const Array<bool>& mask,
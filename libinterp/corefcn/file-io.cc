@@ -72,6 +72,7 @@
 #include "oct-fstrm.h"
 #include "oct-iostrm.h"
 #include "oct-map.h"
+#include "oct-mmapstrm.h"
 #include "oct-prcstrm.h"
 #include "oct-stream.h"
 #include "oct-strstrm.h"
@@ -85,9 +86,10 @@
 OCTAVE_BEGIN_NAMESPACE(octave)
 
 static void
-normalize_fopen_mode (std::string& mode, bool& use_zlib)
+normalize_fopen_mode (std::string& mode, bool& use_zlib, bool& use_mmap)
 {
   use_zlib = false;
+  use_mmap = false;
 
   if (! mode.empty ())
     {
@@ -125,6 +127,21 @@ normalize_fopen_mode (std::string& mode, bool& use_zlib)
 #endif
         }
 
+      pos = mode.find ('m');
+
+      if (pos != std::string::npos)
+        {
+          mode.erase (pos, 1);
+
+          if (use_zlib)
+            error ("fopen: mode 'm' can not be combined with 'z'");
+
+          if (mode[0] != 'r')
+            error ("fopen: mode 'm' requires mode 'r' or 'r+'");
+
+          use_mmap = true;
+        }
+
       // Use binary mode if 't' is not specified, but don't add
       // 'b' if it is already present.
 
@@ -409,7 +426,8 @@ do_stream_open (const std::string& name, const std::string& mode_arg,
 
   std::string mode = mode_arg;
   bool use_zlib = false;
-  normalize_fopen_mode (mode, use_zlib);
+  bool use_mmap = false;
+  normalize_fopen_mode (mode, use_zlib, use_mmap);
 
   std::ios::openmode md = fopen_mode_to_ios_mode (mode);
 
@@ -425,8 +443,10 @@ do_stream_open (const std::string& name, const std::string& mode_arg,
 
   if (! is_dir)
     {
+      if (use_mmap)
+        retval = mmap_stream::create (fname, md, flt_fmt, encoding);
 #if defined (HAVE_ZLIB)
-      if (use_zlib)
+      else if (use_zlib)
         {
           FILE *fptr = sys::fopen (fname.c_str (), mode.c_str ());
 
@@ -442,8 +462,8 @@ do_stream_open (const std::string& name, const std::string& mode_arg,
           else
             retval.error (std::strerror (errno));
         }
-      else
 #endif
+      else
         {
           FILE *fptr = sys::fopen (fname, mode);
 
@@ -580,6 +600,16 @@ Additionally, you may append a @qcode{"z"} to the mode string to open a
 gzipped file for reading or writing.  For this to be successful, you
 must also open the file in binary mode.
 
+Append an @qcode{"m"} to the mode @qcode{"r"} or @qcode{"r+"} to access the
+file through a memory mapping of the whole file.  Seeking is then a constant
+time operation, and @code{fread} returns arrays that share the mapped pages
+instead of copying the data when no conversion is needed, i.e., when the
+input and output precision are the same and the file is in the native
+format.  Modifying such an array does not change the file.  A file opened
+with @qcode{"r+m"} can be written with @code{fwrite} but can not grow, and
+@code{fread} always copies from it.  The file must not be truncated while it
+is mapped.
+
 The parameter @var{arch} is a string specifying the default data format
 for the file.  Valid values for @var{arch} are:
 
@@ -2395,6 +2425,16 @@ as the name of the function when reporting errors.
 
 %!assert <*60711> (textscan('1,.,2', '%f', 'Delimiter', ','), {1});
 
+## Numbers split across buffer refills are read exactly as in one buffer
+%!test
+%! x = [1e-3, 12.5, -0.125, 3e10, 7, 1.5e-7, 42, .5, 6.02E+23, -0];
+%! str = sprintf ("%.10g,%.10g\n", [x; 2*x]);
+%! c1 = textscan (str, "%f %f", "Delimiter", ",");
+%! c2 = textscan (str, "%f %f", "Delimiter", ",", "BufSize", 64);
+%! assert (c2, c1);
+%! assert (c1{1}, x.', -4*eps);
+%! assert (c1{2}, 2*x.', -4*eps);
+
 */
 
 // These tests have end-comment sequences, so can't just be in a comment
@@ -35,6 +35,14 @@
 #  include "config.h"
 #endif
 
+#include <algorithm>
+#include <vector>
+
+#if defined (HAVE_OMP_H)
+#  include <omp.h>
+#endif
+
+#include "nproc-wrapper.h"
 #include "quit.h"
 
 #include "defun.h"
@@ -43,6 +51,166 @@
 
 OCTAVE_BEGIN_NAMESPACE(octave)
 
+// Filter the N samples X[i*STRIDE] with the transposed direct form II
+// structure.  B, and A if USE_A is true, have SI_LEN+1 elements and SI
+// holds the SI_LEN >= 1 state variables.  X and Y may be the same array.
+
+template <typename T>
+static void
+filter_iir (const T *pb, const T *pa, bool use_a, octave_idx_type si_len,
+            const T *px, T *py, octave_idx_type n, octave_idx_type stride,
+            T *psi)
+{
+  octave_idx_type last = si_len - 1;
+
+  if (use_a)
+    {
+      for (octave_idx_type i = 0, idx = 0; i < n; i++, idx += stride)
+        {
+          T xi = px[idx];
+          T yi = psi[0] + pb[0] * xi;
+
+#if defined (HAVE_OPENMP)
+#  pragma omp simd
+#endif
+          for (octave_idx_type j = 0; j < last; j++)
+            psi[j] = psi[j+1] - pa[j+1] * yi + pb[j+1] * xi;
+
+          psi[last] = pb[si_len] * xi - pa[si_len] * yi;
+
+          py[idx] = yi;
+        }
+    }
+  else
+    {
+      for (octave_idx_type i = 0, idx = 0; i < n; i++, idx += stride)
+        {
+          T xi = px[idx];
+          T yi = psi[0] + pb[0] * xi;
+
+#if defined (HAVE_OPENMP)
+#  pragma omp simd
+#endif
+          for (octave_idx_type j = 0; j < last; j++)
+            psi[j] = psi[j+1] + pb[j+1] * xi;
+
+          psi[last] = pb[si_len] * xi;
+
+          py[idx] = yi;
+        }
+    }
+}
+
+// Same as filter_iir without A, but computed as a sum over the
+// coefficients of B for blocks of samples.  The inner loop then runs over
+// consecutive samples and can be vectorized.  X and Y must be different
+// arrays.  The cost of updating the state is proportional to
+// SI_LEN * min (N, SI_LEN), so N should not be much smaller than SI_LEN.
+
+template <typename T>
+static void
+filter_fir (const T *pb, octave_idx_type si_len, const T *px, T *py,
+            octave_idx_type n, octave_idx_type stride, T *psi)
+{
+  const octave_idx_type block = 4096;
+
+  for (octave_idx_type i0 = 0; i0 < n; i0 += block)
+    {
+      octave_idx_type i1 = std::min (i0 + block, n);
+
+      for (octave_idx_type i = i0; i < i1; i++)
+        py[i*stride] = (i < si_len ? psi[i] : T (0));
+
+      for (octave_idx_type k = 0; k <= si_len; k++)
+        {
+          octave_idx_type lo = std::max (i0, k);
+          const T bk = pb[k];
+
+          if (stride == 1)
+            {
+#if defined (HAVE_OPENMP)
+#  pragma omp simd
+#endif
+              for (octave_idx_type i = lo; i < i1; i++)
+                py[i] += bk * px[i-k];
+            }
+          else
+            {
+              for (octave_idx_type i = lo; i < i1; i++)
+                py[i*stride] += bk * px[(i-k)*stride];
+            }
+        }
+    }
+
+  // State after the last sample.  Initial state values that were not
+  // consumed move down by N.
+
+  for (octave_idx_type j = 0; j < si_len; j++)
+    {
+      T z = (j + n < si_len ? psi[j+n] : T (0));
+
+      octave_idx_type k_max = std::min (si_len, n + j);
+      for (octave_idx_type k = j + 1; k <= k_max; k++)
+        z += pb[k] * px[(n+j-k)*stride];
+
+      psi[j] = z;
+    }
+}
+
+// Call FCN (NUM, I0, N) for samples I0 to I0+N-1 of the columns
+// 0 <= NUM < X_NUM of length X_LEN.  Columns are independent and are
+// filtered in parallel if there is enough work.  Otherwise, they are
+// split into chunks so that filtering long columns can be interrupted.
+// ORDER estimates the work per sample.  FCN must not throw.
+
+template <typename F>
+static void
+filter_columns (octave_idx_type x_num, octave_idx_type x_len,
+                octave_idx_type order, F fcn)
+{
+  // Approximate work between checks for interrupts.
+  const double chunk_work = 1e7;
+
+  double col_work = static_cast<double> (x_len) * (order + 1);
+
+#if defined (HAVE_OPENMP)
+  int nthreads
+    = std::min (static_cast<double> (x_num),
+                static_cast<double> (octave_num_processors_wrapper
+                                     (OCTAVE_NPROC_CURRENT_OVERRIDABLE)));
+
+  if (nthreads > 1 && col_work * x_num > 1e6)
+    {
+      octave_idx_type batch
+        = std::max (static_cast<double> (nthreads), chunk_work / col_work);
+
+      for (octave_idx_type lo = 0; lo < x_num; lo += batch)
+        {
+          octave_idx_type hi = std::min (lo + batch, x_num);
+
+#  pragma omp parallel for num_threads (nthreads) schedule (dynamic)
+          for (octave_idx_type num = lo; num < hi; num++)
+            fcn (num, 0, x_len);
+
+          octave_quit ();
+        }
+
+      return;
+    }
+#endif
+
+  octave_idx_type chunk
+    = std::max (1.0, chunk_work / (order + 1));
+
+  for (octave_idx_type num = 0; num < x_num; num++)
+    for (octave_idx_type i0 = 0; i0 < x_len; i0 += chunk)
+      {
+        fcn (num, i0, std::min (chunk, x_len - i0));
+
+        octave_quit ();
+      }
+}
+
 template <typename T>
 MArray<T>
 filter (MArray<T>& b, MArray<T>& a, MArray<T>& x, MArray<T>& si,
@@ -118,119 +286,32 @@ filter (MArray<T>& b, MArray<T>& a, MArray<T>& x, MArray<T>& si,
   // For deconv and fftfilt, x_num seems to always be 1.
   // For directly calling filter, it can be more than 1.
 
-  for (octave_idx_type num = 0; num < x_num; num++)
-    {
-      octave_idx_type x_offset = (x_stride == 1) ? num * x_len
-                                 : num + (num / x_stride) * x_stride * (x_len - 1);
-
-      octave_idx_type si_offset = num * si_len;
-
-      // Try to achieve a balance between speed and interruptibility.
-      //
-      // One extreme is to not check for interruptions at all, which gives
-      // good speed but the user cannot use Ctrl-C for the whole duration.
-      // The other end is to check frequently from inside an inner loop,
-      // which slows down performance by 5X or 6X.
-      //
-      // Putting any sort of check in an inner loop seems to prevent the
-      // compiler from optimizing the loop, so we cannot say "check for
-      // interruptions every M iterations" using an if-statement.
-      //
-      // This is a compromise approach to split the total numer of loop
-      // executions into num_outer and num_inner, to provide periodic checks
-      // for interruptions without writing a conditional inside a tight loop.
-      //
-      // To make it more interruptible and run more slowly, reduce num_inner.
-      // To speed it up but make it less interruptible, increase it.
-      // May need to increase it slowly over time as computers get faster.
-      // The aim is to not lose Ctrl-C ability for longer than about 2 seconds.
-      //
-      // In December 2021, num_inner = 100000 is acceptable.
-
-      octave_idx_type num_execs = si_len-1; // 0 to num_execs-1
-      octave_idx_type num_inner = 100000;
-      octave_idx_type num_outer = num_execs / num_inner;
-
-      // The following if-else block depends on a_len and si_len,
-      // both of which are loop invariants in this 0 <= num < x_num loop.
-      // But x_num is so small in practice that using the if-else inside
-      // the loop has more benefits than duplicating the outer for-loop,
-      // even though the checks are on loop invariants.
-
-      // We cannot have a_len <= 1 AND si_len <= 0 because that case already
-      // returned above. This means exactly one of the following blocks
-      // inside the if-conditional will be obeyed: it is not possible for the
-      // if-block and the else-block to *both* skip. Therefore any code that
-      // is common to both branches can be pulled out here without affecting
-      // correctness or speed.
-
-      T *py = y.rwdata ();
-      T *psi = si.rwdata ();
-      const T *pb = b.data ();
-      const T *px = x.data ();
-      psi += si_offset;
-
-      if (a_len > 1)
-        {
-          const T *pa = a.data ();
+  T *py = y.rwdata ();
+  T *psi = si.rwdata ();
+  const T *pb = b.data ();
+  const T *pa = a.data ();
+  const T *px = x.data ();
 
-          // Usually the last element to be written will be si_len-1
-          // but if si_len is 0, then we need the 0th element to be written.
-          // Pulling this check out of the for-loop makes it run faster.
-          octave_idx_type iidx = (si_len > 0) ? si_len-1 : 0;
+  bool use_a = (a_len > 1);
 
-          for (octave_idx_type i = 0, idx = x_offset;
-               i < x_len;
-               i++, idx += x_stride)
-            {
-              py[idx] = psi[0] + pb[0] * px[idx];
+  auto filter_column = [=] (octave_idx_type num, octave_idx_type i0,
+                            octave_idx_type n)
+  {
+    octave_idx_type x_offset = (x_stride == 1) ? num * x_len
+                               : num + (num / x_stride) * x_stride * (x_len - 1);
 
-              // Outer and inner loops for interruption management
-              for (octave_idx_type u = 0; u <= num_outer; u++)
-                {
-                  octave_idx_type lo = u * num_inner;
-                  octave_idx_type hi = (lo + num_inner < num_execs-1)
-                                       ? lo + num_inner : num_execs-1;
+    x_offset += i0 * x_stride;
 
-                  // Inner loop, no interruption
-                  for (octave_idx_type j = lo; j <= hi; j++)
-                    psi[j] = psi[j+1] - pa[j+1] * py[idx] + pb[j+1] * px[idx];
+    T *z = psi + num * si_len;
 
-                  octave_quit();  // Check for interruptions
-                }
+    if (! use_a && n >= si_len)
+      filter_fir (pb, si_len, px + x_offset, py + x_offset, n, x_stride, z);
+    else
+      filter_iir (pb, pa, use_a, si_len, px + x_offset, py + x_offset, n,
+                  x_stride, z);
+  };
 
-              psi[iidx] = pb[si_len] * px[idx] - pa[si_len] * py[idx];
-            }
-        }
-      else // a_len <= 1 ==> si_len MUST be > 0
-        {
-          // This else-block is almost the same as the above if-block,
-          // except for the absence of variable pa.
-
-          for (octave_idx_type i = 0, idx = x_offset;
-               i < x_len;
-               i++, idx += x_stride)
-            {
-              py[idx] = psi[0] + pb[0] * px[idx];
-
-              // Outer and inner loops for interruption management
-              for (octave_idx_type u = 0; u <= num_outer; u++)
-                {
-                  octave_idx_type lo = u * num_inner;
-                  octave_idx_type hi = (lo + num_inner < num_execs-1)
-                                       ? lo + num_inner : num_execs-1;
-
-                  // Inner loop, no interruption
-                  for (octave_idx_type j = lo; j <= hi; j++)
-                    psi[j] = psi[j+1] + pb[j+1] * px[idx];
-
-                  octave_quit();  // Check for interruptions
-                }
-
-              psi[si_len-1] = pb[si_len] * px[idx];
-            }
-        }
-    }
+  filter_columns (x_num, x_len, si_len, filter_column);
 
   return y;
 }
@@ -260,12 +341,133 @@ filter (MArray<T>& b, MArray<T>& a, MArray<T>& x, int dim = -1)
   return filter (b, a, x, si, dim);
 }
 
+// Cascade of second order sections.  Each row of the L-by-6 matrix SOS
+// holds the coefficients [b0 b1 b2 a0 a1 a2] of one section.  SI holds
+// the two state variables of each section as an L-by-2 array for each
+// column of X.
+
+template <typename T>
+static MArray<T>
+filter_sos (const MArray<T>& sos, const MArray<T>& x, MArray<T>& si,
+            int dim)
+{
+  if (sos.ndims () != 2 || sos.columns () != 6)
+    error ("filter: SOS must be an L-by-6 matrix");
+
+  octave_idx_type n_sec = sos.rows ();
+
+  const dim_vector& x_dims = x.dims ();
+  if (dim < 0 || dim >= x_dims.ndims ())
+    error ("filter: DIM must be a valid dimension");
+
+  octave_idx_type x_len = x_dims(dim);
+
+  octave_idx_type x_num = 1;
+  for (int i = 0; i < x_dims.ndims (); i++)
+    if (i != dim)
+      x_num *= x_dims(i);
+
+  const dim_vector& si_dims = si.dims ();
+  if (si_dims(0) != n_sec || si_dims(1) != 2
+      || si.numel () != 2 * n_sec * x_num)
+    error ("filter: SI must have size L-by-2 for each column of X in SOS mode");
+
+  // Coefficients of each section normalized by a0.
+  std::vector<T> coef (6 * n_sec);
+
+  for (octave_idx_type s = 0; s < n_sec; s++)
+    {
+      T a0 = sos(s, 3);
+
+      if (a0 == static_cast<T> (0.0))
+        error ("filter: the first denominator coefficient of each section must be nonzero");
+
+      for (int k = 0; k < 6; k++)
+        coef[6*s+k] = sos(s, k) / a0;
+    }
+
+  MArray<T> y = x;
+
+  if (x_len == 0 || n_sec == 0)
+    return y;
+
+  octave_idx_type x_stride = 1;
+  for (int i = 0; i < dim; i++)
+    x_stride *= x_dims(i);
+
+  T *py = y.rwdata ();
+  T *psi = si.rwdata ();
+  const T *pc = coef.data ();
+
+  auto filter_column = [=] (octave_idx_type num, octave_idx_type i0,
+                            octave_idx_type n)
+  {
+    octave_idx_type x_offset = (x_stride == 1) ? num * x_len
+                               : num + (num / x_stride) * x_stride * (x_len - 1);
+
+    x_offset += i0 * x_stride;
+
+    T *z = psi + num * 2 * n_sec;
+
+    // Apply one section after the other to the whole block, which
+    // keeps the coefficients and the state of a section in registers.
+    for (octave_idx_type s = 0; s < n_sec; s++)
+      {
+        T zs[2] = { z[s], z[s+n_sec] };
+
+        filter_iir (pc + 6*s, pc + 6*s + 3, true, 2, py + x_offset,
+                    py + x_offset, n, x_stride, zs);
+
+        z[s] = zs[0];
+        z[s+n_sec] = zs[1];
+      }
+  };
+
+  filter_columns (x_num, x_len, 2 * n_sec, filter_column);
+
+  return y;
+}
+
+template <typename NDA>
+static octave_value_list
+do_filter_sos (const octave_value_list& args, int dim)
+{
+  NDA sos = octave_value_extract<NDA> (args(0));
+  NDA x = octave_value_extract<NDA> (args(2));
+
+  NDA si;
+
+  if (args.length () < 4 || args(3).isempty ())
+    {
+      // L-by-2 for each column of X.
+      const dim_vector& x_dims = x.dims ();
+      dim_vector si_dims = dim_vector::alloc (x_dims.ndims () + 1);
+
+      si_dims(0) = sos.rows ();
+      si_dims(1) = 2;
+      for (int i = 0, j = 2; i < x_dims.ndims (); i++)
+        if (i != dim)
+          si_dims(j++) = x_dims(i);
+
+      si_dims.chop_trailing_singletons ();
+
+      si.resize (si_dims, 0.0);
+    }
+  else
+    si = octave_value_extract<NDA> (args(3));
+
+  NDA y (filter_sos<typename NDA::element_type> (sos, x, si, dim));
+
+  return ovl (y, si);
+}
+
 DEFUN (filter, args, ,
        doc: /* -*- texinfo -*-
 @deftypefn  {} {@var{y} =} filter (@var{b}, @var{a}, @var{x})
 @deftypefnx {} {[@var{y}, @var{sf}] =} filter (@var{b}, @var{a}, @var{x}, @var{si})
 @deftypefnx {} {[@var{y}, @var{sf}] =} filter (@var{b}, @var{a}, @var{x}, [], @var{dim})
 @deftypefnx {} {[@var{y}, @var{sf}] =} filter (@var{b}, @var{a}, @var{x}, @var{si}, @var{dim})
+@deftypefnx {} {[@var{y}, @var{sf}] =} filter (@var{sos}, "sos", @var{x}, @var{si}, @var{dim})
 Apply a 1-D digital filter to the data @var{x}.
 
 @code{filter} returns the solution to the following linear, time-invariant
@@ -360,6 +562,18 @@ H(z) = ---------------------
 @end example
 
 @end ifnottex
+
+When the second argument is the string @qcode{"sos"}, the first argument
+@var{sos} is an @var{L}-by-6 matrix of second-order sections.  Each row
+@code{[b0, b1, b2, a0, a1, a2]} holds the coefficients of one section, and
+@var{x} is filtered by the cascade of all @var{L} sections.  This is
+numerically more robust than a single filter of high order.  The state of
+the cascade @var{si} is an @var{L}-by-2 array for each column of @var{x}.
+If it is empty or not supplied, the initial state is set to all zeros.
+
+Programming Note: The columns of a matrix or N-D array @var{x} are filtered
+in parallel when Octave is built with OpenMP support.
+
 @seealso{filter2, fftfilt, freqz}
 @end deftypefn */)
 {
@@ -390,6 +604,22 @@ H(z) = ---------------------
                   || args(2).is_single_type ()
                   || (nargin >= 4 && args(3).is_single_type ()));
 
+  if (args(1).is_string ())
+    {
+      if (args(1).string_value () != "sos")
+        error (R"(filter: A must be a vector or "sos")");
+
+      bool iscomplex = (args(0).iscomplex () || args(2).iscomplex ()
+                        || (nargin >= 4 && args(3).iscomplex ()));
+
+      if (iscomplex)
+        return (isfloat ? do_filter_sos<FloatComplexNDArray> (args, dim)
+                        : do_filter_sos<ComplexNDArray> (args, dim));
+      else
+        return (isfloat ? do_filter_sos<FloatNDArray> (args, dim)
+                        : do_filter_sos<NDArray> (args, dim));
+    }
+
   if (args(0).iscomplex ()
       || args(1).iscomplex ()
       || args(2).iscomplex ()
@@ -648,6 +878,57 @@ filter (MArray<FloatComplex>&, MArray<FloatComplex>&, MArray<FloatComplex>&,
 %! y0 = reshape (y0, size (x));
 %! y = filter ([1 1 1], 1, x, [], 3);
 %! assert (y, y0);
+
+## Filter many columns at once, possibly in parallel
+%!test
+%! b = [0.2, 0.3, 0.1];
+%! a = [1, -0.5, 0.25];
+%! x = rand (300, 200);
+%! si = rand (2, 200);
+%! [y, sf] = filter (b, a, x, si);
+%! for j = 1:columns (x)
+%!   [yj, sfj] = filter (b, a, x(:,j), si(:,j));
+%!   assert (y(:,j), yj);
+%!   assert (sf(:,j), sfj);
+%! endfor
+%! [y2, sf2] = filter (b, a, x.', si, 2);
+%! assert (y2, y.', 1e-14);
+%! assert (sf2, sf, 1e-14);
+
+## FIR filter matches the general path and keeps the state
+%!test
+%! b = rand (1, 30);
+%! x = rand (1000, 3);
+%! si = rand (29, 3);
+%! [y, sf] = filter (b, 1, x, si);
+%! [y0, sf0] = filter (b, [1, 0], x, si);
+%! assert (y, y0, 1e-12);
+%! assert (sf, sf0, 1e-12);
+%! [y1, sf1] = filter (b, 1, x(1:10,:), si);
+%! [y2, sf2] = filter (b, 1, x(11:end,:), sf1);
+%! assert ([y1; y2], y, 1e-12);
+%! assert (sf2, sf, 1e-12);
+%!assert (filter ([1, 2, 3], 1, [1, 0, 0, 0, 1]), [1, 2, 3, 0, 1])
+
+## Second-order sections
+%!test
+%! sos = [1, 2, 1, 1, -0.5, 0.1; 2, -1, 0.5, 2, 0.2, 0.3];
+%! x = rand (100, 2);
+%! y0 = filter (sos(2,1:3), sos(2,4:6), filter (sos(1,1:3), sos(1,4:6), x));
+%! y = filter (sos, "sos", x);
+%! assert (y, y0, 1e-12);
+%! [y1, sf1] = filter (sos, "sos", x(1:40,:));
+%! assert (size (sf1), [2, 2, 2]);
+%! [y2, sf2] = filter (sos, "sos", x(41:end,:), sf1);
+%! assert ([y1; y2], y, 1e-12);
+%! assert (filter (sos, "sos", x.', [], 2), y.', 1e-12);
+%! assert (filter (single (sos), "sos", single (x)), single (y), 1e-5);
+%!assert (size (nthargout (2, @filter, [1 0 0 1 0 0], "sos", 1:5)), [1, 2])
+
+%!error <SOS must be an L-by-6 matrix> filter ([1, 2, 3], "sos", 1:5)
+%!error <A must be a vector or "sos"> filter ([1 0 0 1 0 0], "abc", 1:5)
+%!error <first denominator coefficient> filter ([1 0 0 0 0 0], "sos", 1:5)
+%!error <SI must have size L-by-2> filter ([1 0 0 1 0 0], "sos", 1:5, [0 0 0])
 */
 
 OCTAVE_END_NAMESPACE(octave)
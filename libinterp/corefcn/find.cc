@@ -613,6 +613,23 @@ b = sparse (i, j, v, sz(1), sz(2));
 %!assert (find ([2 0 1 0 5 0], Inf), [1, 3, 5])
 %!assert (find ([2 0 1 0 5 0], Inf, "last"), [1, 3, 5])
 
+## Masks that are long enough to be searched in words and in chunks
+%!test
+%! m = rand (1, 200003) < 0.3;
+%! m(1:1000) = true;
+%! m(end-1000:end) = false;
+%! idx = 1:numel (m);
+%! assert (find (m), idx(m));
+%! assert (nnz (m), numel (idx(m)));
+%! x = 1:numel (m);
+%! assert (x(m), idx(m));
+%! x(m) = 0;
+%! assert (nnz (x), numel (m) - nnz (m));
+%! assert (find (double (m)), find (m));
+%! assert (find (single (m) .* (1+i)), find (m));
+
+%!assert (find (logical ([1 0 0 0 0 0 0 0 1 1 1 1 1 1 1 1 0])), [1, 9:16])
+
 %!error find ()
 */
 
@@ -50,15 +50,205 @@
 // For BUFSIZ.
 #include <cstdio>
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#if defined (HAVE_OMP_H)
+#  include <omp.h>
+#endif
+
+#include "nproc-wrapper.h"
+
 // Internal buffer sizes (default and "unbuffered" versions)
 #define STASHED_CHARACTERS 16
 #define BIGBUFSIZE (256 * 1024 + STASHED_CHARACTERS)
 #define SMALLBUFSIZE 1
 
+// Smallest block compressed as a separate gzip member.  Smaller blocks
+// compress noticeably worse.
+#define MIN_BLOCK_SIZE (64 * 1024)
+
+// Number of decompressed chunks the read-ahead thread may queue.
+#define READ_AHEAD_CHUNKS 4
+
+static std::streamsize default_bufsize = BIGBUFSIZE;
+
+// Number of threads used to compress blocks.
+static int
+compress_threads ()
+{
+#if defined (HAVE_OPENMP)
+  unsigned long n
+    = octave_num_processors_wrapper (OCTAVE_NPROC_CURRENT_OVERRIDABLE);
+
+  return std::max (1, static_cast<int> (n));
+#else
+  return 1;
+#endif
+}
+
+// Compress LEN bytes of DATA as a complete gzip member.
+static int
+compress_block (const char *data, std::size_t len, int level, int strategy,
+                std::string& out)
+{
+  z_stream strm;
+  strm.zalloc = Z_NULL;
+  strm.zfree = Z_NULL;
+  strm.opaque = Z_NULL;
+
+  // 15 + 16 selects the largest window and a gzip header and trailer.
+  int status = deflateInit2 (&strm, level, Z_DEFLATED, 15 + 16, 8, strategy);
+  if (status != Z_OK)
+    return status;
+
+  try
+    {
+      out.resize (deflateBound (&strm, len));
+    }
+  catch (const std::bad_alloc&)
+    {
+      deflateEnd (&strm);
+      return Z_MEM_ERROR;
+    }
+
+  strm.next_in = reinterpret_cast<Bytef *> (const_cast<char *> (data));
+  strm.avail_in = len;
+  strm.next_out = reinterpret_cast<Bytef *> (&out[0]);
+  strm.avail_out = out.size ();
+
+  status = deflate (&strm, Z_FINISH);
+
+  out.resize (strm.total_out);
+  deflateEnd (&strm);
+
+  return status == Z_STREAM_END ? Z_OK : Z_STREAM_ERROR;
+}
+
+// Decompress a gzipped file on a background thread.  Only this thread
+// uses the gzFile while it runs.
+
+class gz_read_ahead
+{
+public:
+
+  gz_read_ahead (gzFile file, unsigned chunk_size)
+    : m_file (file), m_chunk_size (chunk_size), m_mutex (), m_cv (),
+      m_chunks (), m_offset (0), m_status (0), m_done (false),
+      m_stop (false), m_thread ()
+  {
+    m_thread = std::thread (&gz_read_ahead::run, this);
+  }
+
+  OCTAVE_DISABLE_CONSTRUCT_COPY_MOVE (gz_read_ahead)
+
+  ~gz_read_ahead ()
+  {
+    {
+      std::lock_guard<std::mutex> lock (m_mutex);
+      m_stop = true;
+    }
+
+    m_cv.notify_all ();
+    m_thread.join ();
+  }
+
+  // Copy up to LEN decompressed bytes to BUF.  Return the number of
+  // bytes copied, 0 at EOF, or a negative value on error.
+  int read (char *buf, unsigned len)
+  {
+    std::unique_lock<std::mutex> lock (m_mutex);
+
+    m_cv.wait (lock, [this] () { return ! m_chunks.empty () || m_done; });
+
+    if (m_chunks.empty ())
+      return m_status;
+
+    std::vector<char>& chunk = m_chunks.front ();
+
+    std::size_t n = std::min<std::size_t> (len, chunk.size () - m_offset);
+
+    std::memcpy (buf, chunk.data () + m_offset, n);
+
+    m_offset += n;
+
+    if (m_offset == chunk.size ())
+      {
+        m_chunks.pop_front ();
+        m_offset = 0;
+        m_cv.notify_all ();
+      }
+
+    return n;
+  }
+
+private:
+
+  void run ()
+  {
+    for (;;)
+      {
+        std::vector<char> chunk (m_chunk_size);
+
+        int n = gzread (m_file, chunk.data (), m_chunk_size);
+
+        std::unique_lock<std::mutex> lock (m_mutex);
+
+        if (n <= 0)
+          {
+            m_status = n;
+            m_done = true;
+            m_cv.notify_all ();
+            return;
+          }
+
+        chunk.resize (n);
+
+        m_cv.wait (lock, [this] ()
+                         { return m_stop || m_chunks.size () < READ_AHEAD_CHUNKS; });
+
+        if (m_stop)
+          return;
+
+        m_chunks.push_back (std::move (chunk));
+        m_cv.notify_all ();
+      }
+  }
+
+  gzFile m_file;
+
+  unsigned m_chunk_size;
+
+  std::mutex m_mutex;
+
+  std::condition_variable m_cv;
+
+  std::deque<std::vector<char>> m_chunks;
+
+  // Bytes of first chunk already consumed.
+  std::size_t m_offset;
+
+  int m_status;
+
+  bool m_done;
+
+  bool m_stop;
+
+  std::thread m_thread;
+};
+
 // Default constructor
 gzfilebuf::gzfilebuf ()
   : m_file(nullptr), m_io_mode(std::ios_base::openmode(0)), m_own_fd(false),
-    m_buffer(nullptr), m_buffer_size(BIGBUFSIZE), m_own_buffer(true)
+    m_buffer(nullptr), m_buffer_size(default_bufsize), m_own_buffer(true),
+    m_level(Z_DEFAULT_COMPRESSION), m_strategy(Z_DEFAULT_STRATEGY), m_pos(0),
+    m_written(false), m_read_ahead(nullptr)
 {
   // No buffers to start with
   this->disable_buffer ();
@@ -67,20 +257,46 @@ gzfilebuf::gzfilebuf ()
 // Destructor
 gzfilebuf::~gzfilebuf ()
 {
-  // Sync output buffer and close only if responsible for file
+  // Write pending output and close only if responsible for file
   // (i.e., attached streams should be left open at this stage)
-  this->sync ();
   if (m_own_fd)
     this->close ();
+  else
+    this->write_pending ();
+  // Stop reading ahead from an attached file
+  delete m_read_ahead;
   // Make sure internal buffer is deallocated
   this->disable_buffer ();
 }
 
+// Set default buffer size
+std::streamsize
+gzfilebuf::default_buffer_size (std::streamsize n)
+{
+  std::streamsize retval = default_bufsize;
+
+  if (n > STASHED_CHARACTERS)
+    default_bufsize = n;
+
+  return retval;
+}
+
 // Set compression level and strategy
 int
 gzfilebuf::setcompression (int comp_level, int comp_strategy)
 {
-  return gzsetparams (m_file, comp_level, comp_strategy);
+  // Blocks are compressed by write_blocks, so only check that the
+  // parameters are valid and apply them to data not yet compressed.
+  if (! this->is_open () || ! (m_io_mode & std::ios_base::out))
+    return Z_STREAM_ERROR;
+  if (comp_level < Z_DEFAULT_COMPRESSION || comp_level > Z_BEST_COMPRESSION
+      || comp_strategy < Z_DEFAULT_STRATEGY || comp_strategy > Z_FIXED)
+    return Z_STREAM_ERROR;
+
+  m_level = comp_level;
+  m_strategy = comp_strategy;
+
+  return Z_OK;
 }
 
 // Open gzipped file
@@ -104,9 +320,13 @@ gzfilebuf::open (const char *name, std::ios_base::openmode mode)
     return nullptr;
 
   // On success, allocate internal buffer and set flags
-  this->enable_buffer ();
   m_io_mode = mode;
   m_own_fd = true;
+  m_pos = 0;
+  m_written = false;
+  m_pending.clear ();
+  this->size_buffer ();
+  this->enable_buffer ();
   return this;
 }
 
@@ -131,9 +351,13 @@ gzfilebuf::attach (int fd, std::ios_base::openmode mode)
     return nullptr;
 
   // On success, allocate internal buffer and set flags
-  this->enable_buffer ();
   m_io_mode = mode;
   m_own_fd = false;
+  m_pos = 0;
+  m_written = false;
+  m_pending.clear ();
+  this->size_buffer ();
+  this->enable_buffer ();
   return this;
 }
 
@@ -146,9 +370,15 @@ gzfilebuf::close ()
     return nullptr;
   // Assume success
   gzfilebuf *retval = this;
-  // Attempt to sync and close gzipped file
-  if (this->sync () == -1)
+  // Attempt to write pending output and close gzipped file
+  if (! this->write_pending ())
+    retval = nullptr;
+  // Write an empty member so that the file is valid gzip data
+  if ((m_io_mode & std::ios_base::out) && ! m_written
+      && ! this->write_blocks (m_buffer, 0))
     retval = nullptr;
+  delete m_read_ahead;
+  m_read_ahead = nullptr;
   if (gzclose (m_file) < 0)
     retval = nullptr;
   // File is now gone anyway (postcondition [27.8.1.3.8])
@@ -197,6 +427,10 @@ gzfilebuf::open_mode (std::ios_base::openmode mode, char *c_mode) const
 
   strcat (c_mode, "b");
 
+  // Blocks are compressed by write_blocks, so write them unchanged
+  if (testo)
+    strcat (c_mode, "T");
+
   return true;
 }
 
@@ -223,7 +457,7 @@ gzfilebuf::pbackfail (gzfilebuf::int_type c)
 {
   if (this->is_open ())
     {
-      if (gzseek (m_file, this->gptr () - this->egptr () - 1, SEEK_CUR) < 0)
+      if (seek_file (m_pos + (this->gptr () - this->egptr ()) - 1) < 0)
         return traits_type::eof ();
 
       // Invalidates contents of the buffer
@@ -231,7 +465,7 @@ gzfilebuf::pbackfail (gzfilebuf::int_type c)
 
       // Attempt to fill internal buffer from gzipped file
       // (buffer must be guaranteed to exist...)
-      int bytes_read = gzread (m_file, m_buffer, m_buffer_size);
+      int bytes_read = read_file (m_buffer, m_buffer_size);
       // Indicates error or EOF
       if (bytes_read <= 0)
         {
@@ -239,6 +473,7 @@ gzfilebuf::pbackfail (gzfilebuf::int_type c)
           this->setg (m_buffer, m_buffer, m_buffer);
           return traits_type::eof ();
         }
+      m_pos += bytes_read;
 
       // Make all bytes read from file available as get area
       this->setg (m_buffer, m_buffer, m_buffer + bytes_read);
@@ -282,7 +517,7 @@ gzfilebuf::underflow ()
 
   // Attempt to fill internal buffer from gzipped file
   // (buffer must be guaranteed to exist...)
-  int bytes_read = gzread (m_file, m_buffer + stash, m_buffer_size - stash);
+  int bytes_read = read_file (m_buffer + stash, m_buffer_size - stash);
 
   // Indicates error or EOF
   if (bytes_read <= 0)
@@ -291,6 +526,7 @@ gzfilebuf::underflow ()
       this->setg (m_buffer, m_buffer, m_buffer);
       return traits_type::eof ();
     }
+  m_pos += bytes_read;
   // Make all bytes read from file plus the stash available as get area
   this->setg (m_buffer, m_buffer + stash, m_buffer + bytes_read + stash);
 
@@ -314,32 +550,30 @@ gzfilebuf::overflow (int_type c)
           *(this->pptr ()) = traits_type::to_char_type (c);
           this->pbump (1);
         }
-      // Number of characters to write to file
-      int bytes_to_write = this->pptr () - this->pbase ();
-      // Overflow doesn't fail if nothing is to be written
-      if (bytes_to_write > 0)
+      // Only a full buffer is compressed, so that every gzip member
+      // holds a whole block
+      if (this->pptr () >= this->epptr ())
         {
           // If the file hasn't been opened for writing, produce error
           if (! this->is_open () || ! (m_io_mode & std::ios_base::out))
             return traits_type::eof ();
           // If gzipped file won't accept all bytes written to it, fail
-          if (gzwrite (m_file, this->pbase (), bytes_to_write)
-              != bytes_to_write)
+          if (! this->write_pending ())
             return traits_type::eof ();
-          // Reset next pointer to point to pbase on success
-          this->pbump (-bytes_to_write);
         }
     }
-  // Write extra character to file if not EOF
+  // Collect extra character if not EOF
   else if (! traits_type::eq_int_type (c, traits_type::eof ()))
     {
       // If the file hasn't been opened for writing, produce error
       if (! this->is_open () || ! (m_io_mode & std::ios_base::out))
         return traits_type::eof ();
-      // Impromptu char buffer (allows "unbuffered" output)
-      char_type last_char = traits_type::to_char_type (c);
-      // If gzipped file won't accept this character, fail
-      if (gzwrite (m_file, &last_char, 1) != 1)
+      // "Unbuffered" output still collects characters until each
+      // compression thread has a block
+      m_pending.push_back (traits_type::to_char_type (c));
+      if (static_cast<std::streamsize> (m_pending.size ())
+          >= MIN_BLOCK_SIZE * compress_threads ()
+          && ! this->write_pending ())
         return traits_type::eof ();
     }
 
@@ -355,9 +589,12 @@ gzfilebuf::overflow (int_type c)
 std::streambuf *
 gzfilebuf::setbuf (char_type *p, std::streamsize n)
 {
-  // First make sure stuff is sync'ed, for safety
-  if (this->sync () == -1)
-    return nullptr;
+  // Keep the contents of the put area, which is about to be replaced
+  if (this->pbase () && this->pptr () > this->pbase ())
+    {
+      m_pending.append (this->pbase (), this->pptr () - this->pbase ());
+      this->pbump (this->pbase () - this->pptr ());
+    }
   // If buffering is turned off on purpose via setbuf(0,0), still allocate one.
   // "Unbuffered" only really refers to put [27.8.1.4.10], while get needs at
   // least a buffer of size 1 (very inefficient though, therefore make it
@@ -384,12 +621,17 @@ gzfilebuf::setbuf (char_type *p, std::streamsize n)
   return this;
 }
 
-// Write put area to gzipped file (i.e., ensures that put area is empty)
+// Write put area and pending output to gzipped file.  This cuts a
+// shorter gzip member, so overflow only writes full buffers and leaves
+// flushing to explicit requests.
 int
 gzfilebuf::sync ()
 {
-  return traits_type::eq_int_type (this->overflow (),
-                                   traits_type::eof ()) ? -1 : 0;
+  if (this->pbase ()
+      && (this->pptr () > this->epptr () || this->pptr () < this->pbase ()))
+    return -1;
+
+  return this->write_pending () ? 0 : -1;
 }
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
@@ -471,51 +713,168 @@ gzfilebuf::seekoff (off_type off, std::ios_base::seekdir way,
 
   if (this->is_open ())
     {
-      off_type computed_off = off;
-
-      if ((m_io_mode & std::ios_base::in) && way == std::ios_base::cur)
-        computed_off += this->gptr () - this->egptr ();
+      // Current uncompressed position, taking buffer contents into account
+      off_type cur = m_pos;
+      if (m_io_mode & std::ios_base::in)
+        cur += this->gptr () - this->egptr ();
+      else
+        cur += this->pptr () - this->pbase () + m_pending.size ();
 
       // Handle tellg/tellp as a special case up front, no need to seek
       // or invalidate get/put buffers
       if (off == 0 && way == std::ios_base::cur)
-        return pos_type (gztell (m_file) + computed_off);
+        return pos_type (cur);
 
-      if (way == std::ios_base::beg)
-        ret = pos_type (gzseek (m_file, computed_off, SEEK_SET));
-      else if (way == std::ios_base::cur)
-        ret = pos_type (gzseek (m_file, computed_off, SEEK_CUR));
-      else
-        // Can't seek from end of a gzipped file, so this will give -1
-        ret = pos_type (gzseek (m_file, computed_off, SEEK_END));
+      // Can't seek from end of a gzipped file
+      if (way == std::ios_base::end)
+        return ret;
+
+      off_type target = (way == std::ios_base::beg ? off : cur + off);
 
       if (m_io_mode & std::ios_base::in)
-        // Invalidates contents of the buffer
-        enable_buffer ();
-      else
-        // flush contents of buffer to file
-        overflow ();
+        {
+          ret = pos_type (seek_file (target));
+          // Invalidates contents of the buffer
+          enable_buffer ();
+        }
+      else if (target >= cur)
+        {
+          // Like gzseek, fill the gap with zeros.  Seeking backward is
+          // not possible when writing.
+          for (off_type i = cur; i < target; i++)
+            if (traits_type::eq_int_type (this->sputc (0),
+                                          traits_type::eof ()))
+              return ret;
+          ret = pos_type (target);
+        }
     }
 
   return ret;
 }
 
 gzfilebuf::pos_type
-gzfilebuf::seekpos (pos_type sp, std::ios_base::openmode)
+gzfilebuf::seekpos (pos_type sp, std::ios_base::openmode mode)
 {
-  pos_type ret = pos_type (off_type (-1));
+  return seekoff (off_type (sp), std::ios_base::beg, mode);
+}
 
-  if (this->is_open ())
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+// Size internal output buffer so that every thread gets a block
+void
+gzfilebuf::size_buffer ()
+{
+  if (m_own_buffer && ! m_buffer && m_buffer_size > SMALLBUFSIZE
+      && (m_io_mode & std::ios_base::out))
+    m_buffer_size = default_bufsize * compress_threads ();
+}
+
+// Compress blocks in parallel and write them as gzip members
+bool
+gzfilebuf::write_blocks (const char_type *data, std::streamsize n)
+{
+  int nthreads = compress_threads ();
+
+  std::streamsize block_size
+    = std::max<std::streamsize> ((n + nthreads - 1) / nthreads,
+                                 MIN_BLOCK_SIZE);
+
+  // An empty block still produces a (valid, empty) gzip member
+  std::streamsize nblocks = std::max<std::streamsize> ((n + block_size - 1)
+                                                       / block_size, 1);
+
+  std::vector<std::string> out (nblocks);
+  std::vector<int> status (nblocks, Z_OK);
+
+#if defined (HAVE_OPENMP)
+#  pragma omp parallel for num_threads (nthreads) schedule (static)
+#endif
+  for (std::streamsize i = 0; i < nblocks; i++)
     {
-      ret = pos_type (gzseek (m_file, sp, SEEK_SET));
+      std::streamsize offset = i * block_size;
+      std::streamsize len = std::min (block_size, n - offset);
 
-      if (m_io_mode & std::ios_base::in)
-        // Invalidates contents of the buffer
-        enable_buffer ();
-      else
-        // flush contents of buffer to file
-        overflow ();
+      status[i] = compress_block (data + offset, len, m_level, m_strategy,
+                                  out[i]);
+    }
+
+  for (std::streamsize i = 0; i < nblocks; i++)
+    {
+      if (status[i] != Z_OK)
+        return false;
+
+      int len = out[i].size ();
+      if (gzwrite (m_file, out[i].data (), len) != len)
+        return false;
+    }
+
+  m_pos += n;
+  m_written = true;
+
+  return true;
+}
+
+// Write put area and pending output to gzipped file as one block
+bool
+gzfilebuf::write_pending ()
+{
+  if (! this->is_open () || ! (m_io_mode & std::ios_base::out))
+    return true;
+
+  std::streamsize n = (this->pbase () ? this->pptr () - this->pbase () : 0);
+
+  bool ok = true;
+
+  if (! m_pending.empty ())
+    {
+      if (n > 0)
+        m_pending.append (this->pbase (), n);
+      ok = this->write_blocks (m_pending.data (), m_pending.size ());
+      m_pending.clear ();
     }
+  else if (n > 0)
+    ok = this->write_blocks (this->pbase (), n);
+
+  // Reset next pointer to point to pbase
+  if (n > 0)
+    this->pbump (-n);
+
+  return ok;
+}
+
+// Read from gzipped file, decompressing ahead on a background thread
+int
+gzfilebuf::read_file (char_type *buf, unsigned len)
+{
+  if (! m_read_ahead)
+    {
+      try
+        {
+          m_read_ahead
+            = new gz_read_ahead (m_file, std::max<unsigned> (len,
+                                                             MIN_BLOCK_SIZE));
+        }
+      catch (const std::system_error&)
+        {
+          // No thread available, so read synchronously
+          return gzread (m_file, buf, len);
+        }
+    }
+
+  return m_read_ahead->read (buf, len);
+}
+
+// Stop reading ahead and move to uncompressed position POS
+z_off_t
+gzfilebuf::seek_file (z_off_t pos)
+{
+  delete m_read_ahead;
+  m_read_ahead = nullptr;
+
+  z_off_t ret = gzseek (m_file, pos, SEEK_SET);
+
+  if (ret >= 0)
+    m_pos = ret;
 
   return ret;
 }
@@ -41,9 +41,12 @@
 #if defined (HAVE_ZLIB)
 
 #include <iosfwd>
+#include <string>
 
 #include "zlib.h"
 
+class gz_read_ahead;
+
 /**
  *  @brief  Gzipped file stream buffer class.
  *
@@ -51,6 +54,11 @@
  *  support seeking (allowed by zlib but slow/limited), putback and read/write
  *  access *  (tricky).  Otherwise, it attempts to be a drop-in replacement for
  *  the standard file streambuf.
+ *
+ *  Output is split into blocks that are compressed in parallel, each as a
+ *  separate gzip member.  Concatenated members form a valid gzip file.
+ *  Input is decompressed ahead of the reader on a background thread.  The
+ *  buffer size set with setbuf() is the unit of both.
 */
 class gzfilebuf : public std::streambuf
 {
@@ -63,6 +71,14 @@ public:
   //  Destructor.
   virtual ~gzfilebuf ();
 
+  /**
+   *  @brief  Set default size of internal buffers of new stream buffers.
+   *  @param  n  Buffer size in bytes (per thread for output).
+   *  @return  Previous default size.
+  */
+  static std::streamsize
+  default_buffer_size (std::streamsize n);
+
   /**
    *  @brief  Set compression level and strategy on the fly.
    *  @param  comp_level  Compression level (see zlib.h for allowed values)
@@ -147,8 +163,8 @@ protected:
    *  @return  Non-EOF on success, EOF on error.
    *
    *  This actually writes characters in stream buffer to
-   *  gzipped file.  With unbuffered output this is done one
-   *  character at a time.
+   *  gzipped file once the buffer is full.  With unbuffered
+   *  output characters are collected until they fill a block.
   */
   virtual int_type
   overflow (int_type c = traits_type::eof ());
@@ -169,7 +185,9 @@ protected:
    *  @brief  Flush stream buffer to file.
    *  @return  0 on success, -1 on error.
    *
-   *  This calls underflow(EOF) to do the job.
+   *  This writes any pending output as a (possibly short) gzip member.
+   *  Without explicit flushes, members are only cut when the buffer is
+   *  full or the file is closed.
   */
   virtual int
   sync ();
@@ -225,6 +243,45 @@ private:
   void
   disable_buffer ();
 
+  /**
+   *  @brief  Size internal buffer for writing.
+   *
+   *  In write mode, the default buffer holds one block per compression
+   *  thread.
+  */
+  void
+  size_buffer ();
+
+  /**
+   *  @brief  Compress data in parallel and write it to gzipped file.
+   *  @param  data  Uncompressed data.
+   *  @param  n  Number of bytes.
+   *  @return  True on success.
+  */
+  bool
+  write_blocks (const char_type *data, std::streamsize n);
+
+  /**
+   *  @brief  Write put area and pending output to gzipped file.
+   *  @return  True on success.
+  */
+  bool
+  write_pending ();
+
+  /**
+   *  @brief  Read decompressed data, using read-ahead thread if possible.
+   *  @return  Number of bytes read, 0 at EOF, negative on error.
+  */
+  int
+  read_file (char_type *buf, unsigned len);
+
+  /**
+   *  @brief  Stop read-ahead thread and seek to uncompressed position.
+   *  @return  New position or -1 on failure.
+  */
+  z_off_t
+  seek_file (z_off_t pos);
+
   /**
    *  Underlying file pointer.
   */
@@ -266,6 +323,37 @@ private:
    *  upon destruction.
   */
   bool m_own_buffer;
+
+  /**
+   *  Compression level and strategy for written blocks.
+  */
+  int m_level;
+
+  int m_strategy;
+
+  /**
+   *  @brief  Uncompressed file position.
+   *
+   *  Position of end of get area when reading, or start of put area
+   *  when writing.
+  */
+  z_off_t m_pos;
+
+  /**
+   *  True if any block has been written.
+  */
+  bool m_written;
+
+  /**
+   *  Output not yet written, collected with unbuffered output or kept
+   *  when the buffer is replaced.
+  */
+  std::string m_pending;
+
+  /**
+   *  Background decompression for reading, created on first underflow.
+  */
+  gz_read_ahead *m_read_ahead;
 };
 
 /**
@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2024 The Octave Project Developers
+//
+// See the file COPYRIGHT.md in the top-level directory of this
+// distribution or <https://octave.org/copyright/>.
+//
+// This file is part of Octave.
+//
+// Octave is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Octave is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Octave; see the file COPYING.  If not, see
+// <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////
+
+#if ! defined (octave_interp_grid_h)
+#define octave_interp_grid_h 1
+
+#include "octave-config.h"
+
+#include <algorithm>
+
+OCTAVE_BEGIN_NAMESPACE(octave)
+
+// Find the intervals of a strictly increasing grid X[0] < ... < X[N-1]
+// that contain the query points.  Each search starts at the interval of
+// the previous query and gallops from there, so that sorted queries are
+// located by a merge walk over the grid in O(N + M) steps, while
+// unsorted queries still take O(log N) steps each.  Use one locator per
+// thread.
+
+template <typename T>
+class grid_locator
+{
+public:
+
+  grid_locator (const T *x, octave_idx_type n)
+    : m_x (x), m_last (n - 2), m_hint (0)
+  { }
+
+  // Return the index J of the interval with X[J] <= Y < X[J+1], as
+  // lookup (X, Y, "lr") - 1 does.  Points below X[0] give 0, points at
+  // or above X[N-1] give N-2.  The result for NaN is unspecified.
+
+  octave_idx_type operator () (T y)
+  {
+    const T *x = m_x;
+    octave_idx_type j = m_hint;
+
+    if (j < m_last && y >= x[j+1])
+      {
+        // Gallop up.  X[LO] <= Y.
+        octave_idx_type lo = j + 1;
+        octave_idx_type step = 1;
+        while (lo + step <= m_last && x[lo+step] <= y)
+          {
+            lo += step;
+            step *= 2;
+          }
+
+        octave_idx_type hi = std::min (lo + step, m_last + 1);
+        j = std::upper_bound (x + lo + 1, x + hi, y) - x - 1;
+      }
+    else if (j > 0 && y < x[j])
+      {
+        // Gallop down.  Y < X[HI].
+        octave_idx_type hi = j;
+        octave_idx_type step = 1;
+        while (hi - step >= 1 && x[hi-step] > y)
+          {
+            hi -= step;
+            step *= 2;
+          }
+
+        octave_idx_type lo = std::max (hi - step, static_cast<octave_idx_type> (0));
+        j = std::upper_bound (x + lo, x + hi, y) - x - 1;
+        if (j < 0)
+          j = 0;
+      }
+
+    m_hint = j;
+
+    return j;
+  }
+
+private:
+
+  const T *m_x;
+
+  octave_idx_type m_last;
+
+  octave_idx_type m_hint;
+};
+
+OCTAVE_END_NAMESPACE(octave)
+
+#endif
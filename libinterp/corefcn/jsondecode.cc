@@ -27,206 +27,51 @@
 #  include "config.h"
 #endif
 
+#include <istream>
+#include <vector>
+
+#include "quit.h"
+
+#include "Cell.h"
 #include "defun.h"
 #include "error.h"
 #include "errwarn.h"
+#include "interpreter.h"
+#include "oct-map.h"
+#include "oct-stream.h"
 #include "oct-string.h"
 #include "ovl.h"
 #include "utils.h"
 
 #if defined (HAVE_RAPIDJSON)
-#  include <rapidjson/document.h>
 #  include <rapidjson/error/en.h>
+#  include <rapidjson/reader.h>
 #endif
 
 OCTAVE_BEGIN_NAMESPACE(octave)
 
 #if defined (HAVE_RAPIDJSON)
 
-static octave_value
-decode (const rapidjson::Value& val,
-        const octave::make_valid_name_options *options);
-
-//! Decodes a numerical JSON value into a scalar number.
-//!
-//! @param val JSON value that is guaranteed to be a numerical value.
-//!
-//! @return @ref octave_value that contains the numerical value of @p val.
-//!
-//! @b Example:
-//!
-//! @code{.cc}
-//! rapidjson::Document d;
-//! d.Parse ("123");
-//! octave_value num = decode_number (d);
-//! @endcode
-
-static octave_value
-decode_number (const rapidjson::Value& val)
-{
-  if (val.IsUint ())
-    return octave_value (val.GetUint ());
-  else if (val.IsInt ())
-    return octave_value (val.GetInt ());
-  else if (val.IsUint64 ())
-    return octave_value (val.GetUint64 ());
-  else if (val.IsInt64 ())
-    return octave_value (val.GetInt64 ());
-  else if (val.IsDouble ())
-    return octave_value (val.GetDouble ());
-  else
-    error ("jsondecode: unidentified type");
-}
-
-//! Decodes a JSON object into a scalar struct.
-//!
-//! @param val JSON value that is guaranteed to be a JSON object.
-//! @param options @c ReplacementStyle and @c Prefix options with their values.
-//!
-//! @return @ref octave_value that contains the equivalent scalar struct of @p val.
-//!
-//! @b Example:
-//!
-//! @code{.cc}
-//! rapidjson::Document d;
-//! d.Parse ("{\"a\": 1, \"b\": 2}");
-//! octave_value struct = decode_object (d, octave_value_list ());
-//! @endcode
-
-static octave_value
-decode_object (const rapidjson::Value& val,
-               const octave::make_valid_name_options *options)
-{
-  octave_scalar_map retval;
-
-  for (const auto& pair : val.GetObject ())
-    {
-      // Validator function "matlab.lang.makeValidName" to guarantee legitimate
-      // variable name.
-      std::string varname = pair.name.GetString ();
-      if (options != nullptr)
-        octave::make_valid_name (varname, *options);
-      retval.assign (varname, decode (pair.value, options));
-    }
-
-  return retval;
-}
-
-//! Decodes a JSON array that contains only numerical or null values
-//! into an NDArray.
-//!
-//! @param val JSON value that is guaranteed to be a numeric array.
-//!
-//! @return @ref octave_value that contains the equivalent NDArray of @p val.
-//!
-//! @b Example:
-//!
-//! @code{.cc}
-//! rapidjson::Document d;
-//! d.Parse ("[1, 2, 3, 4]");
-//! octave_value numeric_array = decode_numeric_array (d);
-//! @endcode
-
-static octave_value
-decode_numeric_array (const rapidjson::Value& val)
-{
-  NDArray retval (dim_vector (val.Size (), 1));
-  octave_idx_type index = 0;
-  for (const auto& elem : val.GetArray ())
-    retval(index++) = elem.IsNull () ? octave_NaN
-                      : decode_number (elem).double_value ();
-  return retval;
-}
-
-//! Decodes a JSON array that contains only boolean values into a boolNDArray.
-//!
-//! @param val JSON value that is guaranteed to be a boolean array.
-//!
-//! @return @ref octave_value that contains the equivalent boolNDArray of @p val.
-//!
-//! @b Example:
-//!
-//! @code{.cc}
-//! rapidjson::Document d;
-//! d.Parse ("[true, false, true]");
-//! octave_value boolean_array = decode_boolean_array (d);
-//! @endcode
-
-static octave_value
-decode_boolean_array (const rapidjson::Value& val)
-{
-  boolNDArray retval (dim_vector (val.Size (), 1));
-  octave_idx_type index = 0;
-  for (const auto& elem : val.GetArray ())
-    retval(index++) = elem.GetBool ();
-  return retval;
-}
-
-//! Decodes a JSON array that contains different types
-//! or string values only into a Cell.
-//!
-//! @param val JSON value that is guaranteed to be a mixed or string array.
-//! @param options @c ReplacementStyle and @c Prefix options with their values.
-//!
-//! @return @ref octave_value that contains the equivalent Cell of @p val.
-//!
-//! @b Example (decoding a string array):
-//!
-//! @code{.cc}
-//! rapidjson::Document d;
-//! d.Parse ("[\"foo\", \"bar\", \"baz\"]");
-//! octave_value cell = decode_string_and_mixed_array (d, octave_value_list ());
-//! @endcode
-//!
-//! @b Example (decoding a mixed array):
-//!
-//! @code{.cc}
-//! rapidjson::Document d;
-//! d.Parse ("[\"foo\", 123, true]");
-//! octave_value cell = decode_string_and_mixed_array (d, octave_value_list ());
-//! @endcode
-
-static octave_value
-decode_string_and_mixed_array (const rapidjson::Value& val,
-                               const octave::make_valid_name_options *options)
-{
-  Cell retval (dim_vector (val.Size (), 1));
-  octave_idx_type index = 0;
-  for (const auto& elem : val.GetArray ())
-    retval(index++) = decode (elem, options);
-  return retval;
-}
-
 //! Decodes a JSON array that contains only objects into a Cell or struct array
 //! depending on the similarity of the objects' keys.
 //!
-//! @param val JSON value that is guaranteed to be an object array.
-//! @param options @c ReplacementStyle and @c Prefix options with their values.
+//! @param struct_cell Cell of the already decoded objects (scalar structs).
 //!
 //! @return @ref octave_value that contains the equivalent Cell
-//! or struct array of @p val.
+//! or struct array of @p struct_cell.
 //!
 //! @b Example (returns a struct array):
 //!
 //! @code{.cc}
-//! rapidjson::Document d;
-//! d.Parse ("[{\"a\":1,\"b\":2},{\"a\":3,\"b\":4}]");
-//! octave_value object_array = decode_object_array (d, octave_value_list ());
-//! @endcode
-//!
-//! @b Example (returns a Cell):
-//!
-//! @code{.cc}
-//! rapidjson::Document d;
-//! d.Parse ("[{\"a\":1,\"b\":2},{\"b\":3,\"a\":4}]");
-//! octave_value object_array = decode_object_array (d, octave_value_list ());
+//! Cell c (dim_vector (2, 1));
+//! c(0) = jsondecode ("{\"a\":1,\"b\":2}");
+//! c(1) = jsondecode ("{\"a\":3,\"b\":4}");
+//! octave_value object_array = decode_object_array (c);
 //! @endcode
 
 static octave_value
-decode_object_array (const rapidjson::Value& val,
-                     const octave::make_valid_name_options *options)
+decode_object_array (const Cell& struct_cell)
 {
-  Cell struct_cell = decode_string_and_mixed_array (val, options).cell_value ();
   string_vector field_names = struct_cell(0).scalar_map_value ().fieldnames ();
 
   bool same_field_names = true;
@@ -266,35 +111,23 @@ decode_object_array (const rapidjson::Value& val,
 //! Decodes a JSON array that contains only arrays into a Cell or an NDArray
 //! depending on the dimensions and element types of the sub-arrays.
 //!
-//! @param val JSON value that is guaranteed to be an array of arrays.
-//! @param options @c ReplacementStyle and @c Prefix options with their values.
+//! @param cell Cell of the already decoded sub-arrays.
 //!
 //! @return @ref octave_value that contains the equivalent Cell
-//! or NDArray of @p val.
+//! or NDArray of @p cell.
 //!
 //! @b Example (returns an NDArray):
 //!
 //! @code{.cc}
-//! rapidjson::Document d;
-//! d.Parse ("[[1, 2], [3, 4]]");
-//! octave_value array = decode_array_of_arrays (d, octave_value_list ());
-//! @endcode
-//!
-//! @b Example (returns a Cell):
-//!
-//! @code{.cc}
-//! rapidjson::Document d;
-//! d.Parse ("[[1, 2], [3, 4, 5]]");
-//! octave_value cell = decode_array_of_arrays (d, octave_value_list ());
+//! Cell c (dim_vector (2, 1));
+//! c(0) = jsondecode ("[1, 2]");
+//! c(1) = jsondecode ("[3, 4]");
+//! octave_value array = decode_array_of_arrays (c);
 //! @endcode
 
 static octave_value
-decode_array_of_arrays (const rapidjson::Value& val,
-                        const octave::make_valid_name_options *options)
+decode_array_of_arrays (const Cell& cell)
 {
-  // Some arrays should be decoded as NDArrays and others as cell arrays
-  Cell cell = decode_string_and_mixed_array (val, options).cell_value ();
-
   // Only arrays with sub-arrays of booleans and numericals will return NDArray
   bool is_bool = cell(0).is_bool_matrix ();
   bool is_struct = cell(0).isstruct ();
@@ -382,117 +215,513 @@ decode_array_of_arrays (const rapidjson::Value& val,
     }
 }
 
-//! Decodes any type of JSON arrays.  This function only serves as an interface
-//! by choosing which function to call from the previous functions.
+//! SAX handler that builds the decoded Octave value while RapidJSON parses
+//! the JSON text, so no DOM of the whole document is ever held in memory.
 //!
-//! @param val JSON value that is guaranteed to be an array.
-//! @param options @c ReplacementStyle and @c Prefix options with their values.
-//!
-//! @return @ref octave_value that contains the output of decoding @p val.
+//! Every open JSON array or object has a frame on a stack.  Arrays that hold
+//! only numbers and nulls, or only Booleans, are collected directly as
+//! typed columns.  Arrays of objects with identical keys are collected as
+//! one column of values per field.  Other arrays keep their decoded elements
+//! until the array is closed.  The final values are the same as those of
+//! decoding a DOM tree element by element: numbers and nulls become an
+//! NDArray, Booleans a boolNDArray, objects with the same keys a struct
+//! array, arrays of arrays are concatenated if possible, and anything else
+//! becomes a Cell.
 //!
 //! @b Example:
 //!
 //! @code{.cc}
-//! rapidjson::Document d;
-//! d.Parse ("[[1, 2], [3, 4, 5]]");
-//! octave_value array = decode_array (d, octave_value_list ());
+//! json_decoder handler (nullptr);
+//! rapidjson::Reader reader;
+//! rapidjson::StringStream ss ("[1, 2, null]");
+//! reader.Parse (ss, handler);
+//! octave_value array = handler.result ();
 //! @endcode
 
-static octave_value
-decode_array (const rapidjson::Value& val,
-              const octave::make_valid_name_options *options)
+class json_decoder
 {
-  // Handle empty arrays
-  if (val.Empty ())
-    return NDArray ();
-
-  // Compare with other elements to know if the array has multiple types
-  rapidjson::Type array_type = val[0].GetType ();
-  // Check if the array is numeric and if it has multiple types
-  bool same_type = true;
-  bool is_numeric = true;
-  for (const auto& elem : val.GetArray ())
+public:
+
+  json_decoder (const make_valid_name_options *options)
+    : m_options (options), m_stack (), m_result ()
+  { }
+
+  OCTAVE_DISABLE_CONSTRUCT_COPY_MOVE (json_decoder)
+
+  ~json_decoder () = default;
+
+  octave_value result () const { return m_result; }
+
+  // RapidJSON SAX interface.
+
+  bool Null () { return add_number (octave_NaN, true); }
+
+  bool Bool (bool b)
+  {
+    if (in_array ())
+      {
+        frame& f = top ();
+        if (f.m_mode == empty_mode)
+          f.m_mode = bool_mode;
+
+        if (f.m_mode == bool_mode)
+          {
+            f.m_bools.push_back (b);
+            f.note_type (bool_elt);
+            return true;
+          }
+      }
+
+    return add_value (bool_elt, octave_value (b));
+  }
+
+  bool Int (int i) { return add_number (i); }
+
+  bool Uint (unsigned u) { return add_number (u); }
+
+  bool Int64 (int64_t i) { return add_number (i); }
+
+  bool Uint64 (uint64_t u) { return add_number (u); }
+
+  bool Double (double d) { return add_number (d); }
+
+  // Only called with kParseNumbersAsStringsFlag, which is never used.
+  bool RawNumber (const char *, rapidjson::SizeType, bool) { return false; }
+
+  bool String (const char *str, rapidjson::SizeType, bool)
+  {
+    return add_value (string_elt, octave_value (str));
+  }
+
+  bool StartObject ()
+  {
+    m_stack.emplace_back (true);
+    return true;
+  }
+
+  bool Key (const char *str, rapidjson::SizeType, bool)
+  {
+    // Validator function "matlab.lang.makeValidName" to guarantee legitimate
+    // variable name.
+    std::string& varname = top ().m_key;
+    varname = str;
+    if (m_options != nullptr)
+      make_valid_name (varname, *m_options);
+
+    return true;
+  }
+
+  bool EndObject (rapidjson::SizeType)
+  {
+    octave_quit ();
+
+    octave_scalar_map map = std::move (top ().m_map);
+    m_stack.pop_back ();
+
+    return add_object (map);
+  }
+
+  bool StartArray ()
+  {
+    m_stack.emplace_back (false);
+    return true;
+  }
+
+  bool EndArray (rapidjson::SizeType)
+  {
+    octave_quit ();
+
+    octave_value val = top ().finish ();
+    m_stack.pop_back ();
+
+    return add_value (array_elt, val);
+  }
+
+private:
+
+  // Types of JSON values.  RapidJSON's kTrueType and kFalseType are both
+  // represented by bool_elt.
+  enum elt_type
+  {
+    null_elt, bool_elt, number_elt, string_elt, object_elt, array_elt
+  };
+
+  // How the elements of an array are currently stored.
+  enum array_mode
+  {
+    empty_mode, number_mode, bool_mode, struct_mode, value_mode
+  };
+
+  class frame
+  {
+  public:
+
+    frame (bool is_object)
+      : m_is_object (is_object), m_map (), m_key (), m_count (0),
+        m_first_type (null_elt), m_same_type (true), m_mode (empty_mode),
+        m_numbers (), m_nulls (), m_bools (), m_fields (), m_columns (),
+        m_struct_count (0), m_values ()
+    { }
+
+    OCTAVE_DEFAULT_COPY_MOVE_DELETE (frame)
+
+    // Record the type of the next element of an array.
+    void note_type (elt_type type)
     {
-      rapidjson::Type current_elem_type = elem.GetType ();
-      if (is_numeric && ! (current_elem_type == rapidjson::kNullType
-                           || current_elem_type == rapidjson::kNumberType))
-        is_numeric = false;
-      if (same_type && (current_elem_type != array_type))
-        // RapidJSON doesn't have kBoolean Type it has kTrueType and kFalseType
-        if (! ((current_elem_type == rapidjson::kTrueType
-                && array_type == rapidjson::kFalseType)
-               || (current_elem_type == rapidjson::kFalseType
-                   && array_type == rapidjson::kTrueType)))
-          same_type = false;
+      if (m_count == 0)
+        m_first_type = type;
+      else if (m_same_type && type != m_first_type)
+        m_same_type = false;
+
+      m_count++;
     }
 
-  if (is_numeric)
-    return decode_numeric_array (val);
+    // Convert the typed columns into a list of decoded elements.
+    void to_values ()
+    {
+      switch (m_mode)
+        {
+        case number_mode:
+          {
+            m_values.reserve (m_numbers.size ());
+            auto p_null = m_nulls.cbegin ();
+            for (std::size_t i = 0; i < m_numbers.size (); i++)
+              {
+                if (p_null != m_nulls.cend ()
+                    && *p_null == static_cast<octave_idx_type> (i))
+                  {
+                    m_values.push_back (NDArray ());
+                    p_null++;
+                  }
+                else
+                  m_values.push_back (m_numbers[i]);
+              }
+            m_numbers.clear ();
+            m_nulls.clear ();
+          }
+          break;
+
+        case bool_mode:
+          m_values.reserve (m_bools.size ());
+          for (bool b : m_bools)
+            m_values.push_back (b);
+          m_bools.clear ();
+          break;
+
+        case struct_mode:
+          {
+            m_values.reserve (m_struct_count);
+            for (std::size_t k = 0; k < m_struct_count; k++)
+              {
+                octave_scalar_map map;
+                for (octave_idx_type i = 0; i < m_fields.numel (); i++)
+                  map.assign (m_fields(i), m_columns[i][k]);
+                m_values.push_back (map);
+              }
+            m_columns.clear ();
+          }
+          break;
+
+        default:
+          break;
+        }
+
+      m_mode = value_mode;
+    }
 
-  if (same_type && (array_type != rapidjson::kStringType))
+    // Build the decoded value of a complete array.  Typed columns are only
+    // kept while all elements have the same type (numbers and nulls count
+    // as one type), so they can be converted directly.
+    octave_value finish ()
     {
-      if (array_type == rapidjson::kTrueType
-          || array_type == rapidjson::kFalseType)
-        return decode_boolean_array (val);
-      else if (array_type == rapidjson::kObjectType)
-        return decode_object_array (val, options);
-      else if (array_type == rapidjson::kArrayType)
-        return decode_array_of_arrays (val, options);
+      octave_idx_type n = m_count;
+
+      switch (m_mode)
+        {
+        case empty_mode:
+          return NDArray ();
+
+        case number_mode:
+          {
+            NDArray retval (dim_vector (n, 1));
+            std::copy (m_numbers.cbegin (), m_numbers.cend (),
+                       retval.fortran_vec ());
+            return retval;
+          }
+
+        case bool_mode:
+          {
+            boolNDArray retval (dim_vector (n, 1));
+            std::copy (m_bools.cbegin (), m_bools.cend (),
+                       retval.fortran_vec ());
+            return retval;
+          }
+
+        case struct_mode:
+          {
+            octave_map struct_array;
+            const dim_vector& struct_array_dims = dim_vector (n, 1);
+
+            if (m_fields.numel ())
+              {
+                for (octave_idx_type i = 0; i < m_fields.numel (); ++i)
+                  {
+                    Cell value (struct_array_dims);
+                    std::copy (m_columns[i].cbegin (), m_columns[i].cend (),
+                               value.fortran_vec ());
+                    struct_array.assign (m_fields(i), value);
+                  }
+              }
+            else
+              struct_array.resize (struct_array_dims, true);
+
+            return struct_array;
+          }
+
+        default:
+          break;
+        }
+
+      Cell cell (dim_vector (n, 1));
+      std::copy (m_values.cbegin (), m_values.cend (), cell.fortran_vec ());
+
+      if (m_same_type && m_first_type == object_elt)
+        return decode_object_array (cell);
+      else if (m_same_type && m_first_type == array_elt)
+        return decode_array_of_arrays (cell);
       else
-        error ("jsondecode: unidentified type");
+        return cell;
     }
-  else
-    return decode_string_and_mixed_array (val, options);
-}
 
-//! Decodes any JSON value.  This function only serves as an interface
-//! by choosing which function to call from the previous functions.
-//!
-//! @param val JSON value.
-//! @param options @c ReplacementStyle and @c Prefix options with their values.
-//!
-//! @return @ref octave_value that contains the output of decoding @p val.
-//!
-//! @b Example:
-//!
-//! @code{.cc}
-//! rapidjson::Document d;
-//! d.Parse ("[{\"a\":1,\"b\":2},{\"b\":3,\"a\":4}]");
-//! octave_value value = decode (d, octave_value_list ());
-//! @endcode
+    // Object state.
+    bool m_is_object;
+    octave_scalar_map m_map;
+    std::string m_key;
+
+    // Array state.
+    octave_idx_type m_count;
+    elt_type m_first_type;
+    bool m_same_type;
+    array_mode m_mode;
+
+    // Elements of an array of numbers and nulls.  Nulls are stored as NaN
+    // and their positions are recorded in m_nulls.
+    std::vector<double> m_numbers;
+    std::vector<octave_idx_type> m_nulls;
+
+    // Elements of an array of Booleans.
+    std::vector<bool> m_bools;
+
+    // Elements of an array of objects with identical keys, by field.
+    string_vector m_fields;
+    std::vector<std::vector<octave_value>> m_columns;
+    std::size_t m_struct_count;
+
+    // Decoded elements of any other array.
+    std::vector<octave_value> m_values;
+  };
+
+  frame& top () { return m_stack.back (); }
+
+  bool in_array () const
+  {
+    return ! m_stack.empty () && ! m_stack.back ().m_is_object;
+  }
 
+  bool add_number (double d, bool is_null = false)
+  {
+    elt_type type = (is_null ? null_elt : number_elt);
+
+    if (in_array ())
+      {
+        frame& f = top ();
+        if (f.m_mode == empty_mode)
+          f.m_mode = number_mode;
+
+        if (f.m_mode == number_mode)
+          {
+            if (is_null)
+              f.m_nulls.push_back (f.m_numbers.size ());
+            f.m_numbers.push_back (d);
+            f.note_type (type);
+            return true;
+          }
+      }
+
+    return add_value (type, is_null ? octave_value (NDArray ())
+                                    : octave_value (d));
+  }
+
+  bool add_object (const octave_scalar_map& map)
+  {
+    if (in_array ())
+      {
+        frame& f = top ();
+        if (f.m_mode == empty_mode)
+          {
+            f.m_mode = struct_mode;
+            f.m_fields = map.fieldnames ();
+            f.m_columns.resize (f.m_fields.numel ());
+          }
+
+        if (f.m_mode == struct_mode)
+          {
+            string_vector fields = map.fieldnames ();
+            bool same = (fields.numel () == f.m_fields.numel ());
+            for (octave_idx_type i = 0; same && i < fields.numel (); i++)
+              same = (fields(i) == f.m_fields(i));
+
+            if (same)
+              {
+                for (octave_idx_type i = 0; i < fields.numel (); i++)
+                  f.m_columns[i].push_back (map.contents (i));
+                f.m_struct_count++;
+                f.note_type (object_elt);
+                return true;
+              }
+          }
+      }
+
+    return add_value (object_elt, map);
+  }
+
+  // Add a decoded value of type TYPE to the innermost array or object, or
+  // make it the result if it is the top-level value.
+
+  bool add_value (elt_type type, const octave_value& val)
+  {
+    if (m_stack.empty ())
+      m_result = val;
+    else if (top ().m_is_object)
+      top ().m_map.assign (top ().m_key, val);
+    else
+      {
+        frame& f = top ();
+
+        f.to_values ();
+        f.m_values.push_back (val);
+        f.note_type (type);
+      }
+
+    return true;
+  }
+
+  //--------
+
+  const make_valid_name_options *m_options;
+
+  std::vector<frame> m_stack;
+
+  octave_value m_result;
+};
+
+//! RapidJSON input stream that reads a std::istream in large blocks so
+//! that a file can be decoded without first reading all of it into memory.
+
+class json_istream
+{
+public:
+
+  typedef char Ch;
+
+  json_istream (std::istream& is, std::size_t bufsize = 65536)
+    : m_is (is), m_buf (bufsize), m_pos (0), m_len (0), m_count (0)
+  {
+    fill ();
+  }
+
+  OCTAVE_DISABLE_CONSTRUCT_COPY_MOVE (json_istream)
+
+  ~json_istream () = default;
+
+  Ch Peek () const { return m_pos < m_len ? m_buf[m_pos] : '\0'; }
+
+  Ch Take ()
+  {
+    if (m_pos >= m_len)
+      return '\0';
+
+    Ch c = m_buf[m_pos++];
+    m_count++;
+
+    if (m_pos == m_len)
+      fill ();
+
+    return c;
+  }
+
+  std::size_t Tell () const { return m_count; }
+
+  // The remaining functions are only needed for in situ parsing.
+
+  Ch * PutBegin () { return nullptr; }
+
+  void Put (Ch) { }
+
+  void Flush () { }
+
+  std::size_t PutEnd (Ch *) { return 0; }
+
+private:
+
+  void fill ()
+  {
+    m_pos = 0;
+    m_len = 0;
+
+    if (m_is)
+      {
+        m_is.read (m_buf.data (), m_buf.size ());
+        m_len = m_is.gcount ();
+      }
+  }
+
+  std::istream& m_is;
+
+  std::vector<Ch> m_buf;
+
+  std::size_t m_pos;
+
+  std::size_t m_len;
+
+  std::size_t m_count;
+};
+
+//! Parse JSON text from the RapidJSON input stream @p is and decode it.
+
+template <typename STREAM>
 static octave_value
-decode (const rapidjson::Value& val,
-        const octave::make_valid_name_options *options)
+decode (STREAM& is, const make_valid_name_options *options)
 {
-  if (val.IsBool ())
-    return val.GetBool ();
-  else if (val.IsNumber ())
-    return decode_number (val);
-  else if (val.IsString ())
-    return val.GetString ();
-  else if (val.IsObject ())
-    return decode_object (val, options);
-  else if (val.IsNull ())
-    return NDArray ();
-  else if (val.IsArray ())
-    return decode_array (val, options);
-  else
-    error ("jsondecode: unidentified type");
+  json_decoder handler (options);
+  rapidjson::Reader reader;
+
+  reader.Parse<rapidjson::kParseNanAndInfFlag> (is, handler);
+
+  if (reader.HasParseError ())
+    error ("jsondecode: parse error at offset %u: %s\n",
+           static_cast<unsigned int> (reader.GetErrorOffset ()) + 1,
+           rapidjson::GetParseError_En (reader.GetParseErrorCode ()));
+
+  return handler.result ();
 }
 
 #endif
 
-DEFUN (jsondecode, args, ,
-       doc: /* -*- texinfo -*-
+DEFMETHOD (jsondecode, interp, args, ,
+           doc: /* -*- texinfo -*-
 @deftypefn  {} {@var{object} =} jsondecode (@var{JSON_txt})
+@deftypefnx {} {@var{object} =} jsondecode (@var{fid})
 @deftypefnx {} {@var{object} =} jsondecode (@dots{}, "ReplacementStyle", @var{rs})
 @deftypefnx {} {@var{object} =} jsondecode (@dots{}, "Prefix", @var{pfx})
 @deftypefnx {} {@var{object} =} jsondecode (@dots{}, "makeValidName", @var{TF})
 
 Decode text that is formatted in JSON.
 
-The input @var{JSON_txt} is a string that contains JSON text.
+The input @var{JSON_txt} is a string that contains JSON text.  Alternatively,
+the JSON text may be read from the file identified by @var{fid}, which must be
+open for reading.  The file is parsed incrementally from its current position
+to the end, so it never needs to be held in memory as a whole.
 
 The output @var{object} is an Octave object that contains the result of
 decoding @var{JSON_txt}.
@@ -614,27 +843,36 @@ jsondecode ('@{"1": "one", "2": "two"@}', 'Prefix', 'm_')
 
   unwind_action del_opts ([options] () { if (options) delete options; });
 
-  if (! args(0).is_string ())
-    error ("jsondecode: JSON_TXT must be a character string");
+  if (args(0).is_string ())
+    {
+      std::string json = args(0).string_value ();
+      rapidjson::StringStream ss (json.c_str ());
 
-  std::string json = args(0).string_value ();
-  rapidjson::Document d;
-  // DOM is chosen instead of SAX as SAX publishes events to a handler that
-  // decides what to do depending on the event only.  This will cause a
-  // problem in decoding JSON arrays as the output may be an array or a cell
-  // and that doesn't only depend on the event (startArray) but also on the
-  // types of the elements inside the array.
-  d.Parse <rapidjson::kParseNanAndInfFlag> (json.c_str ());
+      return decode (ss, options);
+    }
 
-  if (d.HasParseError ())
-    error ("jsondecode: parse error at offset %u: %s\n",
-           static_cast<unsigned int> (d.GetErrorOffset ()) + 1,
-           rapidjson::GetParseError_En (d.GetParseError ()));
+  std::istream *isp = nullptr;
 
-  return decode (d, options);
+  if (args(0).is_real_scalar ())
+    {
+      stream_list& streams = interp.get_stream_list ();
+
+      stream os = streams.lookup (args(0), "jsondecode");
+
+      isp = os.input_stream ();
+    }
+
+  if (! isp)
+    error ("jsondecode: JSON_TXT must be a character string or "
+           "a file id open for reading");
+
+  json_istream is (*isp);
+
+  return decode (is, options);
 
 #else
 
+  octave_unused_parameter (interp);
   octave_unused_parameter (args);
 
   err_disabled_feature ("jsondecode", "JSON decoding through RapidJSON");
@@ -651,6 +889,20 @@ Functional BIST tests are located in test/json/jsondecode_BIST.tst
 %! fail ("jsondecode ('1', 2)");
 %! fail ("jsondecode (1)", "JSON_TXT must be a character string");
 %! fail ("jsondecode ('12-')", "parse error at offset 3");
+%! fail ("jsondecode ({'1'})", "JSON_TXT must be a character string");
+
+## Decode from a file
+%!testif HAVE_RAPIDJSON
+%! f = tempname ();
+%! fid = fopen (f, "w+");
+%! fputs (fid, '{"a": [1, 2, null], "b": [{"c": true}, {"c": false}]}');
+%! frewind (fid);
+%! obj = jsondecode (fid);
+%! fclose (fid);
+%! unlink (f);
+%! assert (obj.a, [1; 2; NaN]);
+%! assert (size (obj.b), [2, 1]);
+%! assert ({obj.b.c}, {true, false});
 
 */
 
@@ -27,6 +27,8 @@
 #  include "config.h"
 #endif
 
+#include <algorithm>
+
 #include "builtin-defun-decls.h"
 #include "defun.h"
 #include "error.h"
@@ -44,6 +46,35 @@
 
 #if defined (HAVE_RAPIDJSON)
 
+//! Encodes a double precision number into a numerical JSON value.
+//!
+//! @param writer RapidJSON's writer that is responsible for generating JSON.
+//! @param value number to encode.
+//! @param ConvertInfAndNaN @c bool that converts @c Inf and @c NaN to @c null.
+//!
+//! @b Example:
+//!
+//! @code{.cc}
+//! encode_double (writer, 7.5, true);
+//! @endcode
+
+template <typename T> void
+encode_double (T& writer, double value, const bool& ConvertInfAndNaN)
+{
+  // Detect floating point numbers which are actually integers by checking
+  // whether the number and the integer portion of the number are the same
+  // to within eps.
+  // FIXME: If value > 999999, MATLAB will encode it in scientific
+  // notation, but rapidJSON will output all digits.
+  if (fabs (trunc (value) - value) < std::numeric_limits<double>::epsilon ())
+    writer.Int64 (value);
+  // Possibly write NULL for non-finite values (-Inf, Inf, NaN, NA)
+  else if (ConvertInfAndNaN && ! octave::math::isfinite (value))
+    writer.Null ();
+  else
+    writer.Double (value);
+}
+
 //! Encodes a scalar Octave value into a numerical JSON value.
 //!
 //! @param writer RapidJSON's writer that is responsible for generating JSON.
@@ -62,23 +93,7 @@ encode_numeric (T& writer, const octave_value& obj,
                 const bool& ConvertInfAndNaN)
 {
   if (obj.isfloat ())
-    {
-      double value = obj.scalar_value ();
-
-      // Detect floating point numbers which are actually integers by checking
-      // whether the number and the integer portion of the number are the same
-      // to within eps.
-      // FIXME: If value > 999999, MATLAB will encode it in scientific
-      // notation, but rapidJSON will output all digits.
-      if (fabs (trunc (value) - value) < std::numeric_limits<double>::epsilon ())
-
-        writer.Int64 (value);
-      // Possibly write NULL for non-finite values (-Inf, Inf, NaN, NA)
-      else if (ConvertInfAndNaN && ! octave::math::isfinite (value))
-        writer.Null ();
-      else
-        writer.Double (value);
-    }
+    encode_double (writer, obj.scalar_value (), ConvertInfAndNaN);
   else if (obj.isinteger ())
     {
        if (obj.is_uint64_type ())
@@ -318,14 +333,18 @@ encode_array (T& writer, const octave_value& obj, const bool& ConvertInfAndNaN,
     }
   else if (array.isvector ())
     {
+      // Write the elements directly instead of creating a temporary
+      // octave_value for each of them.
+      const double *data = array.data ();
+      octave_idx_type n = array.numel ();
+
       writer.StartArray ();
-      for (octave_idx_type i = 0; i < array.numel (); ++i)
-        {
-          if (is_logical)
-            encode_numeric (writer, bool (array(i)), ConvertInfAndNaN);
-          else
-            encode_numeric (writer, array(i), ConvertInfAndNaN);
-        }
+      if (is_logical)
+        for (octave_idx_type i = 0; i < n; ++i)
+          writer.Bool (data[i] != 0);
+      else
+        for (octave_idx_type i = 0; i < n; ++i)
+          encode_double (writer, data[i], ConvertInfAndNaN);
       writer.EndArray ();
     }
   else
@@ -640,7 +659,13 @@ jsonencode (containers.Map(@{'foo'; 'bar'; 'baz'@}, [1, 2, 3]))
     }
 # endif
 
-  rapidjson::StringBuffer json;
+  // Reserve space for the output up front.  The JSON text is rarely
+  // shorter than the data it encodes, so this avoids repeatedly growing
+  // and copying the buffer for large arrays.
+  std::size_t capacity = std::max (static_cast<std::size_t> (256),
+                                   static_cast<std::size_t>
+                                   (args(0).byte_size ()));
+  rapidjson::StringBuffer json (nullptr, capacity);
   if (PrettyPrint)
     {
 # if defined (HAVE_RAPIDJSON_PRETTYWRITER)
@@ -659,7 +684,7 @@ jsonencode (containers.Map(@{'foo'; 'bar'; 'baz'@}, [1, 2, 3]))
       encode (writer, args(0), ConvertInfAndNaN);
     }
 
-  return octave_value (json.GetString ());
+  return octave_value (std::string (json.GetString (), json.GetSize ()));
 
 #else
 
@@ -91,6 +91,10 @@
 #  include "gzfstream.h"
 #endif
 
+#if defined (HAVE_ZSTD)
+#  include "zstdfstream.h"
+#endif
+
 OCTAVE_BEGIN_NAMESPACE(octave)
 
 OCTAVE_NORETURN static
@@ -180,6 +184,41 @@ check_gzip_magic (const std::string& fname)
 }
 #endif
 
+#if defined (HAVE_ZSTD)
+static bool
+check_zstd_magic (const std::string& fname)
+{
+  bool retval = false;
+
+  std::ifstream file = sys::ifstream (fname.c_str (),
+                                      std::ios::in | std::ios::binary);
+
+  unsigned char magic[4];
+  if (file.read (reinterpret_cast<char *> (&magic[0]), 4)
+      && magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f
+      && magic[3] == 0xfd)
+    retval = true;
+
+  file.close ();
+
+  return retval;
+}
+
+// Close FILE and report any error libzstd found while decompressing it.
+
+static void
+close_zstd_file (zstdifstream& file, const std::string& fname)
+{
+  std::string zstd_error = file.rdbuf ()->error_message ();
+
+  file.close ();
+
+  if (! zstd_error.empty ())
+    error ("load: failed to decompress '%s': %s", fname.c_str (),
+           zstd_error.c_str ());
+}
+#endif
+
 static std::string
 find_file_to_load (const std::string& name, const std::string& orig_name)
 {
@@ -324,6 +363,21 @@ load_save_format
 load_save_system::get_file_format (const std::string& fname,
                                    const std::string& orig_fname,
                                    bool& use_zlib, bool quiet)
+{
+  compression_type compression = NO_COMPRESSION;
+
+  load_save_format retval = get_file_format (fname, orig_fname, compression,
+                                             quiet);
+
+  use_zlib = (compression == GZIP);
+
+  return retval;
+}
+
+load_save_format
+load_save_system::get_file_format (const std::string& fname,
+                                   const std::string& orig_fname,
+                                   compression_type& compression, bool quiet)
 {
   load_save_format retval = UNKNOWN;
 
@@ -339,13 +393,19 @@ load_save_system::get_file_format (const std::string& fname,
     return HDF5;
 #endif
 
+  compression = NO_COMPRESSION;
+
 #if defined (HAVE_ZLIB)
-  use_zlib = check_gzip_magic (fname);
-#else
-  use_zlib = false;
+  if (check_gzip_magic (fname))
+    compression = GZIP;
+#endif
+
+#if defined (HAVE_ZSTD)
+  if (check_zstd_magic (fname))
+    compression = ZSTD;
 #endif
 
-  if (! use_zlib)
+  if (compression == NO_COMPRESSION)
     {
       std::ifstream file = sys::ifstream (fname.c_str (),
                                           std::ios::in | std::ios::binary);
@@ -358,7 +418,7 @@ load_save_system::get_file_format (const std::string& fname,
         err_file_open ("load", orig_fname);
     }
 #if defined (HAVE_ZLIB)
-  else
+  else if (compression == GZIP)
     {
       gzifstream gzfile (fname.c_str (), std::ios::in | std::ios::binary);
       if (gzfile)
@@ -370,6 +430,19 @@ load_save_system::get_file_format (const std::string& fname,
         err_file_open ("load", orig_fname);
     }
 #endif
+#if defined (HAVE_ZSTD)
+  else if (compression == ZSTD)
+    {
+      zstdifstream zstdfile (fname.c_str (), std::ios::in | std::ios::binary);
+      if (zstdfile)
+        {
+          retval = get_file_format (zstdfile, orig_fname);
+          close_zstd_file (zstdfile, orig_fname);
+        }
+      else if (! quiet)
+        err_file_open ("load", orig_fname);
+    }
+#endif
 
   return retval;
 }
@@ -530,10 +603,23 @@ load_save_system::parse_save_options (const string_vector& argv,
                                       load_save_format& fmt, bool& append,
                                       bool& save_as_floats, bool& use_zlib)
 {
-#if ! defined (HAVE_ZLIB)
-  octave_unused_parameter (use_zlib);
-#endif
+  compression_type compression = (use_zlib ? GZIP : NO_COMPRESSION);
+
+  string_vector retval = parse_save_options (argv, fmt, append,
+                                             save_as_floats, compression);
+
+  // Callers of this interface only know about gzip compression.
+  use_zlib = (compression != NO_COMPRESSION);
 
+  return retval;
+}
+
+string_vector
+load_save_system::parse_save_options (const string_vector& argv,
+                                      load_save_format& fmt, bool& append,
+                                      bool& save_as_floats,
+                                      compression_type& compression)
+{
   string_vector retval;
   int argc = argv.numel ();
 
@@ -613,9 +699,17 @@ load_save_system::parse_save_options (const string_vector& argv,
 #if defined (HAVE_ZLIB)
       else if (argv[i] == "-zip" || argv[i] == "-z")
         {
-          use_zlib = true;
+          compression = GZIP;
         }
 #endif
+      else if (argv[i] == "-zstd")
+        {
+#if defined (HAVE_ZSTD)
+          compression = ZSTD;
+#else
+          err_disabled_feature ("save", "Zstandard compression");
+#endif
+        }
       else if (argv[i] == "-struct")
         {
           retval.append (argv[i]);
@@ -644,9 +738,10 @@ load_save_system::parse_save_options (const string_vector& argv,
         warning (R"(save: "-tabs" option only has an effect with "-ascii")");
     }
 
-  if (append && use_zlib
+  if (append && compression != NO_COMPRESSION
       && (fmt.type () != TEXT && fmt.type () != MAT_ASCII))
-    error ("save: -append and -zip options can only be used together with a text format (-text or -ascii)");
+    error ("save: -append and %s options can only be used together with a text format (-text or -ascii)",
+           compression == ZSTD ? "-zstd" : "-zip");
 
   return retval;
 }
@@ -656,6 +751,23 @@ load_save_system::parse_save_options (const std::string& arg,
                                       load_save_format& fmt,
                                       bool& append, bool& save_as_floats,
                                       bool& use_zlib)
+{
+  compression_type compression = (use_zlib ? GZIP : NO_COMPRESSION);
+
+  string_vector retval = parse_save_options (arg, fmt, append,
+                                             save_as_floats, compression);
+
+  // Callers of this interface only know about gzip compression.
+  use_zlib = (compression != NO_COMPRESSION);
+
+  return retval;
+}
+
+string_vector
+load_save_system::parse_save_options (const std::string& arg,
+                                      load_save_format& fmt,
+                                      bool& append, bool& save_as_floats,
+                                      compression_type& compression)
 {
   std::istringstream is (arg);
   std::string str;
@@ -667,7 +779,7 @@ load_save_system::parse_save_options (const std::string& arg,
       argv.append (str);
     }
 
-  return parse_save_options (argv, fmt, append, save_as_floats, use_zlib);
+  return parse_save_options (argv, fmt, append, save_as_floats, compression);
 }
 
 void
@@ -747,17 +859,17 @@ load_save_system::dump_octave_core ()
 
       bool append = false;
 
-      bool use_zlib = false;
+      compression_type compression = NO_COMPRESSION;
 
       load_save_system::parse_save_options (m_octave_core_file_options,
                                             fmt, append, save_as_floats,
-                                            use_zlib);
+                                            compression);
 
       std::ios::openmode mode = std::ios::out;
 
       // Matlab v7 files are always compressed
       if (fmt.type () == MAT7_BINARY)
-        use_zlib = false;
+        compression = NO_COMPRESSION;
 
       if (fmt.type () == BINARY
 #if defined (HAVE_HDF5)
@@ -791,7 +903,7 @@ load_save_system::dump_octave_core ()
         // go with the else above!
         {
 #if defined (HAVE_ZLIB)
-          if (use_zlib)
+          if (compression == GZIP)
             {
               gzofstream file (fname, mode);
 
@@ -807,6 +919,23 @@ load_save_system::dump_octave_core ()
             }
           else
 #endif
+#if defined (HAVE_ZSTD)
+          if (compression == ZSTD)
+            {
+              zstdofstream file (fname, mode);
+
+              if (file)
+                {
+                  dump_octave_core (file, fname, fmt, save_as_floats);
+
+                  file.close ();
+                }
+              else
+                warning ("dump_octave_core: unable to open '%s' for writing...",
+                         fname);
+            }
+          else
+#endif
             {
               std::ofstream file = sys::ofstream (fname, mode);
 
@@ -1297,10 +1426,10 @@ load_save_system::load (const octave_value_list& args, int nargout)
 
       fname = find_file_to_load (fname, orig_fname);
 
-      bool use_zlib = false;
+      compression_type compression = NO_COMPRESSION;
 
       if (format.type () == UNKNOWN)
-        format = get_file_format (fname, orig_fname, use_zlib);
+        format = get_file_format (fname, orig_fname, compression);
 
 #if defined (HAVE_HDF5)
       if (format.type () == HDF5)
@@ -1331,7 +1460,7 @@ load_save_system::load (const octave_value_list& args, int nargout)
             std::ios::openmode mode = std::ios::in | std::ios::binary;
 
 #if defined (HAVE_ZLIB)
-            if (use_zlib)
+            if (compression == GZIP)
               {
                 gzifstream file (fname.c_str (), mode);
 
@@ -1364,6 +1493,51 @@ load_save_system::load (const octave_value_list& args, int nargout)
                 file.close ();
               }
             else
+#endif
+#if defined (HAVE_ZSTD)
+            if (compression == ZSTD)
+              {
+                zstdifstream file (fname.c_str (), mode);
+
+                if (! file)
+                  err_file_open ("load", orig_fname);
+
+                if (format.type () == BINARY)
+                  {
+                    if (read_binary_file_header (file, swap, flt_fmt) < 0)
+                      {
+                        close_zstd_file (file, orig_fname);
+                        return retval;
+                      }
+                  }
+                else if (format.type () == MAT5_BINARY
+                         || format.type () == MAT7_BINARY)
+                  {
+                    if (read_mat5_binary_file_header (file, swap, false,
+                                                      orig_fname) < 0)
+                      {
+                        close_zstd_file (file, orig_fname);
+                        return retval;
+                      }
+                  }
+
+                try
+                  {
+                    retval = load_vars (file, orig_fname, format, flt_fmt,
+                                        list_only, swap, verbose, argv, i,
+                                        argc, nargout);
+                  }
+                catch (const execution_exception&)
+                  {
+                    // A failed read is better explained by the
+                    // decompression error that caused it.
+                    close_zstd_file (file, orig_fname);
+                    throw;
+                  }
+
+                close_zstd_file (file, orig_fname);
+              }
+            else
 #endif
               {
                 std::ifstream file = sys::ifstream (fname.c_str (), mode);
@@ -1415,17 +1589,18 @@ load_save_system::save (const octave_value_list& args, int nargout)
   load_save_format format = TEXT;
   bool save_as_floats = false;
   bool append = false;
-  bool use_zlib = false;
+  compression_type compression = NO_COMPRESSION;
 
 
   // get default options
   parse_save_options (save_default_options (), format, append,
-                      save_as_floats, use_zlib);
+                      save_as_floats, compression);
 
   // override from command line
   string_vector argv = args.make_argv ();
 
-  argv = parse_save_options (argv, format, append, save_as_floats, use_zlib);
+  argv = parse_save_options (argv, format, append, save_as_floats,
+                             compression);
 
   int argc = argv.numel ();
   int i = 0;
@@ -1487,7 +1662,7 @@ load_save_system::save (const octave_value_list& args, int nargout)
 
       // Matlab v7 files are always compressed
       if (format.type () == MAT7_BINARY)
-        use_zlib = false;
+        compression = NO_COMPRESSION;
 
       std::ios::openmode mode
         = (append ? (std::ios::app | std::ios::ate) : std::ios::out);
@@ -1528,7 +1703,7 @@ load_save_system::save (const octave_value_list& args, int nargout)
         // with the "else" above!
         {
 #if defined (HAVE_ZLIB)
-          if (use_zlib)
+          if (compression == GZIP)
             {
               gzofstream file (fname.c_str (), mode);
 
@@ -1544,6 +1719,23 @@ load_save_system::save (const octave_value_list& args, int nargout)
             }
           else
 #endif
+#if defined (HAVE_ZSTD)
+          if (compression == ZSTD)
+            {
+              zstdofstream file (fname.c_str (), mode);
+
+              if (! file)
+                err_file_open ("save", fname);
+
+              bool write_header_info = ! file.tellp ();
+
+              save_vars (argv, i, argc, file, format, save_as_floats,
+                         write_header_info);
+
+              file.close ();
+            }
+          else
+#endif
             {
               std::ofstream file = sys::ofstream (fname.c_str (), mode);
 
@@ -1804,7 +1996,14 @@ Save the data in @sc{matlab}'s v4 binary data format.
 Use the gzip algorithm to compress the file.  This works on files that are
 compressed with gzip outside of Octave, and gzip can also be used to convert
 the files for backward compatibility.  This option is only available if Octave
-was built with a link to the zlib libraries.
+was built with a link to the zlib libraries.  Compressed blocks are written
+in parallel when Octave was built with OpenMP.
+
+@item -zstd
+Use the Zstandard algorithm to compress the file.  Compression uses multiple
+threads and is usually faster than gzip for a similar file size.  Files are
+recognized as Zstandard compressed by @code{load} automatically.  This option
+is only available if Octave was built with a link to the zstd libraries.
 @end table
 
 The list of variables to save may use wildcard patterns (glob patterns)
@@ -1948,6 +2147,73 @@ dlmread, csvread, fread}
 %! x = 1;
 %! fail ('save ("-append", "-zip", "-binary", fname, "x")',
 %!       "-append and -zip options .* with a text format");
+
+## Save and load compressed binary files
+%!testif HAVE_ZLIB
+%! x = x2 = reshape (1:3e5, 600, 500);
+%! s = s2 = repmat ("compressed data ", 1, 1e4);
+%! fname = tempname ();
+%! unwind_protect
+%!   save ("-binary", "-zip", fname, "x", "s");
+%!   clear ("x", "s");
+%!   load (fname);
+%! unwind_protect_cleanup
+%!   unlink (fname);
+%! end_unwind_protect
+%! assert (x, x2);
+%! assert (s, s2);
+
+%!testif HAVE_ZSTD
+%! x = x2 = reshape (1:3e5, 600, 500);
+%! s = s2 = repmat ("compressed data ", 1, 1e4);
+%! fname = tempname ();
+%! unwind_protect
+%!   save ("-binary", "-zstd", fname, "x", "s");
+%!   clear ("x", "s");
+%!   fid = fopen (fname);
+%!   magic = fread (fid, 4, "uint8=>uint8")';
+%!   fclose (fid);
+%!   load (fname);
+%! unwind_protect_cleanup
+%!   unlink (fname);
+%! end_unwind_protect
+%! assert (magic, uint8 ([0x28, 0xB5, 0x2F, 0xFD]));
+%! assert (x, x2);
+%! assert (s, s2);
+
+%!testif HAVE_ZSTD
+%! x = x2 = magic (4);
+%! fname = tempname ();
+%! unwind_protect
+%!   save ("-text", "-zstd", fname, "x");
+%!   clear ("x");
+%!   load (fname);
+%! unwind_protect_cleanup
+%!   unlink (fname);
+%! end_unwind_protect
+%! assert (x, x2);
+
+%!testif HAVE_ZSTD
+%! x = reshape (1:3e5, 600, 500);
+%! fname = tempname ();
+%! unwind_protect
+%!   save ("-binary", "-zstd", fname, "x");
+%!   fid = fopen (fname);
+%!   data = fread (fid, Inf, "uint8=>uint8");
+%!   fclose (fid);
+%!   fid = fopen (fname, "w");
+%!   fwrite (fid, data(1:floor (end/2)));
+%!   fclose (fid);
+%!   fail ("load (fname)", "truncated zstd frame");
+%! unwind_protect_cleanup
+%!   unlink (fname);
+%! end_unwind_protect
+
+%!testif HAVE_ZSTD
+%! fname = tempname ();
+%! x = 1;
+%! fail ('save ("-append", "-zstd", "-binary", fname, "x")',
+%!       "-append and -zstd options .* with a text format");
 */
 
 DEFMETHOD (crash_dumps_octave_core, interp, args, nargout,
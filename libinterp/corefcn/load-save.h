@@ -61,6 +61,13 @@ public:
     UNKNOWN
   };
 
+  enum compression_type
+  {
+    NO_COMPRESSION,
+    GZIP,
+    ZSTD
+  };
+
   enum format_options
   {
     // MAT_ASCII options (not exclusive)
@@ -161,6 +168,10 @@ public:
   get_file_format (const std::string& fname, const std::string& orig_fname,
                    bool& use_zlib, bool quiet = false);
 
+  static OCTINTERP_API load_save_format
+  get_file_format (const std::string& fname, const std::string& orig_fname,
+                   compression_type& compression, bool quiet = false);
+
   // FIXME: this is probably not the best public interface for
   // loading and saving variables, but it is what is currently
   // needed for the Fload and Fsave functions.
@@ -175,10 +186,20 @@ public:
   parse_save_options (const string_vector& argv, load_save_format& fmt,
                       bool& append, bool& save_as_floats, bool& use_zlib);
 
+  static OCTINTERP_API string_vector
+  parse_save_options (const string_vector& argv, load_save_format& fmt,
+                      bool& append, bool& save_as_floats,
+                      compression_type& compression);
+
   static OCTINTERP_API string_vector
   parse_save_options (const std::string& arg, load_save_format& fmt,
                       bool& append, bool& save_as_floats, bool& use_zlib);
 
+  static OCTINTERP_API string_vector
+  parse_save_options (const std::string& arg, load_save_format& fmt,
+                      bool& append, bool& save_as_floats,
+                      compression_type& compression);
+
   OCTINTERP_API void
   save_vars (const string_vector& argv, int argv_idx, int argc,
              std::ostream& os, const load_save_format& fmt,
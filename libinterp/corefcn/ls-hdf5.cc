@@ -69,6 +69,7 @@
 #include "version.h"
 #include "dMatrix.h"
 #include "ov-lazy-idx.h"
+#include "ov-packed-cellstr.h"
 
 #include "ls-utils.h"
 #include "ls-hdf5.h"
@@ -1424,7 +1425,8 @@ add_hdf5_data (octave_hdf5_id loc_id, const octave_value& tc,
   // themselves, so we convert them first to normal matrices using A = A(:,:).
   // This is a temporary hack.
   if (val.is_diag_matrix () || val.is_perm_matrix ()
-      || val.type_id () == octave_lazy_index::static_type_id ())
+      || val.type_id () == octave_lazy_index::static_type_id ()
+      || val.type_id () == octave_packed_cellstr::static_type_id ())
     val = val.full_value ();
 
   std::string t = val.type_name ();
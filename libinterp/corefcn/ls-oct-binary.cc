@@ -50,6 +50,7 @@
 #include "ls-oct-binary.h"
 #include "ls-utils.h"
 #include "ov-cell.h"
+#include "ov-packed-cellstr.h"
 #include "ov.h"
 #include "pager.h"
 #include "sysdep.h"
@@ -360,16 +361,20 @@ save_binary_data (std::ostream& os, const octave_value& tc,
   tmp = 255;
   os.write (reinterpret_cast<char *> (&tmp), 1);
 
+  // The octave_value of tc is const.  Make a copy...
+  octave_value val = tc;
+
+  // Packed cell arrays of strings are saved as cell arrays.
+  if (val.type_id () == octave_packed_cellstr::static_type_id ())
+    val = val.full_value ();
+
   // Write the string corresponding to the octave_value type
-  std::string typ = tc.type_name ();
+  std::string typ = val.type_name ();
   int32_t len = typ.length ();
   os.write (reinterpret_cast<char *> (&len), 4);
   const char *btmp = typ.data ();
   os.write (btmp, len);
 
-  // The octave_value of tc is const.  Make a copy...
-  octave_value val = tc;
-
   // Call specific save function
   bool success = val.save_binary (os, save_as_floats);
 
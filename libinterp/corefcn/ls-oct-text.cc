@@ -60,6 +60,7 @@
 #include "ovl.h"
 #include "oct-map.h"
 #include "ov-cell.h"
+#include "ov-packed-cellstr.h"
 #include "pager.h"
 #include "unwind-prot.h"
 #include "utils.h"
@@ -367,6 +368,10 @@ save_text_data (std::ostream& os, const octave_value& val_arg,
 
   octave_value val = val_arg;
 
+  // Packed cell arrays of strings are saved as cell arrays.
+  if (val.type_id () == octave_packed_cellstr::static_type_id ())
+    val = val.full_value ();
+
   if (mark_global)
     os << "# type: global " << val.type_name () << "\n";
   else
@@ -576,6 +576,35 @@ LU@tie{}factorization.  Once the matrix has been factorized,
 %!test
 %! a = matrix_type (ones (10,10), "Singular");
 %! assert (matrix_type (a), "Singular");
+
+## Large matrices that may be probed by several threads
+%!test
+%! a = triu (rand (1000)) + 1000 * eye (1000);
+%! assert (matrix_type (a), "Upper");
+%! assert (matrix_type (a.'), "Lower");
+%! assert (matrix_type (a + a.'), "Positive Definite");
+%! a(1000,1) = 1;
+%! assert (matrix_type (a), "Full");
+%!test
+%! bnd = spparms ("bandden");
+%! spparms ("bandden", 0.5);
+%! n = 1e5;
+%! e = ones (n, 1);
+%! a = spdiags ([-e, 4*e, -e], [-1, 0, 1], n, n);
+%! assert (matrix_type (a), "Tridiagonal Positive Definite");
+%! a(n,n-1) = 2;
+%! assert (matrix_type (a), "Tridiagonal");
+%! a(n,n) = 0;
+%! assert (matrix_type (a), "Full");
+%! spparms ("bandden", bnd);
+
+## The cached type is kept by the transpose
+%!test
+%! a = matrix_type (triu (ones (10,10)), "Upper");
+%! assert (matrix_type (a.'), "Lower");
+%! assert (matrix_type (a'), "Lower");
+%! a = matrix_type ((1+1i) * triu (ones (10,10)), "Upper");
+%! assert (matrix_type (a'), "Lower");
 */
 
 OCTAVE_END_NAMESPACE(octave)
@@ -68,6 +68,7 @@ COREFCN_INC = \
   %reldir%/oct-hist.h \
   %reldir%/oct-iostrm.h \
   %reldir%/oct-map.h \
+  %reldir%/oct-mmapstrm.h \
   %reldir%/oct-prcstrm.h \
   %reldir%/oct-procbuf.h \
   %reldir%/oct-process.h \
@@ -99,10 +100,12 @@ COREFCN_INC = \
   %reldir%/xdiv.h \
   %reldir%/xnorm.h \
   %reldir%/xpow.h \
-  %reldir%/gzfstream.h
+  %reldir%/gzfstream.h \
+  %reldir%/zstdfstream.h
 
 NOINSTALL_COREFCN_INC = \
   %reldir%/graphics-utils.h \
+  %reldir%/interp-grid.h \
   %reldir%/interpreter-private.h \
   %reldir%/mex-private.h \
   %reldir%/oct-hdf5.h \
@@ -120,13 +123,16 @@ COREFCN_SRC = \
   %reldir%/__expint__.cc \
   %reldir%/__ftp__.cc \
   %reldir%/__gammainc__.cc \
+  %reldir%/__histc__.cc \
   %reldir%/__ichol__.cc \
   %reldir%/__ilu__.cc \
+  %reldir%/__interp1__.cc \
   %reldir%/__isprimelarge__.cc \
   %reldir%/__lin_interpn__.cc \
   %reldir%/__magick_read__.cc \
   %reldir%/__pchip_deriv__.cc \
   %reldir%/__qp__.cc \
+  %reldir%/__unique__.cc \
   %reldir%/amd.cc \
   %reldir%/auto-shlib.cc \
   %reldir%/balance.cc \
@@ -223,6 +229,7 @@ COREFCN_SRC = \
   %reldir%/oct-hist.cc \
   %reldir%/oct-iostrm.cc \
   %reldir%/oct-map.cc \
+  %reldir%/oct-mmapstrm.cc \
   %reldir%/oct-prcstrm.cc \
   %reldir%/oct-procbuf.cc \
   %reldir%/oct-process.cc \
@@ -231,6 +238,7 @@ COREFCN_SRC = \
   %reldir%/oct-tex-lexer.ll \
   %reldir%/oct-tex-parser.h \
   %reldir%/oct-tex-parser.yy \
+  %reldir%/order-stats.cc \
   %reldir%/ordqz.cc \
   %reldir%/ordschur.cc \
   %reldir%/pager.cc \
@@ -287,6 +295,7 @@ COREFCN_SRC = \
   %reldir%/xnorm.cc \
   %reldir%/xpow.cc \
   %reldir%/gzfstream.cc \
+  %reldir%/zstdfstream.cc \
   $(NOINSTALL_COREFCN_INC)
 
 ## Special rules for sources which must be built before rest of compilation.
@@ -344,6 +353,7 @@ noinst_LTLIBRARIES += \
   $(HDF5_CPPFLAGS) \
   $(SPARSE_XCPPFLAGS) \
   $(Z_CPPFLAGS) \
+  $(ZSTD_CPPFLAGS) \
   $(OCTAVE_TEX_PARSER_CPPFLAGS)
 
 libinterp_EXTRA_DIST += \
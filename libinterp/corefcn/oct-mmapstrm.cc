@@ -0,0 +1,506 @@
+////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2024 The Octave Project Developers
+//
+// See the file COPYRIGHT.md in the top-level directory of this
+// distribution or <https://octave.org/copyright/>.
+//
+// This file is part of Octave.
+//
+// Octave is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Octave is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Octave; see the file COPYING.  If not, see
+// <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////
+
+#if defined (HAVE_CONFIG_H)
+#  include "config.h"
+#endif
+
+#include <cerrno>
+#include <cstring>
+
+#include <istream>
+#include <streambuf>
+
+#if defined (OCTAVE_HAVE_STD_PMR_POLYMORPHIC_ALLOCATOR)
+#  include <memory_resource>
+#endif
+
+#if defined (HAVE_SYS_MMAN_H)
+#  include <sys/mman.h>
+#  include <unistd.h>
+#endif
+
+#include "Array.h"
+#include "fcntl-wrappers.h"
+#include "file-stat.h"
+#include "oct-inttypes.h"
+#include "unistd-wrappers.h"
+
+#include "error.h"
+#include "oct-mmapstrm.h"
+#include "ov.h"
+
+#if defined (HAVE_SYS_MMAN_H) && defined (HAVE_MMAP) && defined (HAVE_MUNMAP)
+#  define OCTAVE_USE_MMAP 1
+#endif
+
+OCTAVE_BEGIN_NAMESPACE(octave)
+
+// A private mapping of part of a file that holds the data of an array.
+// It is the memory resource of that array, so it is unmapped when the
+// array data is released.  Because every array has its own mapping,
+// modifying one array only copies the pages of that mapping.
+
+#if defined (OCTAVE_USE_MMAP) && defined (OCTAVE_HAVE_STD_PMR_POLYMORPHIC_ALLOCATOR)
+
+class mmap_region : public std::pmr::memory_resource
+{
+public:
+
+  mmap_region (void *addr, std::size_t len)
+    : m_addr (static_cast<char *> (addr)), m_len (len)
+  { }
+
+  OCTAVE_DISABLE_CONSTRUCT_COPY_MOVE (mmap_region)
+
+  ~mmap_region () { ::munmap (m_addr, m_len); }
+
+private:
+
+  // Arrays never grow in place, so any memory requested through this
+  // resource is ordinary heap memory.
+
+  void * do_allocate (std::size_t bytes, std::size_t /*alignment*/)
+  {
+    return ::operator new (bytes);
+  }
+
+  void do_deallocate (void *ptr, std::size_t /*bytes*/,
+                      std::size_t /*alignment*/)
+  {
+    char *p = static_cast<char *> (ptr);
+
+    if (p >= m_addr && p < m_addr + m_len)
+      delete this;
+    else
+      ::operator delete (ptr);
+  }
+
+  bool do_is_equal (const std::pmr::memory_resource& other) const noexcept
+  {
+    return this == &other;
+  }
+
+  char *m_addr;
+
+  std::size_t m_len;
+};
+
+// Reads smaller than this are copied.  Each mapping uses a kernel
+// memory map entry and at least one page.
+static const std::size_t min_mapped_read_bytes = 1 << 20;
+
+template <typename T>
+static octave_value
+mapped_array (int fd, off_t offset, octave_idx_type nr, octave_idx_type nc)
+{
+  static const off_t page_size = sysconf (_SC_PAGESIZE);
+
+  off_t map_offset = offset - offset % page_size;
+  std::size_t skip = offset - map_offset;
+  std::size_t len = skip + static_cast<std::size_t> (nr) * nc * sizeof (T);
+
+  void *addr = ::mmap (nullptr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                       fd, map_offset);
+
+  if (addr == MAP_FAILED)
+    return octave_value ();
+
+  std::unique_ptr<mmap_region> region (new mmap_region (addr, len));
+
+  T *data = reinterpret_cast<T *> (static_cast<char *> (addr) + skip);
+
+  Array<T> a (data, dim_vector (nr, nc),
+              std::pmr::polymorphic_allocator<T> (region.get ()));
+
+  // The array now owns the mapping.
+  region.release ();
+
+  return octave_value (a);
+}
+
+#endif
+
+// A stream buffer over the whole mapping.  The get area is the entire
+// file, so reading is a memcpy and seeking only moves the get pointer.
+// Writes go to the current get position; the file can not grow.
+
+class mmap_streambuf : public std::streambuf
+{
+public:
+
+  mmap_streambuf (char *data, std::size_t len, bool writable)
+    : std::streambuf (), m_writable (writable)
+  {
+    setg (data, data, data + len);
+  }
+
+  OCTAVE_DISABLE_CONSTRUCT_COPY_MOVE (mmap_streambuf)
+
+  ~mmap_streambuf () = default;
+
+  std::size_t position () const { return gptr () - eback (); }
+
+protected:
+
+  pos_type seekoff (off_type off, std::ios::seekdir dir,
+                    std::ios::openmode = std::ios::in | std::ios::out)
+  {
+    off_type pos = off;
+
+    if (dir == std::ios::cur)
+      pos += gptr () - eback ();
+    else if (dir == std::ios::end)
+      pos += egptr () - eback ();
+
+    if (pos < 0 || pos > egptr () - eback ())
+      return pos_type (off_type (-1));
+
+    setg (eback (), eback () + pos, egptr ());
+
+    return pos_type (pos);
+  }
+
+  pos_type seekpos (pos_type sp,
+                    std::ios::openmode which = std::ios::in | std::ios::out)
+  {
+    return seekoff (off_type (sp), std::ios::beg, which);
+  }
+
+  std::streamsize xsgetn (char *s, std::streamsize n)
+  {
+    std::streamsize avail = egptr () - gptr ();
+
+    if (n > avail)
+      n = avail;
+
+    if (n > 0)
+      {
+        std::memcpy (s, gptr (), n);
+        setg (eback (), gptr () + n, egptr ());
+      }
+
+    return n;
+  }
+
+  std::streamsize xsputn (const char *s, std::streamsize n)
+  {
+    if (! m_writable)
+      return 0;
+
+    std::streamsize avail = egptr () - gptr ();
+
+    if (n > avail)
+      n = avail;
+
+    if (n > 0)
+      {
+        std::memcpy (gptr (), s, n);
+        setg (eback (), gptr () + n, egptr ());
+      }
+
+    return n;
+  }
+
+  int_type overflow (int_type c)
+  {
+    if (traits_type::eq_int_type (c, traits_type::eof ()))
+      return traits_type::not_eof (c);
+
+    char ch = traits_type::to_char_type (c);
+
+    return xsputn (&ch, 1) == 1 ? c : traits_type::eof ();
+  }
+
+private:
+
+  bool m_writable;
+};
+
+stream
+mmap_stream::create (const std::string& nm_arg, std::ios::openmode arg_md,
+                     mach_info::float_format ff, const std::string& encoding)
+{
+  return stream (new mmap_stream (nm_arg, arg_md, ff, encoding));
+}
+
+mmap_stream::mmap_stream (const std::string& nm_arg,
+                          std::ios::openmode arg_md,
+                          mach_info::float_format ff,
+                          const std::string& encoding)
+  : base_stream (arg_md, ff, encoding), m_name (nm_arg), m_fd (-1),
+    m_addr (nullptr), m_len (0), m_buf (), m_stream ()
+{
+#if defined (OCTAVE_USE_MMAP)
+
+  bool writable = arg_md & std::ios::out;
+
+  m_fd = octave_open_wrapper (m_name.c_str (),
+                              (writable ? octave_o_rdwr_wrapper ()
+                               : octave_o_rdonly_wrapper ()), 0);
+
+  if (m_fd < 0)
+    {
+      // Note: error is inherited from base_stream, not ::error.
+      error (std::strerror (errno));
+      return;
+    }
+
+  sys::file_fstat fs (m_fd);
+
+  if (! fs)
+    {
+      error (fs.error ());
+      do_close ();
+      return;
+    }
+
+  m_len = fs.size ();
+
+  if (m_len > 0)
+    {
+      void *addr = ::mmap (nullptr, m_len,
+                           (writable ? PROT_READ | PROT_WRITE : PROT_READ),
+                           MAP_SHARED, m_fd, 0);
+
+      if (addr == MAP_FAILED)
+        {
+          error (std::strerror (errno));
+          m_len = 0;
+          do_close ();
+          return;
+        }
+
+      m_addr = static_cast<char *> (addr);
+    }
+
+  m_buf.reset (new mmap_streambuf (m_addr, m_len, writable));
+
+  m_stream.reset (new std::iostream (m_buf.get ()));
+
+#else
+
+  // Note: error is inherited from base_stream, not ::error.
+  error ("memory mapped files are not supported on this system");
+
+#endif
+}
+
+mmap_stream::~mmap_stream ()
+{
+  do_close ();
+}
+
+// Position a stream at OFFSET relative to ORIGIN.
+
+int
+mmap_stream::seek (off_t offset, int origin)
+{
+  if (! m_stream)
+    return -1;
+
+  std::ios::seekdir dir = std::ios::beg;
+
+  if (origin == SEEK_CUR)
+    dir = std::ios::cur;
+  else if (origin == SEEK_END)
+    dir = std::ios::end;
+
+  m_stream->clear ();
+
+  std::streampos pos = m_buf->pubseekoff (offset, dir);
+
+  return pos == std::streampos (-1) ? -1 : 0;
+}
+
+// Return current stream position.
+
+off_t
+mmap_stream::tell ()
+{
+  return m_buf ? m_buf->position () : -1;
+}
+
+// Return nonzero if EOF has been reached on this stream.
+
+bool
+mmap_stream::eof () const
+{
+  return m_stream ? m_stream->eof () : true;
+}
+
+void
+mmap_stream::do_close ()
+{
+  m_stream.reset ();
+  m_buf.reset ();
+
+#if defined (OCTAVE_USE_MMAP)
+
+  if (m_addr)
+    ::munmap (m_addr, m_len);
+
+  if (m_fd >= 0)
+    octave_close_wrapper (m_fd);
+
+#endif
+
+  m_addr = nullptr;
+  m_len = 0;
+  m_fd = -1;
+}
+
+std::istream *
+mmap_stream::input_stream ()
+{
+  std::istream *retval = nullptr;
+
+  if (mode () & std::ios::in)
+    retval = m_stream.get ();
+
+  return retval;
+}
+
+std::ostream *
+mmap_stream::output_stream ()
+{
+  std::ostream *retval = nullptr;
+
+  if (mode () & std::ios::out)
+    retval = m_stream.get ();
+
+  return retval;
+}
+
+octave_idx_type
+mmap_stream::mapped_elements (std::size_t elt_size) const
+{
+#if defined (OCTAVE_USE_MMAP) && defined (OCTAVE_HAVE_STD_PMR_POLYMORPHIC_ALLOCATOR)
+
+  // Writable files are always copied so that later writes can not
+  // change values that were already read.
+
+  if (! m_buf || (mode () & std::ios::out))
+    return -1;
+
+  std::size_t pos = m_buf->position ();
+
+  if (pos % elt_size != 0)
+    return -1;
+
+  return (m_len - pos) / elt_size;
+
+#else
+
+  octave_unused_parameter (elt_size);
+
+  return -1;
+
+#endif
+}
+
+octave_value
+mmap_stream::mapped_read (oct_data_conv::data_type dt,
+                          octave_idx_type nr, octave_idx_type nc)
+{
+  octave_value retval;
+
+#if defined (OCTAVE_USE_MMAP) && defined (OCTAVE_HAVE_STD_PMR_POLYMORPHIC_ALLOCATOR)
+
+  std::size_t nbytes = static_cast<std::size_t> (nr) * nc
+                       * oct_data_conv::data_type_size (dt);
+
+  if (! m_buf || nbytes < min_mapped_read_bytes)
+    return retval;
+
+  off_t pos = m_buf->position ();
+
+  switch (dt)
+    {
+    case oct_data_conv::dt_int8:
+      retval = mapped_array<octave_int8> (m_fd, pos, nr, nc);
+      break;
+
+    case oct_data_conv::dt_uint8:
+      retval = mapped_array<octave_uint8> (m_fd, pos, nr, nc);
+      break;
+
+    case oct_data_conv::dt_int16:
+      retval = mapped_array<octave_int16> (m_fd, pos, nr, nc);
+      break;
+
+    case oct_data_conv::dt_uint16:
+      retval = mapped_array<octave_uint16> (m_fd, pos, nr, nc);
+      break;
+
+    case oct_data_conv::dt_int32:
+      retval = mapped_array<octave_int32> (m_fd, pos, nr, nc);
+      break;
+
+    case oct_data_conv::dt_uint32:
+      retval = mapped_array<octave_uint32> (m_fd, pos, nr, nc);
+      break;
+
+    case oct_data_conv::dt_int64:
+      retval = mapped_array<octave_int64> (m_fd, pos, nr, nc);
+      break;
+
+    case oct_data_conv::dt_uint64:
+      retval = mapped_array<octave_uint64> (m_fd, pos, nr, nc);
+      break;
+
+    case oct_data_conv::dt_single:
+      retval = mapped_array<float> (m_fd, pos, nr, nc);
+      break;
+
+    case oct_data_conv::dt_double:
+      retval = mapped_array<double> (m_fd, pos, nr, nc);
+      break;
+
+    case oct_data_conv::dt_char:
+    case oct_data_conv::dt_schar:
+    case oct_data_conv::dt_uchar:
+      retval = mapped_array<char> (m_fd, pos, nr, nc);
+      break;
+
+    default:
+      break;
+    }
+
+  if (retval.is_defined ())
+    m_buf->pubseekoff (nbytes, std::ios::cur);
+
+#else
+
+  octave_unused_parameter (dt);
+  octave_unused_parameter (nr);
+  octave_unused_parameter (nc);
+
+#endif
+
+  return retval;
+}
+
+OCTAVE_END_NAMESPACE(octave)
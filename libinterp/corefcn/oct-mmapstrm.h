@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2024 The Octave Project Developers
+//
+// See the file COPYRIGHT.md in the top-level directory of this
+// distribution or <https://octave.org/copyright/>.
+//
+// This file is part of Octave.
+//
+// Octave is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Octave is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Octave; see the file COPYING.  If not, see
+// <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////
+
+#if ! defined (octave_oct_mmapstrm_h)
+#define octave_oct_mmapstrm_h 1
+
+#include "octave-config.h"
+
+#include <iosfwd>
+#include <memory>
+#include <string>
+
+#include "oct-stream.h"
+
+OCTAVE_BEGIN_NAMESPACE(octave)
+
+class mmap_streambuf;
+
+// A stream that reads and writes a file through a memory mapping of
+// the whole file.  Seeking only moves a pointer, and large reads with
+// fread return arrays that use their own private mapping of the file
+// instead of copying the data.  Modifying such an array copies the
+// affected pages and never changes the file or other arrays.
+//
+// Files opened for reading and writing are mapped shared and can not
+// grow.  fread always copies from them so that later writes can not
+// change values that were already read.
+
+class mmap_stream : public base_stream
+{
+public:
+
+  mmap_stream (const std::string& nm_arg,
+               std::ios::openmode arg_md = std::ios::in,
+               mach_info::float_format flt_fmt = mach_info::native_float_format (),
+               const std::string& encoding = "utf-8");
+
+  OCTAVE_DISABLE_CONSTRUCT_COPY_MOVE (mmap_stream)
+
+  static stream
+  create (const std::string& nm_arg,
+          std::ios::openmode arg_md = std::ios::in,
+          mach_info::float_format flt_fmt = mach_info::native_float_format (),
+          const std::string& encoding = "utf-8");
+
+  // Position a stream at OFFSET relative to ORIGIN.
+
+  int seek (off_t offset, int origin);
+
+  // Return current stream position.
+
+  off_t tell ();
+
+  // Return nonzero if EOF has been reached on this stream.
+
+  bool eof () const;
+
+  void do_close ();
+
+  // The name of the file.
+
+  std::string name () const { return m_name; }
+
+  std::istream * input_stream ();
+
+  std::ostream * output_stream ();
+
+  octave_idx_type mapped_elements (std::size_t elt_size) const;
+
+  octave_value mapped_read (oct_data_conv::data_type dt,
+                            octave_idx_type nr, octave_idx_type nc);
+
+protected:
+
+  ~mmap_stream ();
+
+private:
+
+  std::string m_name;
+
+  // The file stays open so that fread can map slices of it.
+  int m_fd;
+
+  char *m_addr;
+
+  std::size_t m_len;
+
+  std::unique_ptr<mmap_streambuf> m_buf;
+
+  std::unique_ptr<std::iostream> m_stream;
+};
+
+OCTAVE_END_NAMESPACE(octave)
+
+#endif
@@ -31,13 +31,17 @@
 #include <cstring>
 
 #include <algorithm>
+#include <charconv>
 #include <deque>
 #include <fstream>
 #include <limits>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <system_error>
+#include <type_traits>
 #include <vector>
 
 #include "Array.h"
@@ -63,6 +67,8 @@
 #include "oct-string.h"
 #include "oct-stream.h"
 #include "ov.h"
+#include "ov-flt-re-mat.h"
+#include "ov-re-mat.h"
 #include "ovl.h"
 #include "pager.h"
 #include "utils.h"
@@ -1274,6 +1280,19 @@ public:
 
   void seekg (char *old_idx) { m_idx = old_idx; }
 
+  // Move the read position forward to NEW_IDX, which must lie within
+  // the buffered data, as if the characters had been read by get_undelim.
+  void advance (char *new_idx)
+  {
+    m_idx = new_idx;
+    if (m_idx >= m_last)
+      m_delimited = false;
+  }
+
+  // Position after the last character currently in the buffer.  Data
+  // in [tellg (), buf_end ()) may be scanned directly.
+  char * buf_end () const { return m_eob; }
+
   bool eof ()
   {
     return (m_eob == m_buf + m_overlap && m_i_stream.eof ())
@@ -1346,6 +1365,9 @@ private:
   // Sequence of single-character delimiters.
   const std::string m_delims;
 
+  // m_delim_table[c] != '\0' if c is one of m_delims.
+  std::string m_delim_table;
+
   // Position of start of buf in original stream.
   std::streampos m_buf_in_file;
 
@@ -1364,9 +1386,12 @@ delimited_stream::delimited_stream (std::istream& is,
                                     int longest_lookahead,
                                     octave_idx_type bsize)
   : m_bufsize (bsize), m_i_stream (is), m_longest (longest_lookahead),
-    m_delims (delimiters),
+    m_delims (delimiters), m_delim_table (256, '\0'),
     m_flags (std::ios::failbit & ~std::ios::failbit) // can't cast 0
 {
+  for (unsigned char ch : m_delims)
+    m_delim_table[ch] = '1';
+
   m_buf = new char[m_bufsize];
   m_eob = m_buf + m_bufsize;
   m_idx = m_eob;                // refresh_buf shouldn't try to copy old data
@@ -1516,7 +1541,7 @@ delimited_stream::refresh_buf (bool initialize)
       for (m_last = m_eob - m_longest; m_last - m_buf - m_overlap >= 0;
            m_last--)
         {
-          if (m_delims.find (*m_last) != std::string::npos)
+          if (m_delim_table[static_cast<unsigned char> (*m_last)])
             break;
         }
 
@@ -1831,6 +1856,8 @@ private:
   double read_double (delimited_stream& is,
                       const textscan_format_elt& fmt) const;
 
+  bool read_buffered_double (delimited_stream& is, double& val) const;
+
   void scan_complex (delimited_stream& is, const textscan_format_elt& fmt,
                      Complex& val) const;
 
@@ -2773,6 +2800,15 @@ double
 textscan::read_double (delimited_stream& is,
                        const textscan_format_elt& fmt) const
 {
+  // Without a field width or precision, most numbers can be parsed
+  // straight out of the buffer.
+  if (fmt.width == static_cast<unsigned int> (-1) && fmt.prec == -1 && is)
+    {
+      double val;
+      if (read_buffered_double (is, val))
+        return val;
+    }
+
   int sign = 1;
   unsigned int width_left = fmt.width;
   double retval = 0;
@@ -2922,6 +2958,114 @@ textscan::read_double (delimited_stream& is,
   return retval * sign;
 }
 
+// Parse a number of unlimited width and precision directly from the
+// characters already in the buffer of IS.  The arithmetic is identical
+// to that of read_double so the result does not depend on where buffer
+// boundaries fall.  Return false, leaving IS untouched, if the number
+// is not entirely contained in the buffer or is not a plain decimal
+// number (for example, Inf or NaN); the caller must then use the
+// character-by-character parser.
+
+bool
+textscan::read_buffered_double (delimited_stream& is, double& val) const
+{
+  char *p = is.tellg ();
+  const char *end = is.buf_end ();
+
+  int sign = 1;
+  double retval = 0;
+  bool valid = false;
+
+  if (p < end && (*p == '+' || *p == '-'))
+    {
+      if (*p == '-')
+        sign = -1;
+      p++;
+    }
+
+  while (p < end && *p >= '0' && *p <= '9')
+    {
+      retval = retval * 10 + (*p++ - '0');
+      valid = true;
+    }
+
+  if (p < end && *p == '.')
+    {
+      double multiplier = 1;
+
+      p++;
+      while (p < end && *p >= '0' && *p <= '9')
+        {
+          retval += (*p++ - '0') * (multiplier *= 0.1);
+          valid = true;
+        }
+    }
+
+  // The character terminating the number must also be buffered.
+  if (! valid || p >= end)
+    return false;
+
+  if (m_exp_chars.find (*p) != std::string::npos)
+    {
+      char *q = p + 1;
+
+      if (q >= end)
+        return false;
+
+      if (*q == '-' || *q == '+' || (*q >= '0' && *q <= '9'))
+        {
+          int exp = 0;
+          int exp_sign = 1;
+
+          if (*q == '+')
+            q++;
+          else if (*q == '-')
+            {
+              exp_sign = -1;
+              q++;
+            }
+
+          char *digits = q;
+          while (q < end && *q >= '0' && *q <= '9')
+            exp = exp*10 + *q++ - '0';
+
+          if (q == digits || q >= end)
+            return false;
+
+          double multiplier = pown (10, exp);
+          if (exp_sign > 0)
+            retval *= multiplier;
+          else
+            retval /= multiplier;
+
+          p = q;
+        }
+    }
+
+  is.clear ();
+  is.advance (p);
+
+  val = retval * sign;
+
+  return true;
+}
+
+// Store the real value X in element N of the numeric column OV.  If
+// OV holds a plain array of type OV_T, write to it directly rather
+// than creating a temporary octave_value for fast_elem_insert.
+
+template <typename OV_T, typename T>
+static inline void
+insert_real (octave_value& ov, octave_idx_type n, T x)
+{
+  OV_T *rep = dynamic_cast<OV_T *> (ov.internal_rep ());
+
+  if (rep && n < rep->numel ())
+    rep->matrix_ref ()(n) = x;
+  else
+    ov.internal_rep ()->fast_elem_insert (n, x);
+}
+
 // Read a single number: real, complex, inf, NaN, possibly with limited
 // precision.  Calls to this should be preceded by skip_whitespace.
 // Calling that inside scan_complex would violate its const declaration.
@@ -3295,7 +3439,7 @@ textscan::scan_one (delimited_stream& is, const textscan_format_elt& fmt,
               if (fmt.bitwidth == 64)
                 {
                   if (ov.isreal () && v.imag () == 0)
-                    ov.internal_rep ()->fast_elem_insert (row(0), v.real ());
+                    insert_real<octave_matrix> (ov, row(0), v.real ());
                   else
                     {
                       if (ov.isreal ())  // cat does type conversion
@@ -3307,8 +3451,8 @@ textscan::scan_one (delimited_stream& is, const textscan_format_elt& fmt,
               else
                 {
                   if (ov.isreal () && v.imag () == 0)
-                    ov.internal_rep ()->fast_elem_insert (row(0),
-                                                          float (v.real ()));
+                    insert_real<octave_float_matrix> (ov, row(0),
+                                                      float (v.real ()));
                   else
                     {
                       if (ov.isreal ())  // cat does type conversion
@@ -4020,6 +4164,13 @@ textscan::match_literal (delimited_stream& is,
   return true;
 }
 
+octave_value
+base_stream::mapped_read (oct_data_conv::data_type, octave_idx_type,
+                          octave_idx_type)
+{
+  return octave_value ();
+}
+
 void
 base_stream::error (const std::string& msg)
 {
@@ -5691,6 +5842,90 @@ do_printf_conv (std::ostream& os, const char *fmt, int nsa, int sa_1,
   return retval;
 }
 
+// Format VAL with std::to_chars for the conversion TYPE of ELT, if the
+// conversion has no flags other than '-' and no '*' arguments.  The
+// characters are the same as those of printf in the "C" locale, but the
+// format is not parsed again and the result not allocated for every
+// element.  Return -1 for the conversions that are not handled here.
+
+template <typename T>
+static int
+do_fast_printf_conv (std::ostream& os, const printf_format_elt *elt,
+                     int nsa, char type, T val)
+{
+  if (nsa != 0 || ! (elt->flags.empty () || elt->flags == "-")
+      || elt->text[0] != '%')
+    return -1;
+
+  char buf[128];
+  std::to_chars_result res;
+
+  if constexpr (std::is_integral<T>::value)
+    {
+      // A precision is the minimum number of digits for integers.
+      if (elt->prec != -1)
+        return -1;
+
+      res = std::to_chars (buf, buf + sizeof (buf), val);
+    }
+  else
+    {
+#if defined (HAVE_CXX_FLOAT_CHARCONV)
+      std::chars_format cf;
+
+      switch (type)
+        {
+        case 'f':
+          cf = std::chars_format::fixed;
+          break;
+
+        case 'e': case 'E':
+          cf = std::chars_format::scientific;
+          break;
+
+        case 'g': case 'G':
+          cf = std::chars_format::general;
+          break;
+
+        default:
+          return -1;
+        }
+
+      int prec = (elt->prec == -1 ? 6 : elt->prec);
+
+      res = std::to_chars (buf, buf + sizeof (buf), val, cf, prec);
+
+      if (res.ec == std::errc () && (type == 'E' || type == 'G'))
+        std::transform (buf, res.ptr, buf, ::toupper);
+#else
+      octave_unused_parameter (os);
+      octave_unused_parameter (type);
+      octave_unused_parameter (val);
+
+      return -1;
+#endif
+    }
+
+  if (res.ec != std::errc ())
+    return -1;
+
+  int len = res.ptr - buf;
+  int fw = (elt->fw > len ? elt->fw : len);
+
+  if (elt->flags.empty ())
+    {
+      std::fill_n (std::ostreambuf_iterator<char> (os), fw - len, ' ');
+      os.write (buf, len);
+    }
+  else
+    {
+      os.write (buf, len);
+      std::fill_n (std::ostreambuf_iterator<char> (os), fw - len, ' ');
+    }
+
+  return fw;
+}
+
 static std::size_t
 do_printf_string (std::ostream& os, const printf_format_elt *elt,
                   int nsa, int sa_1, int sa_2, const std::string& arg,
@@ -5719,6 +5954,10 @@ do_printf_string (std::ostream& os, const printf_format_elt *elt,
 static bool
 is_nan_or_inf (const octave_value& val)
 {
+  // Avoid the temporary values for the common case of real scalars.
+  if (val.isfloat () && val.is_real_scalar ())
+    return ! math::isfinite (val.double_value ());
+
   octave_value ov_isnan = val.isnan ();
   octave_value ov_isinf = val.isinf ();
 
@@ -5851,6 +6090,15 @@ base_stream::do_numeric_printf_conv (std::ostream& os,
             {
               octave_int64 tval = val.int64_scalar_value ();
 
+              int n = (type == 'c' ? -1
+                       : do_fast_printf_conv (os, elt, nsa, type,
+                                              tval.value ()));
+              if (n >= 0)
+                {
+                  retval += n;
+                  break;
+                }
+
               // Insert "long" modifier.
               tfmt.replace (tfmt.rfind (type), 1, llmod + type);
 
@@ -5859,10 +6107,17 @@ base_stream::do_numeric_printf_conv (std::ostream& os,
             }
           else
             {
-              tfmt = switch_to_g_format (elt);
-
               double dval = val.double_value (true);
 
+              int n = do_fast_printf_conv (os, elt, nsa, 'g', dval);
+              if (n >= 0)
+                {
+                  retval += n;
+                  break;
+                }
+
+              tfmt = switch_to_g_format (elt);
+
               retval += do_printf_conv (os, tfmt.c_str (), nsa, sa_1, sa_2,
                                         dval, who);
             }
@@ -5895,8 +6150,13 @@ base_stream::do_numeric_printf_conv (std::ostream& os,
           {
             double dval = val.double_value (true);
 
-            retval += do_printf_conv (os, tfmt.c_str (), nsa, sa_1, sa_2,
-                                      dval, who);
+            int n = do_fast_printf_conv (os, elt, nsa, type, dval);
+
+            if (n >= 0)
+              retval += n;
+            else
+              retval += do_printf_conv (os, tfmt.c_str (), nsa, sa_1, sa_2,
+                                        dval, who);
           }
           break;
 
@@ -6389,6 +6649,31 @@ stream::close ()
     }
 }
 
+// Convert N elements of DATA, read from a file, into DST.  Each branch
+// is a single branch-free pass that the compiler can vectorize.
+
+template <typename SRC_T, typename DST_ELT_T>
+static void
+convert_block (SRC_T *data, octave_idx_type n, DST_ELT_T *dst, bool swap,
+               bool do_float_fmt_conv, mach_info::float_format from_flt_fmt)
+{
+  if (swap)
+    {
+      for (octave_idx_type i = 0; i < n; i++)
+        dst[i] = byte_swapped (data[i]);
+    }
+  else
+    {
+      if (do_float_fmt_conv)
+        do_float_format_conversion (data, sizeof (SRC_T), n,
+                                    from_flt_fmt,
+                                    mach_info::native_float_format ());
+
+      for (octave_idx_type i = 0; i < n; i++)
+        dst[i] = data[i];
+    }
+}
+
 template <typename SRC_T, typename DST_T>
 static octave_value
 convert_and_copy (std::list<void *>& input_buf_list,
@@ -6406,76 +6691,27 @@ convert_and_copy (std::list<void *>& input_buf_list,
 
   octave_idx_type j = 0;
 
+  // FIXME: Potentially add conversion code for MIPS NA here when
+  //        DO_NA_CONV is true.  Bug #59830.
+  octave_unused_parameter (do_NA_conv);
+
   for (auto it = input_buf_list.cbegin (); it != input_buf_list.cend (); it++)
     {
       SRC_T *data = static_cast<SRC_T *> (*it);
 
-      if (swap || do_float_fmt_conv)
-        {
-          if (do_NA_conv)
-            {
-              for (octave_idx_type i = 0; i < input_buf_elts && j < elts_read;
-                   i++, j++)
-                {
-                  if (swap)
-                    swap_bytes<sizeof (SRC_T)> (&data[i]);
-                  else if (do_float_fmt_conv)
-                    do_float_format_conversion (&data[i], sizeof (SRC_T),
-                                                1, from_flt_fmt,
-                                                mach_info::native_float_format ());
-
-                  // FIXME: Potentially add conversion code for MIPS NA here
-                  //        Bug #59830.
-                  // dst_elt_type tmp (data[i]);
-                  // if (is_MIPS_NA (tmp))
-                  //  tmp = replace_MIPS_NA (tmp);
-                  // conv_data[j] = tmp;
-
-                  conv_data[j] = data[i];
-                }
-            }
-          else
-            {
-              for (octave_idx_type i = 0; i < input_buf_elts && j < elts_read;
-                   i++, j++)
-                {
-                  if (swap)
-                    swap_bytes<sizeof (SRC_T)> (&data[i]);
-                  else if (do_float_fmt_conv)
-                    do_float_format_conversion (&data[i], sizeof (SRC_T),
-                                                1, from_flt_fmt,
-                                                mach_info::native_float_format ());
-
-                  conv_data[j] = data[i];
-                }
-            }
-        }
-      else
-        {
-          if (do_NA_conv)
-            {
-              for (octave_idx_type i = 0; i < input_buf_elts && j < elts_read;
-                   i++, j++)
-                {
-                  // FIXME: Potentially add conversion code for MIPS NA here
-                  conv_data[j] = data[i];
-                }
-            }
-          else
-            {
-              for (octave_idx_type i = 0; i < input_buf_elts && j < elts_read;
-                   i++, j++)
-                conv_data[j] = data[i];
-            }
-        }
+      octave_idx_type n = std::min (input_buf_elts, elts_read - j);
+
+      convert_block (data, n, conv_data + j, swap, do_float_fmt_conv,
+                     from_flt_fmt);
+
+      j += n;
 
       delete [] data;
     }
 
   input_buf_list.clear ();
 
-  for (octave_idx_type i = elts_read; i < nr * nc; i++)
-    conv_data[i] = dst_elt_type (0);
+  std::fill (conv_data + elts_read, conv_data + nr * nc, dst_elt_type (0));
 
   return conv;
 }
@@ -6593,6 +6829,186 @@ stream::finalize_read (std::list<void *>& input_buf_list,
   return retval;
 }
 
+// Adjust the requested dimensions NR and NC of the result of fread
+// to the number of elements COUNT that were actually read.
+
+static void
+fread_result_dims (bool read_to_eof, std::ptrdiff_t count,
+                   octave_idx_type& nr, octave_idx_type& nc)
+{
+  if (read_to_eof)
+    {
+      if (nc < 0)
+        {
+          nc = count / nr;
+
+          if (count % nr != 0)
+            nc++;
+        }
+      else
+        nr = count;
+    }
+  else if (count == 0)
+    {
+      nr = 0;
+      nc = 0;
+    }
+  else if (count != nr * nc)
+    {
+      if (count % nr != 0)
+        nc = count / nr + 1;
+      else
+        nc = count / nr;
+
+      if (count < nr)
+        nr = count;
+    }
+}
+
+// Read the NR by NC elements of fread from IS and convert them straight
+// into the result array.  Without conversion, the data is read into the
+// result directly.  Otherwise, it is read in chunks that are converted
+// while they are still in cache.  COUNT is set to the number of elements
+// actually read.
+
+template <typename SRC_T, typename DST_T>
+static octave_value
+read_and_convert (std::istream& is, octave_idx_type nr, octave_idx_type nc,
+                  bool swap, bool do_float_fmt_conv,
+                  mach_info::float_format from_flt_fmt,
+                  octave_idx_type& count)
+{
+  typedef typename DST_T::element_type dst_elt_type;
+
+  octave_idx_type n = nr * nc;
+
+  DST_T conv (dim_vector (nr, nc));
+
+  dst_elt_type *conv_data = conv.rwdata ();
+
+  octave_idx_type j = 0;
+
+  if (std::is_same<SRC_T, dst_elt_type>::value
+      && ! std::is_same<SRC_T, bool>::value
+      && ! swap && ! do_float_fmt_conv)
+    {
+      is.read (reinterpret_cast<char *> (conv_data),
+               static_cast<std::streamsize> (n) * sizeof (SRC_T));
+
+      j = is.gcount () / sizeof (SRC_T);
+    }
+  else
+    {
+      const octave_idx_type chunk_elts
+        = std::max<octave_idx_type> (65536 / sizeof (SRC_T), 1);
+
+      std::unique_ptr<SRC_T[]> buf (new SRC_T [std::min (n, chunk_elts)]);
+
+      while (j < n && is)
+        {
+          octave_idx_type k = std::min (n - j, chunk_elts);
+
+          is.read (reinterpret_cast<char *> (buf.get ()),
+                   static_cast<std::streamsize> (k) * sizeof (SRC_T));
+
+          k = is.gcount () / sizeof (SRC_T);
+
+          convert_block (buf.get (), k, conv_data + j, swap,
+                         do_float_fmt_conv, from_flt_fmt);
+
+          j += k;
+        }
+    }
+
+  count = j;
+
+  if (j == n)
+    return conv;
+
+  // Short read.  Keep the elements read and pad the last column.
+
+  fread_result_dims (false, j, nr, nc);
+
+  DST_T retval (dim_vector (nr, nc));
+
+  dst_elt_type *retval_data = retval.rwdata ();
+
+  std::copy (conv_data, conv_data + j, retval_data);
+  std::fill (retval_data + j, retval_data + nr * nc, dst_elt_type (0));
+
+  return retval;
+}
+
+typedef octave_value (*read_fptr)
+  (std::istream& is, octave_idx_type nr, octave_idx_type nc, bool swap,
+   bool do_float_fmt_conv, mach_info::float_format from_flt_fmt,
+   octave_idx_type& count);
+
+// FILL_TABLE_ROW now fills the table of read_and_convert functions.
+
+#undef TABLE_ELT
+#define TABLE_ELT(T, U, V, W)                                           \
+  read_fptr_table[oct_data_conv::T][oct_data_conv::U] = read_and_convert<V, W>
+
+// Read NR by NC elements of INPUT_TYPE from IS into an array of
+// OUTPUT_TYPE.  Return an undefined value if the types have no direct
+// conversion.
+
+static octave_value
+direct_read (std::istream& is, octave_idx_type nr, octave_idx_type nc,
+             oct_data_conv::data_type input_type,
+             oct_data_conv::data_type output_type,
+             mach_info::float_format ffmt, octave_idx_type& count)
+{
+  static bool initialized = false;
+
+  static read_fptr read_fptr_table[oct_data_conv::dt_unknown][14];
+
+  if (! initialized)
+    {
+      for (int i = 0; i < oct_data_conv::dt_unknown; i++)
+        for (int j = 0; j < 14; j++)
+          read_fptr_table[i][j] = nullptr;
+
+      FILL_TABLE_ROW (dt_int8, int8_t);
+      FILL_TABLE_ROW (dt_uint8, uint8_t);
+      FILL_TABLE_ROW (dt_int16, int16_t);
+      FILL_TABLE_ROW (dt_uint16, uint16_t);
+      FILL_TABLE_ROW (dt_int32, int32_t);
+      FILL_TABLE_ROW (dt_uint32, uint32_t);
+      FILL_TABLE_ROW (dt_int64, int64_t);
+      FILL_TABLE_ROW (dt_uint64, uint64_t);
+      FILL_TABLE_ROW (dt_single, float);
+      FILL_TABLE_ROW (dt_double, double);
+      FILL_TABLE_ROW (dt_char, char);
+      FILL_TABLE_ROW (dt_schar, signed char);
+      FILL_TABLE_ROW (dt_uchar, unsigned char);
+      FILL_TABLE_ROW (dt_logical, bool);
+
+      initialized = true;
+    }
+
+  if (input_type < 0 || input_type >= oct_data_conv::dt_unknown
+      || output_type < 0 || output_type >= 14
+      || ! read_fptr_table[input_type][output_type])
+    return octave_value ();
+
+  bool swap;
+
+  if (mach_info::words_big_endian ())
+    swap = (ffmt == mach_info::flt_fmt_ieee_little_endian);
+  else
+    swap = (ffmt == mach_info::flt_fmt_ieee_big_endian);
+
+  bool do_float_fmt_conv = ((input_type == oct_data_conv::dt_double
+                             || input_type == oct_data_conv::dt_single)
+                            && ffmt != mach_info::native_float_format ());
+
+  return read_fptr_table[input_type][output_type] (is, nr, nc, swap,
+                                                   do_float_fmt_conv, ffmt,
+                                                   count);
+}
+
 octave_value
 stream::read (const Array<double>& size, octave_idx_type block_size,
               oct_data_conv::data_type input_type,
@@ -6689,6 +7105,64 @@ stream::read (const Array<double>& size, octave_idx_type block_size,
     {
       std::istream& is = *isp;
 
+      // Streams backed by a memory mapping can return the data without
+      // copying it if no conversion is needed.
+
+      mach_info::float_format eff_fmt
+        = (ffmt == mach_info::flt_fmt_unknown ? float_format () : ffmt);
+
+      octave_idx_type n_mapped = -1;
+
+      if (skip == 0 && input_type == output_type
+          && input_type != oct_data_conv::dt_logical
+          && eff_fmt == mach_info::native_float_format () && is)
+        n_mapped = m_rep->mapped_elements (input_elt_size);
+
+      if (n_mapped > 0)
+        {
+          std::ptrdiff_t n = n_mapped;
+
+          if (! read_to_eof && elts_to_read < n)
+            n = elts_to_read;
+
+          octave_idx_type mnr = nr;
+          octave_idx_type mnc = nc;
+
+          fread_result_dims (read_to_eof, n, mnr, mnc);
+
+          // Zero padding of a partial last column requires a copy.
+          if (static_cast<std::ptrdiff_t> (mnr) * mnc == n)
+            {
+              retval = m_rep->mapped_read (input_type, mnr, mnc);
+
+              if (retval.is_defined ())
+                {
+                  if (read_to_eof || n < elts_to_read)
+                    {
+                      // Behave like a short read from the file.
+                      m_rep->seek (0, SEEK_END);
+                      is.setstate (std::ios::eofbit | std::ios::failbit);
+                    }
+
+                  count = n;
+
+                  return retval;
+                }
+            }
+        }
+
+      // With a known number of elements and no skipping, convert
+      // straight from the stream into the result.
+
+      if (skip == 0 && ! read_to_eof && is)
+        {
+          retval = direct_read (is, nr, nc, input_type, output_type,
+                                eff_fmt, count);
+
+          if (retval.is_defined ())
+            return retval;
+        }
+
       // Initialize eof_pos variable just once per function call
       off_t eof_pos = 0;
       off_t cur_pos = 0;
@@ -6746,33 +7220,7 @@ stream::read (const Array<double>& size, octave_idx_type block_size,
             }
         }
 
-      if (read_to_eof)
-        {
-          if (nc < 0)
-            {
-              nc = tmp_count / nr;
-
-              if (tmp_count % nr != 0)
-                nc++;
-            }
-          else
-            nr = tmp_count;
-        }
-      else if (tmp_count == 0)
-        {
-          nr = 0;
-          nc = 0;
-        }
-      else if (tmp_count != nr * nc)
-        {
-          if (tmp_count % nr != 0)
-            nc = tmp_count / nr + 1;
-          else
-            nc = tmp_count / nr;
-
-          if (tmp_count < nr)
-            nr = tmp_count;
-        }
+      fread_result_dims (read_to_eof, tmp_count, nr, nc);
 
       if (tmp_count > std::numeric_limits<octave_idx_type>::max ())
         error ("fread: number of elements read exceeds max index size");
@@ -6833,15 +7281,17 @@ convert_ints (const T *data, void *conv_data, octave_idx_type n_elts,
 
   val_type *vt_data = static_cast<val_type *> (conv_data);
 
-  for (octave_idx_type i = 0; i < n_elts; i++)
-    {
-      // Yes, we want saturation semantics when converting to an integer type.
-      V val (data[i]);
+  // Yes, we want saturation semantics when converting to an integer type.
 
-      vt_data[i] = val.value ();
-
-      if (swap)
-        swap_bytes<sizeof (val_type)> (&vt_data[i]);
+  if (swap)
+    {
+      for (octave_idx_type i = 0; i < n_elts; i++)
+        vt_data[i] = byte_swapped (V (data[i]).value ());
+    }
+  else
+    {
+      for (octave_idx_type i = 0; i < n_elts; i++)
+        vt_data[i] = V (data[i]).value ();
     }
 }
 
@@ -6929,12 +7379,10 @@ convert_data (const T *data, void *conv_data, octave_idx_type n_elts,
         float *vt_data = static_cast<float *> (conv_data);
 
         for (octave_idx_type i = 0; i < n_elts; i++)
-          {
-            vt_data[i] = data[i];
+          vt_data[i] = data[i];
 
-            if (do_float_conversion)
-              do_float_format_conversion (&vt_data[i], 1, flt_fmt);
-          }
+        if (do_float_conversion)
+          do_float_format_conversion (vt_data, n_elts, flt_fmt);
       }
       break;
 
@@ -6943,12 +7391,10 @@ convert_data (const T *data, void *conv_data, octave_idx_type n_elts,
         double *vt_data = static_cast<double *> (conv_data);
 
         for (octave_idx_type i = 0; i < n_elts; i++)
-          {
-            vt_data[i] = data[i];
+          vt_data[i] = data[i];
 
-            if (do_float_conversion)
-              do_double_format_conversion (&vt_data[i], 1, flt_fmt);
-          }
+        if (do_float_conversion)
+          do_double_format_conversion (vt_data, n_elts, flt_fmt);
       }
       break;
 
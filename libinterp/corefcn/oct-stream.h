@@ -112,6 +112,20 @@ public:
 
   virtual std::ostream * output_stream () { return nullptr; }
 
+  // If the derived class provides these functions, read() will return
+  // arrays that share memory with the stream instead of copying the
+  // data when no conversion is needed.  MAPPED_ELEMENTS returns the
+  // number of elements of size ELT_SIZE available from the current
+  // position, or -1 if the data can not be shared.  MAPPED_READ returns
+  // an NR by NC array of type DT and advances the stream position past
+  // it, or an undefined value on failure.
+
+  virtual octave_idx_type mapped_elements (std::size_t) const
+  { return -1; }
+
+  virtual octave_value
+  mapped_read (oct_data_conv::data_type, octave_idx_type, octave_idx_type);
+
   // Return either the original output stream or one wrapped with the
   // encoding facet.
 
@@ -0,0 +1,666 @@
+////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2024 The Octave Project Developers
+//
+// See the file COPYRIGHT.md in the top-level directory of this
+// distribution or <https://octave.org/copyright/>.
+//
+// This file is part of Octave.
+//
+// Octave is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Octave is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Octave; see the file COPYING.  If not, see
+// <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////
+
+#if defined (HAVE_CONFIG_H)
+#  include "config.h"
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <vector>
+
+#include "CNDArray.h"
+#include "dNDArray.h"
+#include "fCNDArray.h"
+#include "fNDArray.h"
+#include "lo-mappers.h"
+#include "oct-cmplx.h"
+#include "sparse-util.h"
+
+#include "Cell.h"
+#include "defun.h"
+#include "error.h"
+#include "ovl.h"
+
+OCTAVE_BEGIN_NAMESPACE(octave)
+
+// Order statistics of the columns of a full matrix, computed by
+// selecting the elements of the required ranks instead of sorting.
+// Elements are compared with operator <, which orders complex values
+// by their absolute value and then by their argument, as sort does.
+
+template <typename T>
+static bool
+order_less (const T& a, const T& b)
+{
+  return a < b;
+}
+
+// Rearrange V[LO], ..., V[HI-1] so that the elements whose ranks are in
+// the increasing list RB, ..., RE-1 are in their sorted positions.  The
+// middle rank is selected first, which splits both the range and the
+// list of ranks for the two halves.
+
+template <typename T>
+static void
+select_ranks (T *v, octave_idx_type lo, octave_idx_type hi,
+              const octave_idx_type *rb, const octave_idx_type *re)
+{
+  while (rb != re)
+    {
+      const octave_idx_type *mid = rb + (re - rb) / 2;
+
+      std::nth_element (v + lo, v + *mid, v + hi, order_less<T>);
+
+      select_ranks (v, lo, *mid, rb, mid);
+
+      lo = *mid + 1;
+      rb = mid + 1;
+    }
+}
+
+// Copy the N elements of X that are not NaN to V, in order, and return
+// their number.
+
+template <typename T>
+static octave_idx_type
+copy_non_nan (const T *x, octave_idx_type n, T *v)
+{
+  octave_idx_type m = 0;
+
+  for (octave_idx_type i = 0; i < n; i++)
+    {
+      if (! math::isnan (x[i]))
+        v[m++] = x[i];
+    }
+
+  return m;
+}
+
+// Call FCN (JB, JE) for ranges of the NC columns of NR elements each,
+// on several threads if COST operations per element are worth it.
+
+static void
+column_blocks (octave_idx_type nr, octave_idx_type nc, double cost,
+               const std::function<void (octave_idx_type,
+                                         octave_idx_type)>& fcn)
+{
+  int nt = sparse_kernel_threads (cost * nr * nc);
+
+  if (nt <= 1 || nc <= 1)
+    {
+      fcn (0, nc);
+      return;
+    }
+
+  // The columns of a full matrix are balanced like those of a sparse
+  // matrix with all of its elements.
+  std::vector<octave_idx_type> cidx (nc + 1);
+  for (octave_idx_type j = 0; j <= nc; j++)
+    cidx[j] = j * nr;
+
+  sparse_column_blocks (cidx.data (), nc, nt, fcn);
+}
+
+// The zero-based ranks A <= B of the sorted non-NaN elements of a
+// column of M >= 1 of them, and the weight W of B, from which METHOD
+// computes the quantile P.  Methods 1 and 3 take one element, method 2
+// the mean of two, and the others the interpolation (1-W)*S[A] + W*S[B].
+
+static void
+quantile_ranks (double p, octave_idx_type m, int method,
+                octave_idx_type& a, octave_idx_type& b, double& w)
+{
+  double dm = m;
+
+  w = 0;
+
+  switch (method)
+    {
+    case 1:
+      a = b = std::max (std::ceil (p * dm), 1.0) - 1;
+      return;
+
+    case 2:
+      a = std::max (std::ceil (p * dm), 1.0) - 1;
+      b = std::min (std::floor (p * dm + 1), dm) - 1;
+      return;
+
+    case 3:
+      // Used by SAS, method PCTLDEF=2.
+      a = b = math::roundb (std::max (p * dm, 1.0)) - 1;
+      return;
+
+    default:
+      break;
+    }
+
+  double pos = 0;
+
+  switch (method)
+    {
+    case 4:
+      pos = p * dm;
+      break;
+
+    case 5:
+      // Used by Matlab.
+      pos = p * dm + 0.5;
+      break;
+
+    case 6:
+      // Used by Minitab and SPSS.
+      pos = p * (dm + 1);
+      break;
+
+    case 7:
+      // Used by S and R.
+      pos = p * (dm - 1) + 1;
+      break;
+
+    case 8:
+      // Median unbiased.
+      pos = p * (dm + 1.0/3) + 1.0/3;
+      break;
+
+    case 9:
+      // Approximately unbiased respecting order statistics.
+      pos = p * (dm + 0.25) + 0.375;
+      break;
+    }
+
+  // Interval indices.  A single value is its own neighbor.
+  double pi = std::max (std::min (std::floor (pos), dm - 1), 1.0);
+  w = std::max (std::min (pos - pi, 1.0), 0.0);
+
+  a = static_cast<octave_idx_type> (pi) - 1;
+  b = (m > 1 ? a + 1 : a);
+}
+
+template <typename AT>
+static AT
+quantile_select (const AT& x, const NDArray& p, int method)
+{
+  using T = typename AT::element_type;
+  using R = decltype (std::abs (T ()));
+
+  const dim_vector dv = x.dims ();
+  octave_idx_type xr = dv(0);
+  octave_idx_type xc = dv.numel (1);
+  octave_idx_type np = p.numel ();
+
+  AT retval (dim_vector (np, xc));
+
+  const T *px = x.data ();
+  const double *pp = p.data ();
+  T *pq = retval.rwdata ();
+
+  const T nan = numeric_limits<R>::NaN ();
+  const T inf = numeric_limits<R>::Inf ();
+
+  double cost = 2 * (1 + std::log2 (2.0 * np + 1));
+
+  column_blocks (xr, xc, cost, [=] (octave_idx_type jb, octave_idx_type je)
+  {
+    std::vector<T> buf (xr);
+    std::vector<octave_idx_type> ranks;
+    ranks.reserve (2 * np);
+
+    T *v = buf.data ();
+
+    for (octave_idx_type j = jb; j < je; j++)
+      {
+        const T *xj = px + j * xr;
+        T *qj = pq + j * np;
+
+        octave_idx_type m = (xr == 1 ? 0 : copy_non_nan (xj, xr, v));
+
+        octave_idx_type a, b;
+        double w;
+
+        ranks.clear ();
+        for (octave_idx_type k = 0; k < np; k++)
+          {
+            if (m > 0 && pp[k] >= 0 && pp[k] <= 1)
+              {
+                quantile_ranks (pp[k], m, method, a, b, w);
+                ranks.push_back (a);
+                ranks.push_back (b);
+              }
+          }
+
+        std::sort (ranks.begin (), ranks.end ());
+        ranks.erase (std::unique (ranks.begin (), ranks.end ()),
+                     ranks.end ());
+
+        select_ranks (v, 0, m, ranks.data (), ranks.data () + ranks.size ());
+
+        for (octave_idx_type k = 0; k < np; k++)
+          {
+            double pk = pp[k];
+
+            if (pk < 0)
+              qj[k] = -inf;
+            else if (pk > 1)
+              qj[k] = inf;
+            else if (! (pk >= 0))
+              qj[k] = nan;
+            else if (xr == 1)
+              qj[k] = xj[0];
+            else if (m == 0)
+              qj[k] = nan;
+            else
+              {
+                quantile_ranks (pk, m, method, a, b, w);
+
+                if (method == 1 || method == 3)
+                  qj[k] = v[a];
+                else if (method == 2)
+                  qj[k] = (v[a] + v[b]) / static_cast<R> (2);
+                else
+                  qj[k] = (static_cast<R> (1 - w) * v[a]
+                           + static_cast<R> (w) * v[b]);
+              }
+          }
+      }
+  });
+
+  return retval;
+}
+
+DEFUN (__quantile_select__, args, ,
+       doc: /* -*- texinfo -*-
+@deftypefn {} {@var{q} =} __quantile_select__ (@var{x}, @var{p}, @var{method})
+Undocumented internal function.
+@end deftypefn */)
+{
+  // Compute the quantiles P of each column of X with one of the nine
+  // methods of quantile, ignoring NaN.  Q has one row per element of P.
+  // Elements of P below 0 or above 1 give -Inf or Inf.  The order
+  // statistics that the method needs are selected for all of P at
+  // once, and the columns are handled by several threads.
+
+  if (args.length () != 3)
+    print_usage ();
+
+  octave_value x = args(0);
+
+  if (! (x.isnumeric () || x.islogical ()))
+    error ("quantile: X must be a numeric or logical array");
+
+  const NDArray p = args(1).array_value ();
+
+  int method = args(2).xint_value ("quantile: METHOD must be an integer");
+
+  if (method < 1 || method > 9)
+    error ("quantile: Unknown METHOD, '%d'", method);
+
+  if (x.is_single_type ())
+    {
+      if (x.iscomplex ())
+        return ovl (quantile_select (x.float_complex_array_value (), p,
+                                     method));
+      else
+        return ovl (quantile_select (x.float_array_value (), p, method));
+    }
+  else
+    {
+      if (x.iscomplex ())
+        return ovl (quantile_select (x.complex_array_value (), p, method));
+      else
+        return ovl (quantile_select (x.array_value (), p, method));
+    }
+}
+
+// The mean of the middle elements A <= B of a column, which is +/-Inf or
+// NaN if either of them is infinite.  Real values of the same sign are
+// averaged without overflow.
+
+template <typename T>
+static T
+middle_value (T a, T b)
+{
+  if (math::isinf (a) || math::isinf (b))
+    return a + b;
+  else if ((a < 0) != (b < 0))
+    return (a + b) / 2;
+  else
+    return a + (b - a) / 2;
+}
+
+template <typename T>
+static std::complex<T>
+middle_value (const std::complex<T>& a, const std::complex<T>& b)
+{
+  if (math::isinf (a) || math::isinf (b))
+    return a + b;
+  else
+    return (a + b) / static_cast<T> (2);
+}
+
+template <typename AT>
+static AT
+median_select (const AT& x, bool omitnan)
+{
+  using T = typename AT::element_type;
+  using R = decltype (std::abs (T ()));
+
+  const dim_vector dv = x.dims ();
+  octave_idx_type xr = dv(0);
+  octave_idx_type xc = dv.numel (1);
+
+  AT retval (dim_vector (1, xc));
+
+  const T *px = x.data ();
+  T *pm = retval.rwdata ();
+
+  const T nan = numeric_limits<R>::NaN ();
+
+  column_blocks (xr, xc, 4, [=] (octave_idx_type jb, octave_idx_type je)
+  {
+    std::vector<T> buf (xr);
+    T *v = buf.data ();
+
+    for (octave_idx_type j = jb; j < je; j++)
+      {
+        octave_idx_type m = copy_non_nan (px + j * xr, xr, v);
+
+        if (m == 0 || (m < xr && ! omitnan))
+          {
+            pm[j] = nan;
+            continue;
+          }
+
+        octave_idx_type rank[2] = { (m - 1) / 2, m / 2 };
+        int nr = (m % 2 ? 1 : 2);
+
+        select_ranks (v, 0, m, rank, rank + nr);
+
+        pm[j] = (nr == 1 ? v[rank[0]] : middle_value (v[rank[0]], v[rank[1]]));
+      }
+  });
+
+  return retval;
+}
+
+DEFUN (__median_select__, args, ,
+       doc: /* -*- texinfo -*-
+@deftypefn {} {@var{m} =} __median_select__ (@var{x}, @var{omitnan})
+Undocumented internal function.
+@end deftypefn */)
+{
+  // Compute the median of each column of the floating point array X.
+  // A column with NaN has a NaN median unless OMITNAN is true, in
+  // which case the NaN elements are ignored.  Only the one or two
+  // middle elements of each column are selected.
+
+  if (args.length () != 2)
+    print_usage ();
+
+  octave_value x = args(0);
+
+  if (! x.isfloat ())
+    error ("median: X must be a floating point array");
+
+  bool omitnan = args(1).xbool_value ("median: OMITNAN must be a logical value");
+
+  if (x.is_single_type ())
+    {
+      if (x.iscomplex ())
+        return ovl (median_select (x.float_complex_array_value (), omitnan));
+      else
+        return ovl (median_select (x.float_array_value (), omitnan));
+    }
+  else
+    {
+      if (x.iscomplex ())
+        return ovl (median_select (x.complex_array_value (), omitnan));
+      else
+        return ovl (median_select (x.array_value (), omitnan));
+    }
+}
+
+template <typename AT>
+static octave_value_list
+mode_runs (const AT& x, int nargout)
+{
+  using T = typename AT::element_type;
+
+  const dim_vector dv = x.dims ();
+  octave_idx_type xr = dv(0);
+  octave_idx_type xc = dv.numel (1);
+
+  AT m (dim_vector (1, xc));
+  NDArray f (dim_vector (1, xc));
+
+  bool want_values = (nargout > 2);
+  std::vector<std::vector<T>> values (want_values ? xc : 0);
+
+  const T *px = x.data ();
+  T *pm = m.rwdata ();
+  double *pf = f.rwdata ();
+
+  double cost = 2 * std::log2 (xr + 1.0);
+
+  column_blocks (xr, xc, cost, [=, &values] (octave_idx_type jb,
+                                             octave_idx_type je)
+  {
+    std::vector<T> buf (xr);
+    T *v = buf.data ();
+
+    for (octave_idx_type j = jb; j < je; j++)
+      {
+        const T *xj = px + j * xr;
+
+        // The NaN elements follow the others, in order, and each of
+        // them is a value that occurs once, as after sort.
+        std::copy_n (xj, xr, v);
+        octave_idx_type nn
+          = std::stable_partition (v, v + xr, [] (const T& y)
+                                   { return ! math::isnan (y); }) - v;
+
+        std::stable_sort (v, v + nn, order_less<T>);
+
+        octave_idx_type best = (nn < xr ? 1 : 0);
+        T mode = (nn < xr ? v[nn] : T ());
+
+        for (octave_idx_type i = 0; i < nn; )
+          {
+            octave_idx_type k = i + 1;
+            while (k < nn && v[k] == v[i])
+              k++;
+
+            if (k - i > best || (k - i == best && i == 0))
+              {
+                best = k - i;
+                mode = v[i];
+              }
+
+            i = k;
+          }
+
+        pm[j] = mode;
+        pf[j] = best;
+
+        if (want_values)
+          {
+            std::vector<T>& c = values[j];
+
+            for (octave_idx_type i = 0; i < nn; )
+              {
+                octave_idx_type k = i + 1;
+                while (k < nn && v[k] == v[i])
+                  k++;
+
+                if (k - i == best)
+                  c.push_back (v[i]);
+
+                i = k;
+              }
+
+            if (best == 1)
+              c.insert (c.end (), v + nn, v + xr);
+          }
+      }
+  });
+
+  octave_value_list retval (nargout > 1 ? nargout : 1);
+
+  retval(0) = m;
+
+  if (nargout > 1)
+    retval(1) = f;
+
+  if (want_values)
+    {
+      Cell c (dim_vector (1, xc));
+
+      for (octave_idx_type j = 0; j < xc; j++)
+        {
+          const std::vector<T>& cj = values[j];
+
+          AT a (dim_vector (cj.size (), 1));
+          std::copy (cj.begin (), cj.end (), a.rwdata ());
+
+          c(j) = a;
+        }
+
+      retval(2) = c;
+    }
+
+  return retval;
+}
+
+DEFUN (__mode_runs__, args, nargout,
+       doc: /* -*- texinfo -*-
+@deftypefn {} {[@var{m}, @var{f}, @var{c}] =} __mode_runs__ (@var{x})
+Undocumented internal function.
+@end deftypefn */)
+{
+  // Compute the mode M of each column of the floating point array X,
+  // the smallest of its most frequent values, with their frequency F
+  // and the cell array C of the column vectors of all of the most
+  // frequent values, as mode does.  Each column is sorted on its own,
+  // and the columns are handled by several threads.
+
+  if (args.length () != 1)
+    print_usage ();
+
+  octave_value x = args(0);
+
+  if (! x.isfloat ())
+    error ("mode: X must be a floating point array");
+
+  if (x.is_single_type ())
+    {
+      if (x.iscomplex ())
+        return mode_runs (x.float_complex_array_value (), nargout);
+      else
+        return mode_runs (x.float_array_value (), nargout);
+    }
+  else
+    {
+      if (x.iscomplex ())
+        return mode_runs (x.complex_array_value (), nargout);
+      else
+        return mode_runs (x.array_value (), nargout);
+    }
+}
+
+/*
+%!test
+%! x = [3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5]';
+%! s = sort (x);
+%! assert (__quantile_select__ (x, [0, 0.5, 1], 1), [s(1); s(6); s(11)]);
+%! assert (__quantile_select__ (x, [-1, NaN, 2], 5), [-Inf; NaN; Inf]);
+
+## All methods agree with interpolation in the sorted columns
+%!test
+%! x = rand (37, 6);
+%! x(3:7:end) = NaN;
+%! x(:,6) = NaN;
+%! p = [0, 0.1, 0.25, 0.5, 0.5, 0.9, 1];
+%! for method = 1:9
+%!   q = __quantile_select__ (x, p, method);
+%!   for j = 1:columns (x)
+%!     s = sort (x(! isnan (x(:,j)), j));
+%!     m = numel (s);
+%!     for k = 1:numel (p)
+%!       if (m == 0)
+%!         assert (q(k,j), NaN);
+%!         continue;
+%!       endif
+%!       switch (method)
+%!         case 1
+%!           e = s(max (ceil (p(k)*m), 1));
+%!         case 2
+%!           e = (s(max (ceil (p(k)*m), 1)) + s(min (floor (p(k)*m+1), m))) / 2;
+%!         case 3
+%!           e = s(roundb (max (p(k)*m, 1)));
+%!         otherwise
+%!           pos = [p(k)*m, p(k)*m+0.5, p(k)*(m+1), p(k)*(m-1)+1, ...
+%!                  p(k)*(m+1/3)+1/3, p(k)*(m+0.25)+0.375](method-3);
+%!           i = max (min (floor (pos), m-1), 1);
+%!           w = max (min (pos - i, 1), 0);
+%!           e = (1-w) * s(i) + w * s(i+1);
+%!       endswitch
+%!       assert (q(k,j), e, 4*eps);
+%!     endfor
+%!   endfor
+%! endfor
+
+%!assert (class (__quantile_select__ (single ([1; 2]), 0.5, 5)), "single")
+%!assert (__quantile_select__ (int8 ([1; 2; 4]), 0.5, 5), 2)
+%!assert (__quantile_select__ ([1, NaN, 3], 0.5, 5), [1, NaN, 3])
+%!error <Unknown METHOD> __quantile_select__ (1:3, 0.5, 10)
+
+%!test
+%! x = [4, 2, NaN, 1; 3, 8, 6, 5; 1, 7, 5, NaN; 2, 5, 4, 2];
+%! assert (__median_select__ (x, false), [2.5, 6, NaN, NaN]);
+%! assert (__median_select__ (x, true), [2.5, 6, 5, 2]);
+%! assert (__median_select__ ([1; Inf; Inf; 2], false), Inf);
+%! assert (__median_select__ ([1; -Inf; Inf; 2], false), 1.5);
+%! assert (__median_select__ ([-Inf; Inf], false), NaN);
+%! assert (__median_select__ ([realmax; realmax], false), realmax);
+%! assert (__median_select__ (NaN (3, 1), true), NaN);
+%! assert (class (__median_select__ (single ([1; 2]), false)), "single");
+
+%!test
+%! x = [1, 2, 2, NaN, 3, 3, 0]';
+%! [m, f, c] = __mode_runs__ ([x, [NaN; NaN; 1; 4; 4; 1; 4]]);
+%! assert (m, [2, 4]);
+%! assert (f, [2, 3]);
+%! assert (c, {[2; 3], 4});
+%! [m, f, c] = __mode_runs__ ([NaN; 2; NaN; 1]);
+%! assert (m, 1);
+%! assert (f, 1);
+%! assert (c, {[1; 2; NaN; NaN]});
+%! [m, f] = __mode_runs__ (NaN (2, 1));
+%! assert (m, NaN);
+%! assert (f, 1);
+*/
+
+OCTAVE_END_NAMESPACE(octave)
@@ -159,6 +159,13 @@ do_rand (const octave_value_list& args, int nargin, const char *fcn,
               retval = rand::seed ();
             else if (s_arg == "state" || s_arg == "twister")
               retval = rand::state (fcn);
+            else if (s_arg == "generator")
+              retval = rand::generator ();
+            else if (s_arg == "substream")
+              retval = static_cast<double> (rand::substream ());
+            else if (s_arg == "sampling")
+              retval = (rand::sequential_sampling () ? "sequential"
+                                                     : "batched");
             else if (s_arg == "uniform")
               rand::uniform_distribution ();
             else if (s_arg == "normal")
@@ -277,6 +284,37 @@ do_rand (const octave_value_list& args, int nargin, const char *fcn,
                     rand::state (s, fcn);
                   }
               }
+            else if (ts == "generator")
+              {
+                std::string g = args(idx+1).xstring_value ("%s: generator must be a string", fcn);
+
+                rand::generator (g);
+              }
+            else if (ts == "sampling")
+              {
+                std::string m = args(idx+1).xstring_value ("%s: sampling method must be a string", fcn);
+
+                if (m == "sequential")
+                  rand::sequential_sampling (true);
+                else if (m == "batched")
+                  rand::sequential_sampling (false);
+                else
+                  error (R"(%s: sampling method must be "batched" or "sequential")", fcn);
+              }
+            else if (ts == "substream")
+              {
+                if (args(idx+1).is_string ())
+                  rand::substream (args(idx+1).string_value ());
+                else
+                  {
+                    double d = args(idx+1).xdouble_value ("%s: substream must be a string or an integer", fcn);
+
+                    if (! math::isinteger (d) || d < 0 || d > 4294967295.0)
+                      error ("%s: substream must be an integer between 0 and 2^32-1", fcn);
+
+                    rand::substream (static_cast<uint32_t> (d));
+                  }
+              }
             else
               error ("%s: unrecognized string argument", fcn);
           }
@@ -368,6 +406,12 @@ DEFUN (rand, args, ,
 @deftypefnx {} {@var{v} =} rand ("seed")
 @deftypefnx {} {} rand ("seed", @var{v})
 @deftypefnx {} {} rand ("seed", "reset")
+@deftypefnx {} {@var{g} =} rand ("generator")
+@deftypefnx {} {} rand ("generator", @var{g})
+@deftypefnx {} {@var{id} =} rand ("substream")
+@deftypefnx {} {} rand ("substream", @var{id})
+@deftypefnx {} {@var{method} =} rand ("sampling")
+@deftypefnx {} {} rand ("sampling", @var{method})
 Return a matrix with random elements uniformly distributed on the
 interval (0, 1).
 
@@ -440,6 +484,49 @@ However, it should be noted that querying the seed will not cause
 The state or seed of the generator can be reset to a new random value using
 the @qcode{"reset"} keyword.
 
+The Mersenne Twister (@qcode{"twister"}, the default) can be replaced by the
+counter-based generator Philox4x32-10 with
+
+@example
+rand ("generator", "philox")
+@end example
+
+@noindent
+This applies to @code{rand}, @code{randn}, @code{rande}, @code{randg}, and
+@code{randp}.  Each random number produced by @qcode{"philox"} is computed
+from a key and its position in the sequence only, so large arrays are
+filled in parallel and the result does not depend on the number of threads.
+The state is a column vector of length 5, which holds the key, the
+substream, and the position.  Setting the state from any vector of a
+different length initializes the key with a hash of the vector and restarts
+substream 0.  @code{rand ("substream", @var{id})} switches to the independent
+substream @var{id} with the same key and restarts it.  @var{id} is either an
+integer between 0 and @math{2^{32}-1} or a name, which is hashed to an
+integer.  For example, each worker of a parallel computation can draw
+reproducible and independent numbers after
+
+@example
+@group
+rand ("generator", "philox");
+rand ("state", 42);
+rand ("substream", worker_id);
+@end group
+@end example
+
+Arrays of random numbers are drawn in batches of 256 numbers by default
+(@qcode{"batched"}).  The numbers have the same distribution as those drawn
+one at a time, but with the Mersenne Twister, arrays from @code{randn},
+@code{rande}, and @code{randg} hold them in a different order.  To get the
+same numbers as earlier versions of Octave for a given state, use
+
+@example
+rand ("sampling", "sequential")
+@end example
+
+@noindent
+This setting applies to all random number functions.  The result of the
+@qcode{"philox"} generator does not depend on it.
+
 The class of the value returned can be controlled by a trailing
 @qcode{"double"} or @qcode{"single"} argument.  These are the only valid
 classes.
@@ -524,6 +611,131 @@ classes.
 */
 
 /*
+## Philox generator
+%!test
+%! unwind_protect
+%!   rand ("generator", "philox");
+%!   assert (rand ("generator"), "philox");
+%!   rand ("state", 42);
+%!   assert (size (rand ("state")), [5, 1]);
+%!   x = rand (1, 10);
+%!   rand ("state", 42);
+%!   assert ([rand(1, 4), rand(1, 6)], x);
+%!   s = rand ("state");
+%!   y = rand (1, 3, "single");
+%!   rand ("state", s);
+%!   assert (rand (1, 3, "single"), y);
+%! unwind_protect_cleanup
+%!   rand ("generator", "twister");
+%! end_unwind_protect
+%! assert (rand ("generator"), "twister");
+
+%!test  # result does not depend on how an array is split
+%! unwind_protect
+%!   rand ("generator", "philox");
+%!   randn ("state", 1);
+%!   x = randn (1e5, 1);
+%!   randn ("state", 1);
+%!   assert ([randn(3e4, 1); randn(7e4, 1)], x);
+%!   randg ("state", 1);
+%!   x = randg (0.5, 1e4, 1);
+%!   randg ("state", 1);
+%!   assert ([randg(0.5, 10, 1); randg(0.5, 9990, 1)], x);
+%! unwind_protect_cleanup
+%!   rand ("generator", "twister");
+%! end_unwind_protect
+
+%!test  # substreams
+%! unwind_protect
+%!   rand ("generator", "philox");
+%!   rand ("state", 7);
+%!   rand ("substream", 1);
+%!   assert (rand ("substream"), 1);
+%!   a = rand (1, 5);
+%!   rand ("substream", 2);
+%!   b = rand (1, 5);
+%!   assert (all (a != b));
+%!   rand ("substream", 1);
+%!   assert (rand (1, 5), a);
+%!   rand ("substream", "worker");
+%!   c = rand (1, 5);
+%!   rand ("substream", "worker");
+%!   assert (rand (1, 5), c);
+%! unwind_protect_cleanup
+%!   rand ("generator", "twister");
+%! end_unwind_protect
+
+%!test  # fixed output, pins the rounds and the key schedule
+%! unwind_protect
+%!   rand ("generator", "philox");
+%!   ## Key 0, substream 0, position 0.  Element 0 is the Random123
+%!   ## known-answer vector for Philox4x32-10 with zero key and counter,
+%!   ## [0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8].
+%!   rand ("state", zeros (5, 1));
+%!   x = rand (1, 3);
+%!   a = double (bitshift (0x6627e8d5, -5));
+%!   b = double (bitshift (0xe169c58d, -6));
+%!   assert (x(1), (a*2^26 + b) / 2^53);
+%!   assert (x, [0.39904647231489565, 0.97224120320447616, ...
+%!               0.01944942265336036]);
+%!   rand ("state", zeros (5, 1));
+%!   y = rand (1, 3, "single");
+%!   assert (y(1), single (double (bitand (0x6627e8d5, 0xffffff)) / 2^24));
+%!   assert (y, single ([0.155896485, 0.893747568, 0.979052126]));
+%! unwind_protect_cleanup
+%!   rand ("generator", "twister");
+%! end_unwind_protect
+
+## Batched and sequential sampling
+%!test
+%! unwind_protect
+%!   rand ("sampling", "sequential");
+%!   assert (rand ("sampling"), "sequential");
+%!   randn ("state", 1);
+%!   x = randn (1000, 1);
+%!   randn ("state", 1);
+%!   y = arrayfun (@(k) randn (), (1:1000)');
+%!   assert (x, y);
+%!   rande ("state", 1);
+%!   x = rande (1000, 1, "single");
+%!   rande ("state", 1);
+%!   y = arrayfun (@(k) rande ("single"), (1:1000)');
+%!   assert (x, y);
+%!   randg ("state", 1);
+%!   x = randg (0.5, 1000, 1);
+%!   randg ("state", 1);
+%!   y = arrayfun (@(k) randg (0.5), (1:1000)');
+%!   assert (x, y);
+%! unwind_protect_cleanup
+%!   rand ("sampling", "batched");
+%! end_unwind_protect
+%! assert (rand ("sampling"), "batched");
+%! randn ("state", 1);
+%! x = randn (1e5, 1);
+%! assert (mean (x), 0, 0.02);
+%! assert (std (x), 1, 0.02);
+%! randg ("state", 1);
+%! x = randg (3, 1e5, 1);
+%! assert (mean (x), 3, 0.05);
+%! assert (var (x), 3, 0.1);
+
+%!test  # batched Philox numbers are the same as those drawn one by one
+%! unwind_protect
+%!   rand ("generator", "philox");
+%!   randn ("state", 3);
+%!   x = randn (1000, 1);
+%!   randn ("state", 3);
+%!   y = arrayfun (@(k) randn (), (1:1000)');
+%!   assert (x, y);
+%! unwind_protect_cleanup
+%!   rand ("generator", "twister");
+%! end_unwind_protect
+
+%!error <sampling method must be> rand ("sampling", "foo")
+%!error <invalid generator> rand ("generator", "foo")
+%!error <substream must be an integer> rand ("substream", -1)
+%!error <substreams require the "philox" generator> rand ("substream", 1)
+
 ## Test out-of-range values as rand() seeds.
 %!function v = __rand_sample__ (initval)
 %!  rand ("state", initval);
@@ -40,6 +40,7 @@
 #include "error.h"
 #include "errwarn.h"
 #include "oct-map.h"
+#include "ov-packed-cellstr.h"
 #include "ovl.h"
 #include "utils.h"
 
@@ -357,29 +358,38 @@ parse_options (regexp::opts& options, const octave_value_list& args,
     }
 }
 
-static octave_value_list
-octregexp (const octave_value_list& args, int nargout,
-           const std::string& who, bool case_insensitive = false)
-{
-  octave_value_list retval;
-
-  int nargin = args.length ();
-
-  // Make sure we have string, pattern
-  const std::string buffer = args(0).string_value ();
+// Compile the pattern ARGS(1) with the options ARGS(2:end).
 
+static regexp
+compile_regexp (const octave_value_list& args, const std::string& who,
+                bool case_insensitive, regexp::opts& options,
+                bool& extra_options)
+{
   std::string pattern = args(1).string_value ();
 
   // Rewrite pattern for PCRE
   pattern = do_regexp_ptn_string_escapes (pattern, args(1).is_sq_string ());
 
-  regexp::opts options;
   options.case_insensitive (case_insensitive);
-  bool extra_options = false;
+  extra_options = false;
   parse_options (options, args, who, 2, extra_options);
 
-  const regexp::match_data rx_lst
-    = regexp::match (pattern, buffer, options, who);
+  return regexp (pattern, options, who);
+}
+
+// Match the compiled pattern RX against BUFFER.  ARGS are the arguments
+// that RX was compiled from.
+
+static octave_value_list
+octregexp (const regexp& rx, const std::string& buffer,
+           const regexp::opts& options, bool extra_options,
+           const octave_value_list& args, int nargout)
+{
+  octave_value_list retval;
+
+  int nargin = args.length ();
+
+  const regexp::match_data rx_lst = rx.match (buffer);
 
   string_vector named_pats = rx_lst.named_patterns ();
 
@@ -541,6 +551,53 @@ octregexp (const octave_value_list& args, int nargout,
   return retval;
 }
 
+static octave_value_list
+octregexp (const octave_value_list& args, int nargout,
+           const std::string& who, bool case_insensitive = false)
+{
+  // Make sure we have string, pattern
+  const std::string buffer = args(0).string_value ();
+
+  regexp::opts options;
+  bool extra_options = false;
+  regexp rx = compile_regexp (args, who, case_insensitive, options,
+                              extra_options);
+
+  return octregexp (rx, buffer, options, extra_options, args, nargout);
+}
+
+// Match every string of the cell array STR with the compiled pattern RX
+// and store the outputs in the cell arrays RESULTS.  The strings of a
+// packed cell array are used without converting it to a Cell first.
+
+static void
+cellregexp (const octave_value& str, const regexp& rx,
+            const regexp::opts& options, bool extra_options,
+            const octave_value_list& args, int nargout, Cell *results)
+{
+  const packed_strings *ps = octave_packed_cellstr::strings_of (str);
+
+  Cell cellstr;
+  if (! ps)
+    cellstr = str.cell_value ();
+
+  dim_vector dv = (ps ? ps->dims () : cellstr.dims ());
+  octave_idx_type n = dv.numel ();
+
+  for (int j = 0; j < nargout; j++)
+    results[j].resize (dv);
+
+  for (octave_idx_type i = 0; i < n; i++)
+    {
+      octave_value_list tmp
+        = octregexp (rx, ps ? ps->elem (i) : cellstr(i).string_value (),
+                     options, extra_options, args, nargout);
+
+      for (int j = 0; j < nargout; j++)
+        results[j](i) = tmp(j);
+    }
+}
+
 static octave_value_list
 octcellregexp (const octave_value_list& args, int nargout,
                const std::string& who, bool case_insensitive = false)
@@ -551,29 +608,27 @@ octcellregexp (const octave_value_list& args, int nargout,
     {
       OCTAVE_LOCAL_BUFFER (Cell, newretval, nargout);
       octave_value_list new_args = args;
-      Cell cellstr = args(0).cell_value ();
-      if (args(1).iscell ())
-        {
-          Cell cellpat = args(1).cell_value ();
 
-          if (cellpat.numel () == 1)
-            {
-              for (int j = 0; j < nargout; j++)
-                newretval[j].resize (cellstr.dims ());
+      if (! args(1).iscell () || args(1).numel () == 1)
+        {
+          if (args(1).iscell ())
+            new_args(1) = args(1).cell_value ()(0);
 
-              new_args(1) = cellpat(0);
+          // Compile the pattern once for all strings.
+          regexp::opts options;
+          bool extra_options = false;
+          regexp rx = compile_regexp (new_args, who, case_insensitive,
+                                      options, extra_options);
 
-              for (octave_idx_type i = 0; i < cellstr.numel (); i++)
-                {
-                  new_args(0) = cellstr(i);
-                  octave_value_list tmp = octregexp (new_args, nargout, who,
-                                                     case_insensitive);
+          cellregexp (args(0), rx, options, extra_options, new_args,
+                      nargout, newretval);
+        }
+      else
+        {
+          Cell cellstr = args(0).cell_value ();
+          Cell cellpat = args(1).cell_value ();
 
-                  for (int j = 0; j < nargout; j++)
-                    newretval[j](i) = tmp(j);
-                }
-            }
-          else if (cellstr.numel () == 1)
+          if (cellstr.numel () == 1)
             {
               for (int j = 0; j < nargout; j++)
                 newretval[j].resize (cellpat.dims ());
@@ -613,24 +668,11 @@ octcellregexp (const octave_value_list& args, int nargout,
           else
             error ("regexp: cell array arguments must be scalar or equal size");
         }
-      else
-        {
-          for (int j = 0; j < nargout; j++)
-            newretval[j].resize (cellstr.dims ());
-
-          for (octave_idx_type i = 0; i < cellstr.numel (); i++)
-            {
-              new_args(0) = cellstr(i);
-              octave_value_list tmp = octregexp (new_args, nargout, who,
-                                                 case_insensitive);
-
-              for (int j = 0; j < nargout; j++)
-                newretval[j](i) = tmp(j);
-            }
-        }
 
+      // Outputs that are cell arrays of strings, such as the matches
+      // with the "once" option, are packed.
       for (int j = 0; j < nargout; j++)
-        retval(j) = octave_value (newretval[j]);
+        retval(j) = octave_packed_cellstr::maybe_pack (newretval[j]);
     }
   else if (args(1).iscell ())
     {
@@ -652,7 +694,7 @@ octcellregexp (const octave_value_list& args, int nargout,
         }
 
       for (int j = 0; j < nargout; j++)
-        retval(j) = octave_value (newretval[j]);
+        retval(j) = octave_packed_cellstr::maybe_pack (newretval[j]);
     }
   else
     retval = octregexp (args, nargout, who, case_insensitive);
@@ -1214,6 +1256,39 @@ comprehensive list of @code{regexp} operator syntax see the
 %!assert <*62705> (regexpi ('<n>', '\(?<n\>\)?'), 1)
 %!assert <62705> (regexpi ('<n>a', '\(?<n\>a\)?'), 1)
 
+## Compiled patterns are shared between calls with the same pattern
+%!test
+%! str = {"ab12", "cd", "AB3"};
+%! [tok, nm] = regexp (str, '(?<w>[a-z]+)(?<d>\d*)', "tokens", "names");
+%! for i = 1:numel (str)
+%!   [t1, n1] = regexp (str{i}, '(?<w>[a-z]+)(?<d>\d*)', "tokens", "names");
+%!   assert (tok{i}, t1);
+%!   assert (nm{i}, n1);
+%! endfor
+%! assert (nm{1}, struct ("w", "ab", "d", "12"));
+%! assert (regexp (str, '[a-z]+', "match", "ignorecase"),
+%!         {{"ab"}, {"cd"}, {"AB"}});
+%! assert (regexp (str, '[a-z]+', "match"), {{"ab"}, {"cd"}, cell (1, 0)});
+%! assert (regexp (str, '[a-z]+', "match", "once"), {"ab", "cd", ""});
+%!test
+%! str = repmat ({"key=value; other=thing"}, 1, 300);
+%! [k, v] = regexp (str, '(\w+)=(\w+)', "tokens", "match", "once");
+%! assert (all (strcmp (v, "key=value")));
+%! assert (k{end}(:).', {"key", "value"});
+%!assert (regexp ({"a1", "b"}, {'\d'}), {2, zeros (1, 0)})
+
+## Packed cell arrays of strings
+%!test
+%! str = cellstr (["ab12"; "cd  "; "AB3 "]);
+%! m = regexp (str, '[a-z]+', "match", "once");
+%! assert (typeinfo (m), "packed_cellstr");
+%! assert (m, {"ab"; "cd"; ""});
+%! assert (regexp (str, '\d+', "match"), {{"12"}; cell(1, 0); {"3"}});
+%! r = regexprep (str, '\d', "#");
+%! assert (typeinfo (r), "packed_cellstr");
+%! assert (r, {"ab##"; "cd"; "AB#"});
+%!error <unrecognized option> regexp ({"a1", "b"}, 'a', "BadArg")
+
 ## Test input validation
 %!error regexp ('string', 'tri', 'BadArg')
 %!error regexp ('string')
@@ -1524,7 +1599,10 @@ function.
           ret(i) = new_args(0);
         }
 
-      retval = (args(0).iscell () ? ovl (ret) : ovl (ret(0)));
+      if (args(0).iscell ())
+        retval = ovl (octave_packed_cellstr::maybe_pack (ret));
+      else
+        retval = ovl (ret(0));
     }
   else
     retval = octregexprep (args, "regexprep");
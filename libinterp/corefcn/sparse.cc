@@ -41,6 +41,7 @@
 #include "ov-re-sparse.h"
 #include "ov-cx-sparse.h"
 #include "ov-bool-sparse.h"
+#include "ov-spassembler.h"
 
 OCTAVE_BEGIN_NAMESPACE(octave)
 
@@ -88,6 +89,7 @@ DEFUN (sparse, args, ,
 @deftypefnx {} {@var{S} =} sparse (@var{i}, @var{j}, @var{sv}, @var{m}, @var{n})
 @deftypefnx {} {@var{S} =} sparse (@var{i}, @var{j}, @var{sv}, @var{m}, @var{n}, "unique")
 @deftypefnx {} {@var{S} =} sparse (@var{i}, @var{j}, @var{sv}, @var{m}, @var{n}, @var{nzmax})
+@deftypefnx {} {@var{S} =} sparse (@var{P}, @var{sv})
 Create a sparse matrix from a full matrix @var{A} or row, column, value
 triplets.
 
@@ -122,6 +124,11 @@ be ignored as the default behavior is to sum values at repeated locations.
 @code{sparse (@var{m}, @var{n})} will create an empty @var{m}x@var{n} sparse
 matrix and is equivalent to @code{sparse ([], [], [], @var{m}, @var{n})}
 
+@code{sparse (@var{P}, @var{sv})} creates the sparse matrix with the
+values @var{sv} and the indices stored in the sparse assembler @var{P}.
+@xref{XREFspassembler,,@code{spassembler}}, for the fast repeated assembly
+of matrices with the same indices.
+
 The optional final argument reserves space for @var{nzmax} values in the sparse
 array and is useful if the eventual number of nonzero values will be greater
 than the number of values in @var{sv} used during the initial construction of
@@ -168,8 +175,8 @@ sparse (@var{i}, @var{j}, @var{sv}, 3, 4, "unique")
      (2, 2) ->  5
 @end group
 @end example
-@seealso{full, accumarray, spalloc, spdiags, speye, spones, sprand, sprandn,
-sprandsym, spconvert, spfun}
+@seealso{full, accumarray, spalloc, spassembler, spdiags, speye, spones,
+sprand, sprandn, sprandsym, spconvert, spfun}
 @end deftypefn */)
 {
   int nargin = args.length ();
@@ -197,6 +204,14 @@ sprandsym, spconvert, spfun}
       else
         err_wrong_type_arg ("sparse", arg);
     }
+  else if (nargin == 2
+           && args(0).type_id () == octave_sparse_assembler::static_type_id ())
+    {
+      const octave_sparse_assembler& p
+        = dynamic_cast<const octave_sparse_assembler&> (args(0).get_rep ());
+
+      retval = p.assemble (args(1));
+    }
   else if (nargin == 2)
     {
       octave_idx_type m = args(0).strict_idx_type_value ("sparse: M must be a non-negative integer");
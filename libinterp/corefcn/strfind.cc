@@ -28,11 +28,10 @@
 #endif
 
 #include <algorithm>
-#include <deque>
-#include <limits>
 #include <string>
+#include <vector>
 
-#include "oct-locbuf.h"
+#include "str-search.h"
 
 #include "Cell.h"
 #include "builtin-defun-decls.h"
@@ -40,114 +39,61 @@
 #include "errwarn.h"
 #include "error.h"
 #include "ov.h"
+#include "ov-packed-cellstr.h"
 #include "unwind-prot.h"
 #include "utils.h"
 
 OCTAVE_BEGIN_NAMESPACE(octave)
 
-// This allows safe indexing with char.
-// In C++, char may be (and often is) signed!
-#define ORD(ch) static_cast<unsigned char> (ch)
-#define TABSIZE (std::numeric_limits<unsigned char>::max () + 1)
+// The zero-based positions of MATCHES as a row vector, or a 0x0 array
+// if there are none.
 
-// This is the quick search algorithm, as described at
-// http://www-igm.univ-mlv.fr/~lecroq/string/node19.html
-static void
-qs_preprocess (const Array<char>& needle,
-               octave_idx_type *table)
+static Array<octave_idx_type>
+match_array (const std::vector<octave_idx_type>& matches)
 {
-  const char *x = needle.data ();
-  octave_idx_type m = needle.numel ();
+  octave_idx_type nmatch = matches.size ();
+  octave_idx_type one = 1;
+  Array<octave_idx_type> result (dim_vector (std::min (one, nmatch), nmatch));
+  std::copy (matches.begin (), matches.end (), result.rwdata ());
 
-  for (octave_idx_type i = 0; i < TABSIZE; i++)
-    table[i] = m + 1;
-  for (octave_idx_type i = 0; i < m; i++)
-    table[ORD(x[i])] = m - i;
+  return result;
 }
 
 static Array<octave_idx_type>
-qs_search (const Array<char>& needle,
-           const Array<char>& haystack,
-           const octave_idx_type *table,
-           bool overlaps = true)
+find_matches (const string_searcher& searcher,
+              const char *y, octave_idx_type n,
+              bool overlaps = true)
 {
-  const char *x = needle.data ();
-  octave_idx_type m = needle.numel ();
-  const char *y = haystack.data ();
-  octave_idx_type n = haystack.numel ();
-
-  // We'll use deque because it typically has the most favorable properties for
-  // the operation we need.
-  std::deque<octave_idx_type> accum;
-  if (m == 1)
-    {
-      // Looking for a single character.
-      for (octave_idx_type i = 0; i < n; i++)
-        {
-          if (y[i] == x[0])
-            accum.push_back (i);
-        }
-    }
-  else if (m == 2)
-    {
-      // Two characters.
-      if (overlaps)
-        {
-          for (octave_idx_type i = 0; i < n-1; i++)
-            {
-              if (y[i] == x[0] && y[i+1] == x[1])
-                accum.push_back (i);
-            }
-        }
-      else
-        {
-          for (octave_idx_type i = 0; i < n-1; i++)
-            {
-              if (y[i] == x[0] && y[i+1] == x[1])
-                accum.push_back (i++);
-            }
-        }
-    }
-  else if (n >= m)
-    {
-      // General case.
-      octave_idx_type j = 0;
+  std::vector<octave_idx_type> accum;
+  searcher.find_all (y, n, accum, overlaps);
 
-      if (overlaps)
-        {
-          while (j < n - m)
-            {
-              if (std::equal (x, x + m, y + j))
-                accum.push_back (j);
-              j += table[ORD(y[j + m])];
-            }
-        }
-      else
-        {
-          while (j < n - m)
-            {
-              if (std::equal (x, x + m, y + j))
-                {
-                  accum.push_back (j);
-                  j += m;
-                }
-              else
-                j += table[ORD(y[j + m])];
-            }
-        }
+  return match_array (accum);
+}
 
-      if (j == n - m && std::equal (x, x + m, y + j))
-        accum.push_back (j);
-    }
+static Array<octave_idx_type>
+find_matches (const string_searcher& searcher,
+              const Array<char>& haystack,
+              bool overlaps = true)
+{
+  return find_matches (searcher, haystack.data (), haystack.numel (),
+                       overlaps);
+}
 
-  octave_idx_type nmatch = accum.size ();
-  octave_idx_type one = 1;
-  Array<octave_idx_type> result (dim_vector (std::min (one, nmatch), nmatch));
-  octave_idx_type k = 0;
-  for (const auto& idx : accum)
-    result.xelem (k++) = idx;
+// Searching for several patterns in one pass uses an automaton with
+// 256 transitions per character of the patterns.  Fall back to one
+// search per pattern if that would take too much memory.
+static const octave_idx_type multi_search_max_chars = 16384;
 
-  return result;
+static octave_idx_type
+multi_search_chars (const octave_value& pats)
+{
+  const Array<std::string> p = pats.cellstr_value ();
+
+  octave_idx_type retval = 0;
+  for (octave_idx_type i = 0; i < p.numel (); i++)
+    retval += p(i).length ();
+
+  return retval;
 }
 
 DEFUN (strfind, args, ,
@@ -242,9 +188,8 @@ strfind ("abababa", "aba", "forcecelloutput", true)
 
   if (argpat.is_string ())
     {
-      Array<char> needle = argpat.char_array_value ();
-      OCTAVE_LOCAL_BUFFER (octave_idx_type, table, TABSIZE);
-      qs_preprocess (needle, table);
+      const Array<char> needle = argpat.char_array_value ();
+      const string_searcher searcher (needle.data (), needle.numel ());
 
       if (argstr.is_string ())
         {
@@ -252,13 +197,35 @@ strfind ("abababa", "aba", "forcecelloutput", true)
             // Return a null matrix for null pattern for MW compatibility
             retval = Matrix ();
           else
-            retval = octave_value (qs_search (needle,
-                                              argstr.char_array_value (),
-                                              table, overlaps),
+            retval = octave_value (find_matches (searcher,
+                                                 argstr.char_array_value (),
+                                                 overlaps),
                                    true, true);
           if (forcecelloutput)
             retval = Cell (retval);
         }
+      else if (const packed_strings *ps
+                 = octave_packed_cellstr::strings_of (argstr))
+        {
+          // Search the characters of the packed strings in place, with
+          // the same searcher for all of them.
+
+          Cell retc (ps->dims ());
+          octave_idx_type ns = ps->numel ();
+
+          for (octave_idx_type i = 0; i < ns; i++)
+            {
+              if (argpat.isempty ())
+                retc(i) = Matrix ();
+              else
+                retc(i) = octave_value (find_matches (searcher, ps->data (i),
+                                                      ps->length (i),
+                                                      overlaps),
+                                        true, true);
+            }
+
+          retval = retc;
+        }
       else if (argstr.iscell ())
         {
           const Cell argsc = argstr.cell_value ();
@@ -274,9 +241,9 @@ strfind ("abababa", "aba", "forcecelloutput", true)
               if (argpat.isempty ())
                 retc(i) = Matrix ();
               else
-                retc(i) = octave_value (qs_search (needle,
-                                                   argse.char_array_value (),
-                                                   table, overlaps),
+                retc(i) = octave_value (find_matches (searcher,
+                                                      argse.char_array_value (),
+                                                      overlaps),
                                         true, true);
             }
 
@@ -285,6 +252,39 @@ strfind ("abababa", "aba", "forcecelloutput", true)
       else
         error ("strfind: first argument must be a string or cell array of strings");
     }
+  else if (argpat.iscellstr () && argstr.is_string ()
+           && multi_search_chars (argpat) <= multi_search_max_chars)
+    {
+      // Search for all patterns in one pass over the string.
+
+      const Array<std::string> pats = argpat.cellstr_value ();
+      octave_idx_type np = pats.numel ();
+
+      const multi_string_searcher
+        searcher (std::vector<std::string> (pats.data (), pats.data () + np));
+
+      const Array<char> str = argstr.char_array_value ();
+      std::vector<std::vector<octave_idx_type>> matches;
+      searcher.find_all (str.data (), str.numel (), matches, overlaps);
+
+      Cell retc (pats.dims ());
+
+      for (octave_idx_type k = 0; k < np; k++)
+        {
+          octave_value idx;
+          if (pats(k).empty ())
+            idx = Matrix ();
+          else
+            idx = octave_value (match_array (matches[k]), true, true);
+
+          if (forcecelloutput)
+            retc(k) = Cell (idx);
+          else
+            retc(k) = idx;
+        }
+
+      retval = retc;
+    }
   else if (argpat.iscell ())
     retval = do_simple_cellfun (Fstrfind, "strfind", args);
   else
@@ -307,6 +307,19 @@ strfind ("abababa", "aba", "forcecelloutput", true)
 %!assert (strfind ("abc", ""), [])
 %!assert (strfind ("abc", {"", "b", ""}), {[], 2, []})
 %!assert (strfind ({"abc", "def"}, ""), {[], []})
+%!assert (strfind (cellstr (["abababa"; "bla    "; "       "]), "a"),
+%!        {[1, 3, 5, 7]; 3; zeros (0, 0)})
+%!assert (strfind (cellstr (["abababa"; "bla    "]), "aba", "overlaps", false),
+%!        {[1, 5]; []})
+%!assert (strfind ("abcabcabcabcabcabcabc", "cabcab"), [3, 9, 15])
+%!assert (strfind ("abcabcabcabcabcabcabc", "cabcab", "overlaps", false),
+%!        [3, 15])
+%!assert (strfind ([repmat("x", 1, 40), "0123456789abcdefghij"],
+%!                 "0123456789abcdefghij"), 41)
+%!assert (strfind ("aaaa", {"aa"; "a"; "b"; ""}), {[1, 2, 3]; 1:4; []; []})
+%!assert (strfind ("aaaa", {"aa", "aaa"}, "overlaps", false), {[1, 3], 1})
+%!assert (strfind ("abab", {"ab", "b"}, "forcecelloutput", true),
+%!        {{[1, 3]}, {[2, 4]}})
 
 %!error strfind ()
 %!error strfind ("foo", "bar", 1)
@@ -317,21 +330,19 @@ strfind ("abababa", "aba", "forcecelloutput", true)
 */
 
 static Array<char>
-qs_replace (const Array<char>& str, const Array<char>& pat,
-            const Array<char>& rep,
-            const octave_idx_type *table,
-            bool overlaps = true)
+replace_matches (const Array<char>& str, const string_searcher& searcher,
+                 const Array<char>& rep, bool overlaps = true)
 {
   Array<char> ret = str;
 
   octave_idx_type siz = str.numel ();
-  octave_idx_type psiz = pat.numel ();
+  octave_idx_type psiz = searcher.length ();
   octave_idx_type rsiz = rep.numel ();
 
   if (psiz != 0)
     {
       // Look up matches, without overlaps.
-      const Array<octave_idx_type> idx = qs_search (pat, str, table, overlaps);
+      const Array<octave_idx_type> idx = find_matches (searcher, str, overlaps);
       octave_idx_type nidx = idx.numel ();
 
       if (nidx)
@@ -443,13 +454,12 @@ strrep ("This is a test string", "is", "&%$")
       const Array<char> pat = argpat.char_array_value ();
       const Array<char> rep = argrep.char_array_value ();
 
-      OCTAVE_LOCAL_BUFFER (octave_idx_type, table, TABSIZE);
-      qs_preprocess (pat, table);
+      const string_searcher searcher (pat.data (), pat.numel ());
 
       if (argstr.is_string ())
         if (argstr.rows () == 1)  // most common case of a single string
-          retval = qs_replace (argstr.char_array_value (), pat, rep,
-                               table, overlaps);
+          retval = replace_matches (argstr.char_array_value (), searcher,
+                                    rep, overlaps);
         else
           {
             const charMatrix argchm = argstr.char_matrix_value ();
@@ -460,13 +470,34 @@ strrep ("This is a test string", "is", "&%$")
             for (octave_idx_type i = 0; i < nel; i++)
               {
                 charMatrix rowchm;
-                rowchm = qs_replace (argchm.extract (i, 0, i, nc-1),
-                                     pat, rep, table, overlaps);
+                rowchm = replace_matches (argchm.extract (i, 0, i, nc-1),
+                                          searcher, rep, overlaps);
                 retchm.insert (rowchm, i, 0);
               }
 
             retval = retchm;
           }
+      else if (const packed_strings *ps
+                 = octave_packed_cellstr::strings_of (argstr))
+        {
+          // The result elements are strings again, so they are packed
+          // as well.
+
+          Array<std::string> rets (ps->dims ());
+          octave_idx_type nel = ps->numel ();
+
+          for (octave_idx_type i = 0; i < nel; i++)
+            {
+              Array<char> si (dim_vector (1, ps->length (i)));
+              std::copy_n (ps->data (i), ps->length (i), si.rwdata ());
+
+              Array<char> ri = replace_matches (si, searcher, rep, overlaps);
+
+              rets.xelem (i) = std::string (ri.data (), ri.numel ());
+            }
+
+          retval = new octave_packed_cellstr (packed_strings (rets));
+        }
       else if (argstr.iscell ())
         {
           const Cell argcell = argstr.cell_value ();
@@ -478,8 +509,8 @@ strrep ("This is a test string", "is", "&%$")
 
           for (octave_idx_type i = 0; i < nel; i++)
             {
-              retcell(i) = qs_replace (argcell(i).char_array_value (),
-                                       pat, rep, table, overlaps);
+              retcell(i) = replace_matches (argcell(i).char_array_value (),
+                                            searcher, rep, overlaps);
             }
 
           retval = retcell;
@@ -506,6 +537,11 @@ strrep ("This is a test string", "is", "&%$")
 %!                char ("Hello Jane", "Goodbye Jane"))
 
 %!assert (size (strrep ("a", "a", "")), [0 0])
+%!test
+%! c = strrep (cellstr (["Hello World  "; "Goodbye World"; "World        "]),
+%!             "World", "");
+%! assert (c, {"Hello "; "Goodbye "; ""});
+%! assert (size (c{3}), [0, 0]);
 
 %!error strrep ()
 %!error strrep ("A")
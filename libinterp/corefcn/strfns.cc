@@ -31,6 +31,7 @@
 
 #include <queue>
 #include <sstream>
+#include <string_view>
 
 #include "dMatrix.h"
 #include "localcharset-wrapper.h"
@@ -42,6 +43,7 @@
 #include "error.h"
 #include "errwarn.h"
 #include "ov.h"
+#include "ov-packed-cellstr.h"
 #include "ovl.h"
 #include "unwind-prot.h"
 #include "utils.h"
@@ -318,17 +320,120 @@ Return true if @var{x} is a character array.
 %!error ischar ("test", 1)
 */
 
+typedef bool (*string_view_op) (const std::string_view&,
+                                const std::string_view&,
+                                std::string_view::size_type);
+
+// Compare the elements of packed cell arrays of strings in place.  One
+// of P0 and P1 is not null.  The other argument is a packed cell array
+// or a character array.  The results are the same as those of the
+// comparison of the cell arrays.
+
+static octave_value
+do_packed_strcmp_fcn (const octave_value& arg0, const octave_value& arg1,
+                      const packed_strings *p0, const packed_strings *p1,
+                      octave_idx_type n, const char *fcn_name,
+                      string_view_op view_op)
+{
+  if (! p0 || ! p1)
+    {
+      const packed_strings& cell = (p0 ? *p0 : *p1);
+      const string_vector str = (p0 ? arg1 : arg0).string_vector_value ();
+      octave_idx_type r = str.numel ();
+      octave_idx_type nel = cell.numel ();
+
+      if (r == 0 || r == 1)
+        {
+          // Broadcast the string.
+
+          boolNDArray output (cell.dims ());
+          bool *out = output.rwdata ();
+
+          std::string s = (r == 0 ? "" : str[0]);
+          std::string_view sv (s);
+
+          for (octave_idx_type i = 0; i < nel; i++)
+            out[i] = view_op (cell.view (i), sv, n);
+
+          return output;
+        }
+      else if (nel == 1)
+        {
+          // Broadcast the cell.
+
+          boolNDArray output (dim_vector (r, 1));
+          bool *out = output.rwdata ();
+
+          std::string_view sv = cell.view (0);
+
+          for (octave_idx_type i = 0; i < r; i++)
+            out[i] = view_op (str[i], sv, n);
+
+          return output;
+        }
+      else if (nel == r)
+        {
+          boolNDArray output (cell.dims ());
+          bool *out = output.rwdata ();
+
+          for (octave_idx_type i = 0; i < r; i++)
+            out[i] = view_op (str[i], cell.view (i), n);
+
+          return output;
+        }
+      else
+        return false;
+    }
+
+  // Make the second array the singleton one, if any.
+
+  const packed_strings& cell1 = (p0->numel () == 1 ? *p1 : *p0);
+  const packed_strings& cell2 = (p0->numel () == 1 ? *p0 : *p1);
+
+  octave_idx_type r1 = cell1.numel ();
+
+  boolNDArray output (cell1.dims ());
+  bool *out = output.rwdata ();
+
+  if (cell2.numel () == 1)
+    {
+      // Broadcast cell2.
+
+      std::string_view sv = cell2.view (0);
+
+      for (octave_idx_type i = 0; i < r1; i++)
+        out[i] = view_op (cell1.view (i), sv, n);
+    }
+  else
+    {
+      if (cell1.dims () != cell2.dims ())
+        error ("%s: nonconformant cell arrays", fcn_name);
+
+      for (octave_idx_type i = 0; i < r1; i++)
+        out[i] = view_op (cell1.view (i), cell2.view (i), n);
+    }
+
+  return output;
+}
+
 static octave_value
 do_strcmp_fcn (const octave_value& arg0, const octave_value& arg1,
                octave_idx_type n, const char *fcn_name,
                bool (*array_op) (const Array<char>&, const Array<char>&,
                                  octave_idx_type),
                bool (*str_op) (const std::string&, const std::string&,
-                               std::string::size_type))
+                               std::string::size_type),
+               string_view_op view_op)
 
 {
   octave_value retval;
 
+  const packed_strings *p0 = octave_packed_cellstr::strings_of (arg0);
+  const packed_strings *p1 = octave_packed_cellstr::strings_of (arg1);
+
+  if ((p0 && (p1 || arg1.is_string ())) || (p1 && arg0.is_string ()))
+    return do_packed_strcmp_fcn (arg0, arg1, p0, p1, n, fcn_name, view_op);
+
   bool s1_string = arg0.is_string ();
   bool s1_cell = arg0.iscell ();
   bool s2_string = arg1.is_string ();
@@ -561,7 +666,8 @@ This is just the opposite of the corresponding C library function.
     print_usage ();
 
   return ovl (do_strcmp_fcn (args(0), args(1), 0, "strcmp",
-                             strcmp_ignore_n, strcmp_ignore_n));
+                             strcmp_ignore_n, strcmp_ignore_n,
+                             strcmp_ignore_n));
 }
 
 /*
@@ -609,6 +715,23 @@ This is just the opposite of the corresponding C library function.
 %!assert (strcmp ("foobar", "fooBar"), false)
 %!assert (strcmp ("fooba", "foobar"), false)
 
+## Packed cell arrays of strings
+%!shared c, d
+%! c = cellstr (["foo"; "ba "; "   "]);
+%! d = cellstr (["foo"; "bar"; "   "]);
+%!assert (strcmp (c, "foo"), [true; false; false])
+%!assert (strcmp ("", c), [false; false; true])
+%!assert (strcmp (c, ["foo"; "ba "; "xyz"]), [true; false; false])
+%!assert (strcmp (c, ["foo"; "abc"]), false)
+%!assert (strcmp (c(1), ["foo"; "abc"]), [true; false])
+%!assert (strcmp (c, d), [true; false; true])
+%!assert (strcmp (c(2), d), [false; false; false])
+%!assert (strcmp (d, c(1)), [true; false; false])
+%!assert (strncmp (c, d, 2), [true; true; true])
+%!assert (strcmpi (c, upper (d)), [true; false; true])
+%!assert (strncmpi (c, "BAR", 2), [false; true; false])
+%!error <nonconformant cell arrays> strcmp (c, d(1:2))
+
 %!error strcmp ()
 %!error strcmp ("foo", "bar", 3)
 */
@@ -652,6 +775,7 @@ This is just the opposite of the corresponding C library function.
 
   if (n > 0)
     return ovl (do_strcmp_fcn (args(0), args(1), n, "strncmp",
+                               string::strncmp,
                                string::strncmp,
                                string::strncmp));
   else
@@ -699,7 +823,8 @@ This is just the opposite of the corresponding C library function.
     print_usage ();
 
   return ovl (do_strcmp_fcn (args(0), args(1), 0, "strcmpi",
-                             strcmpi_ignore_n, strcmpi_ignore_n));
+                             strcmpi_ignore_n, strcmpi_ignore_n,
+                             strcmpi_ignore_n));
 }
 
 /*
@@ -733,6 +858,7 @@ This is just the opposite of the corresponding C library function.
 
   if (n > 0)
     return ovl (do_strcmp_fcn (args(0), args(1), n, "strncmpi",
+                               string::strncmpi,
                                string::strncmpi,
                                string::strncmpi));
   else
@@ -871,6 +997,19 @@ efficient, and avoids the security risk of using @code{eval} on unknown data.
 %!assert (str2double (''), NaN)
 %!assert (str2double ([]), NaN)
 %!assert (str2double (char (zeros (3,0))), NaN)
+%!assert (str2double ("  -0.5  "), -0.5)
+%!assert (str2double ("+.5e1"), 5)
+%!assert (str2double ("0.1"), 0.1)
+%!assert (str2double ("1.7976931348623157e308"), realmax)
+%!assert (str2double ("4.9406564584124654e-324"), 2^-1074)
+%!assert (str2double ("12345678901234567890"), 12345678901234567890)
+%!assert (str2double ("123456789.123456789e-3"), 123456.789123456789)
+%!assert (1 ./ str2double ("-0"), -Inf)
+%!assert (str2double ("1e"), NaN)
+%!assert (str2double ("1e400"), NaN)
+%!assert (str2double ("."), NaN)
+%!assert (str2double ("-inf"), -Inf)
+%!assert (str2double ("-NA"), NA)
 */
 
 DEFUN (__native2unicode__, args, ,
@@ -0,0 +1,485 @@
+////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2024 The Octave Project Developers
+//
+// See the file COPYRIGHT.md in the top-level directory of this
+// distribution or <https://octave.org/copyright/>.
+//
+// This file is part of Octave.
+//
+// Octave is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Octave is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Octave; see the file COPYING.  If not, see
+// <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////
+
+#if defined (HAVE_CONFIG_H)
+#  include "config.h"
+#endif
+
+#include <algorithm>
+#include <cstring>
+
+#include "zstdfstream.h"
+
+#if defined (HAVE_ZSTD)
+
+#include "lo-sysdep.h"
+#include "nproc-wrapper.h"
+
+// Number of characters kept in front of the get area for putback.
+#define STASHED_CHARACTERS 16
+
+zstdfilebuf::zstdfilebuf ()
+  : m_file (nullptr), m_io_mode (std::ios_base::openmode (0)),
+    m_cctx (nullptr), m_dctx (nullptr), m_buffer (), m_zbuffer (),
+    m_zpos (0), m_zend (0), m_pos (0), m_eof (false), m_status (0),
+    m_error ()
+{
+  this->setg (nullptr, nullptr, nullptr);
+  this->setp (nullptr, nullptr);
+}
+
+zstdfilebuf::~zstdfilebuf ()
+{
+  if (this->is_open ())
+    this->close ();
+}
+
+bool
+zstdfilebuf::setcompression (int comp_level)
+{
+  if (! m_cctx)
+    return false;
+
+  return ! ZSTD_isError (ZSTD_CCtx_setParameter (m_cctx,
+                                                 ZSTD_c_compressionLevel,
+                                                 comp_level));
+}
+
+zstdfilebuf *
+zstdfilebuf::open (const char *name, std::ios_base::openmode mode)
+{
+  if (this->is_open ())
+    return nullptr;
+
+  bool testi = mode & std::ios_base::in;
+  bool testo = mode & std::ios_base::out;
+  bool testa = mode & (std::ios_base::app | std::ios_base::ate);
+
+  // Only sequential reading or writing is possible
+  if (testi == testo)
+    return nullptr;
+
+  const char *char_mode = (testi ? "rb" : (testa ? "ab" : "wb"));
+
+  m_file = octave::sys::fopen (name, char_mode);
+
+  if (! m_file)
+    return nullptr;
+
+  m_io_mode = mode;
+  m_zpos = 0;
+  m_zend = 0;
+  m_pos = 0;
+  m_eof = false;
+  m_status = 0;
+  m_error.clear ();
+
+  if (testi)
+    {
+      m_dctx = ZSTD_createDCtx ();
+
+      m_buffer.resize (ZSTD_DStreamOutSize () + STASHED_CHARACTERS);
+      m_zbuffer.resize (ZSTD_DStreamInSize ());
+
+      this->setg (m_buffer.data (), m_buffer.data (), m_buffer.data ());
+    }
+  else
+    {
+      m_cctx = ZSTD_createCCtx ();
+
+      if (m_cctx)
+        {
+          // Fails harmlessly if libzstd was built without thread support.
+          unsigned long nthreads
+            = octave_num_processors_wrapper (OCTAVE_NPROC_CURRENT_OVERRIDABLE);
+
+          if (nthreads > 1)
+            ZSTD_CCtx_setParameter (m_cctx, ZSTD_c_nbWorkers, nthreads);
+        }
+
+      m_buffer.resize (ZSTD_CStreamInSize ());
+      m_zbuffer.resize (ZSTD_CStreamOutSize ());
+
+      this->setp (m_buffer.data (), m_buffer.data () + m_buffer.size ());
+    }
+
+  if (! m_cctx && ! m_dctx)
+    {
+      std::fclose (m_file);
+      m_file = nullptr;
+      return nullptr;
+    }
+
+  return this;
+}
+
+zstdfilebuf *
+zstdfilebuf::close ()
+{
+  if (! this->is_open ())
+    return nullptr;
+
+  zstdfilebuf *retval = this;
+
+  if (m_cctx)
+    {
+      if (this->sync () == -1 || ! compress (nullptr, 0, ZSTD_e_end))
+        retval = nullptr;
+
+      ZSTD_freeCCtx (m_cctx);
+      m_cctx = nullptr;
+    }
+
+  if (m_dctx)
+    {
+      ZSTD_freeDCtx (m_dctx);
+      m_dctx = nullptr;
+    }
+
+  if (std::fclose (m_file) != 0)
+    retval = nullptr;
+
+  m_file = nullptr;
+  m_io_mode = std::ios_base::openmode (0);
+
+  this->setg (nullptr, nullptr, nullptr);
+  this->setp (nullptr, nullptr);
+
+  return retval;
+}
+
+zstdfilebuf::int_type
+zstdfilebuf::underflow ()
+{
+  if (this->gptr () && (this->gptr () < this->egptr ()))
+    return traits_type::to_int_type (*(this->gptr ()));
+
+  // A decompression error fails every further read
+  if (! m_dctx || ! m_error.empty ())
+    return traits_type::eof ();
+
+  // Keep the last few characters for putback
+  std::size_t stash = 0;
+  if (this->eback () && this->gptr () > this->eback ())
+    {
+      stash = std::min (static_cast<std::size_t> (this->gptr ()
+                                                  - this->eback ()),
+                        static_cast<std::size_t> (STASHED_CHARACTERS));
+      std::memmove (m_buffer.data (), this->gptr () - stash, stash);
+    }
+
+  std::ptrdiff_t bytes_read = decompress (m_buffer.data () + stash,
+                                          m_buffer.size () - stash);
+
+  if (bytes_read <= 0)
+    {
+      this->setg (m_buffer.data (), m_buffer.data (), m_buffer.data ());
+      return traits_type::eof ();
+    }
+
+  m_pos += bytes_read;
+
+  this->setg (m_buffer.data (), m_buffer.data () + stash,
+              m_buffer.data () + stash + bytes_read);
+
+  return traits_type::to_int_type (*(this->gptr ()));
+}
+
+zstdfilebuf::int_type
+zstdfilebuf::pbackfail (int_type c)
+{
+  if (! m_dctx)
+    return traits_type::eof ();
+
+  off_type pos = m_pos - (this->egptr () - this->gptr ()) - 1;
+
+  if (pos < 0 || this->seekoff (pos, std::ios_base::beg) == pos_type (-1))
+    return traits_type::eof ();
+
+  // Replacing characters is not supported
+  if (! traits_type::eq_int_type (c, traits_type::eof ())
+      && ! traits_type::eq (traits_type::to_char_type (c), *(this->gptr ())))
+    return traits_type::eof ();
+
+  return traits_type::not_eof (c);
+}
+
+zstdfilebuf::int_type
+zstdfilebuf::overflow (int_type c)
+{
+  if (! m_cctx)
+    return traits_type::eof ();
+
+  if (! compress (this->pbase (), this->pptr () - this->pbase (),
+                  ZSTD_e_continue))
+    return traits_type::eof ();
+
+  this->setp (m_buffer.data (), m_buffer.data () + m_buffer.size ());
+
+  if (! traits_type::eq_int_type (c, traits_type::eof ()))
+    {
+      *(this->pptr ()) = traits_type::to_char_type (c);
+      this->pbump (1);
+    }
+
+  return traits_type::not_eof (c);
+}
+
+int
+zstdfilebuf::sync ()
+{
+  if (m_cctx && this->pptr () > this->pbase ())
+    {
+      if (traits_type::eq_int_type (this->overflow (), traits_type::eof ()))
+        return -1;
+    }
+
+  return 0;
+}
+
+zstdfilebuf::pos_type
+zstdfilebuf::seekoff (off_type off, std::ios_base::seekdir way,
+                      std::ios_base::openmode)
+{
+  pos_type ret = pos_type (off_type (-1));
+
+  if (! this->is_open ())
+    return ret;
+
+  off_type cur = (m_dctx ? m_pos - (this->egptr () - this->gptr ())
+                         : m_pos + (this->pptr () - this->pbase ()));
+
+  if (off == 0 && way == std::ios_base::cur)
+    return pos_type (cur);
+
+  // Can't seek from end of a compressed file
+  if (way == std::ios_base::end)
+    return ret;
+
+  off_type target = (way == std::ios_base::beg ? off : cur + off);
+
+  if (target < 0)
+    return ret;
+
+  if (m_cctx)
+    {
+      // Fill the gap with zeros.  Seeking backward is not possible
+      // when writing.
+      if (target < cur)
+        return ret;
+
+      for (off_type i = cur; i < target; i++)
+        if (traits_type::eq_int_type (this->sputc (0), traits_type::eof ()))
+          return ret;
+
+      return pos_type (target);
+    }
+
+  off_type buf_start = m_pos - (this->egptr () - this->eback ());
+
+  if (target >= buf_start && target <= m_pos)
+    {
+      this->setg (this->eback (), this->egptr () - (m_pos - target),
+                  this->egptr ());
+      return pos_type (target);
+    }
+
+  if (target < buf_start && ! rewind ())
+    return ret;
+
+  // Decompress and discard data up to TARGET
+  while (m_pos < target)
+    {
+      this->setg (this->eback (), this->egptr (), this->egptr ());
+
+      if (traits_type::eq_int_type (this->underflow (), traits_type::eof ()))
+        return ret;
+    }
+
+  this->setg (this->eback (), this->egptr () - (m_pos - target),
+              this->egptr ());
+
+  return pos_type (target);
+}
+
+zstdfilebuf::pos_type
+zstdfilebuf::seekpos (pos_type sp, std::ios_base::openmode mode)
+{
+  return this->seekoff (off_type (sp), std::ios_base::beg, mode);
+}
+
+std::ptrdiff_t
+zstdfilebuf::decompress (char *buf, std::size_t len)
+{
+  ZSTD_outBuffer out = { buf, len, 0 };
+
+  while (out.pos < out.size)
+    {
+      if (m_zpos == m_zend)
+        {
+          if (! m_eof)
+            {
+              m_zpos = 0;
+              m_zend = std::fread (m_zbuffer.data (), 1, m_zbuffer.size (),
+                                   m_file);
+
+              if (m_zend == 0)
+                m_eof = true;
+            }
+
+          if (m_eof)
+            {
+              // A nonzero status means that the last frame is not
+              // complete.  Report it once the data before it is used.
+              if (m_status != 0 && out.pos == 0)
+                {
+                  m_error = "truncated zstd frame";
+                  return -1;
+                }
+
+              break;
+            }
+        }
+
+      ZSTD_inBuffer in = { m_zbuffer.data (), m_zend, m_zpos };
+
+      m_status = ZSTD_decompressStream (m_dctx, &out, &in);
+
+      m_zpos = in.pos;
+
+      if (ZSTD_isError (m_status))
+        {
+          m_error = ZSTD_getErrorName (m_status);
+          return -1;
+        }
+    }
+
+  return out.pos;
+}
+
+bool
+zstdfilebuf::compress (const char *data, std::size_t n,
+                       ZSTD_EndDirective end_op)
+{
+  ZSTD_inBuffer in = { data, n, 0 };
+
+  for (;;)
+    {
+      ZSTD_outBuffer out = { m_zbuffer.data (), m_zbuffer.size (), 0 };
+
+      std::size_t remaining = ZSTD_compressStream2 (m_cctx, &out, &in,
+                                                    end_op);
+
+      if (ZSTD_isError (remaining))
+        return false;
+
+      if (out.pos > 0
+          && std::fwrite (m_zbuffer.data (), 1, out.pos, m_file) != out.pos)
+        return false;
+
+      if (end_op == ZSTD_e_continue ? in.pos == in.size : remaining == 0)
+        break;
+    }
+
+  m_pos += n;
+
+  return true;
+}
+
+bool
+zstdfilebuf::rewind ()
+{
+  if (std::fseek (m_file, 0, SEEK_SET) != 0)
+    return false;
+
+  ZSTD_DCtx_reset (m_dctx, ZSTD_reset_session_only);
+
+  m_zpos = 0;
+  m_zend = 0;
+  m_pos = 0;
+  m_eof = false;
+  m_status = 0;
+  m_error.clear ();
+
+  this->setg (m_buffer.data (), m_buffer.data (), m_buffer.data ());
+
+  return true;
+}
+
+zstdifstream::zstdifstream ()
+  : std::istream (nullptr), m_sb ()
+{ this->init (&m_sb); }
+
+zstdifstream::zstdifstream (const char *name, std::ios_base::openmode mode)
+  : std::istream (nullptr), m_sb ()
+{
+  this->init (&m_sb);
+  this->open (name, mode);
+}
+
+void
+zstdifstream::open (const char *name, std::ios_base::openmode mode)
+{
+  if (! m_sb.open (name, (mode | std::ios_base::in) & ~std::ios_base::out))
+    this->setstate (std::ios_base::failbit);
+  else
+    this->clear ();
+}
+
+void
+zstdifstream::close ()
+{
+  if (! m_sb.close ())
+    this->setstate (std::ios_base::failbit);
+}
+
+zstdofstream::zstdofstream ()
+  : std::ostream (nullptr), m_sb ()
+{ this->init (&m_sb); }
+
+zstdofstream::zstdofstream (const char *name, std::ios_base::openmode mode)
+  : std::ostream (nullptr), m_sb ()
+{
+  this->init (&m_sb);
+  this->open (name, mode);
+}
+
+void
+zstdofstream::open (const char *name, std::ios_base::openmode mode)
+{
+  if (! m_sb.open (name, (mode | std::ios_base::out) & ~std::ios_base::in))
+    this->setstate (std::ios_base::failbit);
+  else
+    this->clear ();
+}
+
+void
+zstdofstream::close ()
+{
+  if (! m_sb.close ())
+    this->setstate (std::ios_base::failbit);
+}
+
+#endif
@@ -0,0 +1,232 @@
+////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2024 The Octave Project Developers
+//
+// See the file COPYRIGHT.md in the top-level directory of this
+// distribution or <https://octave.org/copyright/>.
+//
+// This file is part of Octave.
+//
+// Octave is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Octave is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Octave; see the file COPYING.  If not, see
+// <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////
+
+#if ! defined (octave_zstdfstream_h)
+#define octave_zstdfstream_h 1
+
+#include "octave-config.h"
+
+#if defined (HAVE_ZSTD)
+
+#include <cstddef>
+#include <cstdio>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <zstd.h>
+
+/**
+ *  @brief  Zstandard compressed file stream buffer class.
+ *
+ *  Files are read or written sequentially.  Seeking forward is emulated
+ *  by decompressing (or, when writing, by writing zeros).  Seeking
+ *  backward beyond the current buffer restarts decompression from the
+ *  beginning of the file.  Writing uses the multithreaded compressor of
+ *  libzstd when it is available.
+*/
+class zstdfilebuf : public std::streambuf
+{
+public:
+
+  zstdfilebuf ();
+
+  OCTAVE_DISABLE_COPY_MOVE (zstdfilebuf)
+
+  ~zstdfilebuf ();
+
+  /**
+   *  @brief  Set compression level.
+   *  @param  comp_level  Compression level (see ZSTD_c_compressionLevel).
+   *  @return  True on success.
+  */
+  bool
+  setcompression (int comp_level);
+
+  /**
+   *  @brief  Check if file is open.
+   *  @return  True if file is open.
+  */
+  bool
+  is_open () const { return m_file != nullptr; }
+
+  /**
+   *  @brief  Open Zstandard compressed file.
+   *  @param  name  Filename.
+   *  @param  mode  Open mode flags.
+   *  @return  @c this on success, NULL on failure.
+  */
+  zstdfilebuf *
+  open (const char *name, std::ios_base::openmode mode);
+
+  /**
+   *  @brief  Close Zstandard compressed file.
+   *  @return  @c this on success, NULL on failure.
+  */
+  zstdfilebuf *
+  close ();
+
+  /**
+   *  @brief  Get decompression error.
+   *  @return  Name of libzstd error, or empty string if there was none.
+  */
+  std::string
+  error_message () const { return m_error; }
+
+protected:
+
+  virtual int_type
+  underflow ();
+
+  virtual int_type
+  pbackfail (int_type c = traits_type::eof ());
+
+  virtual int_type
+  overflow (int_type c = traits_type::eof ());
+
+  virtual int
+  sync ();
+
+  virtual pos_type
+  seekoff (off_type off, std::ios_base::seekdir way,
+           std::ios_base::openmode mode = std::ios_base::in | std::ios_base::out);
+
+  virtual pos_type
+  seekpos (pos_type sp,
+           std::ios_base::openmode mode = std::ios_base::in | std::ios_base::out);
+
+private:
+
+  // Decompress up to LEN bytes to BUF.  Return number of bytes stored,
+  // or -1 on error.
+  std::ptrdiff_t
+  decompress (char *buf, std::size_t len);
+
+  // Compress N bytes of DATA and write any output to the file.
+  bool
+  compress (const char *data, std::size_t n, ZSTD_EndDirective end_op);
+
+  // Restart decompression at the beginning of the file.
+  bool
+  rewind ();
+
+  std::FILE *m_file;
+
+  std::ios_base::openmode m_io_mode;
+
+  ZSTD_CCtx *m_cctx;
+
+  ZSTD_DCtx *m_dctx;
+
+  // Uncompressed data (get or put area).
+  std::vector<char> m_buffer;
+
+  // Compressed data read from or to be written to the file.
+  std::vector<char> m_zbuffer;
+
+  std::size_t m_zpos;
+
+  std::size_t m_zend;
+
+  // Uncompressed offset of end of get area or beginning of put area.
+  off_type m_pos;
+
+  bool m_eof;
+
+  // Last result of ZSTD_decompressStream, zero at the end of a frame.
+  std::size_t m_status;
+
+  // Error reported by libzstd while decompressing.
+  std::string m_error;
+};
+
+/**
+ *  @brief  Zstandard compressed file input stream class.
+*/
+class zstdifstream : public std::istream
+{
+public:
+
+  zstdifstream ();
+
+  explicit
+  zstdifstream (const char *name,
+                std::ios_base::openmode mode = std::ios_base::in);
+
+  zstdfilebuf *
+  rdbuf () const
+  { return const_cast<zstdfilebuf *> (&m_sb); }
+
+  bool
+  is_open () { return m_sb.is_open (); }
+
+  void
+  open (const char *name,
+        std::ios_base::openmode mode = std::ios_base::in);
+
+  void
+  close ();
+
+private:
+
+  zstdfilebuf m_sb;
+};
+
+/**
+ *  @brief  Zstandard compressed file output stream class.
+*/
+class zstdofstream : public std::ostream
+{
+public:
+
+  zstdofstream ();
+
+  explicit
+  zstdofstream (const char *name,
+                std::ios_base::openmode mode = std::ios_base::out);
+
+  zstdfilebuf *
+  rdbuf () const
+  { return const_cast<zstdfilebuf *> (&m_sb); }
+
+  bool
+  is_open () { return m_sb.is_open (); }
+
+  void
+  open (const char *name,
+        std::ios_base::openmode mode = std::ios_base::out);
+
+  void
+  close ();
+
+private:
+
+  zstdfilebuf m_sb;
+};
+
+#endif
+
+#endif
@@ -34,11 +34,14 @@
 #  include <fftw3.h>
 #endif
 
+#include "file-ops.h"
+#include "lo-mappers.h"
 #include "oct-fftw.h"
 
 #include "defun-dld.h"
 #include "error.h"
 #include "errwarn.h"
+#include "oct-map.h"
 #include "ov.h"
 
 OCTAVE_BEGIN_NAMESPACE(octave)
@@ -49,8 +52,12 @@ DEFUN_DLD (fftw, args, ,
 @deftypefnx {} {} fftw ("planner", @var{method})
 @deftypefnx {} {@var{wisdom} =} fftw ("dwisdom")
 @deftypefnx {} {} fftw ("dwisdom", @var{wisdom})
+@deftypefnx {} {@var{file} =} fftw ("dwisdom_file")
+@deftypefnx {} {} fftw ("dwisdom_file", @var{file})
 @deftypefnx {} {@var{nthreads} =} fftw ("threads")
 @deftypefnx {} {} fftw ("threads", @var{nthreads})
+@deftypefnx {} {@var{stats} =} fftw ("cache")
+@deftypefnx {} {} fftw ("cache", @var{capacity})
 
 Manage @sc{fftw} wisdom data.
 
@@ -127,6 +134,32 @@ the wisdom data can be reloaded if it is saved to a file as described
 above.  Saved wisdom files should not be used on different platforms since
 they will not be efficient and the point of calculating the wisdom is lost.
 
+Alternatively, wisdom can be kept in a file across sessions with
+
+@example
+fftw ("dwisdom_file", @var{file})
+@end example
+
+@noindent
+which imports the wisdom in @var{file}, if it exists, and exports all
+wisdom to @var{file} when Octave exits.  This is typically done in a startup
+file such as @file{~/.octaverc}.  The option @qcode{"swisdom_file"} does the
+same for single precision wisdom.  An empty @var{file} stops exporting.
+
+Octave keeps the plans for the most recently used transform sizes so that
+alternating between a few sizes does not require planning again.
+Statistics of this cache are returned by
+
+@example
+@var{stats} = fftw ("cache")
+@end example
+
+@noindent
+as a structure with fields @qcode{"double"} and @qcode{"single"}, each
+holding the fields @qcode{"capacity"}, @qcode{"size"}, @qcode{"hits"}, and
+@qcode{"misses"}.  The number of plans kept for each precision is set with
+@code{fftw ("cache", @var{capacity})}.
+
 The number of threads used for computing the plans and executing the
 transforms can be set with
 
@@ -297,6 +330,65 @@ current process or @var{3} is used (whichever is smaller).
           retval = octave_value (wisdom_str);
         }
     }
+  else if (arg0 == "dwisdom_file" || arg0 == "swisdom_file")
+    {
+      bool dbl = (arg0 == "dwisdom_file");
+
+      std::string old_file = (dbl ? fftw_planner::wisdom_file ()
+                                  : float_fftw_planner::wisdom_file ());
+
+      if (nargin == 2)  // wisdom file setter
+        {
+          std::string file = args(1).xstring_value ("fftw: FILE must be a string");
+
+          file = sys::file_ops::tilde_expand (file);
+
+          bool ok = (dbl ? fftw_planner::wisdom_file (file)
+                         : float_fftw_planner::wisdom_file (file));
+
+          if (! ok)
+            error ("fftw: could not import wisdom from '%s'", file.c_str ());
+        }
+
+      retval = octave_value (old_file);
+    }
+  else if (arg0 == "cache")
+    {
+      fftw_plan_cache *dcache = fftw_planner::plan_cache ();
+      fftw_plan_cache *scache = float_fftw_planner::plan_cache ();
+
+      if (nargin == 2)  // cache capacity setter
+        {
+          if (! args(1).is_real_scalar ())
+            error ("fftw: CAPACITY must be a positive integer");
+
+          double capacity = args(1).double_value ();
+          if (capacity < 1 || math::x_nint (capacity) != capacity)
+            error ("fftw: CAPACITY must be a positive integer");
+
+          dcache->capacity (capacity);
+          scache->capacity (capacity);
+        }
+      else  // cache statistics getter
+        {
+          octave_scalar_map stats;
+
+          for (int i = 0; i < 2; i++)
+            {
+              fftw_plan_cache *cache = (i == 0 ? dcache : scache);
+
+              octave_scalar_map s;
+              s.assign ("capacity", static_cast<double> (cache->capacity ()));
+              s.assign ("size", static_cast<double> (cache->size ()));
+              s.assign ("hits", static_cast<double> (cache->hits ()));
+              s.assign ("misses", static_cast<double> (cache->misses ()));
+
+              stats.assign (i == 0 ? "double" : "single", s);
+            }
+
+          retval = stats;
+        }
+    }
   else if (arg0 == "threads")
     {
       if (nargin == 2)  //threads setter
@@ -380,6 +472,41 @@ current process or @var{3} is used (whichever is smaller).
 %!   fftw ("swisdom", def_swisdom);
 %! end_unwind_protect
 
+%!testif HAVE_FFTW
+%! def_file = fftw ("dwisdom_file");
+%! fname = tempname ();
+%! unwind_protect
+%!   fftw ("dwisdom_file", fname);
+%!   assert (fftw ("dwisdom_file"), fname);
+%!   assert (! exist (fname, "file"));
+%! unwind_protect_cleanup
+%!   fftw ("dwisdom_file", def_file);
+%! end_unwind_protect
+
+%!testif HAVE_FFTW
+%! s = fftw ("cache");
+%! fft (rand (4096, 1));
+%! fft (rand (512, 512));
+%! s1 = fftw ("cache");
+%! fft (rand (4096, 1));
+%! fft (rand (512, 512));
+%! s2 = fftw ("cache");
+%! assert (s2.double.hits - s1.double.hits, 2);
+%! assert (s2.double.misses, s1.double.misses);
+%! assert (s2.double.size <= s2.double.capacity);
+%! assert (isfield (s2.single, {"capacity", "size", "hits", "misses"}));
+
+%!testif HAVE_FFTW
+%! s = fftw ("cache");
+%! unwind_protect
+%!   fftw ("cache", 1);
+%!   assert (fftw ("cache").double.size <= 1);
+%!   x = rand (100, 1);
+%!   assert (ifft (fft (x)), x, 1e-14);
+%! unwind_protect_cleanup
+%!   fftw ("cache", s.double.capacity);
+%! end_unwind_protect
+
 %!testif HAVE_FFTW3_THREADS
 %! n = fftw ("threads");
 %! unwind_protect
@@ -398,6 +525,9 @@ current process or @var{3} is used (whichever is smaller).
 %!error fftw ("dwisdom", "invalid")
 %!error fftw ("swisdom", "invalid")
 %!error fftw ("threads", "invalid")
+%!error fftw ("dwisdom_file", 1)
+%!error fftw ("cache", 0)
+%!error fftw ("cache", 1.5)
 %!error fftw ("threads", -3)
  */
 
@@ -59,12 +59,15 @@ OCTAVE_VALUE_INC = \
   %reldir%/ov-mex-fcn.h \
   %reldir%/ov-null-mat.h \
   %reldir%/ov-oncleanup.h \
+  %reldir%/ov-packed-cellstr.h \
   %reldir%/ov-perm.h \
   %reldir%/ov-range-traits.h \
   %reldir%/ov-range.h \
   %reldir%/ov-re-diag.h \
   %reldir%/ov-re-mat.h \
   %reldir%/ov-scalar.h \
+  %reldir%/ov-spassembler.h \
+  %reldir%/ov-spdecomp.h \
   %reldir%/ov-str-mat.h \
   %reldir%/ov-struct.h \
   %reldir%/ov-typeinfo.h \
@@ -131,11 +134,14 @@ OCTAVE_VALUE_SRC = \
   %reldir%/ov-mex-fcn.cc \
   %reldir%/ov-null-mat.cc \
   %reldir%/ov-oncleanup.cc \
+  %reldir%/ov-packed-cellstr.cc \
   %reldir%/ov-perm.cc \
   %reldir%/ov-range.cc \
   %reldir%/ov-re-diag.cc \
   %reldir%/ov-re-mat.cc \
   %reldir%/ov-scalar.cc \
+  %reldir%/ov-spassembler.cc \
+  %reldir%/ov-spdecomp.cc \
   %reldir%/ov-str-mat.cc \
   %reldir%/ov-struct.cc \
   %reldir%/ov-typeinfo.cc \
@@ -44,6 +44,7 @@
 #include "error.h"
 #include "mxarray.h"
 #include "ov-cell.h"
+#include "ov-packed-cellstr.h"
 #include "ovl.h"
 #include "oct-hdf5.h"
 #include "unwind-prot.h"
@@ -452,8 +453,7 @@ octave_cell::sort (octave_idx_type dim, sortmode mode) const
 
   tmp = tmp.sort (dim, mode);
 
-  // We already have the cache.
-  retval = new octave_cell (tmp);
+  retval = new octave_packed_cellstr (octave::packed_strings (tmp));
 
   return retval;
 }
@@ -471,8 +471,7 @@ octave_cell::sort (Array<octave_idx_type>& sidx, octave_idx_type dim,
 
   tmp = tmp.sort (sidx, dim, mode);
 
-  // We already have the cache.
-  retval = new octave_cell (tmp);
+  retval = new octave_packed_cellstr (octave::packed_strings (tmp));
 
   return retval;
 }
@@ -1307,8 +1306,24 @@ To convert back from a cellstr to a character array use @code{char}.
     {
       string_vector s = args(0).xstring_vector_value ("cellstr: argument STRING must be a 2-D character array");
 
-      return ovl (s.isempty () ? Cell (octave_value (""))
-                               : Cell (s, true));
+      if (s.isempty ())
+        return ovl (Cell (octave_value ("")));
+
+      octave_idx_type n = s.numel ();
+
+      Array<std::string> a (dim_vector (n, 1));
+
+      for (octave_idx_type i = 0; i < n; i++)
+        {
+          const std::string& si = s[i];
+
+          std::size_t pos = si.find_last_not_of (' ');
+
+          if (pos != std::string::npos)
+            a.xelem (i) = si.substr (0, pos+1);
+        }
+
+      return ovl (new octave_packed_cellstr (octave::packed_strings (a)));
     }
 }
 
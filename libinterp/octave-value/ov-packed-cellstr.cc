@@ -0,0 +1,475 @@
+////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2024 The Octave Project Developers
+//
+// See the file COPYRIGHT.md in the top-level directory of this
+// distribution or <https://octave.org/copyright/>.
+//
+// This file is part of Octave.
+//
+// Octave is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Octave is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Octave; see the file COPYING.  If not, see
+// <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////
+
+#if defined (HAVE_CONFIG_H)
+#  include "config.h"
+#endif
+
+#include <algorithm>
+
+#include "lo-array-errwarn.h"
+
+#include "error.h"
+#include "errwarn.h"
+#include "ov-packed-cellstr.h"
+#include "ov-str-mat.h"
+#include "ovl.h"
+
+DEFINE_OV_TYPEID_FUNCTIONS_AND_DATA (octave_packed_cellstr, "packed_cellstr",
+                                     "cell");
+
+static octave_base_value *
+default_numeric_conversion_function (const octave_base_value& a)
+{
+  const octave_packed_cellstr& v
+    = dynamic_cast<const octave_packed_cellstr&> (a);
+
+  return v.full_value ().clone ();
+}
+
+octave_base_value::type_conv_info
+octave_packed_cellstr::numeric_conversion_function () const
+{
+  return octave_base_value::type_conv_info (default_numeric_conversion_function,
+         octave_cell::static_type_id ());
+}
+
+const octave::packed_strings *
+octave_packed_cellstr::strings_of (const octave_value& val)
+{
+  if (val.type_id () != static_type_id ())
+    return nullptr;
+
+  const octave_packed_cellstr& rep
+    = dynamic_cast<const octave_packed_cellstr&> (val.get_rep ());
+
+  return &rep.m_strings;
+}
+
+octave_value
+octave_packed_cellstr::maybe_pack (const Cell& c)
+{
+  octave_idx_type n = c.numel ();
+
+  // Only strings that are reproduced exactly by octave_value (STR, TYPE)
+  // are packed.
+
+  int sq_id = octave_char_matrix_sq_str::static_type_id ();
+  int dq_id = octave_char_matrix_str::static_type_id ();
+  int id = -1;
+
+  Array<octave_idx_type> offsets (dim_vector (n + 1, 1));
+  octave_idx_type *off = offsets.rwdata ();
+
+  off[0] = 0;
+  for (octave_idx_type i = 0; i < n; i++)
+    {
+      const octave_value& val = c(i);
+
+      int t = val.type_id ();
+
+      if ((t != sq_id && t != dq_id) || (id >= 0 && t != id))
+        return c;
+
+      id = t;
+
+      dim_vector dv = val.dims ();
+
+      if (dv.ndims () != 2
+          || (dv(0) == 0 ? dv(1) != 0 : (dv(0) != 1 || dv(1) == 0)))
+        return c;
+
+      off[i+1] = off[i] + dv(1);
+    }
+
+  Array<char> chars (dim_vector (off[n], 1));
+  char *pc = chars.rwdata ();
+
+  for (octave_idx_type i = 0; i < n; i++)
+    {
+      charNDArray s = c(i).char_array_value ();
+
+      std::copy_n (s.data (), off[i+1] - off[i], pc + off[i]);
+    }
+
+  return new octave_packed_cellstr (octave::packed_strings (c.dims (), chars,
+                                                            offsets),
+                                    id == dq_id ? '"' : '\'');
+}
+
+octave_base_value *
+octave_packed_cellstr::make_cell () const
+{
+  // The conversion from an array of strings also fills the cache of
+  // the cell array that marks it as a cellstr.
+
+  if (m_type == '\'')
+    return new octave_cell (m_strings.array_value ());
+
+  octave_idx_type n = m_strings.numel ();
+
+  Cell c (m_strings.dims ());
+
+  for (octave_idx_type i = 0; i < n; i++)
+    c.xelem (i) = octave_value (m_strings.elem (i), m_type);
+
+  return new octave_cell (c);
+}
+
+octave_value
+octave_packed_cellstr::fast_elem_extract (octave_idx_type n) const
+{
+  if (n < m_strings.numel ())
+    return Cell (octave_value (m_strings.elem (n), m_type));
+  else
+    return octave_value ();
+}
+
+octave_value
+octave_packed_cellstr::do_index_op (const octave_value_list& idx,
+                                    bool resize_ok)
+{
+  // Resizing fills with empty matrices, which are not strings.
+  if (resize_ok)
+    return make_value ().index_op (idx, resize_ok);
+
+  octave_value retval;
+
+  octave_idx_type n = idx.length ();
+
+  // If we catch an indexing error in index_vector, we flag an error
+  // in index k.  Ensure it is the right value before each idx_vector
+  // call.  Same variable as used in for loop in default case.
+
+  octave_idx_type k = 0;
+
+  try
+    {
+      switch (n)
+        {
+        case 0:
+          warn_empty_index ("cell array");
+          retval = make_packed (m_strings);
+          break;
+
+        case 1:
+          {
+            octave::idx_vector i = idx(0).index_vector ();
+
+            retval = make_packed (m_strings.index (i));
+          }
+          break;
+
+        case 2:
+          {
+            octave::idx_vector i = idx(0).index_vector ();
+
+            k = 1;
+            octave::idx_vector j = idx(1).index_vector ();
+
+            retval = make_packed (m_strings.index (i, j));
+          }
+          break;
+
+        default:
+          {
+            Array<octave::idx_vector> iv (dim_vector (n, 1));
+
+            for (k = 0; k < n; k++)
+              iv(k) = idx(k).index_vector ();
+
+            retval = make_packed (m_strings.index (iv));
+          }
+          break;
+        }
+    }
+  catch (octave::index_exception& ie)
+    {
+      // Rethrow to allow more info to be reported later.
+      ie.set_pos_if_unset (n, k+1);
+      throw;
+    }
+
+  return retval;
+}
+
+octave_value_list
+octave_packed_cellstr::brace_index (const octave_value_list& idx,
+                                    bool resize_ok)
+{
+  octave_value tmp = do_index_op (idx, resize_ok);
+
+  const octave::packed_strings *s = strings_of (tmp);
+
+  if (s && s->numel () == 1)
+    return ovl (octave_value (s->elem (0), m_type));
+
+  Cell tcell = tmp.cell_value ();
+
+  if (tcell.numel () == 1)
+    return ovl (tcell(0, 0));
+  else
+    {
+      // Return a comma-separated list.
+      return octave_value (octave_value_list (tcell));
+    }
+}
+
+octave_value_list
+octave_packed_cellstr::simple_subsref (char type, octave_value_list& idx, int)
+{
+  octave_value_list retval;
+
+  switch (type)
+    {
+    case '(':
+      retval(0) = do_index_op (idx);
+      break;
+
+    case '{':
+      {
+        if (idx.empty ())
+          error ("invalid empty index expression {}, use {:} instead");
+
+        retval = brace_index (idx);
+      }
+      break;
+
+    case '.':
+      {
+        std::string nm = class_name ();
+        error ("%s cannot be indexed with %c", nm.c_str (), type);
+      }
+      break;
+
+    default:
+      error ("unexpected: index not '(', '{', or '.' in octave_packed_cellstr::simple_subsref - please report this bug");
+    }
+
+  return retval;
+}
+
+octave_value_list
+octave_packed_cellstr::subsref (const std::string& type,
+                                const std::list<octave_value_list>& idx,
+                                int nargout)
+{
+  octave_value_list retval;
+
+  switch (type[0])
+    {
+    case '(':
+      retval(0) = do_index_op (idx.front ());
+      break;
+
+    case '{':
+      {
+        if (idx.front ().empty ())
+          error ("invalid empty index expression {}, use {:} instead");
+
+        retval = brace_index (idx.front ());
+      }
+      break;
+
+    case '.':
+      {
+        std::string nm = class_name ();
+        error ("%s cannot be indexed with %c", nm.c_str (), type[0]);
+      }
+      break;
+
+    default:
+      error ("unexpected: index not '(', '{', or '.' in octave_packed_cellstr::subsref - please report this bug");
+    }
+
+  if (idx.size () > 1)
+    retval = retval(0).next_subsref (nargout, type, idx);
+
+  return retval;
+}
+
+octave_value
+octave_packed_cellstr::subsref (const std::string& type,
+                                const std::list<octave_value_list>& idx,
+                                bool auto_add)
+{
+  octave_value retval;
+
+  switch (type[0])
+    {
+    case '(':
+      retval = do_index_op (idx.front (), auto_add);
+      break;
+
+    case '{':
+      retval = brace_index (idx.front (), auto_add)(0);
+      break;
+
+    case '.':
+      {
+        std::string nm = class_name ();
+        error ("%s cannot be indexed with %c", nm.c_str (), type[0]);
+      }
+      break;
+
+    default:
+      error ("unexpected: index not '(', '{', or '.' in octave_packed_cellstr::subsref - please report this bug");
+    }
+
+  if (idx.size () > 1)
+    retval = retval.next_subsref (auto_add, type, idx);
+
+  return retval;
+}
+
+octave_value
+octave_packed_cellstr::subsasgn (const std::string& type,
+                                 const std::list<octave_value_list>& idx,
+                                 const octave_value& rhs)
+{
+  // Assignments work on the cell array.  The packed strings are not
+  // needed after that.
+
+  octave_value tmp = make_value ();
+
+  m_value = octave_value ();
+
+  tmp.make_unique ();
+
+  return tmp.subsasgn (type, idx, rhs);
+}
+
+octave_value
+octave_packed_cellstr::reshape (const dim_vector& new_dims) const
+{
+  return make_packed (m_strings.reshape (new_dims));
+}
+
+octave_value
+octave_packed_cellstr::permute (const Array<int>& vec, bool inv) const
+{
+  return make_packed (m_strings.permute (vec, inv));
+}
+
+octave_value
+octave_packed_cellstr::squeeze () const
+{
+  return make_packed (m_strings.squeeze ());
+}
+
+octave_value
+octave_packed_cellstr::sort (octave_idx_type dim, sortmode mode) const
+{
+  // Sorting a cell array gives single-quoted strings.
+  return new octave_packed_cellstr (m_strings.sort (dim, mode));
+}
+
+octave_value
+octave_packed_cellstr::sort (Array<octave_idx_type>& sidx,
+                             octave_idx_type dim, sortmode mode) const
+{
+  return new octave_packed_cellstr (m_strings.sort (sidx, dim, mode));
+}
+
+/*
+%!shared c
+%! c = cellstr (["foo  "; "a    "; "     "; "bar b"]);
+
+%!assert (typeinfo (c), "packed_cellstr")
+%!assert (class (c), "cell")
+%!assert (iscellstr (c))
+%!assert (size (c), [4, 1])
+%!assert (c, {"foo"; "a"; ""; "bar b"})
+%!assert (c{1}, "foo")
+%!assert (size (c{3}), [0, 0])
+%!assert (typeinfo (c([4, 1])), "packed_cellstr")
+%!assert (c([4, 1]), {"bar b"; "foo"})
+%!assert (c(2:3)', {"a", ""})
+%!assert (reshape (c, 2, 2), {"foo", ""; "a", "bar b"})
+%!assert (permute (c, [2, 1]), {"foo", "a", "", "bar b"})
+%!assert (sizeof (c), 9)
+
+## Indexing forms only the positions of the selected elements
+%!test
+%! d = reshape (cellstr (num2str ((1:24)')), 2, 3, 4);
+%! e = cellfun (@(s) s, d, "uniformoutput", false);
+%! assert (d(:), e(:));
+%! assert (d(2, 5), e(2, 5));
+%! assert (d([1, 2], [3, 1]), e([1, 2], [3, 1]));
+%! assert (d(2, :, [4, 1]), e(2, :, [4, 1]));
+%! assert (d(end, end, end), e(end, end, end));
+%! assert (d(logical ([0, 1]), 1:2, 2), e(logical ([0, 1]), 1:2, 2));
+%!error <out of bound> c(5)
+%!error <out of bound> c(1, 2)
+
+%!test
+%! [a, b] = c{[4, 2]};
+%! assert (a, "bar b");
+%! assert (b, "a");
+
+%!test
+%! d = c;
+%! d{2} = 1;
+%! assert (typeinfo (d), "cell");
+%! assert (d, {"foo"; 1; ""; "bar b"});
+%! assert (typeinfo (c), "packed_cellstr");
+%! assert (c{2}, "a");
+
+%!test
+%! d = c;
+%! d(6) = {"x"};
+%! assert (d, {"foo"; "a"; ""; "bar b"; []; "x"});
+
+%!test
+%! [s, i] = sort (c);
+%! assert (typeinfo (s), "packed_cellstr");
+%! assert (s, {""; "a"; "bar b"; "foo"});
+%! assert (i, [3; 2; 4; 1]);
+%! [s, i] = sort (c, "descend");
+%! assert (s, {"foo"; "bar b"; "a"; ""});
+%! assert (i, [1; 4; 2; 3]);
+%! assert (issorted (sort (c)));
+%! assert (! issorted (c));
+
+%!test
+%! d = [c; {"x"}];
+%! assert (d, {"foo"; "a"; ""; "bar b"; "x"});
+%! assert (c', {"foo", "a", "", "bar b"});
+
+%!test
+%! x = cellstr (["abc"; "de "]);
+%! fname = [tempname() ".txt"];
+%! unwind_protect
+%!   save ("-text", fname, "x");
+%!   y = load (fname);
+%!   assert (y.x, {"abc"; "de"});
+%!   assert (typeinfo (y.x), "cell");
+%! unwind_protect_cleanup
+%!   unlink (fname);
+%! end_unwind_protect
+
+%!error <out of bound> c(5, 1)
+%!error <cannot be indexed with \.> c.foo
+*/
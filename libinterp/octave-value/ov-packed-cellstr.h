@@ -0,0 +1,239 @@
+////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2024 The Octave Project Developers
+//
+// See the file COPYRIGHT.md in the top-level directory of this
+// distribution or <https://octave.org/copyright/>.
+//
+// This file is part of Octave.
+//
+// Octave is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Octave is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Octave; see the file COPYING.  If not, see
+// <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////
+
+#if ! defined (octave_ov_packed_cellstr_h)
+#define octave_ov_packed_cellstr_h 1
+
+#include "octave-config.h"
+
+#include <iosfwd>
+#include <string>
+
+#include "packed-strings.h"
+
+#include "Cell.h"
+#include "ov-base.h"
+#include "ov-cell.h"
+#include "ov.h"
+
+// Cell arrays of character strings that keep all characters in one
+// buffer until the conversion to a Cell is actually needed.  Every
+// element is a row of characters or, if it is empty, a 0x0 character
+// array, all of them single-quoted or all double-quoted strings.
+
+class OCTINTERP_API octave_packed_cellstr : public octave_base_value
+{
+public:
+
+  octave_packed_cellstr ()
+    : octave_base_value (), m_strings (), m_type ('\''), m_value () { }
+
+  octave_packed_cellstr (const octave::packed_strings& s, char type = '\'')
+    : octave_base_value (), m_strings (s), m_type (type == '"' ? '"' : '\''),
+      m_value ()
+  { }
+
+  octave_packed_cellstr (const octave_packed_cellstr& c)
+    : octave_base_value (), m_strings (c.m_strings), m_type (c.m_type),
+      m_value (c.m_value)
+  { }
+
+  ~octave_packed_cellstr () = default;
+
+  octave_base_value * clone () const
+  { return new octave_packed_cellstr (*this); }
+  octave_base_value * empty_clone () const { return new octave_cell (); }
+
+  // The strings of VAL if it is a packed cell array, or nullptr.
+  static const octave::packed_strings * strings_of (const octave_value& val);
+
+  // A packed cell array with the elements of C if all of them are
+  // strings that can be packed.  Otherwise C.
+  static octave_value maybe_pack (const Cell& c);
+
+  const octave::packed_strings& strings () const { return m_strings; }
+
+  char string_type () const { return m_type; }
+
+  type_conv_info numeric_conversion_function () const;
+
+  octave_value fast_elem_extract (octave_idx_type n) const;
+
+  std::size_t byte_size () const { return m_strings.chars ().numel (); }
+
+  octave_value full_value () const { return make_value (); }
+
+  builtin_type_t builtin_type () const { return btyp_cell; }
+
+  // We don't need to override all three forms of subsref.  The using
+  // declaration will avoid warnings about partially-overloaded virtual
+  // functions.
+  using octave_base_value::subsref;
+
+  octave_value subsref (const std::string& type,
+                        const std::list<octave_value_list>& idx)
+  {
+    octave_value_list tmp = subsref (type, idx, 1);
+    return tmp.length () > 0 ? tmp(0) : octave_value ();
+  }
+
+  octave_value_list subsref (const std::string& type,
+                             const std::list<octave_value_list>& idx,
+                             int nargout);
+
+  octave_value subsref (const std::string& type,
+                        const std::list<octave_value_list>& idx,
+                        bool auto_add);
+
+  octave_value_list
+  simple_subsref (char type, octave_value_list& idx, int nargout);
+
+  octave_value do_index_op (const octave_value_list& idx,
+                            bool resize_ok = false);
+
+  octave_value subsasgn (const std::string& type,
+                         const std::list<octave_value_list>& idx,
+                         const octave_value& rhs);
+
+  dim_vector dims () const { return m_strings.dims (); }
+
+  octave_idx_type numel () const { return m_strings.numel (); }
+
+  octave_idx_type nnz () const { return make_value ().nnz (); }
+
+  octave_value reshape (const dim_vector& new_dims) const;
+
+  octave_value permute (const Array<int>& vec, bool inv = false) const;
+
+  octave_value squeeze () const;
+
+  octave_value resize (const dim_vector& dv, bool fill = false) const
+  { return make_value ().resize (dv, fill); }
+
+  octave_value sort (octave_idx_type dim = 0, sortmode mode = ASCENDING) const;
+
+  octave_value sort (Array<octave_idx_type>& sidx, octave_idx_type dim = 0,
+                     sortmode mode = ASCENDING) const;
+
+  sortmode issorted (sortmode mode = UNSORTED) const
+  { return m_strings.issorted (mode); }
+
+  Array<octave_idx_type> sort_rows_idx (sortmode mode = ASCENDING) const
+  { return m_strings.array_value ().sort_rows_idx (mode); }
+
+  sortmode is_sorted_rows (sortmode mode = UNSORTED) const
+  { return m_strings.array_value ().is_sorted_rows (mode); }
+
+  bool is_matrix_type () const { return false; }
+
+  bool isnumeric () const { return false; }
+
+  bool is_defined () const { return true; }
+
+  bool is_constant () const { return true; }
+
+  bool iscell () const { return true; }
+
+  bool iscellstr () const { return true; }
+
+  bool is_true () const { return make_value ().is_true (); }
+
+  Cell cell_value () const { return make_value ().cell_value (); }
+
+  octave_value_list list_value () const { return make_value ().list_value (); }
+
+  string_vector string_vector_value (bool pad = false) const
+  { return make_value ().string_vector_value (pad); }
+
+  Array<std::string> cellstr_value () const
+  { return m_strings.array_value (); }
+
+  octave_value convert_to_str_internal (bool pad, bool force, char type) const
+  { return make_value ().convert_to_str_internal (pad, force, type); }
+
+  bool print_as_scalar () const { return make_value ().print_as_scalar (); }
+
+  void print (std::ostream& os, bool pr_as_read_syntax = false)
+  { make_value ().print (os, pr_as_read_syntax); }
+
+  void print_raw (std::ostream& os, bool pr_as_read_syntax = false) const
+  { make_value ().print_raw (os, pr_as_read_syntax); }
+
+  bool print_name_tag (std::ostream& os, const std::string& name) const
+  { return make_value ().print_name_tag (os, name); }
+
+  void short_disp (std::ostream& os) const { make_value ().short_disp (os); }
+
+  void print_info (std::ostream& os, const std::string& prefix) const
+  { make_value ().print_info (os, prefix); }
+
+  octave_value map (unary_mapper_t umap) const
+  { return make_value ().map (umap); }
+
+  mxArray * as_mxArray (bool interleaved) const
+  { return make_value ().as_mxArray (interleaved); }
+
+  // This function exists to support the MEX interface.
+  // You should not use it anywhere else.
+  const void * mex_get_data () const
+  { return make_value ().get_rep ().mex_get_data (); }
+
+private:
+
+  const octave_value& make_value () const
+  {
+    if (m_value.is_undefined ())
+      m_value = make_cell ();
+
+    return m_value;
+  }
+
+  octave_value& make_value ()
+  {
+    if (m_value.is_undefined ())
+      m_value = make_cell ();
+
+    return m_value;
+  }
+
+  octave_base_value * make_cell () const;
+
+  // The element or the comma-separated list C{IDX}.
+  octave_value_list brace_index (const octave_value_list& idx,
+                                 bool resize_ok = false);
+
+  octave_value make_packed (const octave::packed_strings& s) const
+  { return new octave_packed_cellstr (s, m_type); }
+
+  octave::packed_strings m_strings;
+
+  char m_type;
+
+  mutable octave_value m_value;
+
+  DECLARE_OV_TYPEID_FUNCTIONS_AND_DATA_API (OCTINTERP_API)
+};
+
+#endif
@@ -0,0 +1,263 @@
+////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2024 The Octave Project Developers
+//
+// See the file COPYRIGHT.md in the top-level directory of this
+// distribution or <https://octave.org/copyright/>.
+//
+// This file is part of Octave.
+//
+// Octave is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Octave is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Octave; see the file COPYING.  If not, see
+// <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////
+
+#if defined (HAVE_CONFIG_H)
+#  include "config.h"
+#endif
+
+#include <istream>
+#include <ostream>
+#include <string>
+
+#include "defun.h"
+#include "error.h"
+#include "errwarn.h"
+#include "ov-spassembler.h"
+#include "ovl.h"
+
+DEFINE_OV_TYPEID_FUNCTIONS_AND_DATA (octave_sparse_assembler,
+                                     "sparse assembler", "spassembler");
+
+octave_value
+octave_sparse_assembler::assemble (const octave_value& v) const
+{
+  octave_value retval;
+
+  if (v.isfloat ())
+    {
+      if (v.is_single_type ())
+        warning_with_id ("Octave:sparse:double-conversion",
+                         "sparse: input array cast to double");
+
+      if (v.iscomplex ())
+        retval = m_assembler.assemble (v.complex_array_value (),
+                                       m_sum_terms);
+      else
+        retval = m_assembler.assemble (v.array_value (), m_sum_terms);
+    }
+  else if (v.islogical ())
+    retval = m_assembler.assemble (v.bool_array_value (), m_sum_terms);
+  else
+    err_wrong_type_arg ("sparse", v);
+
+  return retval;
+}
+
+bool
+octave_sparse_assembler::save_ascii (std::ostream& /* os */)
+{
+  warning ("save: unable to save sparse assembler variables, skipping");
+
+  return true;
+}
+
+bool
+octave_sparse_assembler::load_ascii (std::istream& /* is */)
+{
+  // Silently skip object that was not saved
+  return true;
+}
+
+bool
+octave_sparse_assembler::save_binary (std::ostream& /* os */,
+                                      bool /* save_as_floats */)
+{
+  warning ("save: unable to save sparse assembler variables, skipping");
+
+  return true;
+}
+
+bool
+octave_sparse_assembler::load_binary (std::istream& /* is */,
+                                      bool /* swap */,
+                                      octave::mach_info::float_format /* fmt */)
+{
+  // Silently skip object that was not saved
+  return true;
+}
+
+bool
+octave_sparse_assembler::save_hdf5 (octave_hdf5_id /* loc_id */,
+                                    const char * /* name */,
+                                    bool /* save_as_floats */)
+{
+  warning ("save: unable to save sparse assembler variables, skipping");
+
+  return true;
+}
+
+bool
+octave_sparse_assembler::load_hdf5 (octave_hdf5_id /* loc_id */,
+                                    const char * /* name */)
+{
+  // Silently skip object that was not saved
+  return true;
+}
+
+void
+octave_sparse_assembler::print (std::ostream& os, bool pr_as_read_syntax)
+{
+  print_raw (os, pr_as_read_syntax);
+  newline (os);
+}
+
+void
+octave_sparse_assembler::print_raw (std::ostream& os, bool) const
+{
+  dim_vector dv = dims ();
+
+  os << "<" << dv.str () << " sparse assembler, " << m_assembler.numel ()
+     << " indices, nnz = " << m_assembler.nnz () << ">";
+}
+
+OCTAVE_BEGIN_NAMESPACE(octave)
+
+DEFUN (spassembler, args, ,
+       doc: /* -*- texinfo -*-
+@deftypefn  {} {@var{P} =} spassembler (@var{i}, @var{j})
+@deftypefnx {} {@var{P} =} spassembler (@var{i}, @var{j}, @var{m}, @var{n})
+@deftypefnx {} {@var{P} =} spassembler (@dots{}, "unique")
+Compute the sparsity pattern of the matrices with row indices @var{i} and
+column indices @var{j} for the repeated assembly of sparse matrices.
+
+@code{sparse (@var{P}, @var{sv})} then returns the same matrix as
+@code{sparse (@var{i}, @var{j}, @var{sv}, @var{m}, @var{n})}.  Only the
+values @var{sv} are scattered into the stored pattern, so that the indices
+are not sorted again.  This is much faster when many matrices with the same
+indices and different values are needed, for example the stiffness matrices
+of a finite element model in the steps of a nonlinear or time-dependent
+solver.
+
+As for @code{sparse}, values with the same indices are summed.  If the
+option @qcode{"unique"} is given, the last of these values is used.  If
+@var{m} or @var{n} are not specified then their values are the largest
+index in @var{i} and @var{j}.
+@seealso{sparse, accumarray}
+@end deftypefn */)
+{
+  int nargin = args.length ();
+
+  bool sum_terms = true;
+
+  if (nargin > 2 && args(nargin-1).is_string ())
+    {
+      std::string opt = args(nargin-1).string_value ();
+
+      if (opt == "unique")
+        sum_terms = false;
+      else if (opt == "sum" || opt == "summation")
+        sum_terms = true;
+      else
+        error ("spassembler: invalid option: %s", opt.c_str ());
+
+      nargin--;
+    }
+
+  if (nargin != 2 && nargin != 4)
+    print_usage ();
+
+  octave_idx_type m = -1;
+  octave_idx_type n = -1;
+
+  if (nargin == 4)
+    {
+      m = args(2).strict_idx_type_value ("spassembler: M must be a non-negative integer");
+      n = args(3).strict_idx_type_value ("spassembler: N must be a non-negative integer");
+
+      if (m < 0 || n < 0)
+        error ("spassembler: dimensions M and N must be non-negative");
+    }
+
+  int argidx = 0;    // index being checked when index_vector throws
+  try
+    {
+      idx_vector i = args(0).index_vector ();
+      argidx = 1;
+      idx_vector j = args(1).index_vector ();
+
+      return ovl (new octave_sparse_assembler
+                  (sparse_assembler (i, j, m, n), sum_terms));
+    }
+  catch (index_exception& ie)
+    {
+      // Rethrow to allow more info to be reported later.
+      ie.set_pos_if_unset (2, argidx+1);
+      throw;
+    }
+}
+
+/*
+%!shared i, j, v, P
+%! i = [3, 1, 2, 1, 3, 3];
+%! j = [1, 2, 2, 2, 4, 1];
+%! v = [1, 2, 3, 4, 5, 6];
+%! P = spassembler (i, j, 3, 5);
+
+%!assert (sparse (P, v), sparse (i, j, v, 3, 5))
+%!assert (sparse (P, 2*v), sparse (i, j, 2*v, 3, 5))
+%!assert (sparse (P, v + 1i), sparse (i, j, v + 1i, 3, 5))
+%!assert (sparse (P, v > 2), sparse (i, j, v > 2, 3, 5))
+%!assert (sparse (P, 7), sparse (i, j, 7, 3, 5))
+%!assert (size (P), [3, 5])
+%!assert (sparse (spassembler (i, j), v), sparse (i, j, v))
+%!assert (sparse (spassembler (i, j, 3, 5, "unique"), v),
+%!        sparse (i, j, v, 3, 5, "unique"))
+
+## Values that cancel are not stored
+%!assert (nnz (sparse (P, [1, 2, 3, -2, 5, -1])), 2)
+
+## Scalar indices
+%!assert (sparse (spassembler (2, 1:4), 1:4), sparse (2, 1:4, 1:4))
+%!assert (sparse (spassembler (1:4, 2), 1:4), sparse (1:4, 2, 1:4))
+
+## Large input that may be sorted by several threads
+%!test
+%! n = 3e5;
+%! ii = randi (1000, n, 1);
+%! jj = randi (800, n, 1);
+%! vv = randn (n, 1);
+%! Q = spassembler (ii, jj, 1000, 800);
+%! ## sparse () uses the assembler too, so compare with references that
+%! ## do not.
+%! assert (full (sparse (Q, vv)), accumarray ([ii, jj], vv, [1000, 800]),
+%!         1e-12);
+%! assert (full (sparse (Q, ones (n, 1))),
+%!         accumarray ([ii, jj], 1, [1000, 800]));
+%! assert (sparse (Q, -vv), -sparse (Q, vv));
+%! Q = spassembler (ii, jj, 1000, 800, "unique");
+%! ref = zeros (1000, 800);
+%! ref(sub2ind ([1000, 800], ii, jj)) = vv;  # last value of each pair
+%! assert (full (sparse (Q, vv)), ref);
+
+%!error <Invalid call> spassembler ()
+%!error <Invalid call> spassembler (1, 2, 3)
+%!error <invalid option> spassembler (1, 2, "foo")
+%!error <dimension mismatch> spassembler ([1, 2], [1, 2, 3])
+%!error <out of bound> spassembler (4, 1, 3, 3)
+%!error <dimension mismatch> sparse (P, [1, 2])
+%!error <wrong type argument> sparse (P, {1})
+*/
+
+OCTAVE_END_NAMESPACE(octave)
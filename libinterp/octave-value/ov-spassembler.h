@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2024 The Octave Project Developers
+//
+// See the file COPYRIGHT.md in the top-level directory of this
+// distribution or <https://octave.org/copyright/>.
+//
+// This file is part of Octave.
+//
+// Octave is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Octave is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Octave; see the file COPYING.  If not, see
+// <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////
+
+#if ! defined (octave_ov_spassembler_h)
+#define octave_ov_spassembler_h 1
+
+#include "octave-config.h"
+
+#include <iosfwd>
+
+#include "sparse-assembler.h"
+
+#include "ov-base.h"
+#include "ov.h"
+
+// The sparsity pattern of a set of row and column indices, used to
+// assemble sparse matrices with these indices and different values.
+
+class OCTINTERP_API octave_sparse_assembler : public octave_base_value
+{
+public:
+
+  octave_sparse_assembler ()
+    : octave_base_value (), m_assembler (), m_sum_terms (true)
+  { }
+
+  octave_sparse_assembler (const octave::sparse_assembler& a,
+                           bool sum_terms)
+    : octave_base_value (), m_assembler (a), m_sum_terms (sum_terms)
+  { }
+
+  octave_sparse_assembler (const octave_sparse_assembler&) = default;
+
+  ~octave_sparse_assembler () = default;
+
+  octave_base_value * clone () const
+  {
+    return new octave_sparse_assembler (*this);
+  }
+
+  octave_base_value * empty_clone () const
+  {
+    return new octave_sparse_assembler ();
+  }
+
+  bool is_defined () const { return true; }
+
+  bool is_constant () const { return true; }
+
+  dim_vector dims () const
+  {
+    return dim_vector (m_assembler.rows (), m_assembler.cols ());
+  }
+
+  // Return the sparse matrix with the values V at the stored indices.
+  octave_value assemble (const octave_value& v) const;
+
+  bool save_ascii (std::ostream& os);
+
+  bool load_ascii (std::istream& is);
+
+  bool save_binary (std::ostream& os, bool save_as_floats);
+
+  bool load_binary (std::istream& is, bool swap,
+                    octave::mach_info::float_format fmt);
+
+  bool save_hdf5 (octave_hdf5_id loc_id, const char *name, bool save_as_floats);
+
+  bool load_hdf5 (octave_hdf5_id loc_id, const char *name);
+
+  bool print_as_scalar () const { return true; }
+
+  void print (std::ostream& os, bool pr_as_read_syntax = false);
+
+  void print_raw (std::ostream& os, bool pr_as_read_syntax = false) const;
+
+  void short_disp (std::ostream& os) const { print_raw (os); }
+
+private:
+
+  octave::sparse_assembler m_assembler;
+
+  // Sum the values with the same indices instead of using the last.
+  bool m_sum_terms;
+
+  DECLARE_OV_TYPEID_FUNCTIONS_AND_DATA_API (OCTINTERP_API)
+};
+
+#endif
@@ -0,0 +1,363 @@
+////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2024 The Octave Project Developers
+//
+// See the file COPYRIGHT.md in the top-level directory of this
+// distribution or <https://octave.org/copyright/>.
+//
+// This file is part of Octave.
+//
+// Octave is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Octave is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Octave; see the file COPYING.  If not, see
+// <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////
+
+#if defined (HAVE_CONFIG_H)
+#  include "config.h"
+#endif
+
+#include <algorithm>
+#include <cctype>
+#include <istream>
+#include <ostream>
+#include <string>
+
+#include "lo-array-errwarn.h"
+#include "lo-mappers.h"
+
+#include "defun.h"
+#include "error.h"
+#include "errwarn.h"
+#include "ov-spdecomp.h"
+#include "ovl.h"
+
+DEFINE_OV_TYPEID_FUNCTIONS_AND_DATA (octave_sparse_decomposition,
+                                     "sparse decomposition",
+                                     "spdecomposition");
+
+octave_value
+octave_sparse_decomposition::solve (const octave_base_value& b) const
+{
+  octave_value retval;
+
+  if (m_is_complex || b.iscomplex ())
+    {
+      ComplexMatrix bm = b.complex_matrix_value ();
+
+      ComplexMatrix x
+        = (m_is_complex
+           ? m_complex.solve<ComplexMatrix, ComplexMatrix> (bm)
+           : m_real.solve<ComplexMatrix, ComplexMatrix> (bm));
+
+      if (b.issparse ())
+        retval = SparseComplexMatrix (x);
+      else
+        retval = x;
+    }
+  else
+    {
+      Matrix x = m_real.solve<Matrix, Matrix> (b.matrix_value ());
+
+      if (b.issparse ())
+        retval = SparseMatrix (x);
+      else
+        retval = x;
+    }
+
+  double rc = rcond ();
+
+  if (octave::math::isnan (rc) || 1.0 + rc == 1.0)
+    octave::warn_singular_matrix (rc);
+
+  return retval;
+}
+
+octave_value
+octave_sparse_decomposition::refactor (const octave_value& a) const
+{
+  if (m_is_complex || a.iscomplex ())
+    {
+      SparseComplexMatrix sa = a.sparse_complex_matrix_value ();
+
+      if (m_is_complex)
+        {
+          complex_decomp d = m_complex;
+          d.refactor (sa);
+          return octave_value (new octave_sparse_decomposition (d));
+        }
+
+      // The ordering of a real factorization is not carried over to a
+      // complex one.
+      complex_decomp::decomposition_type type
+        = static_cast<complex_decomp::decomposition_type> (m_real.type ());
+
+      return octave_value (new octave_sparse_decomposition
+                           (complex_decomp (sa, type)));
+    }
+  else
+    {
+      real_decomp d = m_real;
+      d.refactor (a.sparse_matrix_value ());
+      return octave_value (new octave_sparse_decomposition (d));
+    }
+}
+
+bool
+octave_sparse_decomposition::save_ascii (std::ostream& /* os */)
+{
+  warning ("save: unable to save sparse decomposition variables, skipping");
+
+  return true;
+}
+
+bool
+octave_sparse_decomposition::load_ascii (std::istream& /* is */)
+{
+  // Silently skip object that was not saved
+  return true;
+}
+
+bool
+octave_sparse_decomposition::save_binary (std::ostream& /* os */,
+                                          bool /* save_as_floats */)
+{
+  warning ("save: unable to save sparse decomposition variables, skipping");
+
+  return true;
+}
+
+bool
+octave_sparse_decomposition::load_binary (std::istream& /* is */,
+                                          bool /* swap */,
+                                          octave::mach_info::float_format /* fmt */)
+{
+  // Silently skip object that was not saved
+  return true;
+}
+
+bool
+octave_sparse_decomposition::save_hdf5 (octave_hdf5_id /* loc_id */,
+                                        const char * /* name */,
+                                        bool /* save_as_floats */)
+{
+  warning ("save: unable to save sparse decomposition variables, skipping");
+
+  return true;
+}
+
+bool
+octave_sparse_decomposition::load_hdf5 (octave_hdf5_id /* loc_id */,
+                                        const char * /* name */)
+{
+  // Silently skip object that was not saved
+  return true;
+}
+
+void
+octave_sparse_decomposition::print (std::ostream& os, bool pr_as_read_syntax)
+{
+  print_raw (os, pr_as_read_syntax);
+  newline (os);
+}
+
+void
+octave_sparse_decomposition::print_raw (std::ostream& os, bool) const
+{
+  dim_vector dv = dims ();
+
+  os << "<" << dv.str () << ' ' << (m_is_complex ? "complex " : "")
+     << "sparse " << decomposition_type () << " decomposition>";
+}
+
+OCTAVE_BEGIN_NAMESPACE(octave)
+
+DEFUN (spdecomposition, args, ,
+       doc: /* -*- texinfo -*-
+@deftypefn  {} {@var{F} =} spdecomposition (@var{A})
+@deftypefnx {} {@var{F} =} spdecomposition (@var{A}, @var{type})
+@deftypefnx {} {@var{F} =} spdecomposition (@var{F0}, @var{A})
+Factorize the sparse matrix @var{A} for use in repeated linear solves.
+
+The result @var{F} stores the factors of @var{A}, so that every left
+division @code{@var{F} \ @var{b}} only performs the triangular solves and
+gives the same result as @code{@var{A} \ @var{b}}.  This is much faster
+than @code{@var{A} \ @var{b}} when the same matrix is used with many
+right-hand sides that are not all known in advance, for example in the
+time steps of an implicit solver.
+
+The optional argument @var{type} selects the factorization:
+
+@table @asis
+@item @qcode{"auto"} (default)
+Cholesky@tie{}factorization if @var{A} is Hermitian with a positive real
+diagonal and positive definite, LU@tie{}factorization for other square
+matrices, and QR@tie{}factorization for matrices with more rows than
+columns.
+
+@item @qcode{"lu"}
+LU@tie{}factorization with @sc{umfpack}.
+
+@item @qcode{"chol"}
+Cholesky@tie{}factorization with @sc{cholmod}.  @var{A} must be Hermitian
+positive definite.
+
+@item @qcode{"qr"}
+QR@tie{}factorization.  @code{@var{F} \ @var{b}} is the least squares
+solution for matrices with more rows than columns.
+@end table
+
+When the values of the matrix change but its sparsity pattern does not,
+@code{spdecomposition (@var{F0}, @var{A})} factorizes the new matrix
+@var{A} with the type and the fill-reducing ordering of the earlier
+decomposition @var{F0}.  This skips the ordering step, which is a large
+part of the cost of the factorization of many matrices.  The
+QR@tie{}factorization is always recomputed in full.
+
+A full matrix @var{A} is converted to a sparse matrix before it is
+factorized.
+@seealso{mldivide, lu, chol, qr, spparms}
+@end deftypefn */)
+{
+  int nargin = args.length ();
+
+  if (nargin < 1 || nargin > 2)
+    print_usage ();
+
+  if (args(0).type_id () == octave_sparse_decomposition::static_type_id ())
+    {
+      if (nargin != 2)
+        print_usage ();
+
+      const octave_sparse_decomposition& f
+        = dynamic_cast<const octave_sparse_decomposition&>
+          (args(0).get_rep ());
+
+      if (! args(1).isnumeric ())
+        err_wrong_type_arg ("spdecomposition", args(1));
+
+      return ovl (f.refactor (args(1)));
+    }
+
+  octave_value arg = args(0);
+
+  if (! arg.isnumeric () && ! arg.islogical ())
+    err_wrong_type_arg ("spdecomposition", arg);
+
+  typedef octave_sparse_decomposition::real_decomp real_decomp;
+  typedef octave_sparse_decomposition::complex_decomp complex_decomp;
+
+  real_decomp::decomposition_type type = real_decomp::automatic;
+
+  if (nargin == 2)
+    {
+      std::string str
+        = args(1).xstring_value ("spdecomposition: TYPE must be a string");
+
+      std::transform (str.begin (), str.end (), str.begin (), tolower);
+
+      if (str == "auto")
+        type = real_decomp::automatic;
+      else if (str == "lu")
+        type = real_decomp::lu;
+      else if (str == "chol")
+        type = real_decomp::chol;
+      else if (str == "qr")
+        type = real_decomp::qr;
+      else
+        error (R"(spdecomposition: TYPE must be "auto", "lu", "chol", or "qr")");
+    }
+
+  if (arg.iscomplex ())
+    {
+      complex_decomp::decomposition_type ctype
+        = static_cast<complex_decomp::decomposition_type> (type);
+
+      return ovl (new octave_sparse_decomposition
+                  (complex_decomp (arg.sparse_complex_matrix_value (),
+                                   ctype)));
+    }
+  else
+    return ovl (new octave_sparse_decomposition
+                (real_decomp (arg.sparse_matrix_value (), type)));
+}
+
+/*
+%!shared A, S, C, R, b
+%! A = sprandn (60, 60, 0.08) + 10 * speye (60);
+%! S = A' * A;
+%! C = A + 1i * sprandn (60, 60, 0.05);
+%! R = [A; sprandn (20, 60, 0.1)];
+%! b = randn (60, 3);
+
+%!testif HAVE_UMFPACK
+%! F = spdecomposition (A);
+%! assert (F \ b, A \ b, 1e-10);
+%! assert (F \ b(:,1), A \ b(:,1), 1e-10);
+%! assert (F \ (b + 2i*b), A \ (b + 2i*b), 1e-10);
+%! assert (size (F), [60, 60]);
+
+%!testif HAVE_UMFPACK
+%! F = spdecomposition (C, "lu");
+%! assert (F \ b, C \ b, 1e-10);
+%! assert (iscomplex (F));
+
+%!testif HAVE_UMFPACK
+%! F = spdecomposition (A);
+%! x = F \ sparse (b);
+%! assert (issparse (x));
+%! assert (x, sparse (A \ b), 1e-10);
+
+%!testif HAVE_CHOLMOD
+%! F = spdecomposition (S);
+%! assert (F \ b, S \ b, 1e-8);
+%! F = spdecomposition (S, "chol");
+%! assert (F \ b, S \ b, 1e-8);
+
+%!testif HAVE_CHOLMOD, HAVE_UMFPACK
+%! ## An indefinite symmetric matrix falls back to LU.
+%! T = S - 50 * speye (60);
+%! F = spdecomposition (T);
+%! assert (F \ b, T \ b, 1e-8);
+
+%!testif ; (__have_feature__ ("SPQR") && __have_feature__ ("CHOLMOD")) || __have_feature__ ("CXSPARSE")
+%! F = spdecomposition (R);
+%! c = randn (80, 2);
+%! assert (F \ c, full (R) \ c, 1e-10);
+
+## Refactorization with the previous ordering
+%!testif HAVE_UMFPACK
+%! F = spdecomposition (A, "lu");
+%! A2 = A + spfun (@(x) 0.1 * x, A);
+%! F2 = spdecomposition (F, A2);
+%! assert (F2 \ b, A2 \ b, 1e-10);
+%! assert (F \ b, A \ b, 1e-10);
+
+%!testif HAVE_CHOLMOD
+%! F = spdecomposition (S, "chol");
+%! S2 = S + speye (60);
+%! F2 = spdecomposition (F, S2);
+%! assert (F2 \ b, S2 \ b, 1e-8);
+
+%!error <Invalid call> spdecomposition ()
+%!error <TYPE must be> spdecomposition (speye (3), "foo")
+%!error <wrong type argument> spdecomposition ({1})
+%!testif HAVE_UMFPACK
+%! F = spdecomposition (speye (3));
+%! fail ("spdecomposition (F, speye (4))", "same size");
+%! fail ("F \\ ones (4, 1)", "nonconformant");
+%!testif HAVE_CHOLMOD
+%! fail ('spdecomposition (-speye (3), "chol")', "not positive definite");
+*/
+
+OCTAVE_END_NAMESPACE(octave)
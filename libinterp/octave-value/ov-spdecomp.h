@@ -0,0 +1,138 @@
+////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2024 The Octave Project Developers
+//
+// See the file COPYRIGHT.md in the top-level directory of this
+// distribution or <https://octave.org/copyright/>.
+//
+// This file is part of Octave.
+//
+// Octave is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Octave is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Octave; see the file COPYING.  If not, see
+// <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////
+
+#if ! defined (octave_ov_spdecomp_h)
+#define octave_ov_spdecomp_h 1
+
+#include "octave-config.h"
+
+#include <iosfwd>
+
+#include "sparse-decomp.h"
+
+#include "ov-base.h"
+#include "ov.h"
+
+// A factorized sparse matrix.  The factors are computed once and used
+// by every left division F \ B.
+
+class OCTINTERP_API octave_sparse_decomposition : public octave_base_value
+{
+public:
+
+  typedef octave::math::sparse_decomposition<SparseMatrix> real_decomp;
+
+  typedef octave::math::sparse_decomposition<SparseComplexMatrix>
+    complex_decomp;
+
+  octave_sparse_decomposition ()
+    : octave_base_value (), m_is_complex (false), m_real (), m_complex ()
+  { }
+
+  octave_sparse_decomposition (const real_decomp& d)
+    : octave_base_value (), m_is_complex (false), m_real (d), m_complex ()
+  { }
+
+  octave_sparse_decomposition (const complex_decomp& d)
+    : octave_base_value (), m_is_complex (true), m_real (), m_complex (d)
+  { }
+
+  octave_sparse_decomposition (const octave_sparse_decomposition&) = default;
+
+  ~octave_sparse_decomposition () = default;
+
+  octave_base_value * clone () const
+  {
+    return new octave_sparse_decomposition (*this);
+  }
+
+  octave_base_value * empty_clone () const
+  {
+    return new octave_sparse_decomposition ();
+  }
+
+  bool is_defined () const { return true; }
+
+  bool is_constant () const { return true; }
+
+  bool iscomplex () const { return m_is_complex; }
+
+  dim_vector dims () const
+  {
+    return (m_is_complex
+            ? dim_vector (m_complex.rows (), m_complex.cols ())
+            : dim_vector (m_real.rows (), m_real.cols ()));
+  }
+
+  std::string decomposition_type () const
+  {
+    return m_is_complex ? m_complex.type_name () : m_real.type_name ();
+  }
+
+  double rcond () const
+  {
+    return m_is_complex ? m_complex.rcond () : m_real.rcond ();
+  }
+
+  // Solve A*X = B with the stored factors of A.
+  octave_value solve (const octave_base_value& b) const;
+
+  // Return a new decomposition of A with the type and fill-reducing
+  // ordering of this one.
+  octave_value refactor (const octave_value& a) const;
+
+  bool save_ascii (std::ostream& os);
+
+  bool load_ascii (std::istream& is);
+
+  bool save_binary (std::ostream& os, bool save_as_floats);
+
+  bool load_binary (std::istream& is, bool swap,
+                    octave::mach_info::float_format fmt);
+
+  bool save_hdf5 (octave_hdf5_id loc_id, const char *name, bool save_as_floats);
+
+  bool load_hdf5 (octave_hdf5_id loc_id, const char *name);
+
+  bool print_as_scalar () const { return true; }
+
+  void print (std::ostream& os, bool pr_as_read_syntax = false);
+
+  void print_raw (std::ostream& os, bool pr_as_read_syntax = false) const;
+
+  void short_disp (std::ostream& os) const { print_raw (os); }
+
+private:
+
+  bool m_is_complex;
+
+  real_decomp m_real;
+
+  complex_decomp m_complex;
+
+  DECLARE_OV_TYPEID_FUNCTIONS_AND_DATA_API (OCTINTERP_API)
+};
+
+#endif
@@ -74,6 +74,7 @@
 #include "ov-class.h"
 #include "ov-classdef.h"
 #include "ov-oncleanup.h"
+#include "ov-packed-cellstr.h"
 #include "ov-cs-list.h"
 #include "ov-colon.h"
 #include "ov-builtin.h"
@@ -85,6 +86,8 @@
 #include "ov-null-mat.h"
 #include "ov-lazy-idx.h"
 #include "ov-java.h"
+#include "ov-spassembler.h"
+#include "ov-spdecomp.h"
 
 #include "defun.h"
 #include "error.h"
@@ -3610,9 +3613,12 @@ install_types (octave::type_info& ti)
   octave_null_str::register_type (ti);
   octave_null_sq_str::register_type (ti);
   octave_lazy_index::register_type (ti);
+  octave_packed_cellstr::register_type (ti);
   octave_oncleanup::register_type (ti);
   octave_java::register_type (ti);
   octave_trivial_range::register_type (ti);
+  octave_sparse_decomposition::register_type (ti);
+  octave_sparse_assembler::register_type (ti);
 }
 
 OCTAVE_BEGIN_NAMESPACE(octave)
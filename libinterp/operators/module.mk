@@ -116,6 +116,7 @@ LIBINTERP_OPERATORS_SRC = \
   %reldir%/op-sm-s.cc \
   %reldir%/op-sm-scm.cc \
   %reldir%/op-sm-sm.cc \
+  %reldir%/op-spdecomp.cc \
   %reldir%/op-str-m.cc \
   %reldir%/op-str-s.cc \
   %reldir%/op-str-str.cc \
@@ -53,7 +53,8 @@ DEFUNOP (transpose, complex_matrix)
   if (v.ndims () > 2)
     error ("transpose not defined for N-D objects");
 
-  return octave_value (v.complex_matrix_value ().transpose ());
+  return octave_value (v.complex_matrix_value ().transpose (),
+                       v.matrix_type ().transpose ());
 }
 
 DEFUNOP (hermitian, complex_matrix)
@@ -63,7 +64,8 @@ DEFUNOP (hermitian, complex_matrix)
   if (v.ndims () > 2)
     error ("complex-conjugate transpose not defined for N-D objects");
 
-  return octave_value (v.complex_matrix_value ().hermitian ());
+  return octave_value (v.complex_matrix_value ().hermitian (),
+                       v.matrix_type ().transpose ());
 }
 
 DEFNCUNOP_METHOD (incr, complex_matrix, increment)
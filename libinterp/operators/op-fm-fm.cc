@@ -53,7 +53,8 @@ DEFUNOP (transpose, float_matrix)
   if (v.ndims () > 2)
     error ("transpose not defined for N-D objects");
 
-  return octave_value (v.float_matrix_value ().transpose ());
+  return octave_value (v.float_matrix_value ().transpose (),
+                       v.matrix_type ().transpose ());
 }
 
 DEFNCUNOP_METHOD (incr, float_matrix, increment)
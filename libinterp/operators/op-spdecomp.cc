@@ -0,0 +1,86 @@
+////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2024 The Octave Project Developers
+//
+// See the file COPYRIGHT.md in the top-level directory of this
+// distribution or <https://octave.org/copyright/>.
+//
+// This file is part of Octave.
+//
+// Octave is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Octave is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Octave; see the file COPYING.  If not, see
+// <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////
+
+#if defined (HAVE_CONFIG_H)
+#  include "config.h"
+#endif
+
+#include "ovl.h"
+#include "ov.h"
+#include "ov-typeinfo.h"
+#include "ops.h"
+
+#include "ov-bool-mat.h"
+#include "ov-complex.h"
+#include "ov-cx-mat.h"
+#include "ov-cx-sparse.h"
+#include "ov-flt-complex.h"
+#include "ov-flt-cx-mat.h"
+#include "ov-flt-re-mat.h"
+#include "ov-float.h"
+#include "ov-re-mat.h"
+#include "ov-re-sparse.h"
+#include "ov-scalar.h"
+#include "ov-spdecomp.h"
+
+OCTAVE_BEGIN_NAMESPACE(octave)
+
+// sparse decomposition by matrix ops
+
+DEFBINOP (ldiv, sparse_decomposition, matrix)
+{
+  OCTAVE_CAST_BASE_VALUE (const octave_sparse_decomposition&, v1, a1);
+
+  return v1.solve (a2);
+}
+
+void
+install_spdecomp_ops (octave::type_info& ti)
+{
+  INSTALL_BINOP_TI (ti, op_ldiv, octave_sparse_decomposition,
+                    octave_scalar, ldiv);
+  INSTALL_BINOP_TI (ti, op_ldiv, octave_sparse_decomposition,
+                    octave_matrix, ldiv);
+  INSTALL_BINOP_TI (ti, op_ldiv, octave_sparse_decomposition,
+                    octave_complex, ldiv);
+  INSTALL_BINOP_TI (ti, op_ldiv, octave_sparse_decomposition,
+                    octave_complex_matrix, ldiv);
+  INSTALL_BINOP_TI (ti, op_ldiv, octave_sparse_decomposition,
+                    octave_float_scalar, ldiv);
+  INSTALL_BINOP_TI (ti, op_ldiv, octave_sparse_decomposition,
+                    octave_float_matrix, ldiv);
+  INSTALL_BINOP_TI (ti, op_ldiv, octave_sparse_decomposition,
+                    octave_float_complex, ldiv);
+  INSTALL_BINOP_TI (ti, op_ldiv, octave_sparse_decomposition,
+                    octave_float_complex_matrix, ldiv);
+  INSTALL_BINOP_TI (ti, op_ldiv, octave_sparse_decomposition,
+                    octave_bool_matrix, ldiv);
+  INSTALL_BINOP_TI (ti, op_ldiv, octave_sparse_decomposition,
+                    octave_sparse_matrix, ldiv);
+  INSTALL_BINOP_TI (ti, op_ldiv, octave_sparse_decomposition,
+                    octave_sparse_complex_matrix, ldiv);
+}
+
+OCTAVE_END_NAMESPACE(octave)
@@ -32,12 +32,16 @@
 // this file.
 
 #include <ostream>
+#include <type_traits>
+#include <vector>
 
 #include "Array-util.h"
 #include "Array.h"
 #include "lo-error.h"
 #include "lo-mappers.h"
+#include "mask-util.h"
 #include "oct-locbuf.h"
+#include "sparse-util.h"
 
 // One dimensional array class.  Handles the reference counting for
 // all the derived classes.
@@ -2251,11 +2255,31 @@ Array<T, Alloc>::nnz () const
 {
   const T *src = data ();
   octave_idx_type nel = numel ();
-  octave_idx_type retval = 0;
+
+  if constexpr (std::is_same<T, bool>::value)
+    return mask_nnz (src, nel);
+
   const T zero = T ();
-  for (octave_idx_type i = 0; i < nel; i++)
-    if (src[i] != zero)
-      retval++;
+
+  // Comparisons of trivially copyable values are safe to run on
+  // several threads.
+  int nt = (std::is_trivially_copyable<T>::value
+            ? sparse_kernel_threads (nel) : 1);
+
+  std::vector<octave_idx_type> part (nt, 0);
+
+  sparse_thread_blocks (nel, nt, [=, &part] (int t, octave_idx_type b,
+                                             octave_idx_type e)
+  {
+    octave_idx_type cnt = 0;
+    for (octave_idx_type i = b; i < e; i++)
+      cnt += src[i] != zero;
+    part[t] += cnt;
+  });
+
+  octave_idx_type retval = 0;
+  for (octave_idx_type cnt : part)
+    retval += cnt;
 
   return retval;
 }
@@ -2272,14 +2296,40 @@ Array<T, Alloc>::find (octave_idx_type n, bool backward) const
     {
       // We want all elements, which means we'll almost surely need
       // to resize.  So count first, then allocate array of exact size.
-      octave_idx_type cnt = 0;
-      for (octave_idx_type i = 0; i < nel; i++)
-        cnt += src[i] != zero;
-
-      retval.clear (cnt, 1);
-      octave_idx_type *dest = retval.rwdata ();
-      for (octave_idx_type i = 0; i < nel; i++)
-        if (src[i] != zero) *dest++ = i;
+      // Large arrays are counted and stored in chunks on several
+      // threads, each chunk storing at the sum of the preceding counts.
+      auto alloc = [&retval] (octave_idx_type cnt)
+      {
+        retval.clear (cnt, 1);
+        return retval.rwdata ();
+      };
+
+      if constexpr (std::is_same<T, bool>::value)
+        {
+          octave_idx_type cnt = mask_nnz (src, nel);
+          mask_find (src, nel, cnt, alloc (cnt));
+        }
+      else
+        {
+          int nt = (std::is_trivially_copyable<T>::value
+                    ? sparse_kernel_threads (nel) : 1);
+
+          mask_compact (nel, nt,
+                        [=] (octave_idx_type b, octave_idx_type e)
+                        {
+                          octave_idx_type cnt = 0;
+                          for (octave_idx_type i = b; i < e; i++)
+                            cnt += src[i] != zero;
+                          return cnt;
+                        },
+                        alloc,
+                        [=] (octave_idx_type b, octave_idx_type e,
+                             octave_idx_type *dest, octave_idx_type *)
+                        {
+                          for (octave_idx_type i = b; i < e; i++)
+                            if (src[i] != zero) *dest++ = i;
+                        });
+        }
     }
   else
     {
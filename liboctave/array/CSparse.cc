@@ -211,47 +211,64 @@ SparseComplexMatrix::max (Array<octave_idx_type>& idx_arg, int dim) const
       if (nr == 0 || nc == 0 || dim >= dv.ndims ())
         return SparseComplexMatrix (nr == 0 ? 0 : 1, nc);
 
-      octave_idx_type nel = 0;
-      for (octave_idx_type j = 0; j < nc; j++)
-        {
-          Complex tmp_max;
-          double abs_max = octave::numeric_limits<double>::NaN ();
-          octave_idx_type idx_j = 0;
-          for (octave_idx_type i = cidx (j); i < cidx (j+1); i++)
-            {
-              if (ridx (i) != idx_j)
-                break;
-              else
-                idx_j++;
-            }
+      // The columns are independent.  Mark the nonzero results and
+      // count them afterwards.
+      const octave_idx_type *ci = cidx ();
+      const octave_idx_type *ri = ridx ();
+      const Complex *d = data ();
+      octave_idx_type *ia = idx_arg.rwdata ();
 
-          if (idx_j != nr)
-            {
-              tmp_max = 0.;
-              abs_max = 0.;
-            }
+      OCTAVE_LOCAL_BUFFER (char, nonzero, nc);
 
-          for (octave_idx_type i = cidx (j); i < cidx (j+1); i++)
-            {
-              Complex tmp = data (i);
+      int nthreads = sparse_kernel_threads (static_cast<double> (nnz ()));
 
-              if (octave::math::isnan (tmp))
-                continue;
+      sparse_column_blocks (ci, nc, nthreads,
+                            [=] (octave_idx_type jb, octave_idx_type je)
+      {
+        for (octave_idx_type j = jb; j < je; j++)
+          {
+            Complex tmp_max;
+            double abs_max = octave::numeric_limits<double>::NaN ();
+            octave_idx_type idx_j = 0;
+            for (octave_idx_type i = ci[j]; i < ci[j+1]; i++)
+              {
+                if (ri[i] != idx_j)
+                  break;
+                else
+                  idx_j++;
+              }
 
-              double abs_tmp = std::abs (tmp);
+            if (idx_j != nr)
+              {
+                tmp_max = 0.;
+                abs_max = 0.;
+              }
 
-              if (octave::math::isnan (abs_max) || abs_tmp > abs_max)
-                {
-                  idx_j = ridx (i);
-                  tmp_max = tmp;
-                  abs_max = abs_tmp;
-                }
-            }
+            for (octave_idx_type i = ci[j]; i < ci[j+1]; i++)
+              {
+                Complex tmp = d[i];
 
-          idx_arg.elem (j) = (octave::math::isnan (tmp_max) ? 0 : idx_j);
-          if (abs_max != 0.)
-            nel++;
-        }
+                if (octave::math::isnan (tmp))
+                  continue;
+
+                double abs_tmp = std::abs (tmp);
+
+                if (octave::math::isnan (abs_max) || abs_tmp > abs_max)
+                  {
+                    idx_j = ri[i];
+                    tmp_max = tmp;
+                    abs_max = abs_tmp;
+                  }
+              }
+
+            ia[j] = (octave::math::isnan (tmp_max) ? 0 : idx_j);
+            nonzero[j] = (abs_max != 0.);
+          }
+      });
+
+      octave_idx_type nel = 0;
+      for (octave_idx_type j = 0; j < nc; j++)
+        nel += nonzero[j];
 
       result = SparseComplexMatrix (1, nc, nel);
 
@@ -368,47 +385,64 @@ SparseComplexMatrix::min (Array<octave_idx_type>& idx_arg, int dim) const
       if (nr == 0 || nc == 0 || dim >= dv.ndims ())
         return SparseComplexMatrix (nr == 0 ? 0 : 1, nc);
 
-      octave_idx_type nel = 0;
-      for (octave_idx_type j = 0; j < nc; j++)
-        {
-          Complex tmp_min;
-          double abs_min = octave::numeric_limits<double>::NaN ();
-          octave_idx_type idx_j = 0;
-          for (octave_idx_type i = cidx (j); i < cidx (j+1); i++)
-            {
-              if (ridx (i) != idx_j)
-                break;
-              else
-                idx_j++;
-            }
+      // The columns are independent.  Mark the nonzero results and
+      // count them afterwards.
+      const octave_idx_type *ci = cidx ();
+      const octave_idx_type *ri = ridx ();
+      const Complex *d = data ();
+      octave_idx_type *ia = idx_arg.rwdata ();
 
-          if (idx_j != nr)
-            {
-              tmp_min = 0.;
-              abs_min = 0.;
-            }
+      OCTAVE_LOCAL_BUFFER (char, nonzero, nc);
 
-          for (octave_idx_type i = cidx (j); i < cidx (j+1); i++)
-            {
-              Complex tmp = data (i);
+      int nthreads = sparse_kernel_threads (static_cast<double> (nnz ()));
 
-              if (octave::math::isnan (tmp))
-                continue;
+      sparse_column_blocks (ci, nc, nthreads,
+                            [=] (octave_idx_type jb, octave_idx_type je)
+      {
+        for (octave_idx_type j = jb; j < je; j++)
+          {
+            Complex tmp_min;
+            double abs_min = octave::numeric_limits<double>::NaN ();
+            octave_idx_type idx_j = 0;
+            for (octave_idx_type i = ci[j]; i < ci[j+1]; i++)
+              {
+                if (ri[i] != idx_j)
+                  break;
+                else
+                  idx_j++;
+              }
 
-              double abs_tmp = std::abs (tmp);
+            if (idx_j != nr)
+              {
+                tmp_min = 0.;
+                abs_min = 0.;
+              }
 
-              if (octave::math::isnan (abs_min) || abs_tmp < abs_min)
-                {
-                  idx_j = ridx (i);
-                  tmp_min = tmp;
-                  abs_min = abs_tmp;
-                }
-            }
+            for (octave_idx_type i = ci[j]; i < ci[j+1]; i++)
+              {
+                Complex tmp = d[i];
 
-          idx_arg.elem (j) = (octave::math::isnan (tmp_min) ? 0 : idx_j);
-          if (abs_min != 0.)
-            nel++;
-        }
+                if (octave::math::isnan (tmp))
+                  continue;
+
+                double abs_tmp = std::abs (tmp);
+
+                if (octave::math::isnan (abs_min) || abs_tmp < abs_min)
+                  {
+                    idx_j = ri[i];
+                    tmp_min = tmp;
+                    abs_min = abs_tmp;
+                  }
+              }
+
+            ia[j] = (octave::math::isnan (tmp_min) ? 0 : idx_j);
+            nonzero[j] = (abs_min != 0.);
+          }
+      });
+
+      octave_idx_type nel = 0;
+      for (octave_idx_type j = 0; j < nc; j++)
+        nel += nonzero[j];
 
       result = SparseComplexMatrix (1, nc, nel);
 
@@ -7376,14 +7410,10 @@ SparseComplexMatrix::abs () const
 
   SparseMatrix retval (rows (), nc, nz);
 
-  for (octave_idx_type i = 0; i < nc + 1; i++)
-    retval.cidx (i) = cidx (i);
-
-  for (octave_idx_type i = 0; i < nz; i++)
-    {
-      retval.data (i) = std::abs (data (i));
-      retval.ridx (i) = ridx (i);
-    }
+  octave::sparse_map_values (nz, data (), retval.xdata (),
+                             [] (const Complex& x) { return std::abs (x); });
+  std::copy_n (ridx (), nz, retval.xridx ());
+  std::copy_n (cidx (), nc + 1, retval.xcidx ());
 
   return retval;
 }
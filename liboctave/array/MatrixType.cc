@@ -27,9 +27,14 @@
 #  include "config.h"
 #endif
 
+#include <algorithm>
 #include <cinttypes>
 #include <vector>
 
+#if defined (HAVE_OPENMP)
+#  include <omp.h>
+#endif
+
 #include "MatrixType.h"
 #include "dMatrix.h"
 #include "fMatrix.h"
@@ -39,6 +44,7 @@
 #include "CSparse.h"
 #include "oct-spparms.h"
 #include "oct-locbuf.h"
+#include "sparse-util.h"
 
 static void
 warn_cached ()
@@ -83,6 +89,69 @@ MatrixType::MatrixType (const MatrixType& a)
     }
 }
 
+// Do the checks for lower/upper/hermitian on all pairs of elements
+// A(i,j) and A(j,i) with i < j of the square matrix A.  CHECK updates
+// the three flags for one pair.  For large matrices the columns are
+// split between threads.  They are processed in blocks so that the scan
+// still stops soon after all of the checks have failed.
+
+template <typename T, typename F>
+static void
+probe_triangle (const MArray<T>& a, bool& upper, bool& lower,
+                bool& hermitian, F check)
+{
+  octave_idx_type ncols = a.cols ();
+
+  int nthreads = sparse_kernel_threads (0.5 * double (ncols) * double (ncols));
+
+  if (nthreads > 1)
+    {
+      octave_idx_type blk = 64 * nthreads;
+
+      for (octave_idx_type jb = 0;
+           jb < ncols && (upper || lower || hermitian); jb += blk)
+        {
+          octave_idx_type je = std::min (jb + blk, ncols);
+
+          bool u = upper;
+          bool l = lower;
+          bool h = hermitian;
+
+#if defined (HAVE_OPENMP)
+#  pragma omp parallel for num_threads (nthreads) schedule(dynamic, 4) \
+  reduction(&&: u, l, h)
+#endif
+          for (octave_idx_type j = jb; j < je; j++)
+            {
+              bool cu = u;
+              bool cl = l;
+              bool ch = h;
+
+              for (octave_idx_type i = 0; i < j && (cu || cl || ch); i++)
+                check (a.elem (i, j), a.elem (j, i), i, j, cu, cl, ch);
+
+              u = u && cu;
+              l = l && cl;
+              h = h && ch;
+            }
+
+          upper = u;
+          lower = l;
+          hermitian = h;
+        }
+    }
+  else
+    {
+      for (octave_idx_type j = 0;
+           j < ncols && (upper || lower || hermitian); j++)
+        {
+          for (octave_idx_type i = 0; i < j; i++)
+            check (a.elem (i, j), a.elem (j, i), i, j, upper, lower,
+                   hermitian);
+        }
+    }
+}
+
 template <typename T>
 MatrixType::matrix_type
 matrix_real_probe (const MArray<T>& a)
@@ -112,19 +181,14 @@ matrix_real_probe (const MArray<T>& a)
           diag[j] = d;
         }
 
-      for (octave_idx_type j = 0;
-           j < ncols && (upper || lower || hermitian); j++)
-        {
-          for (octave_idx_type i = 0; i < j; i++)
-            {
-              T aij = a.elem (i, j);
-              T aji = a.elem (j, i);
-              lower = lower && (aij == zero);
-              upper = upper && (aji == zero);
-              hermitian = hermitian && (aij == aji
-                                        && aij*aij < diag[i]*diag[j]);
-            }
-        }
+      probe_triangle (a, upper, lower, hermitian,
+                      [=] (T aij, T aji, octave_idx_type i, octave_idx_type j,
+                           bool& up, bool& lo, bool& herm)
+      {
+        lo = lo && (aij == zero);
+        up = up && (aji == zero);
+        herm = herm && (aij == aji && aij*aij < diag[i]*diag[j]);
+      });
 
       if (upper)
         m_type = MatrixType::Upper;
@@ -171,19 +235,16 @@ matrix_complex_probe (const MArray<std::complex<T>>& a)
           diag[j] = d.real ();
         }
 
-      for (octave_idx_type j = 0;
-           j < ncols && (upper || lower || hermitian); j++)
-        {
-          for (octave_idx_type i = 0; i < j; i++)
-            {
-              std::complex<T> aij = a.elem (i, j);
-              std::complex<T> aji = a.elem (j, i);
-              lower = lower && (aij == zero);
-              upper = upper && (aji == zero);
-              hermitian = hermitian && (aij == octave::math::conj (aji)
-                                        && std::norm (aij) < diag[i]*diag[j]);
-            }
-        }
+      probe_triangle (a, upper, lower, hermitian,
+                      [=] (std::complex<T> aij, std::complex<T> aji,
+                           octave_idx_type i, octave_idx_type j,
+                           bool& up, bool& lo, bool& herm)
+      {
+        lo = lo && (aij == zero);
+        up = up && (aji == zero);
+        herm = herm && (aij == octave::math::conj (aji)
+                        && std::norm (aij) < diag[i]*diag[j]);
+      });
 
       if (upper)
         m_type = MatrixType::Upper;
@@ -299,36 +360,109 @@ MatrixType::MatrixType (const MSparse<T>& a)
       bool singular = false;
       m_upper_band = 0;
       m_lower_band = 0;
-      for (octave_idx_type j = 0; j < ncols; j++)
+
+      int nthreads = sparse_kernel_threads (double (nnz));
+
+      if (nthreads > 1)
         {
-          bool zero_on_diagonal = false;
-          if (j < nrows)
+          // Scan blocks of columns in parallel.  The first block with a
+          // zero on the diagonal is scanned again serially below so that
+          // the bandwidths are the same as those of the serial scan.
+          octave_idx_type blk = std::max (ncols / (8 * nthreads),
+                                          static_cast<octave_idx_type> (1024));
+
+          octave_idx_type jb;
+          for (jb = 0; jb < ncols; jb += blk)
             {
-              zero_on_diagonal = true;
-              for (octave_idx_type i = a.cidx (j); i < a.cidx (j+1); i++)
-                if (a.ridx (i) == j)
-                  {
-                    zero_on_diagonal = false;
-                    break;
-                  }
+              octave_idx_type je = std::min (jb + blk, ncols);
+
+              octave_idx_type upper_band = m_upper_band;
+              octave_idx_type lower_band = m_lower_band;
+              bool block_singular = false;
+
+#if defined (HAVE_OPENMP)
+#  pragma omp parallel for num_threads (nthreads) schedule(static) \
+  reduction(max: upper_band, lower_band) reduction(||: block_singular)
+#endif
+              for (octave_idx_type j = jb; j < je; j++)
+                {
+                  octave_idx_type cb = a.cidx (j);
+                  octave_idx_type ce = a.cidx (j+1);
+
+                  if (j < nrows
+                      && std::find (a.ridx () + cb, a.ridx () + ce, j)
+                         == a.ridx () + ce)
+                    block_singular = true;
+                  else if (ce != cb)
+                    {
+                      upper_band = std::max (upper_band, j - a.ridx (cb));
+                      lower_band = std::max (lower_band, a.ridx (ce-1) - j);
+                    }
+                }
+
+              if (block_singular)
+                break;
+
+              m_upper_band = upper_band;
+              m_lower_band = lower_band;
             }
 
-          if (zero_on_diagonal)
+          if (jb < ncols)
             {
               singular = true;
-              break;
-            }
 
-          if (a.cidx (j+1) != a.cidx (j))
+              for (octave_idx_type j = jb; j < ncols; j++)
+                {
+                  octave_idx_type cb = a.cidx (j);
+                  octave_idx_type ce = a.cidx (j+1);
+
+                  if (j < nrows
+                      && std::find (a.ridx () + cb, a.ridx () + ce, j)
+                         == a.ridx () + ce)
+                    break;
+
+                  if (ce != cb)
+                    {
+                      m_upper_band = std::max (m_upper_band, j - a.ridx (cb));
+                      m_lower_band = std::max (m_lower_band,
+                                               a.ridx (ce-1) - j);
+                    }
+                }
+            }
+        }
+      else
+        {
+          for (octave_idx_type j = 0; j < ncols; j++)
             {
-              octave_idx_type ru = a.ridx (a.cidx (j));
-              octave_idx_type rl = a.ridx (a.cidx (j+1)-1);
+              bool zero_on_diagonal = false;
+              if (j < nrows)
+                {
+                  zero_on_diagonal = true;
+                  for (octave_idx_type i = a.cidx (j); i < a.cidx (j+1); i++)
+                    if (a.ridx (i) == j)
+                      {
+                        zero_on_diagonal = false;
+                        break;
+                      }
+                }
+
+              if (zero_on_diagonal)
+                {
+                  singular = true;
+                  break;
+                }
+
+              if (a.cidx (j+1) != a.cidx (j))
+                {
+                  octave_idx_type ru = a.ridx (a.cidx (j));
+                  octave_idx_type rl = a.ridx (a.cidx (j+1)-1);
 
-              if (j - ru > m_upper_band)
-                m_upper_band = j - ru;
+                  if (j - ru > m_upper_band)
+                    m_upper_band = j - ru;
 
-              if (rl - j > m_lower_band)
-                m_lower_band = rl - j;
+                  if (rl - j > m_lower_band)
+                    m_lower_band = rl - j;
+                }
             }
         }
 
@@ -523,29 +657,66 @@ MatrixType::MatrixType (const MSparse<T>& a)
 
           // next, check symmetry and 2x2 positiveness
 
-          for (octave_idx_type j = 0; is_herm && j < ncols; j++)
-            for (octave_idx_type i = a.cidx (j); is_herm && i < a.cidx (j+1); i++)
+          const ColumnVector& cdiag = diag;
+
+          auto check_column = [&a, &cdiag] (octave_idx_type j, bool herm)
+          {
+            for (octave_idx_type i = a.cidx (j); herm && i < a.cidx (j+1); i++)
               {
                 octave_idx_type k = a.ridx (i);
-                is_herm = k == j;
-                if (is_herm)
+                herm = k == j;
+                if (herm)
                   continue;
 
                 T d = a.data (i);
-                if (std::norm (d) < diag(j)*diag(k))
+                if (std::norm (d) < cdiag(j)*cdiag(k))
                   {
                     d = octave::math::conj (d);
                     for (octave_idx_type l = a.cidx (k); l < a.cidx (k+1); l++)
                       {
                         if (a.ridx (l) == j)
                           {
-                            is_herm = a.data (l) == d;
+                            herm = a.data (l) == d;
                             break;
                           }
                       }
                   }
               }
 
+            return herm;
+          };
+
+          // The search for the transposed element makes this the most
+          // expensive check.  Columns are checked in parallel, one block
+          // at a time so that the check stops soon after a failure.
+          int herm_threads = sparse_kernel_threads (2.0 * double (nnz));
+
+          if (herm_threads > 1)
+            {
+              octave_idx_type blk = 256 * herm_threads;
+
+              for (octave_idx_type jb = 0; is_herm && jb < ncols; jb += blk)
+                {
+                  octave_idx_type je = std::min (jb + blk, ncols);
+
+                  bool herm = true;
+
+#if defined (HAVE_OPENMP)
+#  pragma omp parallel for num_threads (herm_threads) schedule(dynamic, 16) \
+  reduction(&&: herm)
+#endif
+                  for (octave_idx_type j = jb; j < je; j++)
+                    herm = check_column (j, herm);
+
+                  is_herm = herm;
+                }
+            }
+          else
+            {
+              for (octave_idx_type j = 0; is_herm && j < ncols; j++)
+                is_herm = check_column (j, is_herm);
+            }
+
           if (is_herm)
             {
               if (m_type == MatrixType::Full)
@@ -45,6 +45,7 @@
 #include "oct-locbuf.h"
 
 #include "Sparse.h"
+#include "sparse-assembler.h"
 #include "sparse-util.h"
 #include "oct-spparms.h"
 #include "mx-inlines.cc"
@@ -350,6 +351,21 @@ Sparse<T, Alloc>::Sparse (const Array<T>& a,
           std::fill_n (xcidx () + c(0) + 1, nc - c(0), 1);
         }
     }
+  else if (sparse_kernel_threads (static_cast<double> (n)) > 1)
+    {
+      // Sort large sets of triplets into columns with several threads.
+      octave::sparse_assembler pattern (r, c, nr, nc);
+
+      octave_idx_type new_nz = pattern.nnz ();
+      change_capacity (nzm > new_nz ? nzm : new_nz);
+
+      std::copy_n (pattern.cidx (), nc + 1, xcidx ());
+      std::copy_n (pattern.ridx (), new_nz, xridx ());
+
+      pattern.scatter (a, xdata (), sum_terms);
+
+      maybe_compress (true);
+    }
   else if (a_scalar)
     {
       // This is completely specialized, because the sorts can be simplified.
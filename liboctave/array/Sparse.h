@@ -37,6 +37,7 @@
 #include "Array-fwd.h"
 #include "Sparse-fwd.h"
 #include "mx-fwd.h"
+#include "sparse-util.h"
 
 // Two dimensional sparse class.  Handles the reference counting for
 // all the derived classes.
@@ -684,51 +685,52 @@ public:
     Sparse<U> result;
     U f_zero = fcn (0.0);
 
+    octave_idx_type nz = nnz ();
+    octave_idx_type nr = rows ();
+    octave_idx_type nc = cols ();
+
+    const T *d = data ();
+    const octave_idx_type *ri = ridx ();
+    const octave_idx_type *ci = cidx ();
+
+    int nthreads = sparse_kernel_threads (static_cast<double> (nz));
+
     if (f_zero != 0.0)
       {
-        octave_idx_type nr = rows ();
-        octave_idx_type nc = cols ();
-
         result = Sparse<U> (nr, nc, f_zero);
 
-        for (octave_idx_type j = 0; j < nc; j++)
-          for (octave_idx_type i = cidx (j); i < cidx (j+1); i++)
-            {
-              octave_quit ();
-              /* Use data instead of elem for better performance. */
-              result.data (ridx (i) + j * nr) = fcn (data (i));
-            }
-
-        result.maybe_compress (true);
+        // The result is stored full, so every column is written
+        // independently of the others.
+        U *rd = result.xdata ();
+
+        sparse_column_blocks (ci, nc, nthreads,
+                              [=] (octave_idx_type jb, octave_idx_type je)
+        {
+          for (octave_idx_type j = jb; j < je; j++)
+            for (octave_idx_type i = ci[j]; i < ci[j+1]; i++)
+              rd[ri[i] + j * nr] = fcn (d[i]);
+        });
       }
     else
       {
-        octave_idx_type nz = nnz ();
-        octave_idx_type nr = rows ();
-        octave_idx_type nc = cols ();
-
+        // Keep the pattern and drop the elements mapped to zero later.
         result = Sparse<U> (nr, nc, nz);
-        octave_idx_type ii = 0;
-        result.cidx (ii) = 0;
-
-        for (octave_idx_type j = 0; j < nc; j++)
-          {
-            for (octave_idx_type i = cidx (j); i < cidx (j+1); i++)
-              {
-                U val = fcn (data (i));
-                if (val != 0.0)
-                  {
-                    result.data (ii) = val;
-                    result.ridx (ii++) = ridx (i);
-                  }
-                octave_quit ();
-              }
-            result.cidx (j+1) = ii;
-          }
-
-        result.maybe_compress (false);
+
+        U *rd = result.xdata ();
+
+        sparse_range_blocks (nz, nthreads,
+                             [=] (octave_idx_type b, octave_idx_type e)
+        {
+          for (octave_idx_type i = b; i < e; i++)
+            rd[i] = fcn (d[i]);
+        });
+
+        std::copy_n (ri, nz, result.xridx ());
+        std::copy_n (ci, nc + 1, result.xcidx ());
       }
 
+    result.maybe_compress (true);
+
     return result;
   }
 
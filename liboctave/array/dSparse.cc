@@ -210,40 +210,57 @@ SparseMatrix::max (Array<octave_idx_type>& idx_arg, int dim) const
       if (nr == 0 || nc == 0 || dim >= dv.ndims ())
         return SparseMatrix (nr == 0 ? 0 : 1, nc);
 
-      octave_idx_type nel = 0;
-      for (octave_idx_type j = 0; j < nc; j++)
-        {
-          double tmp_max = octave::numeric_limits<double>::NaN ();
-          octave_idx_type idx_j = 0;
-          for (octave_idx_type i = cidx (j); i < cidx (j+1); i++)
-            {
-              if (ridx (i) != idx_j)
-                break;
-              else
-                idx_j++;
-            }
+      // The columns are independent.  Mark the nonzero results and
+      // count them afterwards.
+      const octave_idx_type *ci = cidx ();
+      const octave_idx_type *ri = ridx ();
+      const double *d = data ();
+      octave_idx_type *ia = idx_arg.rwdata ();
 
-          if (idx_j != nr)
-            tmp_max = 0.;
+      OCTAVE_LOCAL_BUFFER (char, nonzero, nc);
 
-          for (octave_idx_type i = cidx (j); i < cidx (j+1); i++)
-            {
-              double tmp = data (i);
+      int nthreads = sparse_kernel_threads (static_cast<double> (nnz ()));
 
-              if (octave::math::isnan (tmp))
-                continue;
-              else if (octave::math::isnan (tmp_max) || tmp > tmp_max)
-                {
-                  idx_j = ridx (i);
-                  tmp_max = tmp;
-                }
+      sparse_column_blocks (ci, nc, nthreads,
+                            [=] (octave_idx_type jb, octave_idx_type je)
+      {
+        for (octave_idx_type j = jb; j < je; j++)
+          {
+            double tmp_max = octave::numeric_limits<double>::NaN ();
+            octave_idx_type idx_j = 0;
+            for (octave_idx_type i = ci[j]; i < ci[j+1]; i++)
+              {
+                if (ri[i] != idx_j)
+                  break;
+                else
+                  idx_j++;
+              }
 
-            }
+            if (idx_j != nr)
+              tmp_max = 0.;
 
-          idx_arg.elem (j) = (octave::math::isnan (tmp_max) ? 0 : idx_j);
-          if (tmp_max != 0.)
-            nel++;
-        }
+            for (octave_idx_type i = ci[j]; i < ci[j+1]; i++)
+              {
+                double tmp = d[i];
+
+                if (octave::math::isnan (tmp))
+                  continue;
+                else if (octave::math::isnan (tmp_max) || tmp > tmp_max)
+                  {
+                    idx_j = ri[i];
+                    tmp_max = tmp;
+                  }
+
+              }
+
+            ia[j] = (octave::math::isnan (tmp_max) ? 0 : idx_j);
+            nonzero[j] = (tmp_max != 0.);
+          }
+      });
+
+      octave_idx_type nel = 0;
+      for (octave_idx_type j = 0; j < nc; j++)
+        nel += nonzero[j];
 
       result = SparseMatrix (1, nc, nel);
 
@@ -361,40 +378,57 @@ SparseMatrix::min (Array<octave_idx_type>& idx_arg, int dim) const
       if (nr == 0 || nc == 0 || dim >= dv.ndims ())
         return SparseMatrix (nr == 0 ? 0 : 1, nc);
 
-      octave_idx_type nel = 0;
-      for (octave_idx_type j = 0; j < nc; j++)
-        {
-          double tmp_min = octave::numeric_limits<double>::NaN ();
-          octave_idx_type idx_j = 0;
-          for (octave_idx_type i = cidx (j); i < cidx (j+1); i++)
-            {
-              if (ridx (i) != idx_j)
-                break;
-              else
-                idx_j++;
-            }
+      // The columns are independent.  Mark the nonzero results and
+      // count them afterwards.
+      const octave_idx_type *ci = cidx ();
+      const octave_idx_type *ri = ridx ();
+      const double *d = data ();
+      octave_idx_type *ia = idx_arg.rwdata ();
 
-          if (idx_j != nr)
-            tmp_min = 0.;
+      OCTAVE_LOCAL_BUFFER (char, nonzero, nc);
 
-          for (octave_idx_type i = cidx (j); i < cidx (j+1); i++)
-            {
-              double tmp = data (i);
+      int nthreads = sparse_kernel_threads (static_cast<double> (nnz ()));
 
-              if (octave::math::isnan (tmp))
-                continue;
-              else if (octave::math::isnan (tmp_min) || tmp < tmp_min)
-                {
-                  idx_j = ridx (i);
-                  tmp_min = tmp;
-                }
+      sparse_column_blocks (ci, nc, nthreads,
+                            [=] (octave_idx_type jb, octave_idx_type je)
+      {
+        for (octave_idx_type j = jb; j < je; j++)
+          {
+            double tmp_min = octave::numeric_limits<double>::NaN ();
+            octave_idx_type idx_j = 0;
+            for (octave_idx_type i = ci[j]; i < ci[j+1]; i++)
+              {
+                if (ri[i] != idx_j)
+                  break;
+                else
+                  idx_j++;
+              }
 
-            }
+            if (idx_j != nr)
+              tmp_min = 0.;
 
-          idx_arg.elem (j) = (octave::math::isnan (tmp_min) ? 0 : idx_j);
-          if (tmp_min != 0.)
-            nel++;
-        }
+            for (octave_idx_type i = ci[j]; i < ci[j+1]; i++)
+              {
+                double tmp = d[i];
+
+                if (octave::math::isnan (tmp))
+                  continue;
+                else if (octave::math::isnan (tmp_min) || tmp < tmp_min)
+                  {
+                    idx_j = ri[i];
+                    tmp_min = tmp;
+                  }
+
+              }
+
+            ia[j] = (octave::math::isnan (tmp_min) ? 0 : idx_j);
+            nonzero[j] = (tmp_min != 0.);
+          }
+      });
+
+      octave_idx_type nel = 0;
+      for (octave_idx_type j = 0; j < nc; j++)
+        nel += nonzero[j];
 
       result = SparseMatrix (1, nc, nel);
 
@@ -7380,10 +7414,14 @@ SparseMatrix::abs () const
 {
   octave_idx_type nz = nnz ();
 
-  SparseMatrix retval (*this);
+  octave_idx_type nc = cols ();
+
+  SparseMatrix retval (rows (), nc, nz);
 
-  for (octave_idx_type i = 0; i < nz; i++)
-    retval.data (i) = fabs (retval.data (i));
+  octave::sparse_map_values (nz, data (), retval.xdata (),
+                             [] (double x) { return fabs (x); });
+  std::copy_n (ridx (), nz, retval.xridx ());
+  std::copy_n (cidx (), nc + 1, retval.xcidx ());
 
   return retval;
 }
@@ -0,0 +1,139 @@
+////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2024 The Octave Project Developers
+//
+// See the file COPYRIGHT.md in the top-level directory of this
+// distribution or <https://octave.org/copyright/>.
+//
+// This file is part of Octave.
+//
+// Octave is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Octave is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Octave; see the file COPYING.  If not, see
+// <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////
+
+#if defined (HAVE_CONFIG_H)
+#  include "config.h"
+#endif
+
+#include <cinttypes>
+
+#include <algorithm>
+#include <vector>
+
+#include "group-partition.h"
+#include "lo-error.h"
+#include "quit.h"
+#include "sparse-util.h"
+
+OCTAVE_BEGIN_NAMESPACE(octave)
+
+group_partition::group_partition (const idx_vector& idx,
+                                  octave_idx_type ngroups)
+  : m_ngroups (ngroups), m_n (0), m_start (), m_order ()
+{
+  if (m_ngroups < 0)
+    m_ngroups = idx.extent (0);
+  else if (idx.extent (m_ngroups) > m_ngroups)
+    (*current_liboctave_error_handler)
+      ("index %" OCTAVE_IDX_TYPE_FORMAT " out of bound "
+       "%" OCTAVE_IDX_TYPE_FORMAT, idx.extent (m_ngroups), m_ngroups);
+
+  m_n = idx.length (m_ngroups);
+
+  octave_idx_type n = m_n;
+  octave_idx_type ng = m_ngroups;
+
+  idx_vector ii = idx;
+  const octave_idx_type *id = ii.raw ();
+
+  // Each thread counts the positions per group in one part of the
+  // index vector.  The counts of all parts give the place of every
+  // position in the grouped order, so that the parts can be scattered
+  // independently.  Keep the count arrays small compared to the input.
+
+  int nt = sparse_kernel_threads (static_cast<double> (n));
+
+  octave_idx_type ntmax = std::max (4 * n / (ng + 1),
+                                    static_cast<octave_idx_type> (1));
+  if (nt > ntmax)
+    nt = static_cast<int> (ntmax);
+
+  std::vector<octave_idx_type> counts (static_cast<std::size_t> (nt)
+                                       * (ng + 1), 0);
+
+#if defined (HAVE_OPENMP)
+#  pragma omp parallel for num_threads (nt) schedule(static, 1)
+#endif
+  for (int t = 0; t < nt; t++)
+    {
+      octave_idx_type *cnt = counts.data () + t * (ng + 1);
+      octave_idx_type ib = n * t / nt;
+      octave_idx_type ie = n * (t + 1) / nt;
+
+      for (octave_idx_type i = ib; i < ie; i++)
+        cnt[id[i]]++;
+    }
+
+  octave_quit ();
+
+  m_start = Array<octave_idx_type> (dim_vector (ng + 1, 1));
+  octave_idx_type *start = m_start.rwdata ();
+
+  start[0] = 0;
+  for (octave_idx_type g = 0; g < ng; g++)
+    {
+      octave_idx_type s = start[g];
+
+      for (int t = 0; t < nt; t++)
+        {
+          octave_idx_type& cnt = counts[t * (ng + 1) + g];
+          octave_idx_type s1 = s + cnt;
+          cnt = s;
+          s = s1;
+        }
+
+      start[g+1] = s;
+    }
+
+  // Bucket sort.  The positions of each part keep their order.
+
+  m_order = Array<octave_idx_type> (dim_vector (n, 1));
+  octave_idx_type *order = m_order.rwdata ();
+
+#if defined (HAVE_OPENMP)
+#  pragma omp parallel for num_threads (nt) schedule(static, 1)
+#endif
+  for (int t = 0; t < nt; t++)
+    {
+      octave_idx_type *cnt = counts.data () + t * (ng + 1);
+      octave_idx_type ib = n * t / nt;
+      octave_idx_type ie = n * (t + 1) / nt;
+
+      for (octave_idx_type i = ib; i < ie; i++)
+        order[cnt[id[i]]++] = i;
+    }
+}
+
+void
+group_partition::parallel_groups
+  (double work,
+   const std::function<void (octave_idx_type, octave_idx_type)>& fcn) const
+{
+  int nt = sparse_kernel_threads (work * m_n);
+
+  sparse_column_blocks (m_start.data (), m_ngroups, nt, fcn);
+}
+
+OCTAVE_END_NAMESPACE(octave)
@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2024 The Octave Project Developers
+//
+// See the file COPYRIGHT.md in the top-level directory of this
+// distribution or <https://octave.org/copyright/>.
+//
+// This file is part of Octave.
+//
+// Octave is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Octave is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Octave; see the file COPYING.  If not, see
+// <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////
+
+#if ! defined (octave_group_partition_h)
+#define octave_group_partition_h 1
+
+#include "octave-config.h"
+
+#include <functional>
+
+#include "Array.h"
+#include "idx-vector.h"
+
+OCTAVE_BEGIN_NAMESPACE(octave)
+
+// The positions 0 to N-1 of an index vector grouped by the value of
+// the index, as for the reductions of accumarray.  The positions in
+// each group keep their order, so that reductions which depend on the
+// order of the terms give the same results as a serial loop.  The
+// groups are formed by several threads for large index vectors.
+
+class OCTAVE_API group_partition
+{
+public:
+
+  group_partition ()
+    : m_ngroups (0), m_n (0), m_start (dim_vector (1, 1), 0), m_order ()
+  { }
+
+  // Group the positions of the elements of IDX.  If NGROUPS is
+  // negative, the number of groups is the largest index.
+
+  group_partition (const idx_vector& idx, octave_idx_type ngroups = -1);
+
+  group_partition (const group_partition&) = default;
+
+  group_partition& operator = (const group_partition&) = default;
+
+  ~group_partition () = default;
+
+  octave_idx_type groups () const { return m_ngroups; }
+
+  // Number of positions.
+  octave_idx_type numel () const { return m_n; }
+
+  // The positions in group G are order()[start(G)] to
+  // order()[start(G+1)-1].
+
+  octave_idx_type start (octave_idx_type g) const
+  { return m_start.xelem (g); }
+
+  octave_idx_type group_size (octave_idx_type g) const
+  { return m_start.xelem (g+1) - m_start.xelem (g); }
+
+  const octave_idx_type * order () const { return m_order.data (); }
+
+  // Call FCN (GB, GE) for ranges of groups [GB, GE) with about the same
+  // number of positions in each range, using several threads if the
+  // work of about WORK operations per position is large enough.
+
+  void
+  parallel_groups (double work,
+                   const std::function<void (octave_idx_type,
+                                             octave_idx_type)>& fcn) const;
+
+private:
+
+  octave_idx_type m_ngroups;
+
+  octave_idx_type m_n;
+
+  Array<octave_idx_type> m_start;
+
+  Array<octave_idx_type> m_order;
+};
+
+OCTAVE_END_NAMESPACE(octave)
+
+#endif
@@ -41,6 +41,7 @@
 #include "oct-locbuf.h"
 #include "lo-error.h"
 #include "lo-mappers.h"
+#include "mask-util.h"
 
 OCTAVE_BEGIN_NAMESPACE(octave)
 
@@ -389,16 +390,11 @@ idx_vector::idx_vector_rep::idx_vector_rep (const Array<bool>& bnda,
     {
       octave_idx_type *d = new octave_idx_type [m_len];
 
-      octave_idx_type ntot = bnda.numel ();
-
-      octave_idx_type k = 0;
-      for (octave_idx_type i = 0; i < ntot; i++)
-        if (bnda.xelem (i))
-          d[k++] = i;
+      mask_find (bnda.data (), bnda.numel (), m_len, d);
 
       m_data = d;
 
-      m_ext = d[k-1] + 1;
+      m_ext = d[m_len-1] + 1;
     }
 }
 
@@ -652,7 +648,10 @@ idx_vector::idx_mask_rep::idx_mask_rep (const Array<bool>& bnda,
 
   // We truncate the extent as much as possible.  For Matlab
   // compatibility, but maybe it's not a bad idea anyway.
-  while (m_ext > 0 && ! bnda(m_ext-1))
+  const bool *data = bnda.data ();
+  while (m_ext >= 8 && mask_word (data + m_ext - 8) == 0)
+    m_ext -= 8;
+  while (m_ext > 0 && ! data[m_ext-1])
     m_ext--;
 
   const dim_vector dv = bnda.dims ();
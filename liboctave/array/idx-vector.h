@@ -37,6 +37,7 @@
 #include "Array-fwd.h"
 #include "dim-vector.h"
 #include "lo-error.h"
+#include "mask-util.h"
 #include "oct-inttypes.h"
 #include "oct-refcount.h"
 #include "Sparse-fwd.h"
@@ -636,8 +637,8 @@ public:
           idx_mask_rep *r = dynamic_cast<idx_mask_rep *> (m_rep);
           const bool *data = r->get_data ();
           octave_idx_type ext = r->extent (0);
-          for (octave_idx_type i = 0; i < ext; i++)
-            if (data[i]) *dest++ = src[i];
+          mask_for_each (data, ext, [&dest, src] (octave_idx_type i)
+          { *dest++ = src[i]; });
         }
         break;
 
@@ -713,8 +714,8 @@ public:
           idx_mask_rep *r = dynamic_cast<idx_mask_rep *> (m_rep);
           const bool *data = r->get_data ();
           octave_idx_type ext = r->extent (0);
-          for (octave_idx_type i = 0; i < ext; i++)
-            if (data[i]) dest[i] = *src++;
+          mask_for_each (data, ext, [dest, &src] (octave_idx_type i)
+          { dest[i] = *src++; });
         }
         break;
 
@@ -790,8 +791,8 @@ public:
           idx_mask_rep *r = dynamic_cast<idx_mask_rep *> (m_rep);
           const bool *data = r->get_data ();
           octave_idx_type ext = r->extent (0);
-          for (octave_idx_type i = 0; i < ext; i++)
-            if (data[i]) dest[i] = val;
+          mask_for_each (data, ext, [dest, &val] (octave_idx_type i)
+          { dest[i] = val; });
         }
         break;
 
@@ -861,8 +862,7 @@ public:
           idx_mask_rep *r = dynamic_cast<idx_mask_rep *> (m_rep);
           const bool *data = r->get_data ();
           octave_idx_type ext = r->extent (0);
-          for (octave_idx_type i = 0; i < ext; i++)
-            if (data[i]) body (i);
+          mask_for_each (data, ext, body);
         }
         break;
 
@@ -41,6 +41,7 @@ ARRAY_INC = \
   %reldir%/fMatrix.h \
   %reldir%/fNDArray.h \
   %reldir%/fRowVector.h \
+  %reldir%/group-partition.h \
   %reldir%/idx-vector.h \
   %reldir%/int16NDArray.h \
   %reldir%/int32NDArray.h \
@@ -49,7 +50,9 @@ ARRAY_INC = \
   %reldir%/intNDArray-fwd.h \
   %reldir%/intNDArray.h \
   %reldir%/mx-fwd.h \
+  %reldir%/packed-strings.h \
   %reldir%/range-fwd.h \
+  %reldir%/sparse-assembler.h \
   %reldir%/uint16NDArray.h \
   %reldir%/uint32NDArray.h \
   %reldir%/uint64NDArray.h \
@@ -110,11 +113,14 @@ ARRAY_SRC = \
   %reldir%/fMatrix.cc \
   %reldir%/fNDArray.cc \
   %reldir%/fRowVector.cc \
+  %reldir%/group-partition.cc \
   %reldir%/idx-vector.cc \
   %reldir%/int16NDArray.cc \
   %reldir%/int32NDArray.cc \
   %reldir%/int64NDArray.cc \
   %reldir%/int8NDArray.cc \
+  %reldir%/packed-strings.cc \
+  %reldir%/sparse-assembler.cc \
   %reldir%/uint16NDArray.cc \
   %reldir%/uint32NDArray.cc \
   %reldir%/uint64NDArray.cc \
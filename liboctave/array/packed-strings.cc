@@ -0,0 +1,369 @@
+////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2024 The Octave Project Developers
+//
+// See the file COPYRIGHT.md in the top-level directory of this
+// distribution or <https://octave.org/copyright/>.
+//
+// This file is part of Octave.
+//
+// Octave is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Octave is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Octave; see the file COPYING.  If not, see
+// <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////
+
+#if defined (HAVE_CONFIG_H)
+#  include "config.h"
+#endif
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+#include "lo-array-errwarn.h"
+#include "lo-error.h"
+#include "oct-locbuf.h"
+#include "packed-strings.h"
+#include "quit.h"
+
+OCTAVE_BEGIN_NAMESPACE(octave)
+
+packed_strings::packed_strings (const dim_vector& dv,
+                                const Array<char>& chars,
+                                const Array<octave_idx_type>& offsets)
+  : m_dims (dv), m_chars (chars), m_offsets (offsets)
+{
+  octave_idx_type n = m_dims.numel ();
+
+  if (m_offsets.numel () != n + 1 || m_offsets.xelem (0) != 0
+      || m_offsets.xelem (n) != m_chars.numel ())
+    (*current_liboctave_error_handler)
+      ("packed_strings: invalid character offsets");
+}
+
+packed_strings::packed_strings (const Array<std::string>& a)
+  : m_dims (a.dims ()), m_chars (), m_offsets ()
+{
+  octave_idx_type n = a.numel ();
+
+  m_offsets = Array<octave_idx_type> (dim_vector (n + 1, 1));
+  octave_idx_type *off = m_offsets.rwdata ();
+
+  off[0] = 0;
+  for (octave_idx_type i = 0; i < n; i++)
+    off[i+1] = off[i] + a(i).length ();
+
+  m_chars = Array<char> (dim_vector (off[n], 1));
+  char *pc = m_chars.rwdata ();
+
+  for (octave_idx_type i = 0; i < n; i++)
+    std::copy_n (a(i).data (), off[i+1] - off[i], pc + off[i]);
+}
+
+int
+packed_strings::compare (octave_idx_type i, octave_idx_type j) const
+{
+  return view (i).compare (view (j));
+}
+
+Array<std::string>
+packed_strings::array_value () const
+{
+  octave_idx_type n = numel ();
+
+  Array<std::string> retval (m_dims);
+
+  for (octave_idx_type i = 0; i < n; i++)
+    retval.xelem (i) = elem (i);
+
+  return retval;
+}
+
+Array<octave_idx_type>
+packed_strings::positions () const
+{
+  Array<octave_idx_type> pos (m_dims);
+
+  std::iota (pos.rwdata (), pos.rwdata () + pos.numel (),
+             static_cast<octave_idx_type> (0));
+
+  return pos;
+}
+
+packed_strings
+packed_strings::select (const Array<octave_idx_type>& pos) const
+{
+  octave_idx_type n = pos.numel ();
+  const octave_idx_type *pp = pos.data ();
+
+  Array<octave_idx_type> offsets (dim_vector (n + 1, 1));
+  octave_idx_type *off = offsets.rwdata ();
+
+  off[0] = 0;
+  for (octave_idx_type i = 0; i < n; i++)
+    off[i+1] = off[i] + length (pp[i]);
+
+  Array<char> chars (dim_vector (off[n], 1));
+  char *pc = chars.rwdata ();
+
+  for (octave_idx_type i = 0; i < n; i++)
+    std::copy_n (data (pp[i]), off[i+1] - off[i], pc + off[i]);
+
+  return packed_strings (pos.dims (), chars, offsets);
+}
+
+packed_strings
+packed_strings::index (const idx_vector& i) const
+{
+  // The result has the dimensions of Array<T>::index (I).  Only the
+  // positions of the selected elements are formed, so that indexing a
+  // single element does not cost as much as the whole array.
+
+  octave_idx_type n = numel ();
+
+  if (i.is_colon ())
+    return reshape (dim_vector (n, 1));
+
+  if (i.extent (n) != n)
+    err_index_out_of_range (1, 1, i.extent (n), n, m_dims);
+
+  dim_vector result_dims = i.orig_dimensions ();
+  octave_idx_type idx_len = i.length ();
+
+  if (n != 1 && m_dims.is_nd_vector () && idx_len != 1
+      && result_dims.is_nd_vector ())
+    result_dims = m_dims.make_nd_vector (idx_len);
+
+  Array<octave_idx_type> pos (result_dims);
+  octave_idx_type *pp = pos.rwdata ();
+
+  i.loop (n, [&pp] (octave_idx_type k) { *pp++ = k; });
+
+  return select (pos);
+}
+
+packed_strings
+packed_strings::index (const idx_vector& i, const idx_vector& j) const
+{
+  // Allow Fortran indexing in the 2nd dimension.
+  const dim_vector dv = m_dims.redim (2);
+  octave_idx_type r = dv(0);
+  octave_idx_type c = dv(1);
+
+  if (i.extent (r) != r)
+    err_index_out_of_range (2, 1, i.extent (r), r, m_dims);
+  if (j.extent (c) != c)
+    err_index_out_of_range (2, 2, j.extent (c), c, m_dims);
+
+  octave_idx_type il = i.length (r);
+  octave_idx_type jl = j.length (c);
+
+  Array<octave_idx_type> pos (dim_vector (il, jl));
+  octave_idx_type *pp = pos.rwdata ();
+
+  j.loop (c, [&pp, &i, r] (octave_idx_type k)
+  {
+    octave_idx_type base = r * k;
+    i.loop (r, [&pp, base] (octave_idx_type l) { *pp++ = base + l; });
+  });
+
+  return select (pos);
+}
+
+packed_strings
+packed_strings::index (const Array<idx_vector>& ia) const
+{
+  int ial = ia.numel ();
+
+  if (ial == 1)
+    return index (ia(0));
+  else if (ial == 2)
+    return index (ia(0), ia(1));
+  else if (ial == 0)
+    return select (positions ().index (ia));
+
+  // Allow Fortran indexing in the last dimension.
+  const dim_vector dv = m_dims.redim (ial);
+
+  dim_vector rdv = dim_vector::alloc (ial);
+  std::vector<octave_idx_type> stride (ial);
+
+  for (int k = 0; k < ial; k++)
+    {
+      if (ia(k).extent (dv(k)) != dv(k))
+        err_index_out_of_range (ial, k+1, ia(k).extent (dv(k)), dv(k),
+                                m_dims);
+
+      rdv(k) = ia(k).length (dv(k));
+      stride[k] = (k == 0 ? 1 : stride[k-1] * dv(k-1));
+    }
+
+  rdv.chop_trailing_singletons ();
+
+  Array<octave_idx_type> pos (rdv);
+  octave_idx_type *pp = pos.rwdata ();
+
+  // The first index varies fastest.
+  std::function<void (int, octave_idx_type)> fill
+    = [&] (int k, octave_idx_type base)
+  {
+    if (k == 0)
+      ia(0).loop (dv(0), [&pp, base] (octave_idx_type l)
+      { *pp++ = base + l; });
+    else
+      ia(k).loop (dv(k), [&fill, &stride, k, base] (octave_idx_type l)
+      { fill (k-1, base + stride[k] * l); });
+  };
+
+  fill (ial - 1, 0);
+
+  return select (pos);
+}
+
+packed_strings
+packed_strings::reshape (const dim_vector& new_dims) const
+{
+  if (m_dims == new_dims)
+    return *this;
+
+  if (m_dims.numel () != new_dims.numel ())
+    {
+      std::string dimensions_str = m_dims.str ();
+      std::string new_dims_str = new_dims.str ();
+
+      (*current_liboctave_error_handler)
+        ("reshape: can't reshape %s array to %s array",
+         dimensions_str.c_str (), new_dims_str.c_str ());
+    }
+
+  packed_strings retval = *this;
+  retval.m_dims = new_dims;
+  retval.m_dims.chop_trailing_singletons ();
+
+  return retval;
+}
+
+packed_strings
+packed_strings::permute (const Array<octave_idx_type>& vec, bool inv) const
+{
+  return select (positions ().permute (vec, inv));
+}
+
+packed_strings
+packed_strings::squeeze () const
+{
+  packed_strings retval = *this;
+  retval.m_dims = Array<octave_idx_type> (m_dims).squeeze ().dims ();
+
+  return retval;
+}
+
+packed_strings
+packed_strings::sort (int dim, sortmode mode) const
+{
+  Array<octave_idx_type> sidx;
+
+  return sort (sidx, dim, mode);
+}
+
+packed_strings
+packed_strings::sort (Array<octave_idx_type>& sidx, int dim,
+                      sortmode mode) const
+{
+  if (dim < 0)
+    (*current_liboctave_error_handler) ("sort: invalid dimension");
+
+  sidx = Array<octave_idx_type> (m_dims);
+
+  if (numel () < 1 || dim >= m_dims.ndims ())
+    {
+      std::fill_n (sidx.rwdata (), sidx.numel (), 0);
+      return *this;
+    }
+
+  octave_idx_type ns = m_dims(dim);
+  octave_idx_type iter = m_dims.numel () / ns;
+  octave_idx_type stride = 1;
+
+  for (int i = 0; i < dim; i++)
+    stride *= m_dims(i);
+
+  // Sort the positions of the elements of each vector along DIM.  The
+  // sort is stable, as for the other types.
+
+  Array<octave_idx_type> pos (m_dims);
+  octave_idx_type *pp = pos.rwdata ();
+  octave_idx_type *vi = sidx.rwdata ();
+
+  OCTAVE_LOCAL_BUFFER (octave_idx_type, perm, ns);
+
+  for (octave_idx_type j = 0; j < iter; j++)
+    {
+      octave_idx_type offset = j % stride + (j / stride) * stride * ns;
+
+      std::iota (perm, perm + ns, static_cast<octave_idx_type> (0));
+
+      if (mode == DESCENDING)
+        std::stable_sort (perm, perm + ns,
+                          [this, offset, stride] (octave_idx_type a,
+                                                  octave_idx_type b)
+                          {
+                            return view (offset + a * stride)
+                                   > view (offset + b * stride);
+                          });
+      else if (mode == ASCENDING)
+        std::stable_sort (perm, perm + ns,
+                          [this, offset, stride] (octave_idx_type a,
+                                                  octave_idx_type b)
+                          {
+                            return view (offset + a * stride)
+                                   < view (offset + b * stride);
+                          });
+
+      for (octave_idx_type i = 0; i < ns; i++)
+        {
+          pp[offset + i * stride] = offset + perm[i] * stride;
+          vi[offset + i * stride] = perm[i];
+        }
+
+      octave_quit ();
+    }
+
+  return select (pos);
+}
+
+sortmode
+packed_strings::issorted (sortmode mode) const
+{
+  octave_idx_type n = numel ();
+
+  if (n <= 1)
+    return (mode == UNSORTED) ? ASCENDING : mode;
+
+  if (mode == UNSORTED)
+    mode = (compare (n-1, 0) < 0 ? DESCENDING : ASCENDING);
+
+  for (octave_idx_type i = 1; i < n; i++)
+    {
+      int c = compare (i-1, i);
+
+      if (mode == DESCENDING ? c < 0 : c > 0)
+        return UNSORTED;
+    }
+
+  return mode;
+}
+
+OCTAVE_END_NAMESPACE(octave)
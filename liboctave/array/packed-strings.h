@@ -0,0 +1,139 @@
+////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2024 The Octave Project Developers
+//
+// See the file COPYRIGHT.md in the top-level directory of this
+// distribution or <https://octave.org/copyright/>.
+//
+// This file is part of Octave.
+//
+// Octave is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Octave is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Octave; see the file COPYING.  If not, see
+// <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////
+
+#if ! defined (octave_packed_strings_h)
+#define octave_packed_strings_h 1
+
+#include "octave-config.h"
+
+#include <cstddef>
+
+#include <string>
+#include <string_view>
+
+#include "Array.h"
+#include "dim-vector.h"
+#include "idx-vector.h"
+#include "oct-sort.h"
+
+OCTAVE_BEGIN_NAMESPACE(octave)
+
+// An N-dimensional array of strings with the characters of all elements
+// stored in one buffer.  The characters of element I are
+// chars(offsets(I):offsets(I+1)-1).
+
+class OCTAVE_API packed_strings
+{
+public:
+
+  packed_strings ()
+    : m_dims (), m_chars (), m_offsets (dim_vector (1, 1), 0)
+  { }
+
+  packed_strings (const dim_vector& dv, const Array<char>& chars,
+                  const Array<octave_idx_type>& offsets);
+
+  packed_strings (const Array<std::string>& a);
+
+  packed_strings (const packed_strings&) = default;
+
+  packed_strings& operator = (const packed_strings&) = default;
+
+  ~packed_strings () = default;
+
+  dim_vector dims () const { return m_dims; }
+
+  octave_idx_type numel () const { return m_dims.numel (); }
+
+  bool isempty () const { return numel () == 0; }
+
+  octave_idx_type length (octave_idx_type i) const
+  { return m_offsets.xelem (i+1) - m_offsets.xelem (i); }
+
+  const char * data (octave_idx_type i) const
+  { return m_chars.data () + m_offsets.xelem (i); }
+
+  std::string_view view (octave_idx_type i) const
+  { return std::string_view (data (i), length (i)); }
+
+  std::string elem (octave_idx_type i) const
+  { return std::string (data (i), length (i)); }
+
+  // Compare elements I and J like std::string::compare.
+  int compare (octave_idx_type i, octave_idx_type j) const;
+
+  const Array<char>& chars () const { return m_chars; }
+
+  const Array<octave_idx_type>& offsets () const { return m_offsets; }
+
+  std::size_t byte_size () const
+  {
+    return (m_chars.numel () * sizeof (char)
+            + m_offsets.numel () * sizeof (octave_idx_type));
+  }
+
+  Array<std::string> array_value () const;
+
+  packed_strings index (const idx_vector& i) const;
+
+  packed_strings index (const idx_vector& i, const idx_vector& j) const;
+
+  packed_strings index (const Array<idx_vector>& ia) const;
+
+  packed_strings reshape (const dim_vector& new_dims) const;
+
+  packed_strings permute (const Array<octave_idx_type>& vec,
+                          bool inv = false) const;
+
+  packed_strings squeeze () const;
+
+  packed_strings sort (int dim = 0, sortmode mode = ASCENDING) const;
+
+  packed_strings sort (Array<octave_idx_type>& sidx, int dim = 0,
+                       sortmode mode = ASCENDING) const;
+
+  sortmode issorted (sortmode mode = UNSORTED) const;
+
+private:
+
+  // The linear indices 0 to numel()-1 arranged with the dimensions of
+  // the array.  Indexing and permuting them gives the elements of the
+  // result.
+  Array<octave_idx_type> positions () const;
+
+  // The array of the elements at the linear indices POS.
+  packed_strings select (const Array<octave_idx_type>& pos) const;
+
+  dim_vector m_dims;
+
+  Array<char> m_chars;
+
+  // numel () + 1 elements.
+  Array<octave_idx_type> m_offsets;
+};
+
+OCTAVE_END_NAMESPACE(octave)
+
+#endif
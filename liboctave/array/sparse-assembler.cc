@@ -0,0 +1,232 @@
+////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2024 The Octave Project Developers
+//
+// See the file COPYRIGHT.md in the top-level directory of this
+// distribution or <https://octave.org/copyright/>.
+//
+// This file is part of Octave.
+//
+// Octave is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Octave is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Octave; see the file COPYING.  If not, see
+// <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////
+
+#if defined (HAVE_CONFIG_H)
+#  include "config.h"
+#endif
+
+#include <cinttypes>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "lo-error.h"
+#include "oct-locbuf.h"
+#include "quit.h"
+#include "sparse-assembler.h"
+#include "sparse-util.h"
+
+OCTAVE_BEGIN_NAMESPACE(octave)
+
+sparse_assembler::sparse_assembler (const idx_vector& r,
+                                    const idx_vector& c,
+                                    octave_idx_type nr, octave_idx_type nc)
+  : m_nr (nr), m_nc (nc), m_n (0), m_nthreads (1), m_cidx (), m_ridx (),
+    m_tcidx (), m_order (), m_slot ()
+{
+  if (m_nr < 0)
+    m_nr = r.extent (0);
+  else if (r.extent (m_nr) > m_nr)
+    (*current_liboctave_error_handler)
+      ("sparse: row index %" OCTAVE_IDX_TYPE_FORMAT " out of bound "
+       "%" OCTAVE_IDX_TYPE_FORMAT, r.extent (m_nr), m_nr);
+
+  if (m_nc < 0)
+    m_nc = c.extent (0);
+  else if (c.extent (m_nc) > m_nc)
+    (*current_liboctave_error_handler)
+      ("sparse: column index %" OCTAVE_IDX_TYPE_FORMAT " out of bound "
+       "%" OCTAVE_IDX_TYPE_FORMAT, c.extent (m_nc), m_nc);
+
+  octave_idx_type rl = r.length (m_nr);
+  octave_idx_type cl = c.length (m_nc);
+
+  if (rl != 1 && cl != 1 && rl != cl)
+    (*current_liboctave_error_handler) ("sparse: dimension mismatch");
+
+  m_n = (rl != 1 ? rl : cl);
+
+  octave_idx_type n = m_n;
+
+  idx_vector rr = r;
+  idx_vector cc = c;
+  const octave_idx_type *rd = rr.raw ();
+  const octave_idx_type *cd = cc.raw ();
+
+  // Each thread counts the pairs per column in one part of the input.
+  // The counts of all parts give the place of every pair in the pairs
+  // sorted by column, so that the parts can be scattered independently.
+  // Keep the count arrays small compared to the input.
+
+  int nt = sparse_kernel_threads (static_cast<double> (n));
+
+  octave_idx_type ntmax = std::max (4 * n / (m_nc + 1),
+                                    static_cast<octave_idx_type> (1));
+  if (nt > ntmax)
+    nt = static_cast<int> (ntmax);
+
+  m_nthreads = nt;
+
+  std::vector<octave_idx_type> counts (static_cast<std::size_t> (nt)
+                                       * (m_nc + 1), 0);
+
+  auto column = [=] (octave_idx_type i) { return cl == 1 ? cd[0] : cd[i]; };
+  auto row = [=] (octave_idx_type i) { return rl == 1 ? rd[0] : rd[i]; };
+
+#if defined (HAVE_OPENMP)
+#  pragma omp parallel for num_threads (nt) schedule(static, 1)
+#endif
+  for (int t = 0; t < nt; t++)
+    {
+      octave_idx_type *cnt = counts.data () + t * (m_nc + 1);
+      octave_idx_type ib = n * t / nt;
+      octave_idx_type ie = n * (t + 1) / nt;
+
+      for (octave_idx_type i = ib; i < ie; i++)
+        cnt[column (i)]++;
+    }
+
+  octave_quit ();
+
+  m_tcidx = Array<octave_idx_type> (dim_vector (m_nc + 1, 1));
+  octave_idx_type *tcidx = m_tcidx.rwdata ();
+
+  tcidx[0] = 0;
+  for (octave_idx_type j = 0; j < m_nc; j++)
+    {
+      octave_idx_type s = tcidx[j];
+
+      for (int t = 0; t < nt; t++)
+        {
+          octave_idx_type& cnt = counts[t * (m_nc + 1) + j];
+          octave_idx_type s1 = s + cnt;
+          cnt = s;
+          s = s1;
+        }
+
+      tcidx[j+1] = s;
+    }
+
+  // Bucket sort.  The pairs of each part keep their order.
+
+  typedef std::pair<octave_idx_type, octave_idx_type> idx_pair;
+  OCTAVE_LOCAL_BUFFER (idx_pair, spairs, n);
+
+#if defined (HAVE_OPENMP)
+#  pragma omp parallel for num_threads (nt) schedule(static, 1)
+#endif
+  for (int t = 0; t < nt; t++)
+    {
+      octave_idx_type *cnt = counts.data () + t * (m_nc + 1);
+      octave_idx_type ib = n * t / nt;
+      octave_idx_type ie = n * (t + 1) / nt;
+
+      for (octave_idx_type i = ib; i < ie; i++)
+        {
+          idx_pair& p = spairs[cnt[column (i)]++];
+          p.first = row (i);
+          p.second = i;
+        }
+    }
+
+  counts = std::vector<octave_idx_type> ();
+
+  octave_quit ();
+
+  // Sort the pairs of each column by row and count the distinct rows.
+  // The position in the input stabilizes the sort.
+
+  m_cidx = Array<octave_idx_type> (dim_vector (m_nc + 1, 1));
+  octave_idx_type *xcidx = m_cidx.rwdata ();
+
+  xcidx[0] = 0;
+
+  parallel_columns ([=] (octave_idx_type cb, octave_idx_type ce)
+  {
+    for (octave_idx_type j = cb; j < ce; j++)
+      {
+        std::sort (spairs + tcidx[j], spairs + tcidx[j+1]);
+
+        octave_idx_type l = -1;
+        octave_idx_type nzj = 0;
+        for (octave_idx_type p = tcidx[j]; p < tcidx[j+1]; p++)
+          {
+            if (spairs[p].first != l)
+              {
+                l = spairs[p].first;
+                nzj++;
+              }
+          }
+
+        xcidx[j+1] = nzj;
+      }
+  });
+
+  octave_quit ();
+
+  for (octave_idx_type j = 0; j < m_nc; j++)
+    xcidx[j+1] += xcidx[j];
+
+  octave_idx_type nz = xcidx[m_nc];
+
+  m_ridx = Array<octave_idx_type> (dim_vector (nz, 1));
+  m_order = Array<octave_idx_type> (dim_vector (n, 1));
+  m_slot = Array<octave_idx_type> (dim_vector (n, 1));
+
+  octave_idx_type *xridx = m_ridx.rwdata ();
+  octave_idx_type *order = m_order.rwdata ();
+  octave_idx_type *slot = m_slot.rwdata ();
+
+  parallel_columns ([=] (octave_idx_type cb, octave_idx_type ce)
+  {
+    for (octave_idx_type j = cb; j < ce; j++)
+      {
+        octave_idx_type k = xcidx[j] - 1;
+        octave_idx_type l = -1;
+
+        for (octave_idx_type p = tcidx[j]; p < tcidx[j+1]; p++)
+          {
+            if (spairs[p].first != l)
+              {
+                l = spairs[p].first;
+                xridx[++k] = l;
+              }
+
+            order[p] = spairs[p].second;
+            slot[p] = k;
+          }
+      }
+  });
+}
+
+void
+sparse_assembler::parallel_columns
+  (const std::function<void (octave_idx_type, octave_idx_type)>& fcn) const
+{
+  sparse_column_blocks (m_tcidx.data (), m_nc, m_nthreads, fcn);
+}
+
+OCTAVE_END_NAMESPACE(octave)
@@ -0,0 +1,173 @@
+////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2024 The Octave Project Developers
+//
+// See the file COPYRIGHT.md in the top-level directory of this
+// distribution or <https://octave.org/copyright/>.
+//
+// This file is part of Octave.
+//
+// Octave is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Octave is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Octave; see the file COPYING.  If not, see
+// <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////
+
+#if ! defined (octave_sparse_assembler_h)
+#define octave_sparse_assembler_h 1
+
+#include "octave-config.h"
+
+#include <algorithm>
+#include <functional>
+
+#include "Array.h"
+#include "Sparse.h"
+#include "idx-vector.h"
+#include "lo-error.h"
+
+OCTAVE_BEGIN_NAMESPACE(octave)
+
+// The sparsity pattern of the matrix built from a set of row and column
+// index pairs, as by sparse (I, J, SV).  Matrices with the same indices
+// but different values are then assembled by only scattering the values
+// into the stored pattern.  The pattern is computed by several threads
+// for large sets of indices.
+
+class OCTAVE_API sparse_assembler
+{
+public:
+
+  sparse_assembler ()
+    : m_nr (0), m_nc (0), m_n (0), m_nthreads (1),
+      m_cidx (dim_vector (1, 1), 0), m_ridx (), m_tcidx (dim_vector (1, 1), 0),
+      m_order (), m_slot ()
+  { }
+
+  // Compute the pattern for the index pairs (R(k), C(k)).  If NR or NC
+  // is negative, the dimension is the largest index.  A scalar index is
+  // used for all pairs.
+
+  sparse_assembler (const idx_vector& r, const idx_vector& c,
+                    octave_idx_type nr = -1, octave_idx_type nc = -1);
+
+  sparse_assembler (const sparse_assembler&) = default;
+
+  sparse_assembler& operator = (const sparse_assembler&) = default;
+
+  ~sparse_assembler () = default;
+
+  octave_idx_type rows () const { return m_nr; }
+
+  octave_idx_type cols () const { return m_nc; }
+
+  // Number of index pairs.
+  octave_idx_type numel () const { return m_n; }
+
+  // Number of distinct index pairs.
+  octave_idx_type nnz () const { return m_cidx.xelem (m_nc); }
+
+  const octave_idx_type * cidx () const { return m_cidx.data (); }
+
+  const octave_idx_type * ridx () const { return m_ridx.data (); }
+
+  // Store the value for every distinct index pair in DATA, which has
+  // nnz () elements.  V has numel () elements or is a scalar.  Values
+  // with the same indices are summed if SUM_TERMS is true.  Otherwise
+  // the last one is used.
+
+  template <typename T>
+  void
+  scatter (const Array<T>& v, T *data, bool sum_terms = true) const
+  {
+    octave_idx_type nv = v.numel ();
+
+    if (nv != m_n && nv != 1)
+      (*current_liboctave_error_handler) ("sparse: dimension mismatch");
+
+    const T *vd = v.data ();
+    const octave_idx_type *tcidx = m_tcidx.data ();
+    const octave_idx_type *order = m_order.data ();
+    const octave_idx_type *slot = m_slot.data ();
+
+    parallel_columns ([=] (octave_idx_type cb, octave_idx_type ce)
+    {
+      for (octave_idx_type p = tcidx[cb]; p < tcidx[ce]; p++)
+        {
+          const T& val = (nv == 1 ? vd[0] : vd[order[p]]);
+
+          if (! sum_terms || p == tcidx[cb] || slot[p] != slot[p-1])
+            data[slot[p]] = val;
+          else
+            data[slot[p]] += val;
+        }
+    });
+  }
+
+  // Return the sparse matrix with the values V, without explicitly
+  // stored zeros.
+
+  template <typename T>
+  Sparse<T>
+  assemble (const Array<T>& v, bool sum_terms = true) const
+  {
+    octave_idx_type nz = nnz ();
+
+    Sparse<T> retval (m_nr, m_nc, nz);
+
+    std::copy_n (m_cidx.data (), m_nc + 1, retval.xcidx ());
+    std::copy_n (m_ridx.data (), nz, retval.xridx ());
+
+    scatter (v, retval.xdata (), sum_terms);
+
+    retval.maybe_compress (true);
+
+    return retval;
+  }
+
+private:
+
+  // Call FCN (CB, CE) for ranges of columns [CB, CE) with about the
+  // same number of index pairs in each range, using several threads.
+
+  void
+  parallel_columns (const std::function<void (octave_idx_type,
+                                              octave_idx_type)>& fcn) const;
+
+  octave_idx_type m_nr;
+
+  octave_idx_type m_nc;
+
+  octave_idx_type m_n;
+
+  int m_nthreads;
+
+  // The pattern of the matrix.
+  Array<octave_idx_type> m_cidx;
+
+  Array<octave_idx_type> m_ridx;
+
+  // The index pairs sorted by column, row and position.  The pairs in
+  // column j are m_order(m_tcidx(j):m_tcidx(j+1)-1), and m_slot(p) is the
+  // element of the pattern that the sorted pair p contributes to.
+
+  Array<octave_idx_type> m_tcidx;
+
+  Array<octave_idx_type> m_order;
+
+  Array<octave_idx_type> m_slot;
+};
+
+OCTAVE_END_NAMESPACE(octave)
+
+#endif
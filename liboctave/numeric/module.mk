@@ -57,6 +57,7 @@ NUMERIC_INC = \
   %reldir%/randpoisson.h \
   %reldir%/schur.h \
   %reldir%/sparse-chol.h \
+  %reldir%/sparse-decomp.h \
   %reldir%/sparse-dmsolve.h \
   %reldir%/sparse-lu.h \
   %reldir%/sparse-qr.h \
@@ -93,6 +94,7 @@ NUMERIC_SRC = \
   %reldir%/randpoisson.cc \
   %reldir%/schur.cc \
   %reldir%/sparse-chol.cc \
+  %reldir%/sparse-decomp.cc \
   %reldir%/sparse-dmsolve.cc \
   %reldir%/sparse-lu.cc \
   %reldir%/sparse-qr.cc \
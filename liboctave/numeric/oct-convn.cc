@@ -28,6 +28,9 @@
 #endif
 
 #include <algorithm>
+#include <cmath>
+#include <complex>
+#include <vector>
 
 #include "Array.h"
 #include "CColVector.h"
@@ -48,7 +51,10 @@
 #include "fMatrix.h"
 #include "fNDArray.h"
 #include "fRowVector.h"
+#include "lo-mappers.h"
 #include "oct-convn.h"
+#include "oct-fftw.h"
+#include "quit.h"
 
 OCTAVE_BEGIN_NAMESPACE(octave)
 
@@ -146,6 +152,327 @@ void convolve_nd (const T *a, const dim_vector& ad, const dim_vector& acd,
     }
 }
 
+#if defined (HAVE_FFTW)
+
+enum conv_method
+{
+  conv_direct,
+  conv_fft,
+  conv_overlap_add
+};
+
+// Complex type of the Fourier transform of an array of T.
+template <typename T>
+struct fft_complex
+{
+  typedef std::complex<T> type;
+};
+
+template <typename T>
+struct fft_complex<std::complex<T>>
+{
+  typedef std::complex<T> type;
+};
+
+template <typename T>
+static inline void
+store_fft_result (T& r, const std::complex<T>& z, bool add)
+{
+  r = (add ? r + z.real () : z.real ());
+}
+
+template <typename T>
+static inline void
+store_fft_result (std::complex<T>& r, const std::complex<T>& z, bool add)
+{
+  r = (add ? r + z : z);
+}
+
+static inline bool
+is_integer_value (double x)
+{
+  return math::isinteger (x);
+}
+
+static inline bool
+is_integer_value (float x)
+{
+  return math::isinteger (x);
+}
+
+template <typename T>
+static inline bool
+is_integer_value (const std::complex<T>& x)
+{
+  return math::isinteger (x.real ()) && math::isinteger (x.imag ());
+}
+
+// Whether all elements of A are finite, and whether they are all
+// integers, which implies the former.
+
+template <typename T>
+static void
+scan_values (const MArray<T>& a, bool& all_finite, bool& all_integer)
+{
+  const T *pa = a.data ();
+  octave_idx_type n = a.numel ();
+
+  all_finite = true;
+  all_integer = true;
+
+  for (octave_idx_type i = 0; i < n && all_finite; i++)
+    {
+      if (all_integer)
+        all_integer = is_integer_value (pa[i]);
+
+      if (! all_integer)
+        all_finite = math::isfinite (pa[i]);
+    }
+}
+
+// Smallest N >= n that factors into 2, 3, 5 and 7 only.  FFTW is
+// fastest for these lengths.
+
+static octave_idx_type
+fast_fft_size (octave_idx_type n)
+{
+  for (;; n++)
+    {
+      octave_idx_type m = n;
+
+      for (int p : {2, 3, 5, 7})
+        while (m % p == 0)
+          m /= p;
+
+      if (m == 1)
+        return n;
+    }
+}
+
+// Approximate cost of a complex FFT of N points, in units of one
+// multiply-add of the direct method.
+
+static double
+fft_cost (double n)
+{
+  return n > 1 ? 2.5 * n * std::log2 (n) : 1;
+}
+
+// Choose the cheapest way to compute the convolution.  For the FFT
+// methods, also return the transform size.  For overlap-add, A is
+// split into blocks of BLOCK_LEN elements along dimension BLOCK_DIM.
+
+static conv_method
+select_conv_method (const dim_vector& adims, const dim_vector& bdims,
+                    const dim_vector& cdims, int nd, bool valid,
+                    dim_vector& fft_dims, int& block_dim,
+                    octave_idx_type& block_len)
+{
+  double nb = bdims.numel ();
+
+  double direct_cost = (valid ? cdims.numel () : adims.numel ()) * nb;
+
+  fft_dims = dim_vector::alloc (nd);
+  for (int i = 0; i < nd; i++)
+    fft_dims(i) = fast_fft_size (adims(i) + bdims(i) - 1);
+
+  double nfft = fft_dims.numel ();
+
+  conv_method method = conv_direct;
+  double best_cost = direct_cost;
+
+  // Transforms of A and B, their product, and the inverse transform.
+  double cost = 3 * fft_cost (nfft) + nfft;
+  if (cost < best_cost)
+    {
+      method = conv_fft;
+      best_cost = cost;
+    }
+
+  // Overlap-add splits A along the dimension in which it is longest
+  // relative to B.  The transform of B is computed only once.
+
+  int d = 0;
+  double ratio = 0;
+  for (int i = 0; i < nd; i++)
+    {
+      double r = static_cast<double> (adims(i)) / bdims(i);
+      if (r > ratio)
+        {
+          ratio = r;
+          d = i;
+        }
+    }
+
+  octave_idx_type full_len = adims(d) + bdims(d) - 1;
+  double other = nfft / fft_dims(d);
+  octave_idx_type best_len = 0;
+
+  for (octave_idx_type len = fast_fft_size (2 * bdims(d)); len < full_len;
+       len = fast_fft_size (2 * len))
+    {
+      octave_idx_type blk = len - bdims(d) + 1;
+      double nblocks = std::ceil (static_cast<double> (adims(d)) / blk);
+      double n = other * len;
+
+      cost = fft_cost (n) + nblocks * (2 * fft_cost (n) + n);
+      if (cost < best_cost)
+        {
+          method = conv_overlap_add;
+          best_cost = cost;
+          block_dim = d;
+          block_len = blk;
+          best_len = len;
+        }
+    }
+
+  if (method == conv_overlap_add)
+    fft_dims(d) = best_len;
+
+  return method;
+}
+
+// Copy the block of size N at offset XOFF of X to offset YOFF of Y,
+// adding to the values in Y if ADD is true.
+
+template <typename T, typename C>
+static void
+copy_fft_block (const Array<C>& x, const std::vector<octave_idx_type>& xoff,
+                MArray<T>& y, const std::vector<octave_idx_type>& yoff,
+                const dim_vector& n, bool add)
+{
+  int nd = n.ndims ();
+  const dim_vector xdims = x.dims ().redim (nd);
+  const dim_vector ydims = y.dims ().redim (nd);
+
+  const C *px = x.data ();
+  T *py = y.rwdata ();
+
+  octave_idx_type n0 = n(0);
+  octave_idx_type nouter = n.numel () / n0;
+
+  std::vector<octave_idx_type> idx (nd, 0);
+
+  for (octave_idx_type k = 0; k < nouter; k++)
+    {
+      octave_idx_type xi = xoff[0];
+      octave_idx_type yi = yoff[0];
+      octave_idx_type xstride = 1;
+      octave_idx_type ystride = 1;
+
+      for (int i = 1; i < nd; i++)
+        {
+          xstride *= xdims(i-1);
+          ystride *= ydims(i-1);
+          xi += (xoff[i] + idx[i]) * xstride;
+          yi += (yoff[i] + idx[i]) * ystride;
+        }
+
+      for (octave_idx_type j = 0; j < n0; j++)
+        store_fft_result (py[yi+j], px[xi+j], add);
+
+      for (int i = 1; i < nd; i++)
+        {
+          if (++idx[i] < n(i))
+            break;
+          idx[i] = 0;
+        }
+    }
+}
+
+// Multiply the transform of X, zero padded to FFT_DIMS, by BF and
+// transform back.  The result is stored in XF.
+
+template <typename T, typename C>
+static void
+fft_multiply (MArray<T> x, const Array<C>& bf, Array<C>& xf,
+              const dim_vector& fft_dims)
+{
+  int nd = fft_dims.ndims ();
+
+  x.resize (fft_dims, T ());
+
+  fftw::fftNd (x.data (), xf.rwdata (), nd, fft_dims);
+
+  C *pxf = xf.rwdata ();
+  const C *pbf = bf.data ();
+  octave_idx_type n = fft_dims.numel ();
+
+  for (octave_idx_type i = 0; i < n; i++)
+    pxf[i] *= pbf[i];
+
+  fftw::ifftNd (pxf, pxf, nd, fft_dims);
+}
+
+// Full convolution of A and B, computed either with a single FFT of
+// size FFT_DIMS or by overlap-add of blocks of A.
+
+template <typename T, typename R>
+static MArray<T>
+fft_convolve (const MArray<T>& a, const dim_vector& adims,
+              const MArray<R>& b, const dim_vector& bdims,
+              const dim_vector& fft_dims, conv_method method,
+              int block_dim, octave_idx_type block_len)
+{
+  typedef typename fft_complex<T>::type C;
+
+  int nd = fft_dims.ndims ();
+
+  dim_vector full = dim_vector::alloc (nd);
+  for (int i = 0; i < nd; i++)
+    full(i) = adims(i) + bdims(i) - 1;
+
+  MArray<T> c (full, T ());
+
+  MArray<R> bp = b.reshape (bdims);
+  bp.resize (fft_dims, R ());
+
+  Array<C> bf (fft_dims);
+  fftw::fftNd (bp.data (), bf.rwdata (), nd, fft_dims);
+
+  Array<C> work (fft_dims);
+  std::vector<octave_idx_type> zero (nd, 0);
+
+  if (method == conv_fft)
+    {
+      fft_multiply (a.reshape (adims), bf, work, fft_dims);
+
+      copy_fft_block (work, zero, c, zero, full, false);
+    }
+  else
+    {
+      const MArray<T> ar = a.reshape (adims);
+
+      Array<idx_vector> sidx (dim_vector (nd, 1), idx_vector::colon);
+
+      for (octave_idx_type start = 0; start < adims(block_dim);
+           start += block_len)
+        {
+          octave_quit ();
+
+          octave_idx_type len = std::min (block_len,
+                                          adims(block_dim) - start);
+
+          sidx(block_dim) = idx_vector::make_range (start, 1, len);
+
+          fft_multiply (MArray<T> (ar.index (sidx)), bf, work, fft_dims);
+
+          // Blocks overlap by the length of B minus one.
+          dim_vector n = full;
+          n(block_dim) = len + bdims(block_dim) - 1;
+
+          std::vector<octave_idx_type> off (nd, 0);
+          off[block_dim] = start;
+
+          copy_fft_block (work, zero, c, off, n, true);
+        }
+    }
+
+  return c;
+}
+
+#endif
+
 // Arbitrary convolutor.
 // The 2nd array is assumed to be the smaller one.
 template <typename T, typename R>
@@ -171,12 +498,65 @@ convolve (const MArray<T>& a, const MArray<R>& b,
                              static_cast<octave_idx_type> (0));
     }
 
-  MArray<T> c (cdims, T ());
-
   // "valid" shape can sometimes result in empty matrices which must avoid
   // calling Fortran code which does not expect this (bug #52067)
-  if (c.isempty ())
-    return c;
+  if (cdims.any_zero ())
+    return MArray<T> (cdims, T ());
+
+#if defined (HAVE_FFTW)
+
+  // Large kernels are faster with FFTs.  Integer valued inputs always
+  // use direct summation so that the result is exact.  So do inputs
+  // with Inf or NaN, which an FFT would spread over the whole result
+  // instead of only the elements that they contribute to.
+
+  dim_vector fft_dims;
+  int block_dim = 0;
+  octave_idx_type block_len = 0;
+
+  conv_method method = select_conv_method (adims, bdims, cdims, nd,
+                                           ct == convn_valid, fft_dims,
+                                           block_dim, block_len);
+
+  bool a_finite, a_integer, b_finite, b_integer;
+
+  if (method != conv_direct)
+    {
+      scan_values (a, a_finite, a_integer);
+      scan_values (b, b_finite, b_integer);
+
+      if (! (a_finite && b_finite) || (a_integer && b_integer))
+        method = conv_direct;
+    }
+
+  if (method != conv_direct)
+    {
+      MArray<T> c = fft_convolve (a, adims, b, bdims, fft_dims, method,
+                                  block_dim, block_len);
+
+      if (ct != convn_full)
+        {
+          // Pick the relevant part.
+          Array<idx_vector> sidx (dim_vector (nd, 1));
+
+          for (int i = 0; i < nd; i++)
+            {
+              octave_idx_type start = (ct == convn_same ? bdims(i)/2
+                                                        : bdims(i)-1);
+              sidx(i) = idx_vector::make_range (start, 1, (ct == convn_same
+                                                           ? adims(i)
+                                                           : cdims(i)));
+            }
+
+          c = c.index (sidx);
+        }
+
+      return c;
+    }
+
+#endif
+
+  MArray<T> c (cdims, T ());
 
   convolve_nd<T, R> (a.data (), adims, adims.cumulative (),
                      b.data (), bdims, bdims.cumulative (),
@@ -31,7 +31,10 @@
 #  include <fftw3.h>
 #endif
 
+#include <algorithm>
+
 #include "lo-error.h"
+#include "lo-sysdep.h"
 #include "oct-fftw.h"
 #include "oct-locbuf.h"
 #include "quit.h"
@@ -45,6 +48,96 @@ OCTAVE_BEGIN_NAMESPACE(octave)
 
 #if defined (HAVE_FFTW)
 
+void *
+fftw_plan_cache::lookup (int dir, int rank, const dim_vector& dims,
+                         octave_idx_type howmany, octave_idx_type stride,
+                         octave_idx_type dist, bool simd_align, bool inplace)
+{
+  for (auto it = m_entries.begin (); it != m_entries.end (); it++)
+    {
+      // Don't use an aligned plan for unaligned data, but do use a
+      // plan for unaligned data if the data happens to be aligned.
+      // This prevents endlessly recreating plans if the alignment
+      // changes.
+
+      if (it->dir != dir || it->rank != rank || it->howmany != howmany
+          || it->stride != stride || it->dist != dist
+          || it->inplace != inplace || (it->simd_align && ! simd_align))
+        continue;
+
+      bool same_dims = true;
+
+      for (int i = 0; i < rank; i++)
+        if (dims(i) != it->dims(i))
+          {
+            same_dims = false;
+            break;
+          }
+
+      if (same_dims)
+        {
+          // Move to front of list.
+          m_entries.splice (m_entries.begin (), m_entries, it);
+          m_hits++;
+          return it->plan;
+        }
+    }
+
+  m_misses++;
+
+  return nullptr;
+}
+
+void
+fftw_plan_cache::insert (int dir, int rank, const dim_vector& dims,
+                         octave_idx_type howmany, octave_idx_type stride,
+                         octave_idx_type dist, bool simd_align, bool inplace,
+                         void *plan)
+{
+  m_entries.push_front ({dir, rank, dims, howmany, stride, dist,
+                         simd_align, inplace, plan});
+
+  // Always keep the new plan, even if the capacity is zero.
+  while (m_entries.size () > std::max (m_capacity, std::size_t (1)))
+    {
+      m_destroy_plan (m_entries.back ().plan);
+      m_entries.pop_back ();
+    }
+}
+
+void
+fftw_plan_cache::clear ()
+{
+  for (auto& e : m_entries)
+    m_destroy_plan (e.plan);
+
+  m_entries.clear ();
+}
+
+void
+fftw_plan_cache::capacity (std::size_t n)
+{
+  m_capacity = n;
+
+  while (m_entries.size () > m_capacity)
+    {
+      m_destroy_plan (m_entries.back ().plan);
+      m_entries.pop_back ();
+    }
+}
+
+static void
+destroy_fftw_plan (void *plan)
+{
+  fftw_destroy_plan (reinterpret_cast<fftw_plan> (plan));
+}
+
+static void
+destroy_fftwf_plan (void *plan)
+{
+  fftwf_destroy_plan (reinterpret_cast<fftwf_plan> (plan));
+}
+
 fftw_planner *fftw_planner::s_instance = nullptr;
 
 // Helper class to create and cache FFTW plans for both 1D and
@@ -66,15 +159,9 @@ fftw_planner *fftw_planner::s_instance = nullptr;
 // Note that it is profitable to store the FFTW3 plans, for small FFTs.
 
 fftw_planner::fftw_planner ()
-  : m_meth (ESTIMATE), m_rplan (nullptr), m_rd (0), m_rs (0), m_rr (0),
-    m_rh (0), m_rn (), m_rsimd_align (false), m_nthreads (1)
+  : m_meth (ESTIMATE), m_plans (destroy_fftw_plan), m_wisdom_file (),
+    m_nthreads (1)
 {
-  m_plan[0] = m_plan[1] = nullptr;
-  m_d[0] = m_d[1] = m_s[0] = m_s[1] = m_r[0] = m_r[1] = m_h[0] = m_h[1] = 0;
-  m_simd_align[0] = m_simd_align[1] = false;
-  m_inplace[0] = m_inplace[1] = false;
-  m_n[0] = m_n[1] = dim_vector ();
-
 #if defined (HAVE_FFTW3_THREADS)
   int init_ret = fftw_init_threads ();
   if (! init_ret)
@@ -99,19 +186,10 @@ fftw_planner::fftw_planner ()
 
 fftw_planner::~fftw_planner ()
 {
-  fftw_plan *plan_p;
-
-  plan_p = reinterpret_cast<fftw_plan *> (&m_rplan);
-  if (*plan_p)
-    fftw_destroy_plan (*plan_p);
-
-  plan_p = reinterpret_cast<fftw_plan *> (&m_plan[0]);
-  if (*plan_p)
-    fftw_destroy_plan (*plan_p);
-
-  plan_p = reinterpret_cast<fftw_plan *> (&m_plan[1]);
-  if (*plan_p)
-    fftw_destroy_plan (*plan_p);
+  // Errors can not be reported this late, so a failed export is
+  // silently ignored.
+  if (! m_wisdom_file.empty ())
+    fftw_export_wisdom_to_filename (m_wisdom_file.c_str ());
 }
 
 bool
@@ -128,6 +206,21 @@ fftw_planner::instance_ok ()
   return retval;
 }
 
+bool
+fftw_planner::wisdom_file (const std::string& file)
+{
+  if (! instance_ok ())
+    return false;
+
+  s_instance->m_wisdom_file = file;
+
+  // A missing file is created when wisdom is exported.
+  if (file.empty () || ! sys::file_exists (file, false))
+    return true;
+
+  return fftw_import_wisdom_from_filename (file.c_str ());
+}
+
 void
 fftw_planner::threads (int nt)
 {
@@ -137,8 +230,7 @@ fftw_planner::threads (int nt)
       s_instance->m_nthreads = nt;
       fftw_plan_with_nthreads (nt);
       // Clear the current plans.
-      s_instance->m_rplan = nullptr;
-      s_instance->m_plan[0] = s_instance->m_plan[1] = nullptr;
+      s_instance->m_plans.clear ();
     }
 #else
   octave_unused_parameter (nt);
@@ -159,43 +251,14 @@ fftw_planner::do_create_plan (int dir, const int rank,
                               octave_idx_type dist,
                               const Complex *in, Complex *out)
 {
-  int which = (dir == FFTW_FORWARD) ? 0 : 1;
-  fftw_plan *cur_plan_p = reinterpret_cast<fftw_plan *> (&m_plan[which]);
-  bool create_new_plan = false;
   bool ioalign = CHECK_SIMD_ALIGNMENT (in) && CHECK_SIMD_ALIGNMENT (out);
   bool ioinplace = (in == out);
 
-  // Don't create a new plan if we have a non SIMD plan already but
-  // can do SIMD.  This prevents endlessly recreating plans if we
-  // change the alignment.
-
-  if (m_plan[which] == nullptr || m_d[which] != dist || m_s[which] != stride
-      || m_r[which] != rank || m_h[which] != howmany
-      || ioinplace != m_inplace[which]
-      || ((ioalign != m_simd_align[which]) ? ! ioalign : false))
-    create_new_plan = true;
-  else
-    {
-      // We still might not have the same shape of array.
-
-      for (int i = 0; i < rank; i++)
-        if (dims(i) != m_n[which](i))
-          {
-            create_new_plan = true;
-            break;
-          }
-    }
+  void *plan = m_plans.lookup (dir, rank, dims, howmany, stride, dist,
+                               ioalign, ioinplace);
 
-  if (create_new_plan)
+  if (! plan)
     {
-      m_d[which] = dist;
-      m_s[which] = stride;
-      m_r[which] = rank;
-      m_h[which] = howmany;
-      m_simd_align[which] = ioalign;
-      m_inplace[which] = ioinplace;
-      m_n[which] = dims;
-
       // Note reversal of dimensions for column major storage in FFTW.
       octave_idx_type nn = 1;
       OCTAVE_LOCAL_BUFFER (int, tmp, rank);
@@ -241,9 +304,6 @@ fftw_planner::do_create_plan (int dir, const int rank,
       else
         plan_flags |= FFTW_UNALIGNED;
 
-      if (*cur_plan_p)
-        fftw_destroy_plan (*cur_plan_p);
-
       OCTAVE_SCOPED_BUFFER_ANCHOR (Complex, itmp);
       itmp = const_cast<Complex *> (in);
       Complex *otmp = out;
@@ -260,18 +320,23 @@ fftw_planner::do_create_plan (int dir, const int rank,
             otmp = itmp;
         }
 
-      *cur_plan_p
+      fftw_plan new_plan
         = fftw_plan_many_dft (rank, tmp, howmany,
                               reinterpret_cast<fftw_complex *> (itmp),
                               nullptr, stride, dist,
                               reinterpret_cast<fftw_complex *> (otmp),
                               nullptr, stride, dist, dir, plan_flags);
 
-      if (*cur_plan_p == nullptr)
+      if (new_plan == nullptr)
         (*current_liboctave_error_handler) ("Error creating FFTW plan");
+
+      plan = new_plan;
+
+      m_plans.insert (dir, rank, dims, howmany, stride, dist, ioalign,
+                      ioinplace, plan);
     }
 
-  return *cur_plan_p;
+  return plan;
 }
 
 void *
@@ -281,38 +346,15 @@ fftw_planner::do_create_plan (const int rank, const dim_vector& dims,
                               octave_idx_type dist,
                               const double *in, Complex *out)
 {
-  fftw_plan *cur_plan_p = reinterpret_cast<fftw_plan *> (&m_rplan);
-  bool create_new_plan = false;
   bool ioalign = CHECK_SIMD_ALIGNMENT (in) && CHECK_SIMD_ALIGNMENT (out);
+  bool ioinplace = (reinterpret_cast<double *> (out) == in);
 
-  // Don't create a new plan if we have a non SIMD plan already but
-  // can do SIMD.  This prevents endlessly recreating plans if we
-  // change the alignment.
-
-  if (m_rplan == nullptr || m_rd != dist || m_rs != stride || m_rr != rank
-      || m_rh != howmany || ((ioalign != m_rsimd_align) ? ! ioalign : false))
-    create_new_plan = true;
-  else
-    {
-      // We still might not have the same shape of array.
-
-      for (int i = 0; i < rank; i++)
-        if (dims(i) != m_rn(i))
-          {
-            create_new_plan = true;
-            break;
-          }
-    }
+  // Real to complex plans are cached with direction 0.
+  void *plan = m_plans.lookup (0, rank, dims, howmany, stride, dist,
+                               ioalign, ioinplace);
 
-  if (create_new_plan)
+  if (! plan)
     {
-      m_rd = dist;
-      m_rs = stride;
-      m_rr = rank;
-      m_rh = howmany;
-      m_rsimd_align = ioalign;
-      m_rn = dims;
-
       // Note reversal of dimensions for column major storage in FFTW.
       octave_idx_type nn = 1;
       OCTAVE_LOCAL_BUFFER (int, tmp, rank);
@@ -358,9 +400,6 @@ fftw_planner::do_create_plan (const int rank, const dim_vector& dims,
       else
         plan_flags |= FFTW_UNALIGNED;
 
-      if (*cur_plan_p)
-        fftw_destroy_plan (*cur_plan_p);
-
       OCTAVE_SCOPED_BUFFER_ANCHOR (double, itmp);
       itmp = const_cast<double *> (in);
       Complex *otmp = out;
@@ -368,7 +407,7 @@ fftw_planner::do_create_plan (const int rank, const dim_vector& dims,
       if (plan_destroys_in)
         {
           // Create matrix with the same size and 16-byte alignment as input
-          octave_idx_type in_place = reinterpret_cast<double *> (out) == in;
+          octave_idx_type in_place = ioinplace;
           OCTAVE_SCOPED_BUFFER (double, itmp,
                                 nn * howmany * (in_place + 1) + 32);
           itmp = reinterpret_cast<double *>
@@ -379,17 +418,22 @@ fftw_planner::do_create_plan (const int rank, const dim_vector& dims,
             otmp = reinterpret_cast<Complex *> (itmp);
         }
 
-      *cur_plan_p
+      fftw_plan new_plan
         = fftw_plan_many_dft_r2c (rank, tmp, howmany, itmp,
                                   nullptr, stride, dist,
                                   reinterpret_cast<fftw_complex *> (otmp),
                                   nullptr, stride, dist, plan_flags);
 
-      if (*cur_plan_p == nullptr)
+      if (new_plan == nullptr)
         (*current_liboctave_error_handler) ("Error creating FFTW plan");
+
+      plan = new_plan;
+
+      m_plans.insert (0, rank, dims, howmany, stride, dist, ioalign,
+                      ioinplace, plan);
     }
 
-  return *cur_plan_p;
+  return plan;
 }
 
 fftw_planner::FftwMethod
@@ -409,13 +453,7 @@ fftw_planner::do_method (FftwMethod _meth)
       if (m_meth != _meth)
         {
           m_meth = _meth;
-          if (m_rplan)
-            fftw_destroy_plan (reinterpret_cast<fftw_plan> (m_rplan));
-          if (m_plan[0])
-            fftw_destroy_plan (reinterpret_cast<fftw_plan> (m_plan[0]));
-          if (m_plan[1])
-            fftw_destroy_plan (reinterpret_cast<fftw_plan> (m_plan[1]));
-          m_rplan = m_plan[0] = m_plan[1] = nullptr;
+          m_plans.clear ();
         }
     }
   else
@@ -426,15 +464,9 @@ fftw_planner::do_method (FftwMethod _meth)
 float_fftw_planner *float_fftw_planner::s_instance = nullptr;
 
 float_fftw_planner::float_fftw_planner ()
-  : m_meth (ESTIMATE), m_rplan (nullptr), m_rd (0), m_rs (0), m_rr (0),
-    m_rh (0), m_rn (), m_rsimd_align (false), m_nthreads (1)
+  : m_meth (ESTIMATE), m_plans (destroy_fftwf_plan), m_wisdom_file (),
+    m_nthreads (1)
 {
-  m_plan[0] = m_plan[1] = nullptr;
-  m_d[0] = m_d[1] = m_s[0] = m_s[1] = m_r[0] = m_r[1] = m_h[0] = m_h[1] = 0;
-  m_simd_align[0] = m_simd_align[1] = false;
-  m_inplace[0] = m_inplace[1] = false;
-  m_n[0] = m_n[1] = dim_vector ();
-
 #if defined (HAVE_FFTW3F_THREADS)
   int init_ret = fftwf_init_threads ();
   if (! init_ret)
@@ -454,19 +486,10 @@ float_fftw_planner::float_fftw_planner ()
 
 float_fftw_planner::~float_fftw_planner ()
 {
-  fftwf_plan *plan_p;
-
-  plan_p = reinterpret_cast<fftwf_plan *> (&m_rplan);
-  if (*plan_p)
-    fftwf_destroy_plan (*plan_p);
-
-  plan_p = reinterpret_cast<fftwf_plan *> (&m_plan[0]);
-  if (*plan_p)
-    fftwf_destroy_plan (*plan_p);
-
-  plan_p = reinterpret_cast<fftwf_plan *> (&m_plan[1]);
-  if (*plan_p)
-    fftwf_destroy_plan (*plan_p);
+  // Errors can not be reported this late, so a failed export is
+  // silently ignored.
+  if (! m_wisdom_file.empty ())
+    fftwf_export_wisdom_to_filename (m_wisdom_file.c_str ());
 }
 
 bool
@@ -483,6 +506,21 @@ float_fftw_planner::instance_ok ()
   return retval;
 }
 
+bool
+float_fftw_planner::wisdom_file (const std::string& file)
+{
+  if (! instance_ok ())
+    return false;
+
+  s_instance->m_wisdom_file = file;
+
+  // A missing file is created when wisdom is exported.
+  if (file.empty () || ! sys::file_exists (file, false))
+    return true;
+
+  return fftwf_import_wisdom_from_filename (file.c_str ());
+}
+
 void
 float_fftw_planner::threads (int nt)
 {
@@ -492,8 +530,7 @@ float_fftw_planner::threads (int nt)
       s_instance->m_nthreads = nt;
       fftwf_plan_with_nthreads (nt);
       // Clear the current plans.
-      s_instance->m_rplan = nullptr;
-      s_instance->m_plan[0] = s_instance->m_plan[1] = nullptr;
+      s_instance->m_plans.clear ();
     }
 #else
   octave_unused_parameter (nt);
@@ -512,43 +549,14 @@ float_fftw_planner::do_create_plan (int dir, const int rank,
                                     const FloatComplex *in,
                                     FloatComplex *out)
 {
-  int which = (dir == FFTW_FORWARD) ? 0 : 1;
-  fftwf_plan *cur_plan_p = reinterpret_cast<fftwf_plan *> (&m_plan[which]);
-  bool create_new_plan = false;
   bool ioalign = CHECK_SIMD_ALIGNMENT (in) && CHECK_SIMD_ALIGNMENT (out);
   bool ioinplace = (in == out);
 
-  // Don't create a new plan if we have a non SIMD plan already but
-  // can do SIMD.  This prevents endlessly recreating plans if we
-  // change the alignment.
+  void *plan = m_plans.lookup (dir, rank, dims, howmany, stride, dist,
+                               ioalign, ioinplace);
 
-  if (m_plan[which] == nullptr || m_d[which] != dist || m_s[which] != stride
-      || m_r[which] != rank || m_h[which] != howmany
-      || ioinplace != m_inplace[which]
-      || ((ioalign != m_simd_align[which]) ? ! ioalign : false))
-    create_new_plan = true;
-  else
+  if (! plan)
     {
-      // We still might not have the same shape of array.
-
-      for (int i = 0; i < rank; i++)
-        if (dims(i) != m_n[which](i))
-          {
-            create_new_plan = true;
-            break;
-          }
-    }
-
-  if (create_new_plan)
-    {
-      m_d[which] = dist;
-      m_s[which] = stride;
-      m_r[which] = rank;
-      m_h[which] = howmany;
-      m_simd_align[which] = ioalign;
-      m_inplace[which] = ioinplace;
-      m_n[which] = dims;
-
       // Note reversal of dimensions for column major storage in FFTW.
       octave_idx_type nn = 1;
       OCTAVE_LOCAL_BUFFER (int, tmp, rank);
@@ -594,9 +602,6 @@ float_fftw_planner::do_create_plan (int dir, const int rank,
       else
         plan_flags |= FFTW_UNALIGNED;
 
-      if (*cur_plan_p)
-        fftwf_destroy_plan (*cur_plan_p);
-
       OCTAVE_SCOPED_BUFFER_ANCHOR (FloatComplex, itmp);
       itmp = const_cast<FloatComplex *> (in);
       FloatComplex *otmp = out;
@@ -613,18 +618,23 @@ float_fftw_planner::do_create_plan (int dir, const int rank,
             otmp = itmp;
         }
 
-      *cur_plan_p
+      fftwf_plan new_plan
         = fftwf_plan_many_dft (rank, tmp, howmany,
                                reinterpret_cast<fftwf_complex *> (itmp),
                                nullptr, stride, dist,
                                reinterpret_cast<fftwf_complex *> (otmp),
                                nullptr, stride, dist, dir, plan_flags);
 
-      if (*cur_plan_p == nullptr)
+      if (new_plan == nullptr)
         (*current_liboctave_error_handler) ("Error creating FFTW plan");
+
+      plan = new_plan;
+
+      m_plans.insert (dir, rank, dims, howmany, stride, dist, ioalign,
+                      ioinplace, plan);
     }
 
-  return *cur_plan_p;
+  return plan;
 }
 
 void *
@@ -634,38 +644,15 @@ float_fftw_planner::do_create_plan (const int rank, const dim_vector& dims,
                                     octave_idx_type dist,
                                     const float *in, FloatComplex *out)
 {
-  fftwf_plan *cur_plan_p = reinterpret_cast<fftwf_plan *> (&m_rplan);
-  bool create_new_plan = false;
   bool ioalign = CHECK_SIMD_ALIGNMENT (in) && CHECK_SIMD_ALIGNMENT (out);
+  bool ioinplace = (reinterpret_cast<float *> (out) == in);
 
-  // Don't create a new plan if we have a non SIMD plan already but
-  // can do SIMD.  This prevents endlessly recreating plans if we
-  // change the alignment.
-
-  if (m_rplan == nullptr || m_rd != dist || m_rs != stride || m_rr != rank
-      || m_rh != howmany || ((ioalign != m_rsimd_align) ? ! ioalign : false))
-    create_new_plan = true;
-  else
-    {
-      // We still might not have the same shape of array.
-
-      for (int i = 0; i < rank; i++)
-        if (dims(i) != m_rn(i))
-          {
-            create_new_plan = true;
-            break;
-          }
-    }
+  // Real to complex plans are cached with direction 0.
+  void *plan = m_plans.lookup (0, rank, dims, howmany, stride, dist,
+                               ioalign, ioinplace);
 
-  if (create_new_plan)
+  if (! plan)
     {
-      m_rd = dist;
-      m_rs = stride;
-      m_rr = rank;
-      m_rh = howmany;
-      m_rsimd_align = ioalign;
-      m_rn = dims;
-
       // Note reversal of dimensions for column major storage in FFTW.
       octave_idx_type nn = 1;
       OCTAVE_LOCAL_BUFFER (int, tmp, rank);
@@ -711,9 +698,6 @@ float_fftw_planner::do_create_plan (const int rank, const dim_vector& dims,
       else
         plan_flags |= FFTW_UNALIGNED;
 
-      if (*cur_plan_p)
-        fftwf_destroy_plan (*cur_plan_p);
-
       OCTAVE_SCOPED_BUFFER_ANCHOR (float, itmp);
       itmp = const_cast<float *> (in);
       FloatComplex *otmp = out;
@@ -721,7 +705,7 @@ float_fftw_planner::do_create_plan (const int rank, const dim_vector& dims,
       if (plan_destroys_in)
         {
           // Create matrix with the same size and 16-byte alignment as input
-          octave_idx_type in_place = reinterpret_cast<float *> (out) == in;
+          octave_idx_type in_place = ioinplace;
           OCTAVE_SCOPED_BUFFER (float, itmp,
                                 nn * howmany * (in_place + 1) + 32);
           itmp = reinterpret_cast<float *>
@@ -732,17 +716,22 @@ float_fftw_planner::do_create_plan (const int rank, const dim_vector& dims,
             otmp = reinterpret_cast<FloatComplex *> (itmp);
         }
 
-      *cur_plan_p
+      fftwf_plan new_plan
         = fftwf_plan_many_dft_r2c (rank, tmp, howmany, itmp,
                                    nullptr, stride, dist,
                                    reinterpret_cast<fftwf_complex *> (otmp),
                                    nullptr, stride, dist, plan_flags);
 
-      if (*cur_plan_p == nullptr)
+      if (new_plan == nullptr)
         (*current_liboctave_error_handler) ("Error creating FFTW plan");
+
+      plan = new_plan;
+
+      m_plans.insert (0, rank, dims, howmany, stride, dist, ioalign,
+                      ioinplace, plan);
     }
 
-  return *cur_plan_p;
+  return plan;
 }
 
 float_fftw_planner::FftwMethod
@@ -762,13 +751,7 @@ float_fftw_planner::do_method (FftwMethod _meth)
       if (m_meth != _meth)
         {
           m_meth = _meth;
-          if (m_rplan)
-            fftwf_destroy_plan (reinterpret_cast<fftwf_plan> (m_rplan));
-          if (m_plan[0])
-            fftwf_destroy_plan (reinterpret_cast<fftwf_plan> (m_plan[0]));
-          if (m_plan[1])
-            fftwf_destroy_plan (reinterpret_cast<fftwf_plan> (m_plan[1]));
-          m_rplan = m_plan[0] = m_plan[1] = nullptr;
+          m_plans.clear ();
         }
     }
   else
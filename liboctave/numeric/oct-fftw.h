@@ -30,6 +30,7 @@
 
 #include <cstddef>
 
+#include <list>
 #include <string>
 
 #include "dim-vector.h"
@@ -37,6 +38,79 @@
 
 OCTAVE_BEGIN_NAMESPACE(octave)
 
+// Cache of FFTW plans with least recently used eviction.  Plans are
+// stored as void pointers so that the same cache can hold double and
+// single precision plans.
+
+class OCTAVE_API fftw_plan_cache
+{
+public:
+
+  fftw_plan_cache (void (*destroy_plan) (void *), std::size_t capacity = 16)
+    : m_destroy_plan (destroy_plan), m_entries (), m_capacity (capacity),
+      m_hits (0), m_misses (0)
+  { }
+
+  OCTAVE_DISABLE_CONSTRUCT_COPY_MOVE (fftw_plan_cache)
+
+  ~fftw_plan_cache () { clear (); }
+
+  // Return a plan for the given transform, or nullptr if none is
+  // cached.  DIR is FFTW_FORWARD or FFTW_BACKWARD for complex
+  // transforms and 0 for real to complex transforms.  A plan for
+  // unaligned data is also used for aligned data.
+  void * lookup (int dir, int rank, const dim_vector& dims,
+                 octave_idx_type howmany, octave_idx_type stride,
+                 octave_idx_type dist, bool simd_align, bool inplace);
+
+  // Add PLAN to the cache, destroying the least recently used plan if
+  // the cache is full.
+  void insert (int dir, int rank, const dim_vector& dims,
+               octave_idx_type howmany, octave_idx_type stride,
+               octave_idx_type dist, bool simd_align, bool inplace,
+               void *plan);
+
+  void clear ();
+
+  std::size_t capacity () const { return m_capacity; }
+
+  void capacity (std::size_t n);
+
+  std::size_t size () const { return m_entries.size (); }
+
+  std::size_t hits () const { return m_hits; }
+
+  std::size_t misses () const { return m_misses; }
+
+  void reset_statistics () { m_hits = m_misses = 0; }
+
+private:
+
+  struct entry
+  {
+    int dir;
+    int rank;
+    dim_vector dims;
+    octave_idx_type howmany;
+    octave_idx_type stride;
+    octave_idx_type dist;
+    bool simd_align;
+    bool inplace;
+    void *plan;
+  };
+
+  void (*m_destroy_plan) (void *);
+
+  // Most recently used plan first.
+  std::list<entry> m_entries;
+
+  std::size_t m_capacity;
+
+  std::size_t m_hits;
+
+  std::size_t m_misses;
+};
+
 class OCTAVE_API fftw_planner
 {
 protected:
@@ -105,6 +179,21 @@ public:
     return instance_ok () ? s_instance->m_nthreads : 0;
   }
 
+  static fftw_plan_cache * plan_cache ()
+  {
+    return instance_ok () ? &s_instance->m_plans : nullptr;
+  }
+
+  static std::string wisdom_file ()
+  {
+    return instance_ok () ? s_instance->m_wisdom_file : "";
+  }
+
+  // Import wisdom from FILE, if it exists, and export all wisdom to
+  // FILE when the planner is destroyed at exit.  An empty FILE stops
+  // exporting.  Return false if FILE exists but can not be imported.
+  static bool wisdom_file (const std::string& file);
+
 private:
 
   static fftw_planner *s_instance;
@@ -129,48 +218,12 @@ private:
 
   FftwMethod m_meth;
 
-  // FIXME: perhaps this should be split into two classes?
-
-  // Plan for fft and ifft of complex values
-  void *m_plan[2];
-
-  // dist
-  octave_idx_type m_d[2];
-
-  // stride
-  octave_idx_type m_s[2];
-
-  // rank
-  int m_r[2];
-
-  // howmany
-  octave_idx_type m_h[2];
-
-  // dims
-  dim_vector m_n[2];
-
-  bool m_simd_align[2];
-  bool m_inplace[2];
-
-  // Plan for fft of real values
-  void *m_rplan;
+  // Plans for fft and ifft of complex values and fft of real values
+  fftw_plan_cache m_plans;
 
-  // dist
-  octave_idx_type m_rd;
-
-  // stride
-  octave_idx_type m_rs;
-
-  // rank
-  int m_rr;
-
-  // howmany
-  octave_idx_type m_rh;
-
-  // dims
-  dim_vector m_rn;
-
-  bool m_rsimd_align;
+  // File from which wisdom was imported and to which it is exported
+  // when the planner is destroyed.
+  std::string m_wisdom_file;
 
   // number of threads.  Always 1 unless compiled with multi-threading
   // support.
@@ -245,6 +298,21 @@ public:
     return instance_ok () ? s_instance->m_nthreads : 0;
   }
 
+  static fftw_plan_cache * plan_cache ()
+  {
+    return instance_ok () ? &s_instance->m_plans : nullptr;
+  }
+
+  static std::string wisdom_file ()
+  {
+    return instance_ok () ? s_instance->m_wisdom_file : "";
+  }
+
+  // Import wisdom from FILE, if it exists, and export all wisdom to
+  // FILE when the planner is destroyed at exit.  An empty FILE stops
+  // exporting.  Return false if FILE exists but can not be imported.
+  static bool wisdom_file (const std::string& file);
+
 private:
 
   static float_fftw_planner *s_instance;
@@ -269,48 +337,12 @@ private:
 
   FftwMethod m_meth;
 
-  // FIXME: perhaps this should be split into two classes?
-
-  // Plan for fft and ifft of complex values
-  void *m_plan[2];
-
-  // dist
-  octave_idx_type m_d[2];
-
-  // stride
-  octave_idx_type m_s[2];
-
-  // rank
-  int m_r[2];
-
-  // howmany
-  octave_idx_type m_h[2];
-
-  // dims
-  dim_vector m_n[2];
-
-  bool m_simd_align[2];
-  bool m_inplace[2];
-
-  // Plan for fft of real values
-  void *m_rplan;
-
-  // dist
-  octave_idx_type m_rd;
-
-  // stride
-  octave_idx_type m_rs;
-
-  // rank
-  int m_rr;
-
-  // howmany
-  octave_idx_type m_rh;
-
-  // dims
-  dim_vector m_rn;
+  // Plans for fft and ifft of complex values and fft of real values
+  fftw_plan_cache m_plans;
 
-  bool m_rsimd_align;
+  // File from which wisdom was imported and to which it is exported
+  // when the planner is destroyed.
+  std::string m_wisdom_file;
 
   // number of threads.  Always 1 unless compiled with multi-threading
   // support.
@@ -51,11 +51,13 @@ rand *rand::s_instance = nullptr;
 
 rand::rand ()
   : m_current_distribution (uniform_dist), m_use_old_generators (false),
-    m_rand_states ()
+    m_use_philox (false), m_rand_states (), m_philox_states ()
 {
   initialize_ranlib_generators ();
 
   initialize_mersenne_twister ();
+
+  initialize_philox ();
 }
 
 bool
@@ -144,10 +146,32 @@ rand::do_reset ()
   initialize_ranlib_generators ();
 }
 
+static philox_stream
+philox_from_array (const uint32NDArray& s)
+{
+  philox_stream ps;
+
+  set_philox_state (ps, reinterpret_cast<const uint32_t *> (s.data ()));
+
+  return ps;
+}
+
+static uint32NDArray
+philox_to_array (const philox_stream& ps)
+{
+  uint32NDArray s (dim_vector (PHILOX_STATE_SIZE, 1));
+
+  get_philox_state (ps, reinterpret_cast<uint32_t *> (s.rwdata ()));
+
+  return s;
+}
+
 uint32NDArray
 rand::do_state (const std::string& d)
 {
-  return m_rand_states[d.empty () ? m_current_distribution : get_dist_id (d)];
+  int dist = (d.empty () ? m_current_distribution : get_dist_id (d));
+
+  return m_use_philox ? m_philox_states[dist] : m_rand_states[dist];
 }
 
 void
@@ -155,6 +179,26 @@ rand::do_state (const uint32NDArray& s, const std::string& d)
 {
   m_use_old_generators = false;
 
+  if (m_use_philox)
+    {
+      int dist = (d.empty () ? m_current_distribution : get_dist_id (d));
+
+      octave_idx_type len = s.numel ();
+
+      const uint32_t *sdata = reinterpret_cast <const uint32_t *> (s.data ());
+
+      philox_stream ps;
+
+      if (len == PHILOX_STATE_SIZE)
+        set_philox_state (ps, sdata);
+      else
+        init_philox (ps, sdata, len);
+
+      m_philox_states[dist] = philox_to_array (ps);
+
+      return;
+    }
+
   int old_dist = m_current_distribution;
 
   int new_dist = (d.empty () ? m_current_distribution : get_dist_id (d));
@@ -177,6 +221,18 @@ rand::do_reset (const std::string& d)
 {
   m_use_old_generators = false;
 
+  if (m_use_philox)
+    {
+      int dist = (d.empty () ? m_current_distribution : get_dist_id (d));
+
+      philox_stream ps;
+      init_philox (ps);
+
+      m_philox_states[dist] = philox_to_array (ps);
+
+      return;
+    }
+
   int old_dist = m_current_distribution;
 
   int new_dist = (d.empty () ? m_current_distribution : get_dist_id (d));
@@ -193,6 +249,78 @@ rand::do_reset (const std::string& d)
     m_rand_states[old_dist] = saved_state;
 }
 
+std::string
+rand::do_generator ()
+{
+  return m_use_philox ? "philox" : "twister";
+}
+
+void
+rand::do_generator (const std::string& g)
+{
+  if (g == "philox")
+    m_use_philox = true;
+  else if (g == "twister")
+    m_use_philox = false;
+  else
+    (*current_liboctave_error_handler)
+      ("rand: invalid generator '%s'", g.c_str ());
+
+  m_use_old_generators = false;
+}
+
+uint32_t
+rand::do_substream ()
+{
+  if (! m_use_philox)
+    return 0;
+
+  return philox_from_array (m_philox_states[m_current_distribution]).id;
+}
+
+void
+rand::do_substream (uint32_t id)
+{
+  if (! m_use_philox)
+    (*current_liboctave_error_handler)
+      ("rand: substreams require the \"philox\" generator");
+
+  philox_stream ps = philox_from_array (m_philox_states[m_current_distribution]);
+
+  ps.id = id;
+  ps.pos = 0;
+
+  m_philox_states[m_current_distribution] = philox_to_array (ps);
+}
+
+bool
+rand::sequential_sampling ()
+{
+  return rand_sequential ();
+}
+
+void
+rand::sequential_sampling (bool flag)
+{
+  rand_sequential (flag);
+}
+
+// 32-bit FNV-1a hash of the name.
+
+uint32_t
+rand::substream_id (const std::string& name)
+{
+  uint32_t h = 2166136261UL;
+
+  for (unsigned char c : name)
+    {
+      h ^= c;
+      h *= 16777619UL;
+    }
+
+  return h;
+}
+
 std::string
 rand::do_distribution ()
 {
@@ -475,6 +603,12 @@ rand::do_scalar (T a)
 {
   T retval = 0;
 
+  if (m_use_philox && ! m_use_old_generators)
+    {
+      fill_philox (1, &retval, a);
+      return retval;
+    }
+
   switch (m_current_distribution)
     {
     case uniform_dist:
@@ -621,6 +755,19 @@ rand::initialize_mersenne_twister ()
   set_internal_state (m_rand_states[m_current_distribution]);
 }
 
+void
+rand::initialize_philox ()
+{
+  philox_stream ps;
+
+  for (int dist : {uniform_dist, normal_dist, expon_dist, poisson_dist,
+                   gamma_dist})
+    {
+      init_philox (ps);
+      m_philox_states[dist] = philox_to_array (ps);
+    }
+}
+
 uint32NDArray
 rand::get_internal_state ()
 {
@@ -683,12 +830,55 @@ rand::switch_to_generator (int dist)
     }
 }
 
+template <typename T>
+void
+rand::fill_philox (octave_idx_type len, T *v, T a)
+{
+  philox_stream ps = philox_from_array (m_philox_states[m_current_distribution]);
+
+  switch (m_current_distribution)
+    {
+    case uniform_dist:
+      philox_uniform<T> (ps, len, v);
+      break;
+
+    case normal_dist:
+      philox_normal<T> (ps, len, v);
+      break;
+
+    case expon_dist:
+      philox_exponential<T> (ps, len, v);
+      break;
+
+    case poisson_dist:
+      philox_poisson<T> (ps, a, len, v);
+      break;
+
+    case gamma_dist:
+      philox_gamma<T> (ps, a, len, v);
+      break;
+
+    default:
+      (*current_liboctave_error_handler)
+        ("rand: invalid distribution ID = %d", m_current_distribution);
+      break;
+    }
+
+  m_philox_states[m_current_distribution] = philox_to_array (ps);
+}
+
 void
 rand::fill (octave_idx_type len, double *v, double a)
 {
   if (len < 1)
     return;
 
+  if (m_use_philox && ! m_use_old_generators)
+    {
+      fill_philox (len, v, a);
+      return;
+    }
+
   switch (m_current_distribution)
     {
     case uniform_dist:
@@ -758,6 +948,12 @@ rand::fill (octave_idx_type len, float *v, float a)
   if (len < 1)
     return;
 
+  if (m_use_philox && ! m_use_old_generators)
+    {
+      fill_philox (len, v, a);
+      return;
+    }
+
   switch (m_current_distribution)
     {
     case uniform_dist:
@@ -97,6 +97,51 @@ public:
       s_instance->do_reset (d);
   }
 
+  // Return the current generator, either "twister" or "philox".
+  static std::string generator ()
+  {
+    return instance_ok () ? s_instance->do_generator () : "";
+  }
+
+  // Select the generator used when the "seed" generators are not
+  // active.  May be either "twister" (the default) or "philox".
+  static void generator (const std::string& g)
+  {
+    if (instance_ok ())
+      s_instance->do_generator (g);
+  }
+
+  // Return the substream of the current distribution.
+  static uint32_t substream ()
+  {
+    return instance_ok () ? s_instance->do_substream () : 0;
+  }
+
+  // Switch the current distribution to the independent substream ID
+  // of its "philox" generator and restart that substream.
+  static void substream (uint32_t id)
+  {
+    if (instance_ok ())
+      s_instance->do_substream (id);
+  }
+
+  // Same as above, for a substream identified by a name.
+  static void substream (const std::string& name)
+  {
+    if (instance_ok ())
+      s_instance->do_substream (substream_id (name));
+  }
+
+  // Return the ID of the substream called NAME.
+  static OCTAVE_API uint32_t substream_id (const std::string& name);
+
+  // Return true if arrays hold the same numbers as repeated scalar
+  // calls, which is slower than drawing them in batches.
+  static OCTAVE_API bool sequential_sampling ();
+
+  // Select sequential or batched sampling.
+  static OCTAVE_API void sequential_sampling (bool flag);
+
   // Return the current distribution.
   static std::string distribution ()
   {
@@ -206,9 +251,16 @@ private:
   // Twister generator.
   bool m_use_old_generators;
 
+  // If TRUE, use the counter-based Philox generator.  Otherwise, use
+  // the Mersenne Twister generator.
+  bool m_use_philox;
+
   // Saved MT states.
   std::map<int, uint32NDArray> m_rand_states;
 
+  // Saved Philox states.
+  std::map<int, uint32NDArray> m_philox_states;
+
   // Return the current seed.
   OCTAVE_API double do_seed ();
 
@@ -227,6 +279,18 @@ private:
   // Reset the current state/
   OCTAVE_API void do_reset (const std::string& d);
 
+  // Return the current generator.
+  OCTAVE_API std::string do_generator ();
+
+  // Set the current generator.
+  OCTAVE_API void do_generator (const std::string& g);
+
+  // Return the current substream.
+  OCTAVE_API uint32_t do_substream ();
+
+  // Set the current substream.
+  OCTAVE_API void do_substream (uint32_t id);
+
   // Return the current distribution.
   OCTAVE_API std::string do_distribution ();
 
@@ -279,6 +343,8 @@ private:
 
   OCTAVE_API void initialize_mersenne_twister ();
 
+  OCTAVE_API void initialize_philox ();
+
   OCTAVE_API uint32NDArray get_internal_state ();
 
   OCTAVE_API void save_state ();
@@ -292,6 +358,9 @@ private:
   OCTAVE_API void fill (octave_idx_type len, double *v, double a);
 
   OCTAVE_API void fill (octave_idx_type len, float *v, float a);
+
+  template <typename T>
+  void fill_philox (octave_idx_type len, T *v, T a);
 };
 
 OCTAVE_END_NAMESPACE(octave)
@@ -84,6 +84,7 @@ Dirichlet(a1,...,ak) for ai > 0
 #  include "config.h"
 #endif
 
+#include <algorithm>
 #include <cmath>
 
 #include "lo-ieee.h"
@@ -93,9 +94,30 @@ Dirichlet(a1,...,ak) for ai > 0
 
 OCTAVE_BEGIN_NAMESPACE(octave)
 
+/* Number of values drawn at once by the batched generators */
+#define GAMMA_BATCH 256
+
+template <typename T>
+static T
+gamma_one (T d, T c)
+{
+  T x, xsq, v, u;
+restart:
+  x = rand_normal<T> ();
+  v = (1+c*x);
+  v *= (v*v);
+  if (v <= 0)
+    goto restart; /* rare, so don't bother moving up */
+  u = rand_uniform<T> ();
+  xsq = x*x;
+  if (u >= 1.-0.0331*xsq*xsq && std::log (u) >= 0.5*xsq + d*(1-v+std::log (v)))
+    goto restart;
+  return d*v;
+}
+
 template <typename T> void rand_gamma (T a, octave_idx_type n, T *r)
 {
-  octave_idx_type i;
+  octave_idx_type i = 0;
   /* If a < 1, start by generating gamma (1+a) */
   const T d = (a < 1. ? 1.+a : a) - 1./3.;
   const T c = 1./std::sqrt (9.*d);
@@ -108,27 +130,59 @@ template <typename T> void rand_gamma (T a, octave_idx_type n, T *r)
       return;
     }
 
-  for (i=0; i < n; i++)
+  if (! rand_sequential ())
     {
-      T x, xsq, v, u;
-    restart:
-      x = rand_normal<T> ();
-      v = (1+c*x);
-      v *= (v*v);
-      if (v <= 0)
-        goto restart; /* rare, so don't bother moving up */
-      u = rand_uniform<T> ();
-      xsq = x*x;
-      if (u >= 1.-0.0331*xsq*xsq && std::log (u) >= 0.5*xsq + d*(1-v+std::log (v)))
-        goto restart;
-      r[i] = d*v;
+      /* Draw the normal and uniform numbers for a batch at once and
+       * accept most of them with the squeeze test.  The others get the
+       * full test and are drawn again if they fail. */
+      T x[GAMMA_BATCH], u[GAMMA_BATCH];
+      bool rej[GAMMA_BATCH];
+
+      for (; i + GAMMA_BATCH <= n; i += GAMMA_BATCH)
+        {
+          rand_normal<T> (GAMMA_BATCH, x);
+          rand_uniform<T> (GAMMA_BATCH, u);
+
+          for (int j = 0; j < GAMMA_BATCH; j++)
+            {
+              T v = (1+c*x[j]);
+              v *= (v*v);
+              const T xsq = x[j]*x[j];
+              r[i+j] = d*v;
+              rej[j] = (v <= 0 || u[j] >= 1.-0.0331*xsq*xsq);
+            }
+
+          for (int j = 0; j < GAMMA_BATCH; j++)
+            if (rej[j])
+              {
+                T v = (1+c*x[j]);
+                v *= (v*v);
+                const T xsq = x[j]*x[j];
+                if (v <= 0 || std::log (u[j]) >= 0.5*xsq + d*(1-v+std::log (v)))
+                  r[i+j] = gamma_one (d, c);
+              }
+        }
     }
+
+  for (; i < n; i++)
+    r[i] = gamma_one (d, c);
+
   if (a < 1)
     {
       /* Use gamma(a) = gamma(1+a)*U^(1/a) */
       /* Given REXP = -log(U) then U^(1/a) = exp(-REXP/a) */
-      for (i = 0; i < n; i++)
-        r[i] *= exp (-rand_exponential<T> () / a);
+      T e[GAMMA_BATCH];
+
+      for (i = 0; i < n; i += GAMMA_BATCH)
+        {
+          octave_idx_type m = std::min (n - i,
+                                        static_cast<octave_idx_type> (GAMMA_BATCH));
+
+          rand_exponential<T> (m, e);
+
+          for (octave_idx_type j = 0; j < m; j++)
+            r[i+j] *= exp (-e[j] / a);
+        }
     }
 }
 
@@ -110,8 +110,9 @@
    extra performance. Check whether -DUSE_X86_32=0 is faster on 64-bit
    x86 architectures.
 
-   If you want to replace the Mersenne Twister with another
-   generator then redefine randi32 appropriately.
+   The generators below take their 32-bit words from a bit source G
+   with a member function next ().  To replace the Mersenne Twister
+   with another generator, pass a different bit source.
 
    === Usage instructions ===
    Before using any of the generators, initialize the state with one of
@@ -138,11 +139,10 @@
    static uint32_t randmt ()               returns 32-bit unsigned int
 
    === inline generators ===
-   static uint32_t randi32 ()   returns 32-bit unsigned int
-   static uint64_t randi53 ()   returns 53-bit unsigned int
-   static uint64_t randi54 ()   returns 54-bit unsigned int
-   static float randu24 ()      returns 24-bit uniform in (0,1)
-   static double randu53 ()     returns 53-bit uniform in (0,1)
+   static uint64_t randi53 (G&) returns 53-bit unsigned int
+   static uint64_t randi54 (G&) returns 54-bit unsigned int
+   static float randu24 (G&)    returns 24-bit uniform in (0,1)
+   static double randu53 (G&)   returns 53-bit uniform in (0,1)
 
    double rand_uniform ()       returns M-bit uniform in (0,1)
    double rand_normal ()        returns M-bit standard normal
@@ -165,9 +165,12 @@
 #include <algorithm>
 #include <random>
 
+#include "nproc-wrapper.h"
 #include "oct-syscalls.h"
 #include "oct-time.h"
+#include "randgamma.h"
 #include "randmtzig.h"
+#include "randpoisson.h"
 
 /* FIXME: may want to suppress X86 if sizeof(long) > 4 */
 #if ! defined (USE_X86_32)
@@ -259,10 +262,10 @@ init_mersenne_twister (const uint32_t *init_key, const int key_length)
   initf = 1;
 }
 
-void
-init_mersenne_twister ()
+/* gather up to MT_N words of entropy, returns the number of words */
+static int
+gather_entropy (uint32_t *entropy)
 {
-  uint32_t entropy[MT_N];
   int n = 0;
 
   // Gather some entropy from various sources
@@ -307,6 +310,15 @@ init_mersenne_twister ()
         }
     }
 
+  return n;
+}
+
+void
+init_mersenne_twister ()
+{
+  uint32_t entropy[MT_N];
+  int n = gather_entropy (entropy);
+
   // Send all the entropy into the initial state vector
   init_mersenne_twister (entropy, n);
 }
@@ -368,16 +380,263 @@ randmt ()
   return (y ^ (y >> 18));
 }
 
-/* ===== Uniform generators ===== */
+/* ===== Philox4x32-10 counter-based generator ===== */
+
+#define PHILOX_M0 0xD2511F53UL
+#define PHILOX_M1 0xCD9E8D57UL
+#define PHILOX_W0 0x9E3779B9UL
+#define PHILOX_W1 0xBB67AE85UL
+
+static inline void
+philox_round (uint32_t *c, const uint32_t *k)
+{
+  const uint64_t p0 = static_cast<uint64_t> (PHILOX_M0) * c[0];
+  const uint64_t p1 = static_cast<uint64_t> (PHILOX_M1) * c[2];
+
+  c[0] = static_cast<uint32_t> (p1 >> 32) ^ c[1] ^ k[0];
+  c[1] = static_cast<uint32_t> (p1);
+  c[2] = static_cast<uint32_t> (p0 >> 32) ^ c[3] ^ k[1];
+  c[3] = static_cast<uint32_t> (p0);
+}
+
+/* Encrypt the counter C in place with KEY. */
+static inline void
+philox4x32_10 (uint32_t *c, const uint32_t *key)
+{
+  uint32_t k[2] = { key[0], key[1] };
+
+  for (int r = 0; r < 9; r++)
+    {
+      philox_round (c, k);
+      k[0] += PHILOX_W0;
+      k[1] += PHILOX_W1;
+    }
+
+  philox_round (c, k);
+}
+
+/* The random bits for element POS of a stream are the encrypted counters
+ * [POS_LO, POS_HI, 0, ID], [POS_LO, POS_HI, 1, ID], ... used in turn, so
+ * that elements are independent of each other even if they need
+ * different numbers of random bits.
+ */
+class philox_bits
+{
+public:
+
+  philox_bits (const philox_stream& s)
+    : m_key { s.key[0], s.key[1] }, m_id (s.id), m_pos (0), m_block (0),
+      m_avail (0)
+  { }
+
+  void seek (uint64_t pos)
+  {
+    m_pos = pos;
+    m_block = 0;
+    m_avail = 0;
+  }
+
+  uint32_t next ()
+  {
+    if (m_avail == 0)
+      {
+        m_buf[0] = static_cast<uint32_t> (m_pos);
+        m_buf[1] = static_cast<uint32_t> (m_pos >> 32);
+        m_buf[2] = m_block++;
+        m_buf[3] = m_id;
+        philox4x32_10 (m_buf, m_key);
+        m_avail = 4;
+      }
+
+    return m_buf[4 - m_avail--];
+  }
+
+private:
+
+  uint32_t m_key[2];
+  uint32_t m_id;
+  uint64_t m_pos;
+  uint32_t m_block;
+  int m_avail;
+  uint32_t m_buf[4];
+};
+
+/* Bit source for the Mersenne Twister.  */
+class mt_bits
+{
+public:
+
+  uint32_t next () { return randmt (); }
+};
+
+/* If set, the scalar and array generators draw their random bits from
+ * this Philox stream of the current thread instead of the Mersenne
+ * Twister.  It is checked once per call, not for every word.
+ */
+static thread_local philox_bits *philox_current = nullptr;
+
+/* ===== Batched generators =====
+ *
+ * The array generators draw the random words for ZIGGURAT_BATCH numbers
+ * at once and apply the fast test of the ziggurat to all of them in a
+ * loop that can be vectorized.  The few numbers that fail the test are
+ * finished one by one with more words from the generator.  The numbers
+ * have the same distribution as those of the scalar generators but, for
+ * the Mersenne Twister, come in a different order unless sequential
+ * sampling is selected.
+ */
+
+#define ZIGGURAT_BATCH 256
+
+static bool sequential_sampling = false;
+
+void
+rand_sequential (bool flag)
+{
+  sequential_sampling = flag;
+}
+
+bool
+rand_sequential ()
+{
+  return sequential_sampling;
+}
+
+/* fills W with the next N words of the Mersenne Twister */
+static void
+randmt_fill (uint32_t *w, octave_idx_type n)
+{
+  while (n > 0)
+    {
+      /* same as the update in randmt, for a whole state vector */
+      if (left == 1)
+        {
+          next_state ();
+          left = MT_N + 1;
+        }
+
+      int k = std::min (n, static_cast<octave_idx_type> (left - 1));
+
+      for (int j = 0; j < k; j++)
+        {
+          uint32_t y = next[j];
+
+          /* Tempering */
+          y ^= (y >> 11);
+          y ^= (y << 7) & 0x9d2c5680UL;
+          y ^= (y << 15) & 0xefc60000UL;
+          w[j] = y ^ (y >> 18);
+        }
+
+      next += k;
+      left -= k;
+      w += k;
+      n -= k;
+    }
+}
+
+/* Fill P with N numbers from the Mersenne Twister.  Each number needs K
+ * words.  BATCH computes a batch of numbers from the words and flags
+ * the rejected ones, which FINISH computes from their words instead.
+ * SCALAR computes the numbers after the last full batch.
+ */
+template <int K, typename T, typename B, typename FIN, typename S>
+static void
+randmt_fill_batched (octave_idx_type n, T *p, B batch, FIN finish,
+                     S scalar)
+{
+  // Called from a generator running on a Philox stream
+  if (philox_current)
+    {
+      philox_bits& g = *philox_current;
+      std::generate_n (p, n, [&g, &scalar] () { return scalar (g); });
+      return;
+    }
+
+  mt_bits g;
+
+  octave_idx_type i = 0;
+
+  if (! sequential_sampling)
+    {
+      uint32_t w[K*ZIGGURAT_BATCH];
+      bool rej[ZIGGURAT_BATCH];
+
+      for (; i + ZIGGURAT_BATCH <= n; i += ZIGGURAT_BATCH)
+        {
+          randmt_fill (w, K*ZIGGURAT_BATCH);
 
-/* Select which 32 bit generator to use */
-#define randi32 randmt
+          batch (w, ZIGGURAT_BATCH, p + i, rej);
 
+          for (int j = 0; j < ZIGGURAT_BATCH; j++)
+            if (rej[j])
+              p[i+j] = finish (w + K*j);
+        }
+    }
+
+  std::generate_n (p + i, n - i, [&g, &scalar] () { return scalar (g); });
+}
+
+/* Stores words 0 to K-1 of the first block of the elements POS to POS+N-1
+ * of stream S in W, the same words that the scalar generators use first.
+ */
+template <int K>
+static void
+philox_words (const philox_stream& s, uint64_t pos, int n, uint32_t *w)
+{
+  uint32_t c0[ZIGGURAT_BATCH], c1[ZIGGURAT_BATCH];
+  uint32_t c2[ZIGGURAT_BATCH], c3[ZIGGURAT_BATCH];
+
+  for (int j = 0; j < n; j++)
+    {
+      c0[j] = static_cast<uint32_t> (pos + j);
+      c1[j] = static_cast<uint32_t> ((pos + j) >> 32);
+      c2[j] = 0;
+      c3[j] = s.id;
+    }
+
+  uint32_t k0 = s.key[0];
+  uint32_t k1 = s.key[1];
+
+  for (int r = 0; r < 10; r++)
+    {
+      if (r > 0)
+        {
+          k0 += PHILOX_W0;
+          k1 += PHILOX_W1;
+        }
+
+#if defined (HAVE_OPENMP)
+#  pragma omp simd
+#endif
+      for (int j = 0; j < n; j++)
+        {
+          const uint64_t p0 = static_cast<uint64_t> (PHILOX_M0) * c0[j];
+          const uint64_t p1 = static_cast<uint64_t> (PHILOX_M1) * c2[j];
+
+          c0[j] = static_cast<uint32_t> (p1 >> 32) ^ c1[j] ^ k0;
+          c1[j] = static_cast<uint32_t> (p1);
+          c2[j] = static_cast<uint32_t> (p0 >> 32) ^ c3[j] ^ k1;
+          c3[j] = static_cast<uint32_t> (p0);
+        }
+    }
+
+  for (int j = 0; j < n; j++)
+    {
+      w[K*j] = c0[j];
+      if (K > 1)
+        w[K*j+1] = c1[j];
+    }
+}
+
+/* ===== Uniform generators ===== */
+
+template <typename G>
 static uint64_t
-randi53 ()
+randi53 (G& g)
 {
-  const uint32_t lo = randi32 ();
-  const uint32_t hi = randi32 () & 0x1FFFFF;
+  const uint32_t lo = g.next ();
+  const uint32_t hi = g.next () & 0x1FFFFF;
 #if defined (HAVE_X86_32)
   uint64_t u;
   uint32_t *p = (uint32_t *)&u;
@@ -389,11 +648,12 @@ randi53 ()
 #endif
 }
 
+template <typename G>
 static uint64_t
-randi54 ()
+randi54 (G& g)
 {
-  const uint32_t lo = randi32 ();
-  const uint32_t hi = randi32 () & 0x3FFFFF;
+  const uint32_t lo = g.next ();
+  const uint32_t hi = g.next () & 0x3FFFFF;
 #if defined (HAVE_X86_32)
   uint64_t u;
   uint32_t *p = static_cast<uint32_t *> (&u);
@@ -406,14 +666,15 @@ randi54 ()
 }
 
 /* generates a random number on (0,1)-real-interval */
+template <typename G>
 static float
-randu24 ()
+randu24 (G& g)
 {
   uint32_t i;
 
   do
     {
-      i = randi32 () & static_cast<uint32_t> (0xFFFFFF);
+      i = g.next () & static_cast<uint32_t> (0xFFFFFF);
     }
   while (i == 0);
 
@@ -421,15 +682,16 @@ randu24 ()
 }
 
 /* generates a random number on (0,1) with 53-bit resolution */
+template <typename G>
 static double
-randu53 ()
+randu53 (G& g)
 {
   int32_t a, b;
 
   do
     {
-      a = randi32 () >> 5;
-      b = randi32 () >> 6;
+      a = g.next () >> 5;
+      b = g.next () >> 6;
     }
   while (a == 0 && b == 0);
 
@@ -441,7 +703,11 @@ template <>
 OCTAVE_API double
 rand_uniform<double> ()
 {
-  return randu53 ();
+  if (philox_current)
+    return randu53 (*philox_current);
+
+  mt_bits g;
+  return randu53 (g);
 }
 
 /* Determine mantissa for uniform floats */
@@ -449,7 +715,11 @@ template <>
 OCTAVE_API float
 rand_uniform<float> ()
 {
-  return randu24 ();
+  if (philox_current)
+    return randu24 (*philox_current);
+
+  mt_bits g;
+  return randu24 (g);
 }
 
 /* ===== Ziggurat normal and exponential generators ===== */
@@ -466,10 +736,10 @@ rand_uniform<float> ()
 
 #define ZIGINT uint64_t
 #define EMANTISSA 9007199254740992.0  /* 53 bit mantissa */
-#define ERANDI randi53() /* 53 bits for mantissa */
+#define ERANDI randi53 (g) /* 53 bits for mantissa */
 #define NMANTISSA EMANTISSA
-#define NRANDI randi54() /* 53 bits for mantissa + 1 bit sign */
-#define RANDU randu53()
+#define NRANDI randi54 (g) /* 53 bits for mantissa + 1 bit sign */
+#define RANDU randu53 (g)
 
 static ZIGINT ki[ZIGGURAT_TABLE_SIZE];
 static double wi[ZIGGURAT_TABLE_SIZE], fi[ZIGGURAT_TABLE_SIZE];
@@ -593,14 +863,43 @@ create_ziggurat_tables ()
  * distribution is exp(-0.5*x*x)
  */
 
-
-template <>
-OCTAVE_API double
-rand_normal<double> ()
+/* Steps 3 and 4 for X = +/-RABS * wi[IDX].  Returns true and sets X if
+ * it is accepted.
+ */
+template <typename G>
+static bool
+normal_slow (G& g, int64_t rabs, int idx, double& x)
 {
-  if (initt)
-    create_ziggurat_tables ();
+  if (idx == 0)
+    {
+      /* As stated in Marsaglia and Tsang
+       *
+       * For the normal tail, the method of Marsaglia[5] provides:
+       * generate x = -ln(U_1)/r, y = -ln(U_2), until y+y > x*x,
+       * then return r+x. Except that r+x is always in the positive
+       * tail!!!! Any thing random might be used to determine the
+       * sign, but as we already have r we might as well use it
+       *
+       * [PAK] but not the bottom 8 bits, since they are all 0 here!
+       */
+      double xx, yy;
+      do
+        {
+          xx = - ZIGGURAT_NOR_INV_R * std::log (RANDU);
+          yy = - std::log (RANDU);
+        }
+      while ( yy+yy <= xx*xx);
+      x = ((rabs & 0x100) ? -ZIGGURAT_NOR_R-xx : ZIGGURAT_NOR_R+xx);
+      return true;
+    }
+
+  return ((fi[idx-1] - fi[idx]) * RANDU + fi[idx] < exp (-0.5*x*x));
+}
 
+template <typename G>
+static double
+normal_draw (G& g)
+{
   while (1)
     {
       /* The following code is specialized for 32-bit mantissa.
@@ -618,9 +917,9 @@ rand_normal<double> ()
       uint32_t lo, hi;
       int64_t rabs;
       uint32_t *p = (uint32_t *)&rabs;
-      lo = randi32 ();
+      lo = g.next ();
       idx = lo & 0xFF;
-      hi = randi32 ();
+      hi = g.next ();
       si = hi & UMASK;
       p[0] = lo;
       p[1] = hi & 0x1FFFFF;
@@ -630,77 +929,183 @@ rand_normal<double> ()
       const uint64_t r = NRANDI;
       const int64_t rabs = r >> 1;
       const int idx = static_cast<int> (rabs & 0xFF);
-      const double x = ( (r & 1) ? -rabs : rabs) * wi[idx];
+      double x = ( (r & 1) ? -rabs : rabs) * wi[idx];
 # endif
       if (rabs < static_cast<int64_t> (ki[idx]))
         return x;        /* 99.3% of the time we return here 1st try */
-      else if (idx == 0)
-        {
-          /* As stated in Marsaglia and Tsang
-           *
-           * For the normal tail, the method of Marsaglia[5] provides:
-           * generate x = -ln(U_1)/r, y = -ln(U_2), until y+y > x*x,
-           * then return r+x. Except that r+x is always in the positive
-           * tail!!!! Any thing random might be used to determine the
-           * sign, but as we already have r we might as well use it
-           *
-           * [PAK] but not the bottom 8 bits, since they are all 0 here!
-           */
-          double xx, yy;
-          do
-            {
-              xx = - ZIGGURAT_NOR_INV_R * std::log (RANDU);
-              yy = - std::log (RANDU);
-            }
-          while ( yy+yy <= xx*xx);
-          return ((rabs & 0x100) ? -ZIGGURAT_NOR_R-xx : ZIGGURAT_NOR_R+xx);
-        }
-      else if ((fi[idx-1] - fi[idx]) * RANDU + fi[idx] < exp (-0.5*x*x))
+      else if (normal_slow (g, rabs, idx, x))
         return x;
     }
 }
 
 template <>
 OCTAVE_API double
-rand_exponential<double> ()
+rand_normal<double> ()
 {
   if (initt)
     create_ziggurat_tables ();
 
+  if (philox_current)
+    return normal_draw (*philox_current);
+
+  mt_bits g;
+  return normal_draw (g);
+}
+
+/* Steps 3 and 4 for X = RI * we[IDX].  Returns true and sets X if it is
+ * accepted.
+ */
+template <typename G>
+static bool
+exponential_slow (G& g, int idx, double& x)
+{
+  if (idx == 0)
+    {
+      /* As stated in Marsaglia and Tsang
+       *
+       * For the exponential tail, the method of Marsaglia[5] provides:
+       * x = r - ln(U);
+       */
+      x = ZIGGURAT_EXP_R - std::log (RANDU);
+      return true;
+    }
+
+  return ((fe[idx-1] - fe[idx]) * RANDU + fe[idx] < exp (-x));
+}
+
+template <typename G>
+static double
+exponential_draw (G& g)
+{
   while (1)
     {
       ZIGINT ri = ERANDI;
       const int idx = static_cast<int> (ri & 0xFF);
-      const double x = ri * we[idx];
+      double x = ri * we[idx];
       if (ri < ke[idx])
         return x;               /* 98.9% of the time we return here 1st try */
-      else if (idx == 0)
-        {
-          /* As stated in Marsaglia and Tsang
-           *
-           * For the exponential tail, the method of Marsaglia[5] provides:
-           * x = r - ln(U);
-           */
-          return ZIGGURAT_EXP_R - std::log (RANDU);
-        }
-      else if ((fe[idx-1] - fe[idx]) * RANDU + fe[idx] < exp (-x))
+      else if (exponential_slow (g, idx, x))
         return x;
     }
 }
 
+template <>
+OCTAVE_API double
+rand_exponential<double> ()
+{
+  if (initt)
+    create_ziggurat_tables ();
+
+  if (philox_current)
+    return exponential_draw (*philox_current);
+
+  mt_bits g;
+  return exponential_draw (g);
+}
+
+/* Batched versions of randu53, rand_normal and rand_exponential.  Each
+ * number X[j] is computed from the words W[2*j] and W[2*j+1] in the same
+ * way as from two words of the generator.  Numbers that need more words are
+ * flagged in REJ.
+ */
+
+static void
+uniform_batch (const uint32_t *w, int n, double *x, bool *rej)
+{
+#if defined (HAVE_OPENMP)
+#  pragma omp simd
+#endif
+  for (int j = 0; j < n; j++)
+    {
+      const int32_t a = w[2*j] >> 5;
+      const int32_t b = w[2*j+1] >> 6;
+      x[j] = (a*67108864.0 + b) * (1.0/9007199254740992.0);
+      rej[j] = (a == 0 && b == 0);
+    }
+}
+
+static void
+normal_batch (const uint32_t *w, int n, double *x, bool *rej)
+{
+#if defined (HAVE_OPENMP)
+#  pragma omp simd
+#endif
+  for (int j = 0; j < n; j++)
+    {
+      const uint64_t r = ((static_cast<uint64_t> (w[2*j+1] & 0x3FFFFF) << 32)
+                          | w[2*j]);
+      const int64_t rabs = r >> 1;
+      const int idx = static_cast<int> (rabs & 0xFF);
+      x[j] = ( (r & 1) ? -rabs : rabs) * wi[idx];
+      rej[j] = (rabs >= static_cast<int64_t> (ki[idx]));
+    }
+}
+
+static double
+normal_finish (const uint32_t *w)
+{
+  const uint64_t r = ((static_cast<uint64_t> (w[1] & 0x3FFFFF) << 32)
+                      | w[0]);
+  const int64_t rabs = r >> 1;
+  const int idx = static_cast<int> (rabs & 0xFF);
+  double x = ( (r & 1) ? -rabs : rabs) * wi[idx];
+
+  mt_bits g;
+  return normal_slow (g, rabs, idx, x) ? x : normal_draw (g);
+}
+
+static void
+exponential_batch (const uint32_t *w, int n, double *x, bool *rej)
+{
+#if defined (HAVE_OPENMP)
+#  pragma omp simd
+#endif
+  for (int j = 0; j < n; j++)
+    {
+      const uint64_t ri = ((static_cast<uint64_t> (w[2*j+1] & 0x1FFFFF) << 32)
+                           | w[2*j]);
+      const int idx = static_cast<int> (ri & 0xFF);
+      x[j] = ri * we[idx];
+      rej[j] = (ri >= ke[idx]);
+    }
+}
+
+static double
+exponential_finish (const uint32_t *w)
+{
+  const uint64_t ri = ((static_cast<uint64_t> (w[1] & 0x1FFFFF) << 32)
+                       | w[0]);
+  const int idx = static_cast<int> (ri & 0xFF);
+  double x = ri * we[idx];
+
+  mt_bits g;
+  return exponential_slow (g, idx, x) ? x : exponential_draw (g);
+}
+
 template <> OCTAVE_API void rand_uniform<double> (octave_idx_type n, double *p)
 {
-  std::generate_n (p, n, []() { return rand_uniform<double> (); });
+  randmt_fill_batched<2> (n, p, uniform_batch,
+                          [] (const uint32_t *)
+                          { mt_bits g; return randu53 (g); },
+                          [] (auto& g) { return randu53 (g); });
 }
 
 template <> OCTAVE_API void rand_normal (octave_idx_type n, double *p)
 {
-  std::generate_n (p, n, []() { return rand_normal<double> (); });
+  if (initt)
+    create_ziggurat_tables ();
+
+  randmt_fill_batched<2> (n, p, normal_batch, normal_finish,
+                          [] (auto& g) { return normal_draw (g); });
 }
 
 template <> OCTAVE_API void rand_exponential (octave_idx_type n, double *p)
 {
-  std::generate_n (p, n, []() { return rand_exponential<double> (); });
+  if (initt)
+    create_ziggurat_tables ();
+
+  randmt_fill_batched<2> (n, p, exponential_batch, exponential_finish,
+                          [] (auto& g) { return exponential_draw (g); });
 }
 
 #undef ZIGINT
@@ -712,10 +1117,10 @@ template <> OCTAVE_API void rand_exponential (octave_idx_type n, double *p)
 
 #define ZIGINT uint32_t
 #define EMANTISSA 4294967296.0 /* 32 bit mantissa */
-#define ERANDI randi32() /* 32 bits for mantissa */
+#define ERANDI g.next () /* 32 bits for mantissa */
 #define NMANTISSA 2147483648.0 /* 31 bit mantissa */
-#define NRANDI randi32() /* 31 bits for mantissa + 1 bit sign */
-#define RANDU randu24()
+#define NRANDI g.next () /* 31 bits for mantissa + 1 bit sign */
+#define RANDU randu24 (g)
 
 static ZIGINT fki[ZIGGURAT_TABLE_SIZE];
 static float fwi[ZIGGURAT_TABLE_SIZE], ffi[ZIGGURAT_TABLE_SIZE];
@@ -801,89 +1206,459 @@ create_ziggurat_float_tables ()
  * distribution is exp(-0.5*x*x)
  */
 
-template <>
-OCTAVE_API float
-rand_normal<float> ()
+/* Steps 3 and 4 for X = RI * fwi[IDX] with RABS = |RI|.  Returns true
+ * and sets X if it is accepted.
+ */
+template <typename G>
+static bool
+float_normal_slow (G& g, uint32_t rabs, int idx, float& x)
 {
-  if (inittf)
-    create_ziggurat_float_tables ();
+  if (idx == 0)
+    {
+      /* As stated in Marsaglia and Tsang
+       *
+       * For the normal tail, the method of Marsaglia[5] provides:
+       * generate x = -ln(U_1)/r, y = -ln(U_2), until y+y > x*x,
+       * then return r+x. Except that r+x is always in the positive
+       * tail!!!! Any thing random might be used to determine the
+       * sign, but as we already have r we might as well use it
+       *
+       * [PAK] but not the bottom 8 bits, since they are all 0 here!
+       */
+      float xx, yy;
+      do
+        {
+          xx = - ZIGGURAT_NOR_INV_R * std::log (RANDU);
+          yy = - std::log (RANDU);
+        }
+      while ( yy+yy <= xx*xx);
+      x = ((rabs & 0x100) ? -ZIGGURAT_NOR_R-xx : ZIGGURAT_NOR_R+xx);
+      return true;
+    }
 
+  return ((ffi[idx-1] - ffi[idx]) * RANDU + ffi[idx] < exp (-0.5*x*x));
+}
+
+template <typename G>
+static float
+float_normal_draw (G& g)
+{
   while (1)
     {
       /* 32-bit mantissa */
-      const uint32_t r = randi32 ();
+      const uint32_t r = g.next ();
       const uint32_t rabs = r & LMASK;
       const int idx = static_cast<int> (r & 0xFF);
-      const float x = static_cast<int32_t> (r) * fwi[idx];
+      float x = static_cast<int32_t> (r) * fwi[idx];
       if (rabs < fki[idx])
         return x;        /* 99.3% of the time we return here 1st try */
-      else if (idx == 0)
-        {
-          /* As stated in Marsaglia and Tsang
-           *
-           * For the normal tail, the method of Marsaglia[5] provides:
-           * generate x = -ln(U_1)/r, y = -ln(U_2), until y+y > x*x,
-           * then return r+x. Except that r+x is always in the positive
-           * tail!!!! Any thing random might be used to determine the
-           * sign, but as we already have r we might as well use it
-           *
-           * [PAK] but not the bottom 8 bits, since they are all 0 here!
-           */
-          float xx, yy;
-          do
-            {
-              xx = - ZIGGURAT_NOR_INV_R * std::log (RANDU);
-              yy = - std::log (RANDU);
-            }
-          while ( yy+yy <= xx*xx);
-          return ((rabs & 0x100) ? -ZIGGURAT_NOR_R-xx : ZIGGURAT_NOR_R+xx);
-        }
-      else if ((ffi[idx-1] - ffi[idx]) * RANDU + ffi[idx] < exp (-0.5*x*x))
+      else if (float_normal_slow (g, rabs, idx, x))
         return x;
     }
 }
 
 template <>
 OCTAVE_API float
-rand_exponential<float> ()
+rand_normal<float> ()
 {
   if (inittf)
     create_ziggurat_float_tables ();
 
+  if (philox_current)
+    return float_normal_draw (*philox_current);
+
+  mt_bits g;
+  return float_normal_draw (g);
+}
+
+/* Steps 3 and 4 for X = RI * fwe[IDX].  Returns true and sets X if it is
+ * accepted.
+ */
+template <typename G>
+static bool
+float_exponential_slow (G& g, int idx, float& x)
+{
+  if (idx == 0)
+    {
+      /* As stated in Marsaglia and Tsang
+       *
+       * For the exponential tail, the method of Marsaglia[5] provides:
+       * x = r - ln(U);
+       */
+      x = ZIGGURAT_EXP_R - std::log (RANDU);
+      return true;
+    }
+
+  return ((ffe[idx-1] - ffe[idx]) * RANDU + ffe[idx] < exp (-x));
+}
+
+template <typename G>
+static float
+float_exponential_draw (G& g)
+{
   while (1)
     {
       ZIGINT ri = ERANDI;
       const int idx = static_cast<int> (ri & 0xFF);
-      const float x = ri * fwe[idx];
+      float x = ri * fwe[idx];
       if (ri < fke[idx])
         return x;               /* 98.9% of the time we return here 1st try */
-      else if (idx == 0)
-        {
-          /* As stated in Marsaglia and Tsang
-           *
-           * For the exponential tail, the method of Marsaglia[5] provides:
-           * x = r - ln(U);
-           */
-          return ZIGGURAT_EXP_R - std::log (RANDU);
-        }
-      else if ((ffe[idx-1] - ffe[idx]) * RANDU + ffe[idx] < exp (-x))
+      else if (float_exponential_slow (g, idx, x))
         return x;
     }
 }
 
+template <>
+OCTAVE_API float
+rand_exponential<float> ()
+{
+  if (inittf)
+    create_ziggurat_float_tables ();
+
+  if (philox_current)
+    return float_exponential_draw (*philox_current);
+
+  mt_bits g;
+  return float_exponential_draw (g);
+}
+
+/* Batched versions of randu24, rand_normal and rand_exponential for
+ * floats.  Each number X[j] is computed from the word W[j].
+ */
+
+static void
+float_uniform_batch (const uint32_t *w, int n, float *x, bool *rej)
+{
+#if defined (HAVE_OPENMP)
+#  pragma omp simd
+#endif
+  for (int j = 0; j < n; j++)
+    {
+      const uint32_t i = w[j] & static_cast<uint32_t> (0xFFFFFF);
+      x[j] = i * (1.0f / 16777216.0f);
+      rej[j] = (i == 0);
+    }
+}
+
+static void
+float_normal_batch (const uint32_t *w, int n, float *x, bool *rej)
+{
+#if defined (HAVE_OPENMP)
+#  pragma omp simd
+#endif
+  for (int j = 0; j < n; j++)
+    {
+      const uint32_t r = w[j];
+      const uint32_t rabs = r & LMASK;
+      const int idx = static_cast<int> (r & 0xFF);
+      x[j] = static_cast<int32_t> (r) * fwi[idx];
+      rej[j] = (rabs >= fki[idx]);
+    }
+}
+
+static float
+float_normal_finish (const uint32_t *w)
+{
+  const uint32_t r = w[0];
+  const uint32_t rabs = r & LMASK;
+  const int idx = static_cast<int> (r & 0xFF);
+  float x = static_cast<int32_t> (r) * fwi[idx];
+
+  mt_bits g;
+  return float_normal_slow (g, rabs, idx, x) ? x : float_normal_draw (g);
+}
+
+static void
+float_exponential_batch (const uint32_t *w, int n, float *x, bool *rej)
+{
+#if defined (HAVE_OPENMP)
+#  pragma omp simd
+#endif
+  for (int j = 0; j < n; j++)
+    {
+      const uint32_t ri = w[j];
+      const int idx = static_cast<int> (ri & 0xFF);
+      x[j] = ri * fwe[idx];
+      rej[j] = (ri >= fke[idx]);
+    }
+}
+
+static float
+float_exponential_finish (const uint32_t *w)
+{
+  const uint32_t ri = w[0];
+  const int idx = static_cast<int> (ri & 0xFF);
+  float x = ri * fwe[idx];
+
+  mt_bits g;
+  return float_exponential_slow (g, idx, x) ? x : float_exponential_draw (g);
+}
+
 template <> OCTAVE_API void rand_uniform (octave_idx_type n, float *p)
 {
-  std::generate_n (p, n, []() { return rand_uniform<float> (); });
+  randmt_fill_batched<1> (n, p, float_uniform_batch,
+                          [] (const uint32_t *)
+                          { mt_bits g; return randu24 (g); },
+                          [] (auto& g) { return randu24 (g); });
 }
 
 template <> OCTAVE_API void rand_normal (octave_idx_type n, float *p)
 {
-  std::generate_n (p, n, []() { return rand_normal<float> (); });
+  if (inittf)
+    create_ziggurat_float_tables ();
+
+  randmt_fill_batched<1> (n, p, float_normal_batch, float_normal_finish,
+                          [] (auto& g) { return float_normal_draw (g); });
 }
 
 template <> OCTAVE_API void rand_exponential (octave_idx_type n, float *p)
 {
-  std::generate_n (p, n, []() { return rand_exponential<float> (); });
+  if (inittf)
+    create_ziggurat_float_tables ();
+
+  randmt_fill_batched<1> (n, p, float_exponential_batch,
+                          float_exponential_finish,
+                          [] (auto& g) { return float_exponential_draw (g); });
+}
+
+/* ===== Philox streams ===== */
+
+static uint64_t
+splitmix64 (uint64_t x)
+{
+  x += 0x9E3779B97F4A7C15ULL;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+  return x ^ (x >> 31);
+}
+
+/* initialize the key of a stream by hashing an array */
+void
+init_philox (philox_stream& s, const uint32_t *init_key,
+             const int key_length)
+{
+  uint64_t h = splitmix64 (key_length);
+
+  for (int i = 0; i < key_length; i++)
+    h = splitmix64 (h ^ init_key[i]);
+
+  s.key[0] = static_cast<uint32_t> (h);
+  s.key[1] = static_cast<uint32_t> (h >> 32);
+  s.id = 0;
+  s.pos = 0;
+}
+
+void
+init_philox (philox_stream& s)
+{
+  uint32_t entropy[MT_N];
+  int n = gather_entropy (entropy);
+
+  init_philox (s, entropy, n);
+}
+
+void
+set_philox_state (philox_stream& s, const uint32_t *save)
+{
+  s.key[0] = save[0];
+  s.key[1] = save[1];
+  s.id = save[2];
+  s.pos = (static_cast<uint64_t> (save[4]) << 32) | save[3];
+}
+
+void
+get_philox_state (const philox_stream& s, uint32_t *save)
+{
+  save[0] = s.key[0];
+  save[1] = s.key[1];
+  save[2] = s.id;
+  save[3] = static_cast<uint32_t> (s.pos);
+  save[4] = static_cast<uint32_t> (s.pos >> 32);
+}
+
+/* Set P[i] = FCN (BITS) for 0 <= i < N, with FCN drawing its random
+ * bits from BITS, positioned at element S.pos+i of stream S.  Large
+ * arrays are filled in parallel.  The result does not depend on the
+ * number of threads.
+ *
+ * If K > 0, BATCH computes batches of numbers from the first K words of
+ * each element, as the batched Mersenne Twister generators do.  Only
+ * the rejected numbers are computed by FCN, from the start of their
+ * element, so that the result is the same as without BATCH.
+ */
+template <int K, typename T, typename F, typename B>
+static void
+philox_fill (philox_stream& s, octave_idx_type n, T *p, F fcn, B batch)
+{
+  if (n < 1)
+    return;
+
+  // The tables must exist before any thread uses them.
+  if (initt)
+    create_ziggurat_tables ();
+  if (inittf)
+    create_ziggurat_float_tables ();
+
+  const uint64_t pos = s.pos;
+
+  auto fill_range = [=] (octave_idx_type lo, octave_idx_type hi)
+  {
+    philox_bits bits (s);
+    philox_current = &bits;
+
+    octave_idx_type i = lo;
+
+    if (K > 0)
+      {
+        uint32_t w[(K > 0 ? K : 1) * ZIGGURAT_BATCH];
+        bool rej[ZIGGURAT_BATCH];
+
+        for (; i + ZIGGURAT_BATCH <= hi; i += ZIGGURAT_BATCH)
+          {
+            philox_words<K> (s, pos + i, ZIGGURAT_BATCH, w);
+
+            batch (w, ZIGGURAT_BATCH, p + i, rej);
+
+            for (int j = 0; j < ZIGGURAT_BATCH; j++)
+              if (rej[j])
+                {
+                  bits.seek (pos + i + j);
+                  p[i+j] = fcn (bits);
+                }
+          }
+      }
+
+    for (; i < hi; i++)
+      {
+        bits.seek (pos + i);
+        p[i] = fcn (bits);
+      }
+
+    philox_current = nullptr;
+  };
+
+  const octave_idx_type chunk = 16384;
+
+#if defined (HAVE_OPENMP)
+  octave_idx_type n_chunks = (n + chunk - 1) / chunk;
+
+  int nthreads
+    = octave_num_processors_wrapper (OCTAVE_NPROC_CURRENT_OVERRIDABLE);
+
+  if (nthreads > 1 && n_chunks > 1)
+    {
+      if (nthreads > n_chunks)
+        nthreads = n_chunks;
+
+#  pragma omp parallel for num_threads (nthreads) schedule (static)
+      for (octave_idx_type c = 0; c < n_chunks; c++)
+        fill_range (c * chunk, std::min (n, (c + 1) * chunk));
+    }
+  else
+    fill_range (0, n);
+#else
+  fill_range (0, n);
+#endif
+
+  s.pos += n;
+}
+
+template <typename T>
+static void
+no_batch (const uint32_t *, int, T *, bool *)
+{ }
+
+template <> OCTAVE_API void
+philox_uniform<double> (philox_stream& s, octave_idx_type n, double *p)
+{
+  philox_fill<2> (s, n, p,
+                  [] (philox_bits& g) { return randu53 (g); },
+                  uniform_batch);
+}
+
+template <> OCTAVE_API void
+philox_uniform<float> (philox_stream& s, octave_idx_type n, float *p)
+{
+  philox_fill<1> (s, n, p,
+                  [] (philox_bits& g)
+                  { return randu24 (g); },
+                  float_uniform_batch);
+}
+
+template <> OCTAVE_API void
+philox_normal<double> (philox_stream& s, octave_idx_type n, double *p)
+{
+  philox_fill<2> (s, n, p,
+                  [] (philox_bits& g)
+                  { return normal_draw (g); },
+                  normal_batch);
+}
+
+template <> OCTAVE_API void
+philox_normal<float> (philox_stream& s, octave_idx_type n, float *p)
+{
+  philox_fill<1> (s, n, p,
+                  [] (philox_bits& g)
+                  { return float_normal_draw (g); },
+                  float_normal_batch);
+}
+
+template <> OCTAVE_API void
+philox_exponential<double> (philox_stream& s, octave_idx_type n, double *p)
+{
+  philox_fill<2> (s, n, p,
+                  [] (philox_bits& g)
+                  { return exponential_draw (g); },
+                  exponential_batch);
+}
+
+template <> OCTAVE_API void
+philox_exponential<float> (philox_stream& s, octave_idx_type n, float *p)
+{
+  philox_fill<1> (s, n, p,
+                  [] (philox_bits& g)
+                  { return float_exponential_draw (g); },
+                  float_exponential_batch);
+}
+
+template <> OCTAVE_API void
+philox_gamma<double> (philox_stream& s, double a, octave_idx_type n,
+                      double *p)
+{
+  philox_fill<0> (s, n, p,
+                  [a] (philox_bits&)
+                  { return rand_gamma<double> (a); },
+                  no_batch<double>);
+}
+
+template <> OCTAVE_API void
+philox_gamma<float> (philox_stream& s, float a, octave_idx_type n, float *p)
+{
+  philox_fill<0> (s, n, p,
+                  [a] (philox_bits&)
+                  { return rand_gamma<float> (a); },
+                  no_batch<float>);
+}
+
+template <> OCTAVE_API void
+philox_poisson<double> (philox_stream& s, double a, octave_idx_type n,
+                        double *p)
+{
+  philox_fill<0> (s, n, p,
+                  [a] (philox_bits&)
+                  { return rand_poisson<double> (a); },
+                  no_batch<double>);
+}
+
+template <> OCTAVE_API void
+philox_poisson<float> (philox_stream& s, float a, octave_idx_type n,
+                       float *p)
+{
+  // Keep poisson distribution in double precision for accuracy
+  philox_fill<0> (s, n, p,
+                  [a] (philox_bits&)
+                  { return static_cast<float> (rand_poisson<double> (a)); },
+                  no_batch<float>);
 }
 
 OCTAVE_END_NAMESPACE(octave)
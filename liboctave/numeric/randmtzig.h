@@ -83,6 +83,13 @@ extern OCTAVE_API void init_mersenne_twister (const uint32_t *init_key,
 extern OCTAVE_API void set_mersenne_twister_state (const uint32_t *save);
 extern OCTAVE_API void get_mersenne_twister_state (uint32_t *save);
 
+// If FLAG is true, the array generators return the same numbers as
+// repeated calls of the scalar generators.  Otherwise, they sample in
+// batches, which is faster but gives the numbers in a different order.
+
+extern OCTAVE_API void rand_sequential (bool flag);
+extern OCTAVE_API bool rand_sequential ();
+
 template <typename T> OCTAVE_API T rand_uniform ();
 template <typename T> OCTAVE_API T rand_normal ();
 template <typename T> OCTAVE_API T rand_exponential ();
@@ -118,6 +125,42 @@ rand_normal<float> (octave_idx_type n, float *p);
 template <> OCTAVE_API void
 rand_exponential<float> (octave_idx_type n, float *p);
 
+// Philox4x32-10 counter-based generator (J. K. Salmon, M. A. Moraes,
+// R. O. Dror, and D. E. Shaw, "Parallel random numbers: as easy as 1, 2,
+// 3", SC11, 2011).  Element POS of the stream ID only depends on KEY, ID,
+// and POS, so arrays may be filled in parallel and streams with
+// different IDs are independent.
+
+struct philox_stream
+{
+  uint32_t key[2];
+  uint32_t id;
+  uint64_t pos;
+};
+
+// Number of uint32_t values to save the state of a stream.
+#define PHILOX_STATE_SIZE 5
+
+extern OCTAVE_API void init_philox (philox_stream& s);
+extern OCTAVE_API void init_philox (philox_stream& s, const uint32_t *init_key,
+                                    const int key_length);
+
+extern OCTAVE_API void set_philox_state (philox_stream& s,
+                                         const uint32_t *save);
+extern OCTAVE_API void get_philox_state (const philox_stream& s,
+                                         uint32_t *save);
+
+template <typename T> OCTAVE_API void
+philox_uniform (philox_stream& s, octave_idx_type n, T *p);
+template <typename T> OCTAVE_API void
+philox_normal (philox_stream& s, octave_idx_type n, T *p);
+template <typename T> OCTAVE_API void
+philox_exponential (philox_stream& s, octave_idx_type n, T *p);
+template <typename T> OCTAVE_API void
+philox_gamma (philox_stream& s, T a, octave_idx_type n, T *p);
+template <typename T> OCTAVE_API void
+philox_poisson (philox_stream& s, T a, octave_idx_type n, T *p);
+
 OCTAVE_END_NAMESPACE(octave)
 
 #endif
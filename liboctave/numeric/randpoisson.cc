@@ -30,6 +30,7 @@
 #  include "config.h"
 #endif
 
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 
@@ -293,6 +294,9 @@ pprsc (double my)
  * will need to be longer still.  */
 #define TABLESIZE 46
 
+/* Number of uniform numbers drawn at once */
+#define POISSON_BATCH 256
+
 /* Given uniform u, find x such that CDF(L,x)==u.  Return x. */
 
 template <typename T>
@@ -308,6 +312,12 @@ poisson_cdf_lookup (double lambda, T *p, std::size_t n)
   int tableidx;
   std::size_t i = n;
 
+  /* Uniform numbers are drawn in batches, but used in the same order
+   * as if they were drawn one by one. */
+  double u_batch[POISSON_BATCH];
+  std::size_t n_batch = 0;
+  std::size_t i_batch = 0;
+
   t[0] = P = exp (-lambda);
   for (tableidx = 1; tableidx <= intlambda; tableidx++)
     {
@@ -317,7 +327,14 @@ poisson_cdf_lookup (double lambda, T *p, std::size_t n)
 
   while (i-- > 0)
     {
-      double u = rand_uniform<double> ();
+      if (i_batch == n_batch)
+        {
+          n_batch = std::min (i + 1, static_cast<std::size_t> (POISSON_BATCH));
+          rand_uniform<double> (n_batch, u_batch);
+          i_batch = 0;
+        }
+
+      double u = u_batch[i_batch++];
 
       /* If u > 0.458 we know we can jump to floor(lambda) before
        * comparing (this observation is based on Stadlober's winrand
@@ -423,9 +440,10 @@ rand_poisson (T L_arg, octave_idx_type n, T *p)
     {
       /* normal approximation: from Phys. Rev. D (1994) v50 p1284 */
       const double sqrtL = std::sqrt (L);
+      rand_normal<T> (n, p);
       for (i = 0; i < n; i++)
         {
-          p[i] = std::floor (rand_normal<T> () * sqrtL + L + 0.5);
+          p[i] = std::floor (p[i] * sqrtL + L + 0.5);
           if (p[i] < 0.0)
             p[i] = 0.0; /* will probably never happen */
         }
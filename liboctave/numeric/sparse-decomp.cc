@@ -0,0 +1,422 @@
+////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2024 The Octave Project Developers
+//
+// See the file COPYRIGHT.md in the top-level directory of this
+// distribution or <https://octave.org/copyright/>.
+//
+// This file is part of Octave.
+//
+// Octave is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Octave is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Octave; see the file COPYING.  If not, see
+// <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////
+
+#if defined (HAVE_CONFIG_H)
+#  include "config.h"
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#include "CMatrix.h"
+#include "CSparse.h"
+#include "MatrixType.h"
+#include "dMatrix.h"
+#include "dRowVector.h"
+#include "dSparse.h"
+#include "idx-vector.h"
+#include "lo-array-errwarn.h"
+#include "lo-error.h"
+#include "lo-ieee.h"
+#include "oct-cmplx.h"
+#include "sparse-chol.h"
+#include "sparse-decomp.h"
+#include "sparse-lu.h"
+#include "sparse-qr.h"
+
+OCTAVE_BEGIN_NAMESPACE(octave)
+
+OCTAVE_BEGIN_NAMESPACE(math)
+
+// Return the rows B(P(i),:) ./ R(P(i)).  An empty P or R stands for
+// the identity.
+
+template <typename T>
+static T
+permute_rows (const T& b, const MArray<octave_idx_type>& p,
+              const ColumnVector& r = ColumnVector ())
+{
+  if (p.isempty () && r.isempty ())
+    return b;
+
+  octave_idx_type nr = b.rows ();
+  octave_idx_type nc = b.cols ();
+
+  T retval (nr, nc);
+
+  for (octave_idx_type j = 0; j < nc; j++)
+    for (octave_idx_type i = 0; i < nr; i++)
+      {
+        octave_idx_type k = (p.isempty () ? i : p.xelem (i));
+
+        if (r.isempty ())
+          retval.xelem (i, j) = b.xelem (k, j);
+        else
+          retval.xelem (i, j) = b.xelem (k, j) / r.xelem (k);
+      }
+
+  return retval;
+}
+
+// Return X with X(Q(i),:) = W(i,:).  An empty Q stands for the
+// identity.
+
+template <typename T>
+static T
+unpermute_rows (const T& w, const MArray<octave_idx_type>& q)
+{
+  if (q.isempty ())
+    return w;
+
+  octave_idx_type nr = w.rows ();
+  octave_idx_type nc = w.cols ();
+
+  T retval (nr, nc);
+
+  for (octave_idx_type j = 0; j < nc; j++)
+    for (octave_idx_type i = 0; i < nr; i++)
+      retval.xelem (q.xelem (i), j) = w.xelem (i, j);
+
+  return retval;
+}
+
+// Q'*B for the QR factorization.  The real factorization is applied to
+// the real and imaginary parts of a complex right-hand side separately.
+
+static Matrix
+qr_apply (const sparse_qr<SparseMatrix>& q, const Matrix& b)
+{
+  return q.C (b);
+}
+
+static ComplexMatrix
+qr_apply (const sparse_qr<SparseMatrix>& q, const ComplexMatrix& b)
+{
+  return ComplexMatrix (q.C (real (b)), q.C (imag (b)));
+}
+
+static ComplexMatrix
+qr_apply (const sparse_qr<SparseComplexMatrix>& q, const ComplexMatrix& b)
+{
+  return q.C (b);
+}
+
+// Convert a one-based permutation vector to a zero-based index array.
+
+template <typename T>
+static MArray<octave_idx_type>
+zero_based_perm (const T& perm)
+{
+  octave_idx_type n = perm.numel ();
+
+  MArray<octave_idx_type> retval (dim_vector (n, 1));
+
+  for (octave_idx_type i = 0; i < n; i++)
+    retval.xelem (i) = static_cast<octave_idx_type> (perm.xelem (i)) - 1;
+
+  return retval;
+}
+
+template <typename SPARSE_T>
+sparse_decomposition<SPARSE_T>::sparse_decomposition
+(const SPARSE_T& a, decomposition_type type)
+  : m_type (type), m_nr (a.rows ()), m_nc (a.cols ()), m_rcond (0),
+    m_L (), m_U (), m_R (), m_P (), m_Q (), m_qr ()
+{
+  if (m_type == automatic)
+    {
+      if (m_nr != m_nc)
+        m_type = qr;
+      else
+        {
+          MatrixType mattype (a);
+          int typ = mattype.type ();
+
+          if (typ == MatrixType::Hermitian
+              || typ == MatrixType::Banded_Hermitian
+              || typ == MatrixType::Tridiagonal_Hermitian)
+            {
+              factor_chol (a, false, true);
+              return;
+            }
+
+          m_type = lu;
+        }
+    }
+
+  switch (m_type)
+    {
+    case lu:
+      factor_lu (a, false);
+      break;
+
+    case chol:
+      factor_chol (a, false, false);
+      break;
+
+    case qr:
+      factor_qr (a);
+      break;
+
+    default:
+      (*current_liboctave_error_handler)
+        ("sparse_decomposition: invalid decomposition type");
+    }
+}
+
+template <typename SPARSE_T>
+void
+sparse_decomposition<SPARSE_T>::refactor (const SPARSE_T& a)
+{
+  if (a.rows () != m_nr || a.cols () != m_nc)
+    (*current_liboctave_error_handler)
+      ("sparse_decomposition: matrix must have the same size as the factorized matrix");
+
+  switch (m_type)
+    {
+    case lu:
+      factor_lu (a, true);
+      break;
+
+    case chol:
+      factor_chol (a, true, false);
+      break;
+
+    case qr:
+      factor_qr (a);
+      break;
+
+    default:
+      (*current_liboctave_error_handler)
+        ("sparse_decomposition: nothing to refactorize");
+    }
+}
+
+template <typename SPARSE_T>
+std::string
+sparse_decomposition<SPARSE_T>::type_name () const
+{
+  switch (m_type)
+    {
+    case lu:
+      return "lu";
+
+    case chol:
+      return "chol";
+
+    case qr:
+      return "qr";
+
+    default:
+      return "";
+    }
+}
+
+template <typename SPARSE_T>
+void
+sparse_decomposition<SPARSE_T>::factor_lu (const SPARSE_T& a,
+                                           bool reuse_ordering)
+{
+  if (m_nr != m_nc)
+    (*current_liboctave_error_handler)
+      ("sparse_decomposition: LU factorization requires a square matrix");
+
+  // With the column ordering of the previous factorization fixed,
+  // UMFPACK skips the fill-reducing ordering and only repeats the
+  // cheap part of the symbolic analysis.
+  sparse_lu<SPARSE_T> fact;
+
+  if (reuse_ordering)
+    {
+      ColumnVector qinit (m_nc);
+      for (octave_idx_type i = 0; i < m_nc; i++)
+        qinit.xelem (i) = m_Q.xelem (i);
+
+      fact = sparse_lu<SPARSE_T> (a, qinit, Matrix (), true, true);
+    }
+  else
+    fact = sparse_lu<SPARSE_T> (a, Matrix (), true);
+
+  m_type = lu;
+  m_rcond = fact.rcond ();
+  m_L = fact.L ();
+  m_U = fact.U ();
+
+  const SparseMatrix r = fact.R ();
+  m_R = ColumnVector (m_nr);
+  for (octave_idx_type i = 0; i < m_nr; i++)
+    m_R.xelem (i) = r.data (i);
+
+  m_P = zero_based_perm (fact.Pr_vec ());
+  m_Q = zero_based_perm (fact.Pc_vec ());
+}
+
+template <typename SPARSE_T>
+void
+sparse_decomposition<SPARSE_T>::factor_chol (const SPARSE_T& a,
+                                             bool reuse_ordering,
+                                             bool fallback)
+{
+  if (m_nr != m_nc)
+    (*current_liboctave_error_handler)
+      ("sparse_decomposition: Cholesky factorization requires a square matrix");
+
+  octave_idx_type info = 0;
+  MArray<octave_idx_type> perm;
+
+  sparse_chol<SPARSE_T> fact;
+
+  if (reuse_ordering && ! m_Q.isempty ())
+    {
+      // Factorize the permuted matrix with the natural ordering.
+      idx_vector iv (m_Q);
+      SPARSE_T ap (a.index (iv, iv));
+
+      fact = sparse_chol<SPARSE_T> (ap, info, true, false);
+      perm = m_Q;
+    }
+  else
+    {
+      fact = sparse_chol<SPARSE_T> (a, info, false, false);
+      perm = zero_based_perm (fact.perm ());
+    }
+
+  if (info != 0)
+    {
+      if (fallback)
+        {
+          factor_lu (a, false);
+          return;
+        }
+
+      (*current_liboctave_error_handler)
+        ("sparse_decomposition: matrix is not positive definite");
+    }
+
+  m_type = chol;
+  m_rcond = fact.rcond ();
+  m_L = fact.L ();
+  m_U = m_L.hermitian ();
+  m_R = ColumnVector ();
+
+  // A(Q,Q) = L*L', so A*x = b is solved as L*L'*x(Q) = b(Q).
+  m_P = perm;
+  m_Q = perm;
+}
+
+template <typename SPARSE_T>
+void
+sparse_decomposition<SPARSE_T>::factor_qr (const SPARSE_T& a)
+{
+  if (m_nr < m_nc)
+    (*current_liboctave_error_handler)
+      ("sparse_decomposition: QR factorization requires at least as many rows as columns");
+
+  m_type = qr;
+  m_qr = sparse_qr<SPARSE_T> (a);
+
+  // Only the leading square block of R is nonzero.  Keep it as the
+  // triangular factor together with the column permutation.
+  SPARSE_T r = m_qr.R (false);
+  m_U = r.index (idx_vector (0, m_nc), idx_vector (0, m_nc));
+  m_L = SPARSE_T ();
+  m_R = ColumnVector ();
+  m_P = MArray<octave_idx_type> ();
+  m_Q = zero_based_perm (m_qr.E ());
+
+  // Estimate the reciprocal condition number from the diagonal of R.
+  const SPARSE_T& u = m_U;
+  double dmin = lo_ieee_inf_value ();
+  double dmax = 0;
+  for (octave_idx_type i = 0; i < m_nc; i++)
+    {
+      double d = std::abs (u.elem (i, i));
+      dmin = std::min (dmin, d);
+      dmax = std::max (dmax, d);
+    }
+
+  m_rcond = (m_nc == 0 ? lo_ieee_inf_value ()
+             : (dmax == 0 ? 0 : dmin / dmax));
+}
+
+template <typename SPARSE_T>
+template <typename RHS_T, typename RET_T>
+RET_T
+sparse_decomposition<SPARSE_T>::solve (const RHS_T& b) const
+{
+  octave_idx_type b_nr = b.rows ();
+  octave_idx_type b_nc = b.cols ();
+
+  if (b_nr != m_nr)
+    err_nonconformant ("operator \\", m_nr, m_nc, b_nr, b_nc);
+
+  if (m_type == automatic)
+    (*current_liboctave_error_handler)
+      ("sparse_decomposition: matrix has not been factorized");
+
+  MatrixType ltype (MatrixType::Lower);
+  MatrixType utype (MatrixType::Upper);
+  octave_idx_type info;
+  double rcond;
+
+  RET_T w;
+
+  if (m_type == qr)
+    {
+      RET_T c = qr_apply (m_qr, RET_T (b));
+      w = m_U.solve (utype, c.extract_n (0, 0, m_nc, b_nc), info, rcond,
+                     nullptr, false);
+    }
+  else
+    {
+      RET_T y = m_L.solve (ltype, permute_rows (b, m_P, m_R), info, rcond,
+                           nullptr, false);
+      w = m_U.solve (utype, y, info, rcond, nullptr, false);
+    }
+
+  return unpermute_rows (w, m_Q);
+}
+
+// Instantiations we need.
+
+template class OCTAVE_API sparse_decomposition<SparseMatrix>;
+
+template OCTAVE_API Matrix
+sparse_decomposition<SparseMatrix>::solve<Matrix, Matrix>
+(const Matrix& b) const;
+
+template OCTAVE_API ComplexMatrix
+sparse_decomposition<SparseMatrix>::solve<ComplexMatrix, ComplexMatrix>
+(const ComplexMatrix& b) const;
+
+template class OCTAVE_API sparse_decomposition<SparseComplexMatrix>;
+
+template OCTAVE_API ComplexMatrix
+sparse_decomposition<SparseComplexMatrix>::solve<ComplexMatrix, ComplexMatrix>
+(const ComplexMatrix& b) const;
+
+OCTAVE_END_NAMESPACE(math)
+OCTAVE_END_NAMESPACE(octave)
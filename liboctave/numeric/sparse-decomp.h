@@ -0,0 +1,151 @@
+////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2024 The Octave Project Developers
+//
+// See the file COPYRIGHT.md in the top-level directory of this
+// distribution or <https://octave.org/copyright/>.
+//
+// This file is part of Octave.
+//
+// Octave is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Octave is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Octave; see the file COPYING.  If not, see
+// <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////
+
+#if ! defined (octave_sparse_decomp_h)
+#define octave_sparse_decomp_h 1
+
+#include "octave-config.h"
+
+#include <string>
+
+#include "CSparse.h"
+#include "MArray.h"
+#include "dColVector.h"
+#include "dSparse.h"
+#include "sparse-qr.h"
+
+OCTAVE_BEGIN_NAMESPACE(octave)
+
+OCTAVE_BEGIN_NAMESPACE(math)
+
+// A factorization of a sparse matrix that is kept so that it can be
+// used for any number of solves.  The matrix can also be refactorized
+// with the fill-reducing ordering of the previous factorization, which
+// skips the ordering step when only the values of the matrix change.
+
+template <typename SPARSE_T>
+class sparse_decomposition
+{
+public:
+
+  enum decomposition_type
+  {
+    automatic = 0,
+    lu,
+    chol,
+    qr
+  };
+
+  typedef typename SPARSE_T::element_type elt_type;
+
+  typedef typename SPARSE_T::dense_matrix_type dense_matrix_type;
+
+  sparse_decomposition ()
+    : m_type (automatic), m_nr (0), m_nc (0), m_rcond (0), m_L (), m_U (),
+      m_R (), m_P (), m_Q (), m_qr ()
+  { }
+
+  // Factorize A.  With TYPE automatic, a Cholesky factorization is
+  // tried for Hermitian matrices with a positive diagonal, LU is used
+  // for other square matrices and QR for rectangular ones.
+
+  OCTAVE_API sparse_decomposition (const SPARSE_T& a,
+                                   decomposition_type type = automatic);
+
+  sparse_decomposition (const sparse_decomposition&) = default;
+
+  sparse_decomposition& operator = (const sparse_decomposition&) = default;
+
+  ~sparse_decomposition () = default;
+
+  // Factorize A, which must have the same size as the matrix that was
+  // factorized before, with the same type of factorization and the
+  // same fill-reducing ordering.
+
+  OCTAVE_API void refactor (const SPARSE_T& a);
+
+  decomposition_type type () const { return m_type; }
+
+  OCTAVE_API std::string type_name () const;
+
+  octave_idx_type rows () const { return m_nr; }
+
+  octave_idx_type cols () const { return m_nc; }
+
+  double rcond () const { return m_rcond; }
+
+  // Solve A*X = B.  For a QR factorization this is the least squares
+  // solution.
+
+  template <typename RHS_T, typename RET_T>
+  OCTAVE_API RET_T solve (const RHS_T& b) const;
+
+private:
+
+  void factor_lu (const SPARSE_T& a, bool reuse_ordering);
+
+  void factor_chol (const SPARSE_T& a, bool reuse_ordering,
+                    bool fallback);
+
+  void factor_qr (const SPARSE_T& a);
+
+  decomposition_type m_type;
+
+  octave_idx_type m_nr;
+
+  octave_idx_type m_nc;
+
+  double m_rcond;
+
+  // Triangular factors.  For LU, P*(R\A)*Q = L*U, where the row
+  // scaling R is kept as a vector.  For Cholesky, L*U = A(Q,Q) with
+  // U = L' and P = Q.  The permutations are stored as zero-based vectors
+  // and are empty for the identity.
+
+  SPARSE_T m_L;
+
+  SPARSE_T m_U;
+
+  ColumnVector m_R;
+
+  MArray<octave_idx_type> m_P;
+
+  MArray<octave_idx_type> m_Q;
+
+  sparse_qr<SPARSE_T> m_qr;
+};
+
+// extern instantiations with set visibility/export/import attribute
+
+extern template class OCTAVE_EXTERN_TEMPLATE_API
+sparse_decomposition<SparseMatrix>;
+
+extern template class OCTAVE_EXTERN_TEMPLATE_API
+sparse_decomposition<SparseComplexMatrix>;
+
+OCTAVE_END_NAMESPACE(math)
+OCTAVE_END_NAMESPACE(octave)
+
+#endif
@@ -28,10 +28,20 @@
 
 #include "octave-config.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#if defined (HAVE_OPENMP)
+#  include <omp.h>
+#endif
+
 #include "Array-util.h"
 #include "lo-array-errwarn.h"
 #include "mx-inlines.cc"
 #include "oct-locbuf.h"
+#include "quit.h"
+#include "sparse-util.h"
 
 // sparse matrix by scalar operations.
 
@@ -44,32 +54,34 @@
                                                                         \
     R r (nr, nc, (0.0 OP s));                                           \
                                                                         \
-    for (octave_idx_type j = 0; j < nc; j++)                            \
-      for (octave_idx_type i = m.cidx (j); i < m.cidx (j+1); i++)       \
-        r.xelem (m.ridx (i), j) = m.data (i) OP s;                      \
+    octave::sparse_columns (m, [&] (octave_idx_type jb,                 \
+                                    octave_idx_type je)                 \
+    {                                                                   \
+      for (octave_idx_type j = jb; j < je; j++)                         \
+        for (octave_idx_type i = m.cidx (j); i < m.cidx (j+1); i++)     \
+          r.xelem (m.ridx (i), j) = m.data (i) OP s;                    \
+    });                                                                 \
     return r;                                                           \
   }
 
-#define SPARSE_SMS_BIN_OP_2(R, F, OP, M, S)             \
-  R                                                     \
-  F (const M& m, const S& s)                            \
-  {                                                     \
-    octave_idx_type nr = m.rows ();                     \
-    octave_idx_type nc = m.cols ();                     \
-    octave_idx_type nz = m.nnz ();                      \
-                                                        \
-    R r (nr, nc, nz);                                   \
-                                                        \
-    for (octave_idx_type i = 0; i < nz; i++)            \
-      {                                                 \
-        r.xdata (i) = m.data (i) OP s;                  \
-        r.xridx (i) = m.ridx (i);                       \
-      }                                                 \
-    for (octave_idx_type i = 0; i < nc + 1; i++)        \
-      r.xcidx (i) = m.cidx (i);                         \
-                                                        \
-    r.maybe_compress (true);                            \
-    return r;                                           \
+#define SPARSE_SMS_BIN_OP_2(R, F, OP, M, S)                             \
+  R                                                                     \
+  F (const M& m, const S& s)                                            \
+  {                                                                     \
+    octave_idx_type nr = m.rows ();                                     \
+    octave_idx_type nc = m.cols ();                                     \
+    octave_idx_type nz = m.nnz ();                                      \
+                                                                        \
+    R r (nr, nc, nz);                                                   \
+                                                                        \
+    octave::sparse_map_values (nz, m.data (), r.xdata (),               \
+                               [s] (const M::element_type& x)           \
+                               { return x OP s; });                     \
+    std::copy_n (m.ridx (), nz, r.xridx ());                            \
+    std::copy_n (m.cidx (), nc + 1, r.xcidx ());                        \
+                                                                        \
+    r.maybe_compress (true);                                            \
+    return r;                                                           \
   }
 
 #define SPARSE_SMS_BIN_OPS(R1, R2, M, S)        \
@@ -216,33 +228,35 @@
                                                                         \
     R r (nr, nc, (s OP 0.0));                                           \
                                                                         \
-    for (octave_idx_type j = 0; j < nc; j++)                            \
-      for (octave_idx_type i = m.cidx (j); i < m.cidx (j+1); i++)       \
-        r.xelem (m.ridx (i), j) = s OP m.data (i);                      \
+    octave::sparse_columns (m, [&] (octave_idx_type jb,                 \
+                                    octave_idx_type je)                 \
+    {                                                                   \
+      for (octave_idx_type j = jb; j < je; j++)                         \
+        for (octave_idx_type i = m.cidx (j); i < m.cidx (j+1); i++)     \
+          r.xelem (m.ridx (i), j) = s OP m.data (i);                    \
+    });                                                                 \
                                                                         \
     return r;                                                           \
   }
 
-#define SPARSE_SSM_BIN_OP_2(R, F, OP, S, M)             \
-  R                                                     \
-  F (const S& s, const M& m)                            \
-  {                                                     \
-    octave_idx_type nr = m.rows ();                     \
-    octave_idx_type nc = m.cols ();                     \
-    octave_idx_type nz = m.nnz ();                      \
-                                                        \
-    R r (nr, nc, nz);                                   \
-                                                        \
-    for (octave_idx_type i = 0; i < nz; i++)            \
-      {                                                 \
-        r.xdata (i) = s OP m.data (i);                  \
-        r.xridx (i) = m.ridx (i);                       \
-      }                                                 \
-    for (octave_idx_type i = 0; i < nc + 1; i++)        \
-      r.xcidx (i) = m.cidx (i);                         \
-                                                        \
-    r.maybe_compress(true);                             \
-    return r;                                           \
+#define SPARSE_SSM_BIN_OP_2(R, F, OP, S, M)                             \
+  R                                                                     \
+  F (const S& s, const M& m)                                            \
+  {                                                                     \
+    octave_idx_type nr = m.rows ();                                     \
+    octave_idx_type nc = m.cols ();                                     \
+    octave_idx_type nz = m.nnz ();                                      \
+                                                                        \
+    R r (nr, nc, nz);                                                   \
+                                                                        \
+    octave::sparse_map_values (nz, m.data (), r.xdata (),               \
+                               [s] (const M::element_type& x)           \
+                               { return s OP x; });                     \
+    std::copy_n (m.ridx (), nz, r.xridx ());                            \
+    std::copy_n (m.cidx (), nc + 1, r.xcidx ());                        \
+                                                                        \
+    r.maybe_compress (true);                                            \
+    return r;                                                           \
   }
 
 #define SPARSE_SSM_BIN_OPS(R1, R2, S, M)        \
@@ -1608,13 +1622,44 @@
           octave_idx_type j = 0;                                        \
           OCTAVE_LOCAL_BUFFER (EL_TYPE, tmp, nr);                       \
                                                                         \
-          for (octave_idx_type i = 0; i < nr; i++)                      \
-            tmp[i] = INIT_VAL;                                          \
-          for (j = 0; j < nc; j++)                                      \
+          /* Each thread reduces a range of rows in the order of the */ \
+          /* serial loop.  Only use threads if the search for the    */ \
+          /* range in each column is cheap compared to the sum.      */ \
+          int nthreads = sparse_kernel_threads (nnz ());                \
+          if (nthreads > 1 && nnz () < 16.0 * nthreads * nc)            \
+            nthreads = 1;                                               \
+                                                                        \
+          if (nthreads > 1)                                             \
             {                                                           \
-              for (octave_idx_type i = cidx (j); i < cidx (j + 1); i++) \
+              const octave_idx_type *ri = ridx ();                      \
+              sparse_range_blocks (nr, nthreads,                        \
+                                   [&] (octave_idx_type rb,             \
+                                        octave_idx_type re)             \
+              {                                                         \
+                for (octave_idx_type i = rb; i < re; i++)               \
+                  tmp[i] = INIT_VAL;                                    \
+                for (octave_idx_type j = 0; j < nc; j++)                \
+                  {                                                     \
+                    octave_idx_type i                                   \
+                      = std::lower_bound (ri + cidx (j), ri + cidx (j+1), \
+                                          rb) - ri;                     \
+                    for (; i < cidx (j+1) && ri[i] < re; i++)           \
+                      {                                                 \
+                        ROW_EXPR;                                       \
+                      }                                                 \
+                  }                                                     \
+              });                                                       \
+            }                                                           \
+          else                                                          \
+            {                                                           \
+              for (octave_idx_type i = 0; i < nr; i++)                  \
+                tmp[i] = INIT_VAL;                                      \
+              for (j = 0; j < nc; j++)                                  \
                 {                                                       \
-                  ROW_EXPR;                                             \
+                  for (octave_idx_type i = cidx (j); i < cidx (j+1); i++) \
+                    {                                                   \
+                      ROW_EXPR;                                         \
+                    }                                                   \
                 }                                                       \
             }                                                           \
           octave_idx_type nel = 0;                                      \
@@ -1636,14 +1681,20 @@
         {                                                               \
           OCTAVE_LOCAL_BUFFER (EL_TYPE, tmp, nc);                       \
                                                                         \
-          for (octave_idx_type j = 0; j < nc; j++)                      \
-            {                                                           \
-              tmp[j] = INIT_VAL;                                        \
-              for (octave_idx_type i = cidx (j); i < cidx (j + 1); i++) \
-                {                                                       \
-                  COL_EXPR;                                             \
-                }                                                       \
-            }                                                           \
+          sparse_column_blocks (cidx (), nc,                            \
+                                sparse_kernel_threads (nnz ()),         \
+                                [&] (octave_idx_type jb,                \
+                                     octave_idx_type je)                \
+          {                                                             \
+            for (octave_idx_type j = jb; j < je; j++)                   \
+              {                                                         \
+                tmp[j] = INIT_VAL;                                      \
+                for (octave_idx_type i = cidx (j); i < cidx (j+1); i++) \
+                  {                                                     \
+                    COL_EXPR;                                           \
+                  }                                                     \
+              }                                                         \
+          });                                                           \
           octave_idx_type nel = 0;                                      \
           for (octave_idx_type i = 0; i < nc; i++)                      \
             if (tmp[i] != EL_TYPE ())                                   \
@@ -1760,6 +1811,368 @@
 
 #define SPARSE_ANY_OP(DIM) SPARSE_ANY_ALL_OP (DIM, false, false, !=, true)
 
+// Kernels for the elementwise operations and reductions above.  They
+// split the work between threads once the matrix is large enough for
+// sparse_kernel_threads to request more than one.
+
+OCTAVE_BEGIN_NAMESPACE(octave)
+
+// Call FCN (JB, JE) for ranges of columns of M with about the same
+// number of nonzero elements.
+
+template <typename MT, typename F>
+void
+sparse_columns (const MT& m, F fcn)
+{
+  sparse_column_blocks (m.cidx (), m.cols (),
+                        sparse_kernel_threads (m.nnz ()), fcn);
+}
+
+// Store FCN (SRC[i]) in DST[i] for i = 0, ..., N-1.  Each thread gets
+// a contiguous part of the plain arrays, which the compiler can
+// vectorize.
+
+template <typename T, typename R, typename F>
+void
+sparse_map_values (octave_idx_type n, const T *src, R *dst, F fcn)
+{
+  sparse_range_blocks (n, sparse_kernel_threads (n),
+                       [=] (octave_idx_type b, octave_idx_type e)
+  {
+    for (octave_idx_type i = b; i < e; i++)
+      dst[i] = fcn (src[i]);
+  });
+}
+
+OCTAVE_END_NAMESPACE(octave)
+
+// Kernels for the threaded versions of the sparse matrix products
+// below.  They are used by the product macros once the amount of work
+// is large enough for sparse_kernel_threads to request more than one
+// thread.
+
+OCTAVE_BEGIN_NAMESPACE(octave)
+
+// Call FCN (i, t) for i = 0, ..., N-1 using NTHREADS threads, where T
+// is the number of the thread doing the work.  The loop is split in
+// batches so that interrupts are still checked between them.
+
+template <typename F>
+void
+sparse_parallel_loop (octave_idx_type n, int nthreads, F fcn)
+{
+  octave_idx_type batch = 256 * static_cast<octave_idx_type> (nthreads);
+
+  for (octave_idx_type i0 = 0; i0 < n; i0 += batch)
+    {
+      octave_quit ();
+
+      octave_idx_type i1 = std::min (i0 + batch, n);
+
+#if defined (HAVE_OPENMP)
+#  pragma omp parallel for num_threads (nthreads) schedule (dynamic, 4)
+      for (octave_idx_type i = i0; i < i1; i++)
+        fcn (i, omp_get_thread_num ());
+#else
+      for (octave_idx_type i = i0; i < i1; i++)
+        fcn (i, 0);
+#endif
+    }
+}
+
+// Sparse by sparse product, computed column by column as in the
+// serial code of SPARSE_SPARSE_MUL.  A symbolic pass first counts the
+// nonzero elements of every column of the result so that the numeric
+// pass can fill the columns independently.  Each thread has its own
+// marker and dense accumulator of length NR.
+
+template <typename RET_TYPE, typename RET_EL_TYPE, typename MT, typename AT>
+RET_TYPE
+sparse_sparse_mul (const MT& m, const AT& a, double flops, int nthreads)
+{
+  octave_idx_type nr = m.rows ();
+  octave_idx_type a_nc = a.cols ();
+
+  // Clearing the accumulators costs O(NR) per thread, which should
+  // stay small compared to the product itself.
+  if (nthreads > 1 && nthreads * static_cast<double> (nr) > flops)
+    nthreads = std::max (1, static_cast<int> (flops / nr));
+
+  const octave_idx_type *mc = m.cidx ();
+  const octave_idx_type *mr = m.ridx ();
+  const auto *md = m.data ();
+  const octave_idx_type *ac = a.cidx ();
+  const octave_idx_type *ar = a.ridx ();
+  const auto *ad = a.data ();
+
+  std::size_t acc_len = static_cast<std::size_t> (nthreads) * nr;
+  std::vector<octave_idx_type> mark (acc_len, 0);
+
+  RET_TYPE retval (nr, a_nc, static_cast<octave_idx_type> (0));
+  octave_idx_type *rc = retval.xcidx ();
+
+  rc[0] = 0;
+
+  sparse_parallel_loop (a_nc, nthreads,
+                        [=, &mark] (octave_idx_type i, int t)
+  {
+    octave_idx_type *w = mark.data () + static_cast<std::size_t> (t) * nr;
+    octave_idx_type n = 0;
+
+    for (octave_idx_type j = ac[i]; j < ac[i+1]; j++)
+      {
+        octave_idx_type col = ar[j];
+        for (octave_idx_type k = mc[col]; k < mc[col+1]; k++)
+          if (w[mr[k]] != i + 1)
+            {
+              w[mr[k]] = i + 1;
+              n++;
+            }
+      }
+
+    rc[i+1] = n;
+  });
+
+  for (octave_idx_type i = 0; i < a_nc; i++)
+    rc[i+1] += rc[i];
+
+  octave_idx_type nel = rc[a_nc];
+
+  if (nel == 0)
+    return RET_TYPE (nr, a_nc);
+
+  retval.change_capacity (nel);
+
+  octave_idx_type *ri = retval.xridx ();
+  RET_EL_TYPE *rd = retval.xdata ();
+
+  std::fill (mark.begin (), mark.end (), 0);
+  std::vector<RET_EL_TYPE> acc (acc_len);
+
+  // Same break-point between scanning the accumulator and sorting the
+  // row indices as in SPARSE_SPARSE_MUL.
+  octave_idx_type n_per_col = (a_nc > 43000 ? 43000
+                               : (a_nc * a_nc) / 43000);
+
+  sparse_parallel_loop (a_nc, nthreads,
+                        [=, &mark, &acc] (octave_idx_type i, int t)
+  {
+    std::size_t off = static_cast<std::size_t> (t) * nr;
+    octave_idx_type *w = mark.data () + off;
+    RET_EL_TYPE *Xcol = acc.data () + off;
+    octave_idx_type ii = rc[i];
+    bool scan = rc[i+1] - rc[i] > n_per_col;
+
+    for (octave_idx_type j = ac[i]; j < ac[i+1]; j++)
+      {
+        octave_idx_type col = ar[j];
+        auto tmpval = ad[j];
+        for (octave_idx_type k = mc[col]; k < mc[col+1]; k++)
+          {
+            octave_idx_type row = mr[k];
+            if (w[row] != i + 1)
+              {
+                w[row] = i + 1;
+                if (! scan)
+                  ri[ii++] = row;
+                Xcol[row] = tmpval * md[k];
+              }
+            else
+              Xcol[row] += tmpval * md[k];
+          }
+      }
+
+    if (scan)
+      {
+        for (octave_idx_type k = 0; k < nr; k++)
+          if (w[k] == i + 1)
+            {
+              rd[ii] = Xcol[k];
+              ri[ii++] = k;
+            }
+      }
+    else
+      {
+        std::sort (ri + rc[i], ri + rc[i+1]);
+        for (octave_idx_type k = rc[i]; k < rc[i+1]; k++)
+          rd[k] = Xcol[ri[k]];
+      }
+  });
+
+  retval.maybe_compress (true);
+  return retval;
+}
+
+// Sparse by full product.  Every thread computes whole columns of the
+// result.
+
+template <typename RET_TYPE, typename MT, typename AT>
+RET_TYPE
+sparse_full_mul (const MT& m, const AT& a, int nthreads)
+{
+  octave_idx_type nr = m.rows ();
+  octave_idx_type a_nr = a.rows ();
+  octave_idx_type a_nc = a.cols ();
+
+  RET_TYPE retval (nr, a_nc, typename RET_TYPE::element_type ());
+
+  const octave_idx_type *mc = m.cidx ();
+  const octave_idx_type *mr = m.ridx ();
+  const auto *md = m.data ();
+  const auto *ad = a.data ();
+  auto *rd = retval.rwdata ();
+
+  sparse_parallel_loop (a_nc, nthreads, [=] (octave_idx_type i, int)
+  {
+    const auto *acol = ad + static_cast<std::size_t> (i) * a_nr;
+    auto *rcol = rd + static_cast<std::size_t> (i) * nr;
+
+    for (octave_idx_type j = 0; j < a_nr; j++)
+      {
+        auto tmpval = acol[j];
+        for (octave_idx_type k = mc[j]; k < mc[j+1]; k++)
+          rcol[mr[k]] += tmpval * md[k];
+      }
+  });
+
+  return retval;
+}
+
+// Transposed sparse by full product.  Every element of the result is
+// an independent dot product, so the elements are distributed over
+// the threads in column-major order.
+
+template <typename RET_TYPE, typename EL_TYPE, typename MT, typename AT,
+          typename F>
+RET_TYPE
+sparse_full_trans_mul (const MT& m, const AT& a, int nthreads, F conj_op)
+{
+  octave_idx_type nc = m.cols ();
+  octave_idx_type a_nr = a.rows ();
+  octave_idx_type a_nc = a.cols ();
+
+  RET_TYPE retval (nc, a_nc);
+
+  const octave_idx_type *mc = m.cidx ();
+  const octave_idx_type *mr = m.ridx ();
+  const auto *md = m.data ();
+  const auto *ad = a.data ();
+  auto *rd = retval.rwdata ();
+
+  // Work on blocks of rows of the result so that each task is large
+  // enough to amortize the scheduling overhead.
+  octave_idx_type bs = std::min (nc, static_cast<octave_idx_type> (64));
+  octave_idx_type nb = (nc + bs - 1) / bs;
+
+  sparse_parallel_loop (nb * a_nc, nthreads,
+                        [=] (octave_idx_type p, int)
+  {
+    octave_idx_type i = p / nb;
+    octave_idx_type j0 = (p % nb) * bs;
+    octave_idx_type j1 = std::min (j0 + bs, nc);
+    const auto *acol = ad + static_cast<std::size_t> (i) * a_nr;
+    auto *rcol = rd + static_cast<std::size_t> (i) * nc;
+
+    for (octave_idx_type j = j0; j < j1; j++)
+      {
+        EL_TYPE acc = EL_TYPE ();
+        for (octave_idx_type k = mc[j]; k < mc[j+1]; k++)
+          acc += acol[mr[k]] * conj_op (md[k]);
+        rcol[j] = acc;
+      }
+  });
+
+  return retval;
+}
+
+// Full by sparse product.  Every thread computes whole columns of the
+// result.
+
+template <typename RET_TYPE, typename MT, typename AT>
+RET_TYPE
+full_sparse_mul (const MT& m, const AT& a, int nthreads)
+{
+  octave_idx_type nr = m.rows ();
+  octave_idx_type a_nc = a.cols ();
+
+  RET_TYPE retval (nr, a_nc, typename RET_TYPE::element_type ());
+
+  const auto *mdat = m.data ();
+  const octave_idx_type *ac = a.cidx ();
+  const octave_idx_type *ar = a.ridx ();
+  const auto *ad = a.data ();
+  auto *rd = retval.rwdata ();
+
+  sparse_parallel_loop (a_nc, nthreads, [=] (octave_idx_type i, int)
+  {
+    auto *rcol = rd + static_cast<std::size_t> (i) * nr;
+
+    for (octave_idx_type j = ac[i]; j < ac[i+1]; j++)
+      {
+        const auto *mcol = mdat + static_cast<std::size_t> (ar[j]) * nr;
+        auto tmpval = ad[j];
+
+#if defined (HAVE_OPENMP)
+#  pragma omp simd
+#endif
+        for (octave_idx_type k = 0; k < nr; k++)
+          rcol[k] += tmpval * mcol[k];
+      }
+  });
+
+  return retval;
+}
+
+// Full by transposed sparse product.  The columns of the result are
+// scattered, so the threads work on separate blocks of rows instead.
+
+template <typename RET_TYPE, typename MT, typename AT, typename F>
+RET_TYPE
+full_sparse_mul_trans (const MT& m, const AT& a, int nthreads, F conj_op)
+{
+  octave_idx_type nr = m.rows ();
+  octave_idx_type a_nr = a.rows ();
+  octave_idx_type a_nc = a.cols ();
+
+  RET_TYPE retval (nr, a_nr, typename RET_TYPE::element_type ());
+
+  const auto *mdat = m.data ();
+  const octave_idx_type *ac = a.cidx ();
+  const octave_idx_type *ar = a.ridx ();
+  const auto *ad = a.data ();
+  auto *rd = retval.rwdata ();
+
+  octave_idx_type nb = std::min (nr, static_cast<octave_idx_type> (4) * nthreads);
+  octave_idx_type bs = (nr + nb - 1) / nb;
+
+  sparse_parallel_loop (nb, nthreads, [=] (octave_idx_type b, int)
+  {
+    octave_idx_type k0 = b * bs;
+    octave_idx_type k1 = std::min (k0 + bs, nr);
+
+    for (octave_idx_type i = 0; i < a_nc; i++)
+      {
+        const auto *mcol = mdat + static_cast<std::size_t> (i) * nr;
+
+        for (octave_idx_type j = ac[i]; j < ac[i+1]; j++)
+          {
+            auto *rcol = rd + static_cast<std::size_t> (ar[j]) * nr;
+            auto tmpval = conj_op (ad[j]);
+
+#if defined (HAVE_OPENMP)
+#  pragma omp simd
+#endif
+            for (octave_idx_type k = k0; k < k1; k++)
+              rcol[k] += tmpval * mcol[k];
+          }
+      }
+  });
+
+  return retval;
+}
+
+OCTAVE_END_NAMESPACE(octave)
+
 #define SPARSE_SPARSE_MUL(RET_TYPE, RET_EL_TYPE, EL_TYPE)               \
   octave_idx_type nr = m.rows ();                                       \
   octave_idx_type nc = m.cols ();                                       \
@@ -1813,6 +2226,15 @@
     octave::err_nonconformant ("operator *", nr, nc, a_nr, a_nc);               \
   else                                                                  \
     {                                                                   \
+      double flops = 0;                                                 \
+      for (octave_idx_type j = 0; j < a.nnz (); j++)                    \
+        flops += m.cidx (a.ridx (j) + 1) - m.cidx (a.ridx (j));         \
+                                                                        \
+      int nthreads = sparse_kernel_threads (flops);                     \
+      if (nthreads > 1)                                                 \
+        return octave::sparse_sparse_mul<RET_TYPE, RET_EL_TYPE>         \
+               (m, a, flops, nthreads);                                 \
+                                                                        \
       OCTAVE_LOCAL_BUFFER (octave_idx_type, w, nr);                     \
       RET_TYPE retval (nr, a_nc, static_cast<octave_idx_type> (0));     \
       for (octave_idx_type i = 0; i < nr; i++)                          \
@@ -1942,6 +2364,11 @@
     octave::err_nonconformant ("operator *", nr, nc, a_nr, a_nc);               \
   else                                                                  \
     {                                                                   \
+      int nthreads                                                      \
+        = sparse_kernel_threads (static_cast<double> (m.nnz ()) * a_nc); \
+      if (nthreads > 1 && a_nc > 1)                                     \
+        return octave::sparse_full_mul<RET_TYPE> (m, a, nthreads);      \
+                                                                        \
       RET_TYPE::element_type zero = RET_TYPE::element_type ();          \
                                                                         \
       RET_TYPE retval (nr, a_nc, zero);                                 \
@@ -1976,6 +2403,13 @@
     octave::err_nonconformant ("operator *", nc, nr, a_nr, a_nc);               \
   else                                                                  \
     {                                                                   \
+      int nthreads                                                      \
+        = sparse_kernel_threads (static_cast<double> (m.nnz ()) * a_nc); \
+      if (nthreads > 1)                                                 \
+        return octave::sparse_full_trans_mul<RET_TYPE, EL_TYPE>         \
+               (m, a, nthreads,                                         \
+                [] (const auto& x) { return CONJ_OP (x); });            \
+                                                                        \
       RET_TYPE retval (nc, a_nc);                                       \
                                                                         \
       for (octave_idx_type i = 0; i < a_nc ; i++)                       \
@@ -2009,6 +2443,11 @@
     octave::err_nonconformant ("operator *", nr, nc, a_nr, a_nc);               \
   else                                                                  \
     {                                                                   \
+      int nthreads                                                      \
+        = sparse_kernel_threads (static_cast<double> (a.nnz ()) * nr);  \
+      if (nthreads > 1 && a_nc > 1)                                     \
+        return octave::full_sparse_mul<RET_TYPE> (m, a, nthreads);      \
+                                                                        \
       RET_TYPE::element_type zero = RET_TYPE::element_type ();          \
                                                                         \
       RET_TYPE retval (nr, a_nc, zero);                                 \
@@ -2044,6 +2483,13 @@
     octave::err_nonconformant ("operator *", nr, nc, a_nc, a_nr);               \
   else                                                                  \
     {                                                                   \
+      int nthreads                                                      \
+        = sparse_kernel_threads (static_cast<double> (a.nnz ()) * nr);  \
+      if (nthreads > 1 && nr > 1)                                       \
+        return octave::full_sparse_mul_trans<RET_TYPE>                  \
+               (m, a, nthreads,                                         \
+                [] (const auto& x) { return CONJ_OP (x); });            \
+                                                                        \
       RET_TYPE::element_type zero = RET_TYPE::element_type ();          \
                                                                         \
       RET_TYPE retval (nr, a_nr, zero);                                 \
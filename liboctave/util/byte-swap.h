@@ -28,6 +28,9 @@
 
 #include "octave-config.h"
 
+#include <cstdint>
+#include <cstring>
+
 static inline void
 swap_bytes (void *ptr, unsigned int i, unsigned int j)
 {
@@ -51,47 +54,98 @@ inline void
 swap_bytes<1> (void *)
 { }
 
+// The fixed-size specializations load the element into an unsigned
+// integer and reverse it with a single bswap instruction.  Going through
+// memcpy keeps the accesses well-defined for unaligned data and lets the
+// compiler turn the loops below into vector byte shuffles.
+
+static inline uint16_t
+octave_bswap16 (uint16_t x)
+{
+#if defined (__GNUC__)
+  return __builtin_bswap16 (x);
+#else
+  return static_cast<uint16_t> ((x >> 8) | (x << 8));
+#endif
+}
+
+static inline uint32_t
+octave_bswap32 (uint32_t x)
+{
+#if defined (__GNUC__)
+  return __builtin_bswap32 (x);
+#else
+  x = ((x & 0xFF00FF00u) >> 8) | ((x & 0x00FF00FFu) << 8);
+  return (x >> 16) | (x << 16);
+#endif
+}
+
+static inline uint64_t
+octave_bswap64 (uint64_t x)
+{
+#if defined (__GNUC__)
+  return __builtin_bswap64 (x);
+#else
+  uint64_t lo = octave_bswap32 (static_cast<uint32_t> (x));
+  uint64_t hi = octave_bswap32 (static_cast<uint32_t> (x >> 32));
+  return (lo << 32) | hi;
+#endif
+}
+
 template <>
 inline void
 swap_bytes<2> (void *ptr)
 {
-  swap_bytes (ptr, 0, 1);
+  uint16_t x;
+  std::memcpy (&x, ptr, 2);
+  x = octave_bswap16 (x);
+  std::memcpy (ptr, &x, 2);
 }
 
 template <>
 inline void
 swap_bytes<4> (void *ptr)
 {
-  swap_bytes (ptr, 0, 3);
-  swap_bytes (ptr, 1, 2);
+  uint32_t x;
+  std::memcpy (&x, ptr, 4);
+  x = octave_bswap32 (x);
+  std::memcpy (ptr, &x, 4);
 }
 
 template <>
 inline void
 swap_bytes<8> (void *ptr)
 {
-  swap_bytes (ptr, 0, 7);
-  swap_bytes (ptr, 1, 6);
-  swap_bytes (ptr, 2, 5);
-  swap_bytes (ptr, 3, 4);
+  uint64_t x;
+  std::memcpy (&x, ptr, 8);
+  x = octave_bswap64 (x);
+  std::memcpy (ptr, &x, 8);
 }
 
 template <int n>
 void
-swap_bytes (void *ptr, int len)
+swap_bytes (void *ptr, octave_idx_type len)
 {
   char *t = static_cast<char *> (ptr);
 
-  for (int i = 0; i < len; i++)
-    {
-      swap_bytes<n> (t);
-      t += n;
-    }
+  for (octave_idx_type i = 0; i < len; i++)
+    swap_bytes<n> (t + i * n);
 }
 
 template <>
 inline void
-swap_bytes<1> (void *, int)
+swap_bytes<1> (void *, octave_idx_type)
 { }
 
+// Return X with its bytes reversed.  Useful in conversion loops so that
+// swapping happens in the same pass as the type conversion.
+
+template <typename T>
+inline T
+byte_swapped (T x)
+{
+  swap_bytes<sizeof (T)> (&x);
+  return x;
+}
+
 #endif
@@ -612,9 +612,15 @@ oct_data_conv::data_type_as_string (oct_data_conv::data_type dt)
           std::streamsize n_bytes = size * static_cast<std::streamsize> (len); \
           stream.read (reinterpret_cast<char *> (ptr), n_bytes);        \
           if (swap)                                                     \
-            swap_bytes< size > (ptr, len);                              \
-          for (octave_idx_type i = 0; i < len; i++)                     \
-            data[i] = ptr[i];                                           \
+            {                                                           \
+              for (octave_idx_type i = 0; i < len; i++)                 \
+                data[i] = byte_swapped (ptr[i]);                        \
+            }                                                           \
+          else                                                          \
+            {                                                           \
+              for (octave_idx_type i = 0; i < len; i++)                 \
+                data[i] = ptr[i];                                       \
+            }                                                           \
         }                                                               \
     }                                                                   \
   while (0)
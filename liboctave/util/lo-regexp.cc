@@ -28,8 +28,12 @@
 #endif
 
 #include <list>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #if defined (HAVE_PCRE2)
@@ -54,7 +58,6 @@
 #include "lo-regexp.h"
 #include "str-vec.h"
 #include "unistr-wrappers.h"
-#include "unwind-prot.h"
 
 #if defined (HAVE_PCRE2)
 typedef pcre2_code octave_pcre_code;
@@ -105,22 +108,203 @@ OCTAVE_BEGIN_NAMESPACE(octave)
 // FIXME: should this be configurable?
 #define MAXLOOKBEHIND 10
 
+// Number of compiled patterns kept in the pattern cache.
+#define PATTERN_CACHE_SIZE 128
+
 static bool lookbehind_warned = false;
 
-// FIXME: don't bother collecting and composing return values
-//        the user doesn't want.
+// A compiled pattern with the names of its named tokens.
 
-void
-regexp::free ()
+class regexp::compiled_pattern
 {
-  octave_pcre_code_free (static_cast<octave_pcre_code *> (m_code));
-}
+public:
+
+  compiled_pattern (octave_pcre_code *code, const string_vector& named_pats,
+                    int names, const Array<int>& named_idx)
+    : m_code (code), m_named_pats (named_pats), m_names (names),
+      m_named_idx (named_idx)
+  { }
+
+  OCTAVE_DISABLE_COPY_MOVE (compiled_pattern)
+
+  ~compiled_pattern () { octave_pcre_code_free (m_code); }
+
+  octave_pcre_code * code () const { return m_code; }
+
+  string_vector named_patterns () const { return m_named_pats; }
+
+  int names () const { return m_names; }
+
+  Array<int> named_index () const { return m_named_idx; }
+
+private:
+
+  octave_pcre_code *m_code;
+
+  string_vector m_named_pats;
+
+  int m_names;
+
+  Array<int> m_named_idx;
+};
+
+// The most recently used values for a set of keys.  The cache may be
+// used by several threads.
+
+template <typename T>
+class lru_cache
+{
+public:
+
+  typedef std::shared_ptr<const T> value_type;
+
+  lru_cache (std::size_t capacity)
+    : m_capacity (capacity), m_mutex (), m_list (), m_index ()
+  { }
+
+  OCTAVE_DISABLE_COPY_MOVE (lru_cache)
+
+  ~lru_cache () = default;
+
+  value_type find (const std::string& key)
+  {
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    auto p = m_index.find (key);
+
+    if (p == m_index.end ())
+      return value_type ();
+
+    m_list.splice (m_list.begin (), m_list, p->second);
+
+    return p->second->second;
+  }
+
+  void insert (const std::string& key, const value_type& val)
+  {
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    auto p = m_index.find (key);
+
+    if (p != m_index.end ())
+      {
+        p->second->second = val;
+        m_list.splice (m_list.begin (), m_list, p->second);
+        return;
+      }
+
+    m_list.emplace_front (key, val);
+    m_index[key] = m_list.begin ();
+
+    if (m_list.size () > m_capacity)
+      {
+        m_index.erase (m_list.back ().first);
+        m_list.pop_back ();
+      }
+  }
+
+private:
+
+  typedef std::list<std::pair<std::string, value_type>> list_type;
+
+  std::size_t m_capacity;
+
+  std::mutex m_mutex;
+
+  // Most recently used first.
+  list_type m_list;
+
+  std::unordered_map<std::string, typename list_type::iterator> m_index;
+};
+
+#if defined (HAVE_PCRE2)
+
+// The match data and the stack for JIT compiled patterns are reused by
+// all matches in a thread.  The match data grows with the number of
+// subpatterns.
+
+class match_resources
+{
+public:
+
+  match_resources ()
+    : m_match_data (nullptr), m_size (0),
+      m_jit_stack (pcre2_jit_stack_create (32 * 1024, 1024 * 1024, nullptr)),
+      m_context (pcre2_match_context_create (nullptr))
+  {
+    if (m_jit_stack && m_context)
+      pcre2_jit_stack_assign (m_context, nullptr, m_jit_stack);
+  }
+
+  OCTAVE_DISABLE_COPY_MOVE (match_resources)
+
+  ~match_resources ()
+  {
+    pcre2_match_data_free (m_match_data);
+    pcre2_match_context_free (m_context);
+    pcre2_jit_stack_free (m_jit_stack);
+  }
+
+  pcre2_match_data * match_data (uint32_t n)
+  {
+    if (n > m_size)
+      {
+        pcre2_match_data_free (m_match_data);
+        m_match_data = pcre2_match_data_create (n, nullptr);
+        m_size = (m_match_data ? n : 0);
+      }
+
+    return m_match_data;
+  }
+
+  pcre2_match_context * context () const { return m_context; }
+
+private:
+
+  pcre2_match_data *m_match_data;
+
+  uint32_t m_size;
+
+  pcre2_jit_stack *m_jit_stack;
+
+  pcre2_match_context *m_context;
+};
+
+static thread_local match_resources pcre_match_resources;
+
+#endif
+
+// FIXME: don't bother collecting and composing return values
+//        the user doesn't want.
 
 void
 regexp::compile_internal ()
 {
-  // If we had a previously compiled pattern, release it.
-  free ();
+  // Patterns are compiled once and shared through a cache, keyed by
+  // the options that change the compiled pattern and the pattern.
+
+  static lru_cache<compiled_pattern> pattern_cache (PATTERN_CACHE_SIZE);
+
+  std::string key (1, static_cast<char> ((m_options.case_insensitive () ? 1 : 0)
+                                         | (m_options.dotexceptnewline () ? 2 : 0)
+                                         | (m_options.lineanchors () ? 4 : 0)
+                                         | (m_options.freespacing () ? 8 : 0)));
+  key += m_pattern;
+
+  std::shared_ptr<const compiled_pattern> cached = pattern_cache.find (key);
+
+  if (cached)
+    {
+      m_code = cached;
+      m_named_pats = cached->named_patterns ();
+      m_names = cached->names ();
+      m_named_idx = cached->named_index ();
+      return;
+    }
+
+  m_named_pats = string_vector ();
+  m_names = 0;
+  m_named_idx = Array<int> ();
 
   std::size_t max_length = MAXLOOKBEHIND;
 
@@ -284,15 +468,17 @@ regexp::compile_internal ()
          | (m_options.freespacing () ? OCTAVE_PCRE_EXTENDED : 0)
          | OCTAVE_PCRE_UTF);
 
+  octave_pcre_code *code;
+
 #if defined (HAVE_PCRE2)
   PCRE2_SIZE erroffset;
   int errnumber;
 
-  m_code = pcre2_compile (reinterpret_cast<PCRE2_SPTR> (buf_str.c_str ()),
-                          PCRE2_ZERO_TERMINATED, pcre_options,
-                          &errnumber, &erroffset, nullptr);
+  code = pcre2_compile (reinterpret_cast<PCRE2_SPTR> (buf_str.c_str ()),
+                        PCRE2_ZERO_TERMINATED, pcre_options,
+                        &errnumber, &erroffset, nullptr);
 
-  if (! m_code)
+  if (! code)
     {
       // PCRE docs say:
       //
@@ -310,17 +496,26 @@ regexp::compile_internal ()
         ("%s: %s at position %zu of expression", m_who.c_str (), err,
          erroffset);
     }
+
+  // Compile the pattern to machine code if PCRE2 supports it on this
+  // platform.  Otherwise the pattern is interpreted as before.
+  pcre2_jit_compile (code, PCRE2_JIT_COMPLETE);
 #else
   const char *err;
   int erroffset;
 
-  m_code = pcre_compile (buf_str.c_str (), pcre_options,
-                         &err, &erroffset, nullptr);
+  code = pcre_compile (buf_str.c_str (), pcre_options,
+                       &err, &erroffset, nullptr);
 
-  if (! m_code)
+  if (! code)
     (*current_liboctave_error_handler)
       ("%s: %s at position %d of expression", m_who.c_str (), err, erroffset);
 #endif
+
+  m_code = std::make_shared<const compiled_pattern> (code, m_named_pats,
+                                                     m_names, m_named_idx);
+
+  pattern_cache.insert (key, m_code);
 }
 
 regexp::match_data
@@ -342,14 +537,23 @@ regexp::match (const std::string& buffer) const
   char *nametable;
   std::size_t idx = 0;
 
-  octave_pcre_code *re = static_cast<octave_pcre_code *> (m_code);
+  octave_pcre_code *re = m_code->code ();
 
   octave_pcre_pattern_info (re, OCTAVE_PCRE_INFO_CAPTURECOUNT, &subpatterns);
   octave_pcre_pattern_info (re, OCTAVE_PCRE_INFO_NAMECOUNT, &namecount);
   octave_pcre_pattern_info (re, OCTAVE_PCRE_INFO_NAMEENTRYSIZE, &nameentrysize);
   octave_pcre_pattern_info (re, OCTAVE_PCRE_INFO_NAMETABLE, &nametable);
 
-#if defined (HAVE_PCRE)
+#if defined (HAVE_PCRE2)
+  pcre2_match_data *tmp_match_data
+    = pcre_match_resources.match_data (subpatterns+1);
+
+  if (! tmp_match_data)
+    (*current_liboctave_error_handler)
+      ("%s: cannot allocate memory for match data", m_who.c_str ());
+
+  pcre2_match_context *match_context = pcre_match_resources.context ();
+#else
   OCTAVE_LOCAL_BUFFER (OCTAVE_PCRE_SIZE, ovector, (subpatterns+1)*3);
 #endif
 
@@ -368,15 +572,19 @@ regexp::match (const std::string& buffer) const
       octave_quit ();
 
 #if defined (HAVE_PCRE2)
-      pcre2_match_data *tmp_match_data
-        = pcre2_match_data_create_from_pattern (re, nullptr);
-
-      unwind_action cleanup_match_data ([tmp_match_data] () { pcre2_match_data_free (tmp_match_data); });
+      uint32_t match_options = PCRE2_NO_UTF_CHECK | (idx ? PCRE2_NOTBOL : 0);
 
       int matches = pcre2_match (re, reinterpret_cast<PCRE2_SPTR> (buffer.c_str ()),
-                                 buffer.length (), idx,
-                                 PCRE2_NO_UTF_CHECK | (idx ? PCRE2_NOTBOL : 0),
-                                 tmp_match_data, nullptr);
+                                 buffer.length (), idx, match_options,
+                                 tmp_match_data, match_context);
+
+      // Patterns that need more than the largest JIT stack are matched
+      // by the interpreter.
+      if (matches == PCRE2_ERROR_JIT_STACKLIMIT)
+        matches = pcre2_match (re, reinterpret_cast<PCRE2_SPTR> (buffer.c_str ()),
+                               buffer.length (), idx,
+                               match_options | PCRE2_NO_JIT,
+                               tmp_match_data, match_context);
 
       if (matches < 0 && matches != PCRE2_ERROR_NOMATCH)
         (*current_liboctave_error_handler)
@@ -29,6 +29,7 @@
 #include "octave-config.h"
 
 #include <list>
+#include <memory>
 #include <sstream>
 #include <string>
 
@@ -58,7 +59,7 @@ public:
 
   regexp& operator = (const regexp& rx) = default;
 
-  ~regexp () { free (); }
+  ~regexp () = default;
 
   void compile (const std::string& pat,
                 const regexp::opts& opt = regexp::opts ())
@@ -216,21 +217,22 @@ public:
 
 private:
 
+  class compiled_pattern;
+
   // The pattern we've been asked to match.
   std::string m_pattern;
 
   opts m_options;
 
-  // Internal data describing the regular expression.
-  void *m_code;
+  // Internal data describing the regular expression.  Objects with the
+  // same pattern and options share it.
+  std::shared_ptr<const compiled_pattern> m_code;
 
   string_vector m_named_pats;
   int m_names;
   Array<int> m_named_idx;
   std::string m_who;
 
-  void free ();
-
   void compile_internal ();
 };
 
@@ -0,0 +1,138 @@
+////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2024 The Octave Project Developers
+//
+// See the file COPYRIGHT.md in the top-level directory of this
+// distribution or <https://octave.org/copyright/>.
+//
+// This file is part of Octave.
+//
+// Octave is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Octave is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Octave; see the file COPYING.  If not, see
+// <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////
+
+#if defined (HAVE_CONFIG_H)
+#  include "config.h"
+#endif
+
+#include <vector>
+
+#include "mask-util.h"
+#include "sparse-util.h"
+
+// Number of true elements of MASK[B], ..., MASK[E-1].  The sum of the
+// bytes of a word, each 0 or 1, ends up in its top byte when it is
+// multiplied by mask_word_all.
+
+static octave_idx_type
+mask_count (const bool *mask, octave_idx_type b, octave_idx_type e)
+{
+  octave_idx_type cnt = 0;
+  octave_idx_type i = b;
+
+  for (; i + 8 <= e; i += 8)
+    cnt += (mask_word (mask + i) * mask_word_all) >> 56;
+
+  for (; i < e; i++)
+    cnt += mask[i];
+
+  return cnt;
+}
+
+// Store the indices of the true elements of MASK[B], ..., MASK[E-1] in
+// DEST, which has room for exactly DEST_END - DEST of them.  Words with
+// both true and false elements are stored without branches, always
+// writing the index and advancing by the element, as long as the spare
+// writes stay inside DEST.
+
+static void
+mask_store (const bool *mask, octave_idx_type b, octave_idx_type e,
+            octave_idx_type *dest, octave_idx_type *dest_end)
+{
+  octave_idx_type i = b;
+
+  for (; i + 8 <= e; i += 8)
+    {
+      uint64_t w = mask_word (mask + i);
+
+      if (w == 0)
+        continue;
+      else if (w == mask_word_all)
+        {
+          for (int k = 0; k < 8; k++)
+            dest[k] = i + k;
+          dest += 8;
+        }
+      else if (dest_end - dest > 8)
+        {
+          for (int k = 0; k < 8; k++)
+            {
+              *dest = i + k;
+              dest += mask[i+k];
+            }
+        }
+      else
+        {
+          for (int k = 0; k < 8; k++)
+            if (mask[i+k])
+              *dest++ = i + k;
+        }
+    }
+
+  for (; i < e; i++)
+    if (mask[i])
+      *dest++ = i;
+}
+
+// Counting and storing read about one byte per element.
+
+static int
+mask_threads (octave_idx_type n)
+{
+  return sparse_kernel_threads (n / 4.0);
+}
+
+octave_idx_type
+mask_nnz (const bool *mask, octave_idx_type n)
+{
+  int nt = mask_threads (n);
+
+  std::vector<octave_idx_type> part (nt, 0);
+
+  sparse_thread_blocks (n, nt, [=, &part] (int t, octave_idx_type b,
+                                           octave_idx_type e)
+  { part[t] += mask_count (mask, b, e); });
+
+  octave_idx_type nnz = 0;
+  for (octave_idx_type cnt : part)
+    nnz += cnt;
+
+  return nnz;
+}
+
+void
+mask_find (const bool *mask, octave_idx_type n, octave_idx_type nnz,
+           octave_idx_type *dest)
+{
+  mask_compact (n, mask_threads (n),
+                [=] (octave_idx_type b, octave_idx_type e)
+                {
+                  return (b == 0 && e == n ? nnz : mask_count (mask, b, e));
+                },
+                [=] (octave_idx_type) { return dest; },
+                [=] (octave_idx_type b, octave_idx_type e,
+                     octave_idx_type *d, octave_idx_type *d_end)
+                { mask_store (mask, b, e, d, d_end); });
+}
@@ -0,0 +1,159 @@
+////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2024 The Octave Project Developers
+//
+// See the file COPYRIGHT.md in the top-level directory of this
+// distribution or <https://octave.org/copyright/>.
+//
+// This file is part of Octave.
+//
+// Octave is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Octave is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Octave; see the file COPYING.  If not, see
+// <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////
+
+#if ! defined (octave_mask_util_h)
+#define octave_mask_util_h 1
+
+#include "octave-config.h"
+
+#include <cstdint>
+#include <cstring>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "sparse-util.h"
+
+// Kernels for arrays of bool used as masks.  The mask is read eight
+// elements at a time, so that runs of false or of true elements cost a
+// single test per word.
+
+static_assert (sizeof (bool) == 1, "mask-util.h: bool must be one byte");
+
+// The word of eight mask elements that are all true.
+
+const uint64_t mask_word_all = 0x0101010101010101ULL;
+
+// The eight mask elements starting at P as one word.
+
+inline uint64_t
+mask_word (const bool *p)
+{
+  uint64_t w;
+  std::memcpy (&w, p, sizeof (w));
+  return w;
+}
+
+// Call FCN (I) for the true elements MASK[I], 0 <= I < N, in order.
+
+template <typename F>
+inline void
+mask_for_each (const bool *mask, octave_idx_type n, F&& fcn)
+{
+  octave_idx_type i = 0;
+
+  for (; i + 8 <= n; i += 8)
+    {
+      uint64_t w = mask_word (mask + i);
+
+      if (w == 0)
+        continue;
+      else if (w == mask_word_all)
+        {
+          for (int k = 0; k < 8; k++)
+            fcn (i + k);
+        }
+      else
+        {
+          for (int k = 0; k < 8; k++)
+            if (mask[i+k])
+              fcn (i + k);
+        }
+    }
+
+  for (; i < n; i++)
+    if (mask[i])
+      fcn (i);
+}
+
+// Compact the selected indices of [0, N) in two passes, using NTHREADS
+// threads.  COUNT (B, E) returns the number of selected indices in
+// [B, E), ALLOC (NNZ) returns storage for all of them, and
+// STORE (B, E, DEST, DEST_END) writes those of [B, E) to DEST, where
+// exactly DEST_END - DEST of them fit.  Each thread counts and then
+// stores consecutive chunks of indices, whose offsets in the result
+// are the prefix sums of the counts.  Return the total count.
+
+template <typename C, typename A, typename S>
+octave_idx_type
+mask_compact (octave_idx_type n, int nthreads, C count, A alloc, S store)
+{
+  if (nthreads <= 1)
+    {
+      octave_idx_type nnz = count (0, n);
+      octave_idx_type *dest = alloc (nnz);
+      store (0, n, dest, dest + nnz);
+      return nnz;
+    }
+
+  static const octave_idx_type chunk = 16384;
+
+  octave_idx_type nc = (n + chunk - 1) / chunk;
+  std::vector<octave_idx_type> offset (nc + 1, 0);
+
+  // A chunk belongs to the range that holds its first index.
+  auto chunks = [n] (octave_idx_type b, octave_idx_type e, auto fcn)
+  {
+    for (octave_idx_type k = (b + chunk - 1) / chunk; k * chunk < e; k++)
+      fcn (k, k * chunk, std::min (n, (k + 1) * chunk));
+  };
+
+  sparse_range_blocks (n, nthreads, [&] (octave_idx_type b,
+                                         octave_idx_type e)
+  {
+    chunks (b, e, [&] (octave_idx_type k, octave_idx_type cb,
+                       octave_idx_type ce)
+    { offset[k+1] = count (cb, ce); });
+  });
+
+  std::partial_sum (offset.begin (), offset.end (), offset.begin ());
+
+  octave_idx_type *dest = alloc (offset[nc]);
+
+  sparse_range_blocks (n, nthreads, [&] (octave_idx_type b,
+                                         octave_idx_type e)
+  {
+    chunks (b, e, [&] (octave_idx_type k, octave_idx_type cb,
+                       octave_idx_type ce)
+    { store (cb, ce, dest + offset[k], dest + offset[k+1]); });
+  });
+
+  return offset[nc];
+}
+
+// Number of true elements of the N elements of MASK.
+
+extern OCTAVE_API octave_idx_type
+mask_nnz (const bool *mask, octave_idx_type n);
+
+// Store the indices of the NNZ true elements of the N elements of MASK
+// in DEST.
+
+extern OCTAVE_API void
+mask_find (const bool *mask, octave_idx_type n, octave_idx_type nnz,
+           octave_idx_type *dest);
+
+#endif
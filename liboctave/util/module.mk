@@ -14,6 +14,7 @@ UTIL_INC = \
   %reldir%/lo-regexp.h \
   %reldir%/lo-traits.h \
   %reldir%/lo-utils.h \
+  %reldir%/mask-util.h \
   %reldir%/f77-fcn.h \
   %reldir%/lo-error.h \
   %reldir%/octave-preserve-stream-state.h \
@@ -36,6 +37,7 @@ UTIL_INC = \
   %reldir%/pathsearch.h \
   %reldir%/singleton-cleanup.h \
   %reldir%/sparse-util.h \
+  %reldir%/str-search.h \
   %reldir%/str-vec.h \
   %reldir%/unwind-prot.h \
   %reldir%/url-transfer.h
@@ -70,6 +72,7 @@ UTIL_SRC = \
   %reldir%/lo-ieee.cc \
   %reldir%/lo-regexp.cc \
   %reldir%/lo-utils.cc \
+  %reldir%/mask-util.cc \
   %reldir%/quit.cc \
   %reldir%/oct-atomic.c \
   %reldir%/oct-base64.cc \
@@ -83,6 +86,7 @@ UTIL_SRC = \
   %reldir%/pathsearch.cc \
   %reldir%/singleton-cleanup.cc \
   %reldir%/sparse-util.cc \
+  %reldir%/str-search.cc \
   %reldir%/str-vec.cc \
   %reldir%/unwind-prot.cc \
   %reldir%/url-transfer.cc \
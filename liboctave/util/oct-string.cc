@@ -31,9 +31,13 @@
 
 #include <algorithm>
 #include <cctype>
+#include <charconv>
+#include <cstdint>
 #include <cstring>
 #include <iomanip>
 #include <string>
+#include <string_view>
+#include <system_error>
 #include <unordered_set>
 
 #include "Array.h"
@@ -236,6 +240,7 @@ octave::string::strncmpi (const T& str_a, const typename T::value_type *str_b,
 // We could also instantiate std::vector<char> but would it be
 // useful for anyone?
 INSTANTIATE_OCTAVE_STRING(std::string, OCTAVE_API)
+INSTANTIATE_OCTAVE_STRING(std::string_view, OCTAVE_API)
 INSTANTIATE_OCTAVE_STRING(Array<char>, OCTAVE_API)
 
 #undef INSTANTIATE_OCTAVE_STRING
@@ -440,6 +445,145 @@ extract_num (std::istringstream& is, double& num, bool& imag, bool& have_sign)
   return is;
 }
 
+// Parse a plain real number, that is optional spaces, an optional
+// sign, decimal digits with an optional point and exponent, and
+// optional spaces, or a signed Inf, NaN, or NA.  This is most of the
+// input of str2double in practice.  Return false for anything else, and
+// for numbers that cannot be converted exactly here, so that the
+// general parser can handle them with the same result as before.
+
+static bool
+fast_str2double (const char *p, const char *end, double& num)
+{
+  while (p < end && isspace (static_cast<unsigned char> (*p)))
+    p++;
+
+  while (end > p && isspace (static_cast<unsigned char> (end[-1])))
+    end--;
+
+  bool negative = false;
+
+  if (p < end && (*p == '+' || *p == '-'))
+    negative = (*p++ == '-');
+
+  std::size_t len = end - p;
+
+  if (len == 0)
+    return false;
+
+  if (len == 3 && std::tolower (p[0]) == 'i' && std::tolower (p[1]) == 'n'
+      && std::tolower (p[2]) == 'f')
+    num = octave::numeric_limits<double>::Inf ();
+  else if (len == 3 && p[0] == 'N' && p[1] == 'a' && p[2] == 'N')
+    num = octave::numeric_limits<double>::NaN ();
+  else if (len == 2 && p[0] == 'N' && p[1] == 'A')
+    num = octave_NA;
+  else
+    {
+      // Collect up to 19 significant digits, which fit in a 64-bit
+      // integer.
+
+      const char *start = p;
+
+      std::uint64_t mant = 0;
+      int ndigits = 0;
+      bool have_digits = false;
+      bool exact = true;
+      long scale = 0;
+
+      auto digit = [&] (int d, bool frac)
+      {
+        have_digits = true;
+
+        if (mant == 0 && d == 0)
+          scale -= frac;
+        else if (ndigits < 19)
+          {
+            mant = 10 * mant + d;
+            ndigits++;
+            scale -= frac;
+          }
+        else
+          exact = false;
+      };
+
+      while (p < end && isdigit (static_cast<unsigned char> (*p)))
+        digit (*p++ - '0', false);
+
+      if (p < end && *p == '.')
+        {
+          p++;
+          while (p < end && isdigit (static_cast<unsigned char> (*p)))
+            digit (*p++ - '0', true);
+        }
+
+      if (! have_digits)
+        return false;
+
+      if (p < end && (*p == 'e' || *p == 'E'))
+        {
+          p++;
+
+          bool neg_exp = false;
+          if (p < end && (*p == '+' || *p == '-'))
+            neg_exp = (*p++ == '-');
+
+          if (p == end)
+            return false;
+
+          long exp = 0;
+          while (p < end && isdigit (static_cast<unsigned char> (*p)))
+            {
+              if (exp < 100000)
+                exp = 10 * exp + (*p - '0');
+              p++;
+            }
+
+          scale += (neg_exp ? -exp : exp);
+        }
+
+      if (p != end)
+        return false;
+
+      // Powers of ten that are exactly representable.
+      static const double pow10[] =
+      {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+      };
+
+      if (mant == 0)
+        num = 0.0;
+      else if (exact && mant <= (UINT64_C (1) << 53)
+               && scale >= -22 && scale <= 22)
+        {
+          // Both factors are exact, so the one rounding of the product
+          // or the quotient gives the correctly rounded result.
+
+          double m = static_cast<double> (mant);
+          num = (scale < 0 ? m / pow10[-scale] : m * pow10[scale]);
+        }
+      else
+        {
+#if defined (HAVE_CXX_FLOAT_CHARCONV)
+          auto [ptr, ec] = std::from_chars (start, end, num);
+
+          if (ec != std::errc () || ptr != end)
+            return false;
+#else
+          octave_unused_parameter (start);
+
+          return false;
+#endif
+        }
+    }
+
+  if (negative)
+    num = -num;
+
+  return true;
+}
+
 static inline void
 set_component (Complex& c, double num, bool imag)
 {
@@ -471,6 +615,14 @@ octave::string::str2double (const std::string& str_arg)
   // FIXME: removing all commas doesn't allow actual parsing.
   //        Example: "1,23.45" is wrong, but passes Octave.
   str.erase (std::remove (str.begin (), str.end(), ','), str.end ());
+
+  double fast_num;
+  if (fast_str2double (str.data (), str.data () + str.length (), fast_num))
+    {
+      set_component (val, fast_num, false);
+      return val;
+    }
+
   std::istringstream is (str);
 
   double num;
@@ -28,11 +28,17 @@
 #endif
 
 #include <cinttypes>
+#include <cmath>
 #include <cstdarg>
 #include <cstdio>
 
+#include <algorithm>
+#include <vector>
+
 #include "lo-error.h"
+#include "nproc-wrapper.h"
 #include "oct-sparse.h"
+#include "quit.h"
 #include "sparse-util.h"
 
 static inline void
@@ -131,3 +137,136 @@ sparse_indices_ok (octave_idx_type *r, octave_idx_type *c,
 
   return true;
 }
+
+int
+sparse_kernel_threads (double work)
+{
+#if defined (HAVE_OPENMP)
+
+  // Below this amount of work per thread, starting and synchronizing
+  // the threads costs more than it saves.
+  static const double min_work_per_thread = 131072;
+
+  double nt = std::floor (work / min_work_per_thread);
+
+  if (nt < 2)
+    return 1;
+
+  int nproc
+    = octave_num_processors_wrapper (OCTAVE_NPROC_CURRENT_OVERRIDABLE);
+
+  return nt < nproc ? static_cast<int> (nt) : nproc;
+
+#else
+
+  octave_unused_parameter (work);
+
+  return 1;
+
+#endif
+}
+
+// Number of elements or columns handled by each thread between two
+// checks for interrupts.
+static const octave_idx_type sparse_block_batch = 65536;
+
+void
+sparse_thread_blocks (octave_idx_type n, int nthreads,
+                      const std::function<void (int, octave_idx_type,
+                                                octave_idx_type)>& fcn)
+{
+  if (nthreads < 1)
+    nthreads = 1;
+
+  octave_idx_type batch = sparse_block_batch * nthreads;
+
+  if (n <= batch)
+    {
+      fcn (0, 0, n);
+      return;
+    }
+
+  for (octave_idx_type b0 = 0; b0 < n; b0 += batch)
+    {
+      octave_quit ();
+
+      octave_idx_type len = std::min (batch, n - b0);
+
+      if (nthreads == 1)
+        fcn (0, b0, b0 + len);
+      else
+        {
+#if defined (HAVE_OPENMP)
+#  pragma omp parallel for num_threads (nthreads) schedule(static, 1)
+#endif
+          for (int t = 0; t < nthreads; t++)
+            fcn (t, b0 + len * t / nthreads, b0 + len * (t + 1) / nthreads);
+        }
+    }
+}
+
+void
+sparse_range_blocks (octave_idx_type n, int nthreads,
+                     const std::function<void (octave_idx_type,
+                                               octave_idx_type)>& fcn)
+{
+  sparse_thread_blocks (n, nthreads,
+                        [&fcn] (int, octave_idx_type b, octave_idx_type e)
+                        { fcn (b, e); });
+}
+
+void
+sparse_column_blocks (const octave_idx_type *cidx, octave_idx_type nc,
+                      int nthreads,
+                      const std::function<void (octave_idx_type,
+                                                octave_idx_type)>& fcn)
+{
+  if (nthreads <= 1 || nc == 0)
+    {
+      fcn (0, nc);
+      return;
+    }
+
+  // Split the columns into ranges with about the same number of nonzero
+  // elements.  There are several ranges per thread to even out columns
+  // that take longer than others, and at least one batch of elements
+  // per range.
+
+  octave_idx_type nz = cidx[nc] - cidx[0];
+
+  octave_idx_type nranges
+    = std::max (static_cast<octave_idx_type> (4 * nthreads),
+                nz / sparse_block_batch);
+  nranges = std::min (nranges, nc);
+
+  std::vector<octave_idx_type> bounds (nranges + 1);
+
+  bounds[0] = 0;
+  for (octave_idx_type k = 1; k < nranges; k++)
+    {
+      octave_idx_type target
+        = cidx[0] + static_cast<octave_idx_type> (static_cast<double> (nz)
+                                                  * k / nranges);
+
+      octave_idx_type jb = std::lower_bound (cidx, cidx + nc + 1, target)
+                           - cidx;
+
+      bounds[k] = std::max (std::min (jb, nc), bounds[k-1]);
+    }
+  bounds[nranges] = nc;
+
+  octave_idx_type group = 4 * nthreads;
+
+  for (octave_idx_type k0 = 0; k0 < nranges; k0 += group)
+    {
+      octave_quit ();
+
+      octave_idx_type k1 = std::min (k0 + group, nranges);
+
+#if defined (HAVE_OPENMP)
+#  pragma omp parallel for num_threads (nthreads) schedule(dynamic, 1)
+#endif
+      for (octave_idx_type k = k0; k < k1; k++)
+        fcn (bounds[k], bounds[k+1]);
+    }
+}
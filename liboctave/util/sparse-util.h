@@ -28,6 +28,8 @@
 
 #include "octave-config.h"
 
+#include <functional>
+
 // The next two functions don't do anything unless CHOLMOD is available
 
 // FIXME: This overload is here due to API change in SuiteSparse (3.1 -> 3.2)
@@ -45,4 +47,39 @@ sparse_indices_ok (octave_idx_type *r, octave_idx_type *c,
                    octave_idx_type nrows, octave_idx_type ncols,
                    octave_idx_type nnz);
 
+// Number of threads to use for a sparse matrix kernel that performs
+// about WORK floating point operations.  This is 1 if Octave was built
+// without OpenMP or if the work is too small to be worth splitting.
+
+extern OCTAVE_API int
+sparse_kernel_threads (double work);
+
+// Call FCN (B, E) for consecutive ranges [B, E) that cover [0, N),
+// using NTHREADS threads.  Interrupts are checked between batches of
+// ranges, never while FCN runs on more than one thread.
+
+extern OCTAVE_API void
+sparse_range_blocks (octave_idx_type n, int nthreads,
+                     const std::function<void (octave_idx_type,
+                                               octave_idx_type)>& fcn);
+
+// Like sparse_range_blocks, but also pass the number T of the thread
+// that handles the range, 0 <= T < NTHREADS, so that FCN can accumulate
+// into one buffer per thread.  The ranges of each thread are increasing.
+
+extern OCTAVE_API void
+sparse_thread_blocks (octave_idx_type n, int nthreads,
+                      const std::function<void (int, octave_idx_type,
+                                                octave_idx_type)>& fcn);
+
+// Call FCN (JB, JE) for ranges of columns [JB, JE) of a matrix with NC
+// columns and column pointers CIDX, using NTHREADS threads.  The ranges
+// hold about the same number of nonzero elements.
+
+extern OCTAVE_API void
+sparse_column_blocks (const octave_idx_type *cidx, octave_idx_type nc,
+                      int nthreads,
+                      const std::function<void (octave_idx_type,
+                                                octave_idx_type)>& fcn);
+
 #endif
@@ -0,0 +1,315 @@
+////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2024 The Octave Project Developers
+//
+// See the file COPYRIGHT.md in the top-level directory of this
+// distribution or <https://octave.org/copyright/>.
+//
+// This file is part of Octave.
+//
+// Octave is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Octave is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Octave; see the file COPYING.  If not, see
+// <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////
+
+#if defined (HAVE_CONFIG_H)
+#  include "config.h"
+#endif
+
+#include <cstdint>
+#include <cstring>
+
+#include <limits>
+
+#include "str-search.h"
+
+OCTAVE_BEGIN_NAMESPACE(octave)
+
+// This allows safe indexing with char.
+// In C++, char may be (and often is) signed!
+#define ORD(ch) static_cast<unsigned char> (ch)
+#define TABSIZE (std::numeric_limits<unsigned char>::max () + 1)
+
+// Patterns up to this length are searched for with the word-wise
+// filter.  Longer ones are better served by the large shifts of Quick
+// Search.
+static const octave_idx_type short_pattern_max = 16;
+
+// The byte C in each of the eight bytes of a word.
+
+static inline std::uint64_t
+broadcast (char c)
+{
+  return UINT64_C (0x0101010101010101) * ORD (c);
+}
+
+// The high bit is set in the bytes of the result for which the byte of
+// V is zero, and nowhere else.  No carry crosses a byte boundary.
+
+static inline std::uint64_t
+zero_bytes (std::uint64_t v)
+{
+  const std::uint64_t low7 = UINT64_C (0x7f7f7f7f7f7f7f7f);
+
+  return ~(((v & low7) + low7) | v) & ~low7;
+}
+
+string_searcher::string_searcher (const char *pat, octave_idx_type m)
+  : m_pat (pat, m), m_shift ()
+{
+  if (m > short_pattern_max)
+    {
+      // This is the quick search algorithm, as described at
+      // http://www-igm.univ-mlv.fr/~lecroq/string/node19.html
+
+      m_shift.assign (TABSIZE, m + 1);
+      for (octave_idx_type i = 0; i < m; i++)
+        m_shift[ORD (pat[i])] = m - i;
+    }
+}
+
+template <typename FCN>
+void
+string_searcher::search (const char *y, octave_idx_type n, bool overlaps,
+                         FCN fcn) const
+{
+  const char *x = m_pat.data ();
+  octave_idx_type m = m_pat.length ();
+
+  if (m == 0 || n < m)
+    return;
+
+  if (m == 1)
+    {
+      // Looking for a single character.  Matches cannot overlap.
+      const char *p = y;
+      const char *end = y + n;
+
+      while ((p = static_cast<const char *> (std::memchr (p, x[0], end - p))))
+        {
+          fcn (p - y);
+          p++;
+        }
+    }
+  else if (m <= short_pattern_max)
+    {
+      // Compare the first and the last character of the pattern with
+      // the text at eight positions at once.  Only the positions that
+      // pass this test are compared in full.  The words are loaded with
+      // memcpy, which works for any alignment and byte order, as the
+      // filter only asks whether any of the eight positions is a
+      // candidate.
+
+      const char x0 = x[0];
+      const char xl = x[m-1];
+      const std::uint64_t first = broadcast (x0);
+      const std::uint64_t last = broadcast (xl);
+
+      // Matches may not start before NEXT.
+      octave_idx_type next = 0;
+      octave_idx_type skip = (overlaps ? 1 : m);
+
+      auto check = [=, &next, &fcn] (octave_idx_type j)
+      {
+        if (j >= next && y[j] == x0 && y[j+m-1] == xl
+            && std::memcmp (y + j + 1, x + 1, m - 2) == 0)
+          {
+            fcn (j);
+            next = j + skip;
+          }
+      };
+
+      octave_idx_type i = 0;
+
+      for (; i + m + 7 <= n; i += 8)
+        {
+          std::uint64_t a, b;
+          std::memcpy (&a, y + i, 8);
+          std::memcpy (&b, y + i + m - 1, 8);
+
+          if (zero_bytes ((a ^ first) | (b ^ last)))
+            {
+              for (octave_idx_type k = 0; k < 8; k++)
+                check (i + k);
+            }
+        }
+
+      for (; i + m <= n; i++)
+        check (i);
+    }
+  else
+    {
+      // General case.
+      octave_idx_type j = 0;
+
+      while (j < n - m)
+        {
+          if (std::memcmp (x, y + j, m) == 0)
+            {
+              fcn (j);
+              if (! overlaps)
+                {
+                  j += m;
+                  continue;
+                }
+            }
+
+          j += m_shift[ORD (y[j + m])];
+        }
+
+      if (j == n - m && std::memcmp (x, y + j, m) == 0)
+        fcn (j);
+    }
+}
+
+void
+string_searcher::find_all (const char *y, octave_idx_type n,
+                           std::vector<octave_idx_type>& matches,
+                           bool overlaps) const
+{
+  search (y, n, overlaps,
+          [&matches] (octave_idx_type j) { matches.push_back (j); });
+}
+
+octave_idx_type
+string_searcher::count (const char *y, octave_idx_type n,
+                        bool overlaps) const
+{
+  octave_idx_type retval = 0;
+
+  search (y, n, overlaps, [&retval] (octave_idx_type) { retval++; });
+
+  return retval;
+}
+
+multi_string_searcher::multi_string_searcher
+  (const std::vector<std::string>& pats)
+  : m_len (pats.size ()), m_next (TABSIZE, -1), m_out (1, -1),
+    m_same (pats.size (), -1), m_dict ()
+{
+  // Build the trie of the patterns.  Missing transitions are -1.
+
+  int nstates = 1;
+
+  for (std::size_t k = 0; k < pats.size (); k++)
+    {
+      const std::string& p = pats[k];
+
+      m_len[k] = p.length ();
+
+      if (p.empty ())
+        continue;
+
+      int s = 0;
+
+      for (char c : p)
+        {
+          std::size_t e = static_cast<std::size_t> (s) * TABSIZE + ORD (c);
+          int t = m_next[e];
+
+          if (t < 0)
+            {
+              t = nstates++;
+              m_next.resize (static_cast<std::size_t> (nstates) * TABSIZE, -1);
+              m_out.push_back (-1);
+              m_next[e] = t;
+            }
+
+          s = t;
+        }
+
+      m_same[k] = m_out[s];
+      m_out[s] = k;
+    }
+
+  // Compute the suffix links in breadth-first order and replace the
+  // missing transitions by those of the suffix link, so that the
+  // search makes exactly one transition per character.
+
+  std::vector<int> fail (nstates, 0);
+  std::vector<int> queue;
+  queue.reserve (nstates);
+
+  m_dict.assign (nstates, 0);
+
+  for (int c = 0; c < TABSIZE; c++)
+    {
+      int t = m_next[c];
+
+      if (t < 0)
+        m_next[c] = 0;
+      else
+        queue.push_back (t);
+    }
+
+  for (std::size_t q = 0; q < queue.size (); q++)
+    {
+      int s = queue[q];
+      int f = fail[s];
+
+      m_dict[s] = (m_out[f] >= 0 ? f : m_dict[f]);
+
+      int *ns = m_next.data () + static_cast<std::size_t> (s) * TABSIZE;
+      const int *nf = m_next.data () + static_cast<std::size_t> (f) * TABSIZE;
+
+      for (int c = 0; c < TABSIZE; c++)
+        {
+          int t = ns[c];
+
+          if (t < 0)
+            ns[c] = nf[c];
+          else
+            {
+              fail[t] = nf[c];
+              queue.push_back (t);
+            }
+        }
+    }
+}
+
+void
+multi_string_searcher::find_all
+  (const char *y, octave_idx_type n,
+   std::vector<std::vector<octave_idx_type>>& matches, bool overlaps) const
+{
+  std::size_t np = m_len.size ();
+
+  matches.assign (np, std::vector<octave_idx_type> ());
+
+  // Without overlaps, a match of pattern K may not start before
+  // NEXT[K].
+  std::vector<octave_idx_type> next (np, 0);
+
+  const int *trans = m_next.data ();
+  std::size_t s = 0;
+
+  for (octave_idx_type i = 0; i < n; i++)
+    {
+      s = static_cast<std::size_t> (trans[s * TABSIZE + ORD (y[i])]);
+
+      for (int t = s; t > 0; t = m_dict[t])
+        for (int k = m_out[t]; k >= 0; k = m_same[k])
+          {
+            octave_idx_type j = i + 1 - m_len[k];
+
+            if (overlaps || j >= next[k])
+              {
+                matches[k].push_back (j);
+                next[k] = i + 1;
+              }
+          }
+    }
+}
+
+OCTAVE_END_NAMESPACE(octave)
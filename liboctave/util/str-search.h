@@ -0,0 +1,135 @@
+////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2024 The Octave Project Developers
+//
+// See the file COPYRIGHT.md in the top-level directory of this
+// distribution or <https://octave.org/copyright/>.
+//
+// This file is part of Octave.
+//
+// Octave is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Octave is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Octave; see the file COPYING.  If not, see
+// <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////
+
+#if ! defined (octave_str_search_h)
+#define octave_str_search_h 1
+
+#include "octave-config.h"
+
+#include <string>
+#include <vector>
+
+OCTAVE_BEGIN_NAMESPACE(octave)
+
+// Find all occurrences of one pattern in any number of strings.  The
+// pattern is preprocessed once, so the same searcher should be used
+// for all elements of a cell array.  Single characters are found with
+// memchr, short patterns by testing the first and last character at
+// eight positions at once in a 64-bit word, and long patterns with the
+// Quick Search algorithm.
+
+class OCTAVE_API string_searcher
+{
+public:
+
+  string_searcher (const char *pat, octave_idx_type m);
+
+  string_searcher (const std::string& pat)
+    : string_searcher (pat.data (), pat.length ())
+  { }
+
+  string_searcher (const string_searcher&) = default;
+
+  string_searcher& operator = (const string_searcher&) = default;
+
+  ~string_searcher () = default;
+
+  octave_idx_type length () const { return m_pat.length (); }
+
+  // Append the zero-based positions of the matches in Y[0] to Y[N-1]
+  // to MATCHES.  If OVERLAPS is false, a match may only start after the
+  // end of the previous one.  An empty pattern never matches.
+
+  void find_all (const char *y, octave_idx_type n,
+                 std::vector<octave_idx_type>& matches,
+                 bool overlaps = true) const;
+
+  // The number of matches, as found by find_all.
+
+  octave_idx_type count (const char *y, octave_idx_type n,
+                         bool overlaps = true) const;
+
+private:
+
+  template <typename FCN>
+  void search (const char *y, octave_idx_type n, bool overlaps,
+               FCN fcn) const;
+
+  std::string m_pat;
+
+  // Shift table of the Quick Search algorithm.  Only used for long
+  // patterns.
+  std::vector<octave_idx_type> m_shift;
+};
+
+// Find all occurrences of several patterns in a string in one pass,
+// using an Aho-Corasick automaton.  This is faster than searching for
+// each pattern on its own if there are many patterns.
+
+class OCTAVE_API multi_string_searcher
+{
+public:
+
+  // Empty patterns never match.
+
+  multi_string_searcher (const std::vector<std::string>& pats);
+
+  multi_string_searcher (const multi_string_searcher&) = default;
+
+  multi_string_searcher& operator = (const multi_string_searcher&) = default;
+
+  ~multi_string_searcher () = default;
+
+  octave_idx_type numel () const { return m_len.size (); }
+
+  // Set MATCHES[K] to the zero-based positions of the matches of
+  // pattern K in Y[0] to Y[N-1], in increasing order.  OVERLAPS applies
+  // to the matches of each pattern as for string_searcher::find_all.
+
+  void find_all (const char *y, octave_idx_type n,
+                 std::vector<std::vector<octave_idx_type>>& matches,
+                 bool overlaps = true) const;
+
+private:
+
+  // Lengths of the patterns.
+  std::vector<octave_idx_type> m_len;
+
+  // Transitions of the automaton, 256 per state.
+  std::vector<int> m_next;
+
+  // The patterns that end in each state, linked through m_same.
+  std::vector<int> m_out;
+
+  std::vector<int> m_same;
+
+  // The next state on the chain of suffix links that ends a pattern,
+  // or 0.
+  std::vector<int> m_dict;
+};
+
+OCTAVE_END_NAMESPACE(octave)
+
+#endif
@@ -2792,6 +2792,31 @@ AC_DEFUN([OCTAVE_CXX_DYNAMIC_AUTO_ARRAYS], [
   fi
 ])
 dnl
+dnl Check if the C++ library has std::from_chars and std::to_chars for
+dnl floating point numbers.
+dnl
+AC_DEFUN([OCTAVE_CXX_FLOAT_CHARCONV], [
+  AC_CACHE_CHECK([whether std::from_chars and std::to_chars support double],
+    [octave_cv_cxx_float_charconv],
+    [AC_LANG_PUSH(C++)
+    AC_LINK_IFELSE([AC_LANG_PROGRAM([[
+        #include <charconv>
+        ]], [[
+        char buf[32];
+        double x = 0.0;
+        std::to_chars (buf, buf + sizeof (buf), 1.5,
+                       std::chars_format::general, 6);
+        std::from_chars (buf, buf + sizeof (buf), x);
+      ]])],
+      octave_cv_cxx_float_charconv=yes, octave_cv_cxx_float_charconv=no)
+    AC_LANG_POP(C++)
+  ])
+  if test $octave_cv_cxx_float_charconv = yes; then
+    AC_DEFINE(HAVE_CXX_FLOAT_CHARCONV, 1,
+      [Define to 1 if C++ library has std::from_chars and std::to_chars for double.])
+  fi
+])
+dnl
 dnl Check if C++ compiler handles FLAG command line option.  If two
 dnl arguments are specified, execute the second arg as shell commands.
 dnl Otherwise, add FLAG to CXXFLAGS if the compiler accepts the flag.
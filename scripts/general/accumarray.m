@@ -127,7 +127,9 @@
 ## generally O(M+N), where N is the number of subscripts and M is the
 ## maximum subscript (linearized in multi-dimensional case).  If
 ## @var{fcn} is one of @code{@@sum} (default), @code{@@max},
-## @code{@@min} or @code{@@(x) @{x@}}, an optimized code path is used.
+## @code{@@min}, @code{@@prod}, @code{@@mean}, @code{@@var}, @code{@@std},
+## @code{@@numel}, @code{@@length}, @code{@@any}, @code{@@all} or
+## @code{@@(x) @{x@}}, an optimized code path is used.
 ## Note that for general reduction function the interpreter overhead can
 ## play a major part and it may be more efficient to do multiple
 ## accumarray calls and compute the results in a vectorized manner.
@@ -204,7 +206,15 @@ function A = accumarray (subs, vals, sz = [], fcn = [], fillval = [], issparse =
       error ("accumarray: in the sparse case, values must be numeric or logical");
     endif
 
-    if (fcn != @sum)
+    if (fcn != @sum && ! isempty (op = reduction_op (fcn, vals)))
+
+      ## Reduce the values of the distinct index pairs with the compiled
+      ## group-by engine.
+      [subs, ~, jdx] = unique (subs, "rows");
+      vals = __accumarray_reduce__ (jdx, vals, op, rows (subs));
+      mode = "unique";
+
+    elseif (fcn != @sum)
 
       ## Reduce values.  This is not needed if we're about to sum them,
       ## because "sparse" can do that.
@@ -337,6 +347,20 @@ function A = accumarray (subs, vals, sz = [], fcn = [], fillval = [], issparse =
         mask(subs) = false;
         A(mask) = fillval;
       endif
+    elseif (! isempty (op = reduction_op (fcn, vals)))
+      ## Other reductions done by the compiled group-by engine.
+      if (isempty (sz))
+        A = __accumarray_reduce__ (subs, vals, op);
+      else
+        A = __accumarray_reduce__ (subs, vals, op, prod (sz));
+        A = reshape (A, sz);
+      endif
+
+      if (! strcmp (op, "cell") && fillval != 0)
+        mask = true (size (A));
+        mask(subs) = false;
+        A(mask) = fillval;
+      endif
     else
 
       ## The general case.  Reduce values.
@@ -388,6 +412,38 @@ function A = accumarray (subs, vals, sz = [], fcn = [], fillval = [], issparse =
 
 endfunction
 
+## The reduction of __accumarray_reduce__ that gives the same result as FCN
+## applied to the values VALS of each group, or "" if there is none.
+function op = reduction_op (fcn, vals)
+
+  persistent simple_cell_str = func2str (@(x) {x});
+
+  op = "";
+
+  if (! (isnumeric (vals) || islogical (vals)) || iscomplex (vals))
+    return;
+  endif
+
+  if (fcn == @prod)
+    op = "prod";
+  elseif (fcn == @numel || fcn == @length)
+    op = "count";
+  elseif (fcn == @any)
+    op = "any";
+  elseif (fcn == @all)
+    op = "all";
+  elseif (fcn == @mean && ! any (strcmp (class (vals), {"int64", "uint64"})))
+    op = "mean";
+  elseif (fcn == @var && isfloat (vals))
+    op = "var";
+  elseif (fcn == @std && isfloat (vals))
+    op = "std";
+  elseif (strcmp (func2str (fcn), simple_cell_str))
+    op = "cell";
+  endif
+
+endfunction
+
 
 %!assert (accumarray ([1; 2; 4; 2; 4], 101:105), [101; 206; 0; 208])
 %!assert (accumarray ([1 1 1; 2 1 2; 2 3 2; 2 1 2; 2 3 2], 101:105),
@@ -410,6 +466,11 @@ endfunction
 %!assert (accumarray ([1 1; 2 1; 2 3; 2 1; 2 3], 101:105, [2 4], @(x) length (x) > 1),
 %!        [false false false false; true false true false])
 
+%!assert (accumarray ([1; 1; 2], [NaN; 0; NaN], [], @any), [false; false])
+%!assert (accumarray ([1; 1; 2], [NaN; 0; NaN], [2, 1], @any, [], true),
+%!        sparse ([false; false]))
+%!assert (accumarray ([1; 1; 2], [NaN; 0; NaN], [], @all), [false; true])
+
 %!assert (accumarray ([1; 2], [3; 4], [2, 1], @min, [], 0), [3; 4])
 %!assert (accumarray ([1; 2], [3; 4], [2, 1], @min, [], 1), sparse ([3; 4]))
 %!assert (accumarray ([1; 2], [3; 4], [1, 2], @min, [], 0), [3, 4])
@@ -123,6 +123,37 @@ function A = accumdim (subs, vals, dim, n = 0, fcn = [], fillval = 0)
     return;
   endif
 
+  ## Reductions done by the compiled group-by engine.
+  if ((isnumeric (vals) || islogical (vals)) && ! iscomplex (vals))
+    op = "";
+    if (fcn == @min)
+      op = "min";
+    elseif (fcn == @max)
+      op = "max";
+    elseif (fcn == @prod)
+      op = "prod";
+    elseif (fcn == @any)
+      op = "any";
+    elseif (fcn == @all)
+      op = "all";
+    elseif (fcn == @mean && ! any (strcmp (class (vals), {"int64", "uint64"})))
+      op = "mean";
+    endif
+
+    if (! isempty (op))
+      A = __accumdim_reduce__ (subs, vals, op, dim, n);
+
+      if (fillval != 0)
+        mask = true (n, 1);
+        mask(subs) = false;
+        subsc = {':'}(ones (1, length (sz)));
+        subsc{dim} = mask;
+        A(subsc{:}) = fillval;
+      endif
+      return;
+    endif
+  endif
+
   ## The general case.
   ns = length (subs);
   ## Sort indices.
@@ -177,6 +208,11 @@ endfunction
 %!assert (accumdim ([1;3;1;3;3], a)(2,:,:), zeros (1,5,5))
 %!assert (accumdim ([1;3;1;3;3], a, 1, 4)([2 4],:,:), zeros (2,5,5))
 %!assert (accumdim ([1;3;1;3;3], a, 1, 4, [], pi)([2 4],:,:), pi (2,5,5))
+%!assert (accumdim ([1;3;1;3;3], a, 1, 4, @prod, pi)([2 4],:,:), pi (2,5,5))
+%!assert (accumdim ([1;1;2], [NaN;0;NaN], 1, 2, @any), [false; false])
+%!assert (accumdim ([1;1;2], [NaN;0;NaN], 1, 2, @all), [false; true])
+%!assert (accumdim ([2;1;2;2;1], a, 3, 2, @mean),
+%!        cat (3, mean (a(:,:,[2 5]), 3), mean (a(:,:,[1 3 4]), 3)), eps)
 
 ## Test input validation
 %!error <Invalid call> accumdim ()
@@ -214,10 +214,19 @@ function ZI = interp2 (varargin)
       endif
     endif
 
-    xidx = lookup (X, XI, "lr");
-    yidx = lookup (Y, YI, "lr");
+    ## Bilinear interpolation of floating point data in compiled code.
+    compiled = (strcmp (method, "linear") && isfloat (Z) && ! issparse (Z)
+                && isfloat (X) && isfloat (Y) && isfloat (XI) && isfloat (YI));
 
-    if (strcmp (method, "linear"))
+    if (! compiled)
+      xidx = lookup (X, XI, "lr");
+      yidx = lookup (Y, YI, "lr");
+    endif
+
+    if (compiled)
+      ZI = __lin_interpn__ (Y, X, Z, YI, XI);
+
+    elseif (strcmp (method, "linear"))
       ## each quad satisfies the equation z(x,y)=a+b*x+c*y+d*xy
       ##
       ## a-b
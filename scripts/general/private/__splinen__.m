@@ -41,7 +41,7 @@ function yi = __splinen__ (x, y, xi, extrapval, f)
 
   yi = y;
   for i = length (x):-1:1
-    yi = permute (spline (x{i}, yi, xi{i}(:)), [length(x),1:length(x)-1]);
+    yi = permute (spline_last (x{i}, yi, xi{i}(:)), [length(x),1:length(x)-1]);
   endfor
 
   if (! isempty (extrapval))
@@ -54,3 +54,30 @@ function yi = __splinen__ (x, y, xi, extrapval, f)
   endif
 
 endfunction
+
+## Spline interpolation along the last dimension of Y, as spline does for
+## arrays.  Real floating point data is evaluated in compiled code.
+function yi = spline_last (x, y, xi)
+
+  x = x(:);
+  sz = size (y);
+
+  if (! isvector (y) && sz(end) == numel (x)
+      && isfloat (x) && isreal (x) && isfloat (y) && isreal (y)
+      && isfloat (xi) && isreal (xi) && ! any (isnan (y(:))))
+    xs = x;
+    ys = reshape (y, [], sz(end)).';
+    if (xs(end) < xs(1))
+      xs = flipud (xs);
+      ys = flipud (ys);
+    endif
+    if (all (diff (xs) > 0))
+      yi = __interp1__ (xs, ys, xi, "spline", "extrap");
+      yi = reshape (yi.', [sz(1:end-1), numel(xi)]);
+      return;
+    endif
+  endif
+
+  yi = spline (x, y, xi);
+
+endfunction
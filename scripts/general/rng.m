@@ -40,10 +40,11 @@
 ##
 ## The optional string @var{generator} specifies the type of random number
 ## generator to be used.  Its value can be @qcode{"twister"},
-## @qcode{"v5uniform"}, or @qcode{"v5normal"}.  The @qcode{"twister"} keyword
-## is described below.  @qcode{"v5uniform"} and @qcode{"v5normal"} refer to
-## older versions of Octave that used to use a different random number
-## generator.
+## @qcode{"philox"}, @qcode{"v5uniform"}, or @qcode{"v5normal"}.  The
+## @qcode{"twister"} and @qcode{"philox"} keywords are described below.
+## @qcode{"v5uniform"} and @qcode{"v5normal"} refer to older versions of
+## Octave that used to use a different random number generator.  Without
+## @var{generator}, the generator currently in use is seeded.
 ##
 ## The state or seed of the random number generator can be reset to a new
 ## random value using the @qcode{"shuffle"} keyword.
@@ -72,6 +73,12 @@
 ## returned values together, otherwise the generator state can be learned after
 ## reading 624 consecutive values.
 ##
+## With the @qcode{"philox"} option, pseudo-random sequences are computed
+## using the counter-based generator Philox4x32-10, which
+## @code{rand ("generator", "philox")} also selects.  Each number only depends
+## on the seed and its position in the sequence, so large arrays are filled
+## in parallel with the same result for any number of threads.
+##
 ## @seealso{rand, randn}
 ## @end deftypefn
 
@@ -82,8 +89,6 @@ function s = rng (varargin)
   endif
 
   ## Store current settings of random number generator
-  ## FIXME: there doesn't seem to be a way to query the type of generator
-  ##        currently used in Octave - assume "twister".
   ## FIXME: there doesn't seem to be a way to query the seed initialization
   ##        value - use "Not applicable".
   ## FIXME: rand and randn use different generators - storing both states.
@@ -93,7 +98,7 @@ function s = rng (varargin)
   ## Type is the generator name.
   ## Seed is the initial seed value.
   ## State is a structure describing internal state of the generator.
-  srng = struct ("Type", "twister",
+  srng = struct ("Type", rand ("generator"),
                  "Seed", "Not applicable",
                  "State", {{rand("state"), randn("state")}});
 
@@ -138,7 +143,8 @@ function s = rng (varargin)
     generator = srng.Type;
   endif
   switch (generator)
-    case "twister"
+    case {"twister", "philox"}
+      rand ("generator", generator);
       rand ("state", s_rand);
       randn ("state", s_randn);
 
@@ -174,9 +180,9 @@ function gen = check_generator (val)
   endif
 
   gen = lower (char (val));
-  if (any (strcmp (gen, {"simdtwister", "combrecursive", "philox", "threefry", "multfibonacci", "v4"})))
+  if (any (strcmp (gen, {"simdtwister", "combrecursive", "threefry", "multfibonacci", "v4"})))
     error ('rng: random number generator "%s" is not available in Octave', gen);
-  elseif (! any (strcmp (gen, {"twister", "v5uniform", "v5normal"})))
+  elseif (! any (strcmp (gen, {"twister", "philox", "v5uniform", "v5normal"})))
     error ('rng: unknown random number generator "%s"', gen);
   endif
 
@@ -287,6 +293,33 @@ endfunction
 %!   rng (state);
 %! end_unwind_protect
 
+%!test
+%! state = rng ();
+%! unwind_protect
+%!   rng (42, "philox");
+%!   assert (rand ("generator"), "philox");
+%!   ru1 = rand (1, 3);
+%!   rn1 = randn (1, 3);
+%!   rng (42, "philox");
+%!   assert (rand (1, 3), ru1);
+%!   assert (randn (1, 3), rn1);
+%!   s = rng ();
+%!   assert (s.Type, "philox");
+%!   assert (size (s.State{1}), [5, 1]);
+%!   ru1 = rand (1, 3);
+%!   rng (1);
+%!   assert (rand ("generator"), "philox");
+%!   rng (s);
+%!   assert (rand (1, 3), ru1);
+%!   rng ("default");
+%!   assert (rand ("generator"), "twister");
+%!   rng (s);
+%!   assert (rand ("generator"), "philox");
+%! unwind_protect_cleanup
+%!   rng (state);
+%! end_unwind_protect
+%! assert (rand ("generator"), "twister");
+
 ## Test input validation
 %!error <Invalid call> rng (1, 2, 3)
 %!error <Invalid call> rng (eye (2))
@@ -301,6 +334,6 @@ endfunction
 %!error <input structure requires "Type">
 %! rng (struct ("Type1",[],"State",[],"Seed",[]));
 %!error <GENERATOR must be a string> rng (0, struct ())
-%!error <"philox" is not available in Octave> rng (0, "philox")
+%!error <"threefry" is not available in Octave> rng (0, "threefry")
 %!error <GENERATOR must be a string> rng ("shuffle", struct ())
 %!error <unknown random number generator "foobar"> rng ("shuffle", "foobar")
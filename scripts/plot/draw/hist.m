@@ -206,7 +206,12 @@ function [nn, xx] = hist (varargin)
   n = rows (x);
   y_nc = columns (y);
 
-  if (n < 11 * (1 + (! equal_bin_spacing)))
+  if ((isnumeric (y) || islogical (y)) && ! issparse (y))
+    ## Count in compiled code.  The bins are closed on the right, and the
+    ## first and last bin are open.
+    nanidx = isnan (y);
+    freq = __histc__ (y, cutoff, 1, [], "hist");
+  elseif (n < 11 * (1 + (! equal_bin_spacing)))
     ## The following algorithm works fastest for small n.
     nanidx = isnan (y);
     chist = zeros (n+1, y_nc);
@@ -87,6 +87,30 @@ function [c, ia, ib] = intersect (a, b, varargin)
     isrowvec = isrow (a) && isrow (b);
   endif
 
+  if (! by_rows && ! optlegacy
+      && ((iscellstr (a) && iscellstr (b))
+          || (strcmp (class (a), class (b))
+              && isreal (a) && isreal (b) && ! issparse (a) && ! issparse (b))))
+    ## Keep the unique elements of A that are found in a hash table of the
+    ## elements of B.  Their order is that of the unique elements of A.
+    if (nargout > 1)
+      [a, ia] = unique (a, varargin{:});
+      [b, ib] = unique (b, varargin{:});
+      [tf, loc] = __ismember__ (a, b);
+      ia = ia(tf)(:);
+      ib = ib(loc(tf))(:);
+    else
+      a = unique (a, varargin{:});
+      tf = __ismember__ (a, b);
+    endif
+
+    c = a(tf)(:);
+    if (isrowvec)
+      c = c.';
+    endif
+    return;
+  endif
+
   ## Form A and B into sets
   if (nargout > 1 || ! optsorted)
     [a, ia] = unique (a, varargin{:});
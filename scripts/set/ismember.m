@@ -124,7 +124,17 @@ function [tf, s_idx] = ismember (a, s, varargin)
   ## FIXME: uncomment if bug #56692 is addressed.
   ## optlegacy = any (strcmp ("legacy", varargin));
 
-  if (! by_rows)
+  if (! by_rows && ((iscellstr (a) && iscellstr (s))
+                    || (strcmp (class (a), class (s))
+                        && ! issparse (a) && ! issparse (s))))
+    ## Look up the elements in a hash table of S.
+    if (nargout > 1)
+      [tf, s_idx] = __ismember__ (a, s);
+    else
+      tf = __ismember__ (a, s);
+    endif
+
+  elseif (! by_rows)
     s = s(:);
     ## Check sort status, because we expect the array will often be sorted.
     if (issorted (s))
@@ -94,16 +94,25 @@ function [c, ia] = setdiff (a, b, varargin)
       c = unique (a, varargin{:});
     endif
     if (! isempty (c) && ! isempty (b))
-      ## Form a and b into combined set.
-      b = unique (b);
-      [csort, idx] = sort ([c(:); b(:)]);
-      ## Eliminate those elements of a that are the same as in b.
-      if (iscellstr (csort))
-        dups = find (strcmp (csort(1:end-1), csort(2:end)));
+      if ((iscellstr (c) && iscellstr (b))
+          || (strcmp (class (c), class (b))
+              && isreal (c) && isreal (b) && ! issparse (c) && ! issparse (b)))
+        ## Look up the elements of c in a hash table of b.
+        dups = find (__ismember__ (c, b));
       else
-        dups = find (csort(1:end-1) == csort(2:end));
+        ## Form a and b into combined set.
+        b = unique (b);
+        [csort, idx] = sort ([c(:); b(:)]);
+        ## Find those elements of a that are the same as in b.
+        if (iscellstr (csort))
+          dups = find (strcmp (csort(1:end-1), csort(2:end)));
+        else
+          dups = find (csort(1:end-1) == csort(2:end));
+        endif
+        dups = idx(dups);
       endif
-      c(idx(dups)) = [];
+      ## Eliminate them.
+      c(dups) = [];
 
       ## Reshape if necessary for Matlab compatibility.
       if (isrowvec)
@@ -113,7 +122,7 @@ function [c, ia] = setdiff (a, b, varargin)
       endif
 
       if (nargout > 1)
-        ia(idx(dups)) = [];
+        ia(dups) = [];
         if (optlegacy && isrowvec)
           ia = ia(:).';
         endif
@@ -132,6 +141,7 @@ endfunction
 %!assert (setdiff ([1, 2; 3, 4], [1, 2; 3, 6], "rows"), [3, 4])
 %!assert (setdiff ({"one","two";"three","four"}, {"one","two";"three","six"}),
 %!        {"four"})
+%!assert (setdiff ([NaN, 2, -0, 1], [NaN, 2, 0]), [1, NaN])
 
 ## Test multi-dimensional input
 %!test
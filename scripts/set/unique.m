@@ -183,6 +183,27 @@ function [y, i, j] = unique (x, varargin)
     return;
   endif
 
+  ## The compiled kernel uses a radix sort for sorted output and a hash table
+  ## for stable output.  It returns the index vectors directly.
+  if (! optrows && ! issparse (x) && (iscellstr (x) || isreal (x)))
+    optlast = ! optfirst || optlegacy;
+    if (nargout > 2)
+      [y, i, j] = __unique__ (x, ! optsorted, optlast);
+    elseif (nargout > 1)
+      [y, i] = __unique__ (x, ! optsorted, optlast);
+    else
+      y = __unique__ (x, ! optsorted, optlast);
+    endif
+
+    if (optlegacy && isrowvec && nargout > 1)
+      i = i.';
+      if (nargout > 2)
+        j = j.';
+      endif
+    endif
+    return;
+  endif
+
   ## Calculate y output
   if (optrows)
     if (nargout > 1 || ! optsorted)
@@ -103,9 +103,17 @@ function [n, idx] = histc (x, edges, dim)
   nsz = sz;
   nsz(dim) = num_edges;
 
-  ## the splitting point is 3 bins
+  if ((isnumeric (x) || islogical (x)) && ! issparse (x) && isnumeric (edges))
 
-  if (num_edges <= 3)
+    ## Count in compiled code.  Uniformly spaced edges are found in
+    ## constant time, others by a binary search.
+    if (nargout > 1)
+      [n, idx] = __histc__ (x, edges, dim);
+    else
+      n = __histc__ (x, edges, dim);
+    endif
+
+  elseif (num_edges <= 3)
 
     ## This is the O(M*N) algorithm.
 
@@ -188,6 +196,14 @@ endfunction
 %! n = histc (x, 0:10, 2);
 %! assert (n, repmat ([repmat(100, 1, 10), 1], [2, 1, 3]));
 
+%!test
+%! [n, idx] = histc ([1, 2.5, 7, 3, NaN, 2], [1, 2, 2.5, 3]);
+%! assert (n, [1, 1, 1, 1]);
+%! assert (idx, [1, 3, 0, 4, 0, 2]);
+%! [n, idx] = histc (single ([1, 2.5, 7, 3, NaN, 2]), [1, 2, 2.5, 3]);
+%! assert (n, [1, 1, 1, 1]);
+%! assert (idx, [1, 3, 0, 4, 0, 2]);
+
 ## Test input validation
 %!error <Invalid call> histc ()
 %!error <Invalid call> histc (1)
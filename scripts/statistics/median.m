@@ -311,6 +311,25 @@ function m = median (x, varargin)
     perm_flag = true;
   endif
 
+  if (isfloat (x) && ! issparse (x))
+    ## Select the middle elements of each column instead of sorting.
+    if (isvector (x))
+      m = __median_select__ (x(:), omitnan);
+    else
+      m = __median_select__ (reshape (x, szx(1), []), omitnan);
+      m = reshape (m, [1, szx(2:end)]);
+    endif
+
+    if (perm_flag)
+      m = ipermute (m, perm);
+    endif
+
+    if (! strcmp (class (m), outtype))
+      m = feval (outtype, m);
+    endif
+    return;
+  endif
+
   ## Find column locations of NaNs
   nanfree = ! any (isnan (x), dim);
 
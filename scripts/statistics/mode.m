@@ -99,6 +99,22 @@ function [m, f, c] = mode (x, dim)
     return;
   endif
 
+  if (isfloat (x) && ! issparse (x))
+    ## Sort and count the values of each column in compiled code.
+    perm = [dim, 1:dim-1, dim+1:nd];
+    x = reshape (permute (x, perm), sz(dim), []);
+    szp = [1, sz(perm(2:end))];
+    if (nargout > 2)
+      [m, f, c] = __mode_runs__ (x);
+      c = ipermute (reshape (c, szp), perm);
+    else
+      [m, f] = __mode_runs__ (x);
+    endif
+    m = ipermute (reshape (m, szp), perm);
+    f = ipermute (reshape (f, szp), perm);
+    return;
+  endif
+
   sz2 = sz;
   sz2(dim) = 1;
   sz3 = ones (1, nd);
@@ -410,95 +410,8 @@ function inv = __quantile__ (x, p, method = 5)
     print_usage ("quantile");
   endif
 
-  if (isinteger (x) || islogical (x))
-    x = double (x);
-  endif
-
-  ## set shape of quantiles to column vector.
-  p = p(:);
-
-  ## Save length and set shape of samples.
-  x = sort (x, 1);
-  m = sum (! isnan (x));
-  [xr, xc] = size (x);
-
-  ## Initialize output values.
-  inv = Inf (class (x)) * (-(p < 0) + (p > 1));
-  inv = repmat (inv, 1, xc);
-
-  ## Do the work.
-  if (any (k = find ((p >= 0) & (p <= 1))))
-    n = length (k);
-    p = p(k);
-    ## Special case of 1 row.
-    if (xr == 1)
-      inv(k,:) = repmat (x, n, 1);
-      return;
-    endif
-
-    ## The column-distribution indices.
-    pcd = kron (ones (n, 1), xr*(0:xc-1));
-    mm = kron (ones (n, 1), m);
-    switch (method)
-      case {1, 2, 3}
-        switch (method)
-          case 1
-            p = max (ceil (kron (p, m)), 1);
-            inv(k,:) = x(p + pcd);
-
-          case 2
-            p = kron (p, m);
-            p_lr = max (ceil (p), 1);
-            p_rl = min (floor (p + 1), mm);
-            inv(k,:) = (x(p_lr + pcd) + x(p_rl + pcd))/2;
-
-          case 3
-           ## Used by SAS, method PCTLDEF=2.
-           ## http://support.sas.com/onlinedoc/913/getDoc/en/statug.hlp/stdize_sect14.htm
-            t = max (kron (p, m), 1);
-            t = roundb (t);
-            inv(k,:) = x(t + pcd);
-        endswitch
-
-      otherwise
-        switch (method)
-          case 4
-            p = kron (p, m);
-
-          case 5
-            ## Used by Matlab.
-            p = kron (p, m) + 0.5;
-
-          case 6
-            ## Used by Minitab and SPSS.
-            p = kron (p, m+1);
-
-          case 7
-            ## Used by S and R.
-            p = kron (p, m-1) + 1;
-
-          case 8
-            ## Median unbiased.
-            p = kron (p, m+1/3) + 1/3;
-
-          case 9
-            ## Approximately unbiased respecting order statistics.
-            p = kron (p, m+0.25) + 0.375;
-
-          otherwise
-            error ("quantile: Unknown METHOD, '%d'", method);
-        endswitch
-
-        ## Duplicate single values.
-        imm1 = (mm(1,:) == 1);
-        x(2,imm1) = x(1,imm1);
-
-        ## Interval indices.
-        pi = max (min (floor (p), mm-1), 1);
-        pr = max (min (p - pi, 1), 0);
-        pi += pcd;
-        inv(k,:) = (1-pr) .* x(pi) + pr .* x(pi+1);
-    endswitch
-  endif
+  ## The order statistics that METHOD interpolates are selected in each
+  ## column, ignoring NaN, without sorting the columns.
+  inv = __quantile_select__ (x, p, method);
 
 endfunction
@@ -903,6 +903,61 @@
 %!   endif
 %! endif
 
+## Byte swapping and conversion in fread/fwrite
+%!test
+%! nm = tempname ();
+%! [id, err] = fopen (nm, "wb+");
+%! if (id < 0)
+%!   __printf_assert__ ("open failed: %s (%s): %s\n", nm, "wb+", err);
+%! else
+%!   unwind_protect
+%!     x = [-32768, -1.5, 0, 1, 258, 32767, 40000];
+%!     fwrite (id, x, "int16", 0, "ieee-be");
+%!     frewind (id);
+%!     assert (fread (id, [1, 4], "uint8=>uint8"), uint8 ([128, 0, 255, 254]));
+%!     frewind (id);
+%!     y = fread (id, Inf, "int16=>single", 0, "ieee-be");
+%!     assert (y, single ([-32768; -2; 0; 1; 258; 32767; 32767]));
+%!     frewind (id);
+%!     y = fread (id, [2, 5], "int16=>double", 0, "ieee-be");
+%!     assert (y, [-32768, 0, 258, 32767; -2, 1, 32767, 0]);
+%!     frewind (id);
+%!     fwrite (id, [pi, -Inf, NaN], "double", 0, "ieee-be");
+%!     frewind (id);
+%!     y = fread (id, 3, "double", 0, "ieee-be");
+%!     assert (y, [pi; -Inf; NaN]);
+%!     frewind (id);
+%!     y = fread (id, 3, "double=>single", 0, "ieee-be");
+%!     assert (y, single ([pi; -Inf; NaN]));
+%!   unwind_protect_cleanup
+%!     fclose (id);
+%!     unlink (nm);
+%!   end_unwind_protect
+%! endif
+
+## Conversion of more elements than fread converts at once
+%!test
+%! nm = tempname ();
+%! [id, err] = fopen (nm, "wb+");
+%! if (id < 0)
+%!   __printf_assert__ ("open failed: %s (%s): %s\n", nm, "wb+", err);
+%! else
+%!   unwind_protect
+%!     x = int32 (-50000:49999)';
+%!     fwrite (id, x, "int32", 0, "ieee-be");
+%!     frewind (id);
+%!     assert (fread (id, 1e5, "int32=>int32", 0, "ieee-be"), x);
+%!     frewind (id);
+%!     assert (fread (id, 1e5, "int32=>double", 0, "ieee-be"), double (x));
+%!     frewind (id);
+%!     assert (fread (id, [1e5, 1], "int32=>single", 0, "ieee-be"),
+%!             single (x));
+%!   unwind_protect_cleanup
+%!     fclose (id);
+%!     unlink (nm);
+%!   end_unwind_protect
+%! endif
+
 %!test
 %! nm = tempname ();
 %! id = fopen (nm, "wb");
@@ -1222,6 +1277,15 @@
 %!assert <*53148> (double (sprintf ("B\0B")), [66, 0, 66])
 %!assert <*53148> (sscanf ("B\0B 13", "B\0B %d"), 13)
 
+%!assert (sprintf ("|%8.3f|%-8.3f|", pi, -pi), "|   3.142|-3.142  |")
+%!assert (sprintf ("%e %E", 12345.678, 1e-10), "1.234568e+04 1.000000E-10")
+%!assert (sprintf ("%g %G %.3g %g", 0.0001, 1e-5, 2/3, -0), "0.0001 1E-05 0.667 -0")
+%!assert (sprintf ("|%5d|%-5d|%d|", 42, -7, 1.5), "|   42|-7   |1.5|")
+%!assert (sprintf ("%d", intmax ("int64")), "9223372036854775807")
+%!assert (sprintf ("%.20f", 0.1), "0.10000000000000000555")
+%!assert (sprintf ("%.0f %.0e", 2.5, 2.5), "2 2e+00")
+%!assert (sprintf ("%+.2f|%05.1f|% g", 1, 2, 3), "+1.00|002.0| 3")
+
 %!test <*58055>
 %!  w_modes = {"wb", "wt"};
 %!  r_modes = {"rb", "rt"};
@@ -1283,3 +1347,69 @@
 %!     end_unwind_protect
 %!   endfor
 %! endfor
+
+## Memory mapped files
+%!test
+%! nm = tempname ();
+%! unwind_protect
+%!   x = (1:2^17)';
+%!   fid = fopen (nm, "w");
+%!   fwrite (fid, x, "double");
+%!   fwrite (fid, int16 ([-3, 7]), "int16");
+%!   fprintf (fid, "line one\nline two\n");
+%!   fclose (fid);
+%!   fid = fopen (nm, "rm");
+%!   assert (fid >= 3);
+%!   y = fread (fid, 2^17, "double");
+%!   assert (y, x);
+%!   assert (ftell (fid), 2^20);
+%!   frewind (fid);
+%!   z = fread (fid, [2^16, 2], "double=>double", 0, "native");
+%!   assert (z(:), x);
+%!   y(2) = -1;
+%!   assert (z(2), 2);
+%!   assert (fseek (fid, -8, SEEK_CUR), 0);
+%!   [w, count] = fread (fid, [2, 2], "double");
+%!   assert (count, 3);
+%!   assert (w(1,1), 2^17);
+%!   assert (w(2,2), 0);
+%!   assert (fseek (fid, 2^20, SEEK_SET), 0);
+%!   assert (fread (fid, 2, "int16=>int16"), int16 ([-3; 7]));
+%!   assert (fgetl (fid), "line one");
+%!   assert (fgetl (fid), "line two");
+%!   assert (fgetl (fid), -1);
+%!   assert (feof (fid));
+%!   assert (fseek (fid, -8, SEEK_CUR), 0);
+%!   assert (fread (fid, Inf, "char=>char").', "ine two\n");
+%!   assert (fseek (fid, 1, SEEK_END), -1);
+%!   fclose (fid);
+%!   assert (y([1, 3:end]), x([1, 3:end]));
+%!   assert (y(2), -1);
+%!   fid = fopen (nm, "r");
+%!   assert (fread (fid, 2^17, "double"), x);
+%!   fclose (fid);
+%! unwind_protect_cleanup
+%!   unlink (nm);
+%! end_unwind_protect
+
+%!test
+%! nm = tempname ();
+%! unwind_protect
+%!   fid = fopen (nm, "w");
+%!   fwrite (fid, zeros (1, 4), "int32");
+%!   fclose (fid);
+%!   fid = fopen (nm, "r+m");
+%!   fseek (fid, 4, SEEK_SET);
+%!   fwrite (fid, [5, 6], "int32");
+%!   frewind (fid);
+%!   y = fread (fid, Inf, "int32=>int32");
+%!   fclose (fid);
+%!   assert (y, int32 ([0; 5; 6; 0]));
+%!   fid = fopen (nm, "r");
+%!   assert (fread (fid, Inf, "int32"), [0; 5; 6; 0]);
+%!   fclose (fid);
+%! unwind_protect_cleanup
+%!   unlink (nm);
+%! end_unwind_protect
+
+%!error <mode 'm' requires mode 'r' or 'r\+'> fopen (tempname (), "wm")
@@ -517,6 +517,17 @@
 %! obs  = jsondecode (json);
 %! assert (isequaln (obs, exp));
 
+%% Arrays whose elements change type part way through
+%!testif HAVE_RAPIDJSON
+%! assert (isequal (jsondecode ('[1, null, "a"]'), {1; []; 'a'}));
+%! assert (isequal (jsondecode ('[true, false, 1]'), {true; false; 1}));
+%! assert (isequal (jsondecode ('[null, true]'), {[]; true}));
+%! assert (isequal (jsondecode ('[{"a": 1}, {"a": 2}, 3]'), ...
+%!                  {struct('a', 1); struct('a', 2); 3}));
+%! assert (isequal (jsondecode ('[{"a": 1}, {"a": 2}, {"b": 3}]'), ...
+%!                  {struct('a', 1); struct('a', 2); struct('b', 3)}));
+%! assert (isequal (jsondecode ('[{}, {}]'), repmat (struct (), 2, 1)));
+
 %%% Test 7: Check "ReplacementStyle", "Prefix", and "makeValidName" options
 %%%         Not Matlab compatible!
 
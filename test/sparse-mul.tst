@@ -0,0 +1,60 @@
+########################################################################
+##
+## Copyright (C) 2024 The Octave Project Developers
+##
+## See the file COPYRIGHT.md in the top-level directory of this
+## distribution or <https://octave.org/copyright/>.
+##
+## This file is part of Octave.
+##
+## Octave is free software: you can redistribute it and/or modify it
+## under the terms of the GNU General Public License as published by
+## the Free Software Foundation, either version 3 of the License, or
+## (at your option) any later version.
+##
+## Octave is distributed in the hope that it will be useful, but
+## WITHOUT ANY WARRANTY; without even the implied warranty of
+## MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+## GNU General Public License for more details.
+##
+## You should have received a copy of the GNU General Public License
+## along with Octave; see the file COPYING.  If not, see
+## <https://www.gnu.org/licenses/>.
+##
+########################################################################
+
+## The products below are large enough to be split over several threads
+## when Octave is built with OpenMP.  The results are compared against
+## the same products computed with full matrices.
+
+%!shared A, B, C, F, G
+%! A = sprandn (2000, 1500, 0.01);
+%! B = sprandn (1500, 1800, 0.01);
+%! C = A + 1i * sprandn (2000, 1500, 0.01);
+%! F = randn (1500, 40);
+%! G = randn (40, 2000);
+
+## sparse * sparse
+%!test
+%! S = A * B;
+%! assert (issparse (S));
+%! assert (S, sparse (full (A) * full (B)), 1e-12);
+%!test
+%! S = C * B;
+%! assert (issparse (S));
+%! assert (S, sparse (full (C) * full (B)), 1e-12);
+%!test
+%! S = C * C.';
+%! assert (issparse (S));
+%! assert (S, sparse (full (C) * full (C).'), 1e-12);
+%!assert (nnz (A * sparse (1500, 1800)), 0)
+
+## sparse * full and full * sparse
+%!assert (A * F, full (A) * F, 1e-12)
+%!assert (C * F, full (C) * F, 1e-12)
+%!assert (A' * (A * F), full (A)' * (full (A) * F), 1e-10)
+%!assert (C' * (A * F), full (C)' * (full (A) * F), 1e-10)
+%!assert (G * A, G * full (A), 1e-12)
+%!assert (G * C, G * full (C), 1e-12)
+%!assert (F' * A', F' * full (A)', 1e-12)
+%!assert (F' * C', F' * full (C)', 1e-12)
@@ -0,0 +1,84 @@
+########################################################################
+##
+## Copyright (C) 2024 The Octave Project Developers
+##
+## See the file COPYRIGHT.md in the top-level directory of this
+## distribution or <https://octave.org/copyright/>.
+##
+## This file is part of Octave.
+##
+## Octave is free software: you can redistribute it and/or modify it
+## under the terms of the GNU General Public License as published by
+## the Free Software Foundation, either version 3 of the License, or
+## (at your option) any later version.
+##
+## Octave is distributed in the hope that it will be useful, but
+## WITHOUT ANY WARRANTY; without even the implied warranty of
+## MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+## GNU General Public License for more details.
+##
+## You should have received a copy of the GNU General Public License
+## along with Octave; see the file COPYING.  If not, see
+## <https://www.gnu.org/licenses/>.
+##
+########################################################################
+
+
+## The matrices below have enough nonzero elements for the reductions and
+## elementwise operations to be split over several threads when Octave is
+## built with OpenMP.  The results are compared against the same
+## operations on full matrices.
+
+%!shared A, C, FA, FC
+%! A = sprandn (3000, 2000, 0.06);
+%! A(:,7) = 0;
+%! A(11,:) = 0;
+%! C = A + 1i * sprandn (3000, 2000, 0.06);
+%! FA = full (A);
+%! FC = full (C);
+
+## Reductions along both dimensions
+%!assert (sum (A), sparse (sum (FA)), 1e-10)
+%!assert (sum (A, 2), sparse (sum (FA, 2)), 1e-10)
+%!assert (sum (C), sparse (sum (FC)), 1e-10)
+%!assert (sum (C, 2), sparse (sum (FC, 2)), 1e-10)
+%!assert (sumsq (A), sparse (sumsq (FA)), 1e-10)
+%!assert (sumsq (C, 2), sparse (sumsq (FC, 2)), 1e-10)
+%!assert (prod (A), sparse (prod (FA)))
+%!assert (prod (A, 2), sparse (prod (FA, 2)))
+%!assert (any (A), sparse (any (FA)))
+%!assert (any (A, 2), sparse (any (FA, 2)))
+%!assert (all (A != 0, 2), sparse (all (FA != 0, 2)))
+%!test
+%! [m, i] = max (A);
+%! [fm, fi] = max (FA);
+%! assert (m, sparse (fm));
+%! assert (i, fi);
+%!test
+%! [m, i] = min (C);
+%! [fm, fi] = min (FC);
+%! assert (m, sparse (fm));
+%! assert (i, fi);
+
+## Row sums keep the order of summation of the serial loop
+%!test
+%! s = sum (A, 2);
+%! t = zeros (3000, 1);
+%! for j = 1:2000
+%!   t += FA(:,j);
+%! endfor
+%! assert (full (s), t);
+
+## Elementwise operations and mappers
+%!assert (abs (A), sparse (abs (FA)))
+%!assert (abs (C), sparse (abs (FC)))
+%!assert (2 * A, sparse (2 * FA))
+%!assert (A / 4, sparse (FA / 4))
+%!assert (C * 2i, sparse (FC * 2i))
+%!assert (A + 1, 1 + FA)
+%!assert (1 - C, 1 - FC)
+%!assert (sin (A), sparse (sin (FA)))
+%!assert (cos (A), sparse (cos (FA)))
+%!assert (exp (C), sparse (exp (FC)), eps)
+%!assert (isnan (A), sparse (isnan (FA)))
+%!assert (nnz (A * 0), 0)